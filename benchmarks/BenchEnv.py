@@ -0,0 +1,221 @@
+#------------------------------------------------------------------------------
+# Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+#------------------------------------------------------------------------------
+
+#------------------------------------------------------------------------------
+# Sets the environment used by the cx_Oracle benchmark suite. The benchmarks
+# use the same schema and connection parameters as the test suite; see the
+# Python script TestEnv.py in the test directory for the environment variables
+# that can be set to avoid being prompted for them.
+#
+# The tables and types used by the benchmarks are created in the main schema
+# the first time they are needed (or whenever the number of rows requested
+# changes) and are populated with deterministic data so that the results of
+# different runs can be compared with each other.
+#------------------------------------------------------------------------------
+
+import cx_Oracle
+import datetime
+import os
+import random
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)),
+        os.pardir, "test"))
+import TestEnv
+
+# seed used for generating data so that every run uses identical data
+DATA_SEED = 20200801
+
+# size of each batch of rows inserted when populating the tables
+POPULATE_BATCH_SIZE = 5000
+
+# definition of the tables used by the benchmarks; columns are given as
+# (name, definition) pairs and the first column is always the primary key
+TABLES = {
+    "narrow" : ("BenchNarrow", [
+        ("Id", "number(9) not null"),
+        ("IntCol", "number(9)"),
+        ("NumberCol", "number(15, 4)"),
+        ("BigIntCol", "number(18)"),
+        ("DoubleCol", "binary_double")
+    ]),
+    "wide" : ("BenchWide", [
+        ("Id", "number(9) not null"),
+        ("IntCol", "number(9)"),
+        ("NumberCol", "number(15, 4)"),
+        ("StringCol", "varchar2(40)"),
+        ("FixedCharCol", "char(10)"),
+        ("DateCol", "date"),
+        ("TimestampCol", "timestamp"),
+        ("RawCol", "raw(16)"),
+        ("NullableNumberCol", "number(9)"),
+        ("NullableStringCol", "varchar2(40)")
+    ] + [("ExtraNumberCol%d" % i, "number(9)") for i in range(1, 6)] + \
+        [("ExtraStringCol%d" % i, "varchar2(20)") for i in range(1, 6)]),
+    "strings" : ("BenchStrings", [("Id", "number(9) not null")] + \
+        [("StringCol%d" % i, "varchar2(100)") for i in range(1, 11)]),
+    "lobs" : ("BenchLobs", [
+        ("Id", "number(9) not null"),
+        ("ClobCol", "clob"),
+        ("BlobCol", "blob")
+    ]),
+    "objects" : ("BenchObjects", [
+        ("Id", "number(9) not null"),
+        ("PointCol", "udt_BenchPoint"),
+        ("PointsCol", "udt_BenchPoints")
+    ])
+}
+
+# definition of the types used by the "objects" table
+TYPES = [
+    ("udt_BenchPoint", "create type udt_BenchPoint as object " \
+            "(X number, Y number, Z number, Label varchar2(20))"),
+    ("udt_BenchPoints", "create type udt_BenchPoints as " \
+            "table of udt_BenchPoint")
+]
+
+# number of elements in each collection and size of each LOB
+NUM_POINTS_PER_ROW = 20
+LOB_SIZE = 32768
+
+def GetConnection(**kwargs):
+    return TestEnv.GetConnection(**kwargs)
+
+def GetPool(**kwargs):
+    return TestEnv.GetPool(**kwargs)
+
+def GetTableName(schemaName):
+    tableName, columns = TABLES[schemaName]
+    return tableName
+
+def GetColumnNames(schemaName):
+    tableName, columns = TABLES[schemaName]
+    return [n for n, d in columns]
+
+def _GetRowCount(cursor, tableName):
+    cursor.execute("""
+            select count(*)
+            from user_tables
+            where table_name = upper(:name)""", name=tableName)
+    exists, = cursor.fetchone()
+    if not exists:
+        return None
+    cursor.execute("select count(*) from " + tableName)
+    count, = cursor.fetchone()
+    return count
+
+def _DropTable(cursor, tableName):
+    try:
+        cursor.execute("drop table %s purge" % tableName)
+    except cx_Oracle.DatabaseError:
+        pass
+
+def _CreateTypes(cursor):
+    cursor.execute("""
+            select type_name
+            from user_types
+            where type_name like 'UDT_BENCH%'""")
+    existingTypes = set(n for n, in cursor)
+    for typeName, sql in TYPES:
+        if typeName.upper() not in existingTypes:
+            cursor.execute(sql)
+
+def _GenerateRow(schemaName, connection, rowNum, rand):
+    if schemaName == "narrow":
+        return (rowNum, rand.randint(-999999999, 999999999),
+                round(rand.uniform(-1e9, 1e9), 4),
+                rand.randint(-10 ** 17, 10 ** 17), rand.random())
+    elif schemaName == "wide":
+        baseDate = datetime.datetime(2000, 1, 1)
+        return (rowNum, rand.randint(0, 10 ** 8),
+                round(rand.uniform(0, 1e6), 4),
+                "String %d %s" % (rowNum, "X" * rand.randint(0, 20)),
+                "F%d" % (rowNum % 1000),
+                baseDate + datetime.timedelta(days=rand.randint(0, 7300)),
+                baseDate + datetime.timedelta(seconds=rand.randint(0, 6e8),
+                        microseconds=rand.randint(0, 999999)),
+                bytes(rand.getrandbits(8) for i in range(16)),
+                rand.randint(0, 1000) if rowNum % 3 else None,
+                "Nullable %d" % rowNum if rowNum % 2 else None) + \
+                tuple(rand.randint(0, 10 ** 6) for i in range(5)) + \
+                tuple("Extra %d" % rand.randint(0, 10 ** 9) for i in range(5))
+    elif schemaName == "strings":
+        return (rowNum,) + tuple("%d-%s" % (rowNum, "S" * rand.randint(10, 90))
+                for i in range(10))
+    elif schemaName == "lobs":
+        text = "".join(chr(rand.randint(65, 90)) for i in range(64))
+        text = text * (LOB_SIZE // len(text))
+        return (rowNum, text, text.encode())
+    pointType = connection.gettype("UDT_BENCHPOINT")
+    pointsType = connection.gettype("UDT_BENCHPOINTS")
+    points = pointsType.newobject()
+    for i in range(NUM_POINTS_PER_ROW):
+        point = pointType.newobject()
+        point.X = rand.randint(-1000, 1000)
+        point.Y = rand.randint(-1000, 1000)
+        point.Z = round(rand.uniform(-1000, 1000), 2)
+        point.LABEL = "Point %d.%d" % (rowNum, i)
+        points.append(point)
+    return (rowNum, points.getelement(points.first()), points)
+
+def EnsureTable(connection, schemaName, numRows):
+    """Create and populate the table for the given schema, if it does not
+       already contain the requested number of rows, and return its name."""
+    tableName, columns = TABLES[schemaName]
+    cursor = connection.cursor()
+    if _GetRowCount(cursor, tableName) == numRows:
+        return tableName
+    _DropTable(cursor, tableName)
+    if schemaName == "objects":
+        _CreateTypes(cursor)
+    columnClauses = ",\n".join("%s %s" % c for c in columns)
+    sql = "create table %s (\n%s,\nconstraint %s_pk primary key (Id))" % \
+            (tableName, columnClauses, tableName)
+    if schemaName == "objects":
+        sql += " nested table PointsCol store as %s_nt" % tableName
+    cursor.execute(sql)
+    insertSql = "insert into %s values (%s)" % \
+            (tableName, ",".join(":%d" % (i + 1) for i in range(len(columns))))
+    if schemaName == "lobs":
+        cursor.setinputsizes(None, cx_Oracle.DB_TYPE_CLOB,
+                cx_Oracle.DB_TYPE_BLOB)
+    rand = random.Random(DATA_SEED)
+    batchSize = POPULATE_BATCH_SIZE
+    if schemaName in ("lobs", "objects"):
+        batchSize = 100
+    rows = []
+    for rowNum in range(1, numRows + 1):
+        rows.append(_GenerateRow(schemaName, connection, rowNum, rand))
+        if len(rows) == batchSize or rowNum == numRows:
+            cursor.executemany(insertSql, rows)
+            rows = []
+    connection.commit()
+    return tableName
+
+def GetDataSize(connection, schemaName):
+    """Return the number of bytes of data stored in the table for the given
+       schema, as determined by the database. This is used for reporting the
+       throughput of the benchmarks in bytes per second."""
+    tableName, columns = TABLES[schemaName]
+    if schemaName == "lobs":
+        expr = "dbms_lob.getlength(ClobCol) + dbms_lob.getlength(BlobCol)"
+    elif schemaName == "objects":
+        return None
+    else:
+        expr = " + ".join("nvl(vsize(%s), 0)" % n for n, d in columns)
+    cursor = connection.cursor()
+    cursor.execute("select sum(%s) from %s" % (expr, tableName))
+    size, = cursor.fetchone()
+    return int(size or 0)
+
+def DropTables(connection):
+    cursor = connection.cursor()
+    for tableName, columns in TABLES.values():
+        _DropTable(cursor, tableName)
+        _DropTable(cursor, tableName + "_Copy")
+    for typeName, sql in reversed(TYPES):
+        try:
+            cursor.execute("drop type %s force" % typeName)
+        except cx_Oracle.DatabaseError:
+            pass
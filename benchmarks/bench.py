@@ -0,0 +1,333 @@
+#------------------------------------------------------------------------------
+# Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+#------------------------------------------------------------------------------
+
+#------------------------------------------------------------------------------
+# bench.py
+#   Runs the cx_Oracle benchmark suite, which measures the throughput of the
+# fetch, bind, LOB and session pool code paths against tables with a number
+# of standard shapes (narrow numeric, wide mixed, string heavy, LOB and object
+# types). For each benchmark the best of a number of iterations is reported as
+# rows per second, bytes per second (where the size of the data is known),
+# Python memory blocks retained per row fetched and the time spent in each
+# phase of statement execution as gathered by Cursor.stats().
+#
+# Results can be saved to a file in JSON format with --output and compared
+# with the results of a previous run with --compare. Run with --help for the
+# complete list of options.
+#
+# This script requires cx_Oracle 8.1 and higher.
+#------------------------------------------------------------------------------
+
+import argparse
+import cx_Oracle
+import json
+import sys
+import time
+
+import BenchEnv
+
+# registry of benchmarks, in the order in which they are run
+BENCHMARKS = []
+
+def Benchmark(name, schemaName=None, description=None):
+    def Register(func):
+        BENCHMARKS.append((name, schemaName, description, func))
+        return func
+    return Register
+
+class Result(object):
+
+    def __init__(self, name, numRows, elapsed, dataSize=None,
+            blocksPerRow=None, stats=None):
+        self.name = name
+        self.numRows = numRows
+        self.elapsed = elapsed
+        self.dataSize = dataSize
+        self.blocksPerRow = blocksPerRow
+        self.stats = stats
+
+    @property
+    def rowsPerSecond(self):
+        return self.numRows / self.elapsed
+
+    @property
+    def bytesPerSecond(self):
+        if self.dataSize is not None:
+            return self.dataSize / self.elapsed
+
+    def asDict(self):
+        result = dict(name=self.name, rows=self.numRows,
+                elapsed=self.elapsed, rows_per_second=self.rowsPerSecond,
+                bytes_per_second=self.bytesPerSecond,
+                blocks_per_row=self.blocksPerRow)
+        if self.stats is not None:
+            result["stats"] = self.stats._asdict()
+        return result
+
+class Context(object):
+
+    def __init__(self, args):
+        self.args = args
+        self.connection = BenchEnv.GetConnection()
+        self.numRows = {}
+        self.dataSizes = {}
+
+    def getRows(self, schemaName):
+        if schemaName in ("lobs", "objects"):
+            return max(self.args.rows // 50, 100)
+        return self.args.rows
+
+    def prepareSchema(self, schemaName):
+        if schemaName not in self.numRows:
+            numRows = self.getRows(schemaName)
+            print("Preparing schema %s (%d rows)..." % (schemaName, numRows))
+            sys.stdout.flush()
+            BenchEnv.EnsureTable(self.connection, schemaName, numRows)
+            self.numRows[schemaName] = numRows
+            self.dataSizes[schemaName] = \
+                    BenchEnv.GetDataSize(self.connection, schemaName)
+
+    def cursor(self):
+        cursor = self.connection.cursor()
+        cursor.arraysize = self.args.arraysize
+        cursor.prefetchrows = self.args.arraysize + 1
+        cursor.collectstats = True
+        return cursor
+
+def _Fetch(context, schemaName, measureBlocks):
+    tableName = BenchEnv.GetTableName(schemaName)
+    cursor = context.cursor()
+    startBlocks = sys.getallocatedblocks()
+    startTime = time.perf_counter()
+    cursor.execute("select * from %s" % tableName)
+    if measureBlocks:
+        rows = cursor.fetchall()
+        numRows = len(rows)
+    else:
+        numRows = 0
+        for row in cursor:
+            numRows += 1
+    elapsed = time.perf_counter() - startTime
+    blocksPerRow = None
+    if measureBlocks:
+        blocksPerRow = (sys.getallocatedblocks() - startBlocks) / numRows
+        del rows
+    return numRows, elapsed, blocksPerRow, cursor.stats()
+
+def _FetchBenchmark(schemaName):
+    def Run(context):
+        numRows, elapsed, blocksPerRow, stats = \
+                _Fetch(context, schemaName, True)
+        return Result(None, numRows, elapsed, context.dataSizes[schemaName],
+                blocksPerRow, stats)
+    return Run
+
+def _IterateBenchmark(schemaName):
+    def Run(context):
+        numRows, elapsed, blocksPerRow, stats = \
+                _Fetch(context, schemaName, False)
+        return Result(None, numRows, elapsed, context.dataSizes[schemaName],
+                stats=stats)
+    return Run
+
+def _ExecuteManyBenchmark(schemaName):
+    def Run(context):
+        tableName = BenchEnv.GetTableName(schemaName)
+        copyTableName = tableName + "_Copy"
+        columnNames = BenchEnv.GetColumnNames(schemaName)
+        cursor = context.cursor()
+        cursor.execute("select * from %s order by Id" % tableName)
+        rows = cursor.fetchall()
+        try:
+            cursor.execute("truncate table %s" % copyTableName)
+        except cx_Oracle.DatabaseError:
+            cursor.execute("create table %s as select * from %s where 1 = 0" \
+                    % (copyTableName, tableName))
+        sql = "insert into %s (%s) values (%s)" % (copyTableName,
+                ",".join(columnNames),
+                ",".join(":%d" % (i + 1) for i in range(len(columnNames))))
+        cursor = context.cursor()
+        batchSize = context.args.arraysize
+        startTime = time.perf_counter()
+        for i in range(0, len(rows), batchSize):
+            cursor.executemany(sql, rows[i:i + batchSize])
+        context.connection.commit()
+        elapsed = time.perf_counter() - startTime
+        return Result(None, len(rows), elapsed, context.dataSizes[schemaName],
+                stats=cursor.stats())
+    return Run
+
+for _schemaName in ("narrow", "wide", "strings"):
+    Benchmark("fetch.%s" % _schemaName, _schemaName,
+            "fetchall() of every row")(_FetchBenchmark(_schemaName))
+    Benchmark("iterate.%s" % _schemaName, _schemaName,
+            "iteration over every row")(_IterateBenchmark(_schemaName))
+    Benchmark("executemany.%s" % _schemaName, _schemaName,
+            "executemany() of every row")(_ExecuteManyBenchmark(_schemaName))
+
+@Benchmark("fetch.objects", "objects",
+        "fetchall() of object and collection columns")
+def FetchObjects(context):
+    numRows, elapsed, blocksPerRow, stats = _Fetch(context, "objects", True)
+    return Result(None, numRows, elapsed, None, blocksPerRow, stats)
+
+@Benchmark("convert.objects", "objects",
+        "fetch and convert objects with asdict(deep=True)")
+def ConvertObjects(context):
+    cursor = context.cursor()
+    startTime = time.perf_counter()
+    cursor.execute("select PointCol, PointsCol from BenchObjects")
+    numRows = 0
+    for point, points in cursor:
+        point.asdict(deep=True)
+        points.aslist(deep=True)
+        numRows += 1
+    elapsed = time.perf_counter() - startTime
+    return Result(None, numRows, elapsed, stats=cursor.stats())
+
+@Benchmark("lob.read", "lobs", "fetch LOB locators and read() each LOB")
+def ReadLobs(context):
+    cursor = context.cursor()
+    startTime = time.perf_counter()
+    cursor.execute("select ClobCol, BlobCol from BenchLobs")
+    numRows = 0
+    for clob, blob in cursor:
+        clob.read()
+        blob.read()
+        numRows += 1
+    elapsed = time.perf_counter() - startTime
+    return Result(None, numRows, elapsed, context.dataSizes["lobs"],
+            stats=cursor.stats())
+
+@Benchmark("lob.stream", "lobs", "read each BLOB with openstream()")
+def StreamLobs(context):
+    cursor = context.cursor()
+    startTime = time.perf_counter()
+    cursor.execute("select BlobCol from BenchLobs")
+    numRows = dataSize = 0
+    for blob, in cursor:
+        with blob.openstream() as stream:
+            for chunk in stream:
+                dataSize += len(chunk)
+        numRows += 1
+    elapsed = time.perf_counter() - startTime
+    return Result(None, numRows, elapsed, dataSize, stats=cursor.stats())
+
+@Benchmark("pool.acquire", None, "SessionPool acquire() and release()")
+def AcquireFromPool(context):
+    numIters = context.args.rows // 10
+    pool = BenchEnv.GetPool(min=1, max=1, increment=0)
+    pool.release(pool.acquire())
+    startTime = time.perf_counter()
+    for i in range(numIters):
+        pool.release(pool.acquire())
+    elapsed = time.perf_counter() - startTime
+    pool.close()
+    return Result(None, numIters, elapsed)
+
+def RunBenchmarks(context):
+    results = []
+    for name, schemaName, description, func in BENCHMARKS:
+        if context.args.benchmarks and not any(name.startswith(p) \
+                for p in context.args.benchmarks):
+            continue
+        if schemaName is not None:
+            context.prepareSchema(schemaName)
+        best = None
+        for i in range(context.args.iterations):
+            result = func(context)
+            if best is None or result.elapsed < best.elapsed:
+                best = result
+        best.name = name
+        results.append(best)
+        ReportResult(best)
+    return results
+
+def FormatNumber(value):
+    if value is None:
+        return "-"
+    for limit, suffix in ((1e9, "G"), (1e6, "M"), (1e3, "K")):
+        if value >= limit:
+            return "%.2f%s" % (value / limit, suffix)
+    return "%.2f" % value
+
+def ReportResult(result):
+    blocks = "-" if result.blocksPerRow is None \
+            else "%.1f" % result.blocksPerRow
+    print("%-22s %10s %10s/s %10s B/s %8s blk/row" % (result.name,
+            FormatNumber(result.numRows),
+            FormatNumber(result.rowsPerSecond),
+            FormatNumber(result.bytesPerSecond), blocks))
+    if result.stats is not None:
+        stats = result.stats
+        print("%22s prepare %.3fs bind %.3fs execute %.3fs fetch %.3fs " \
+                "(%d round trips) rows %.3fs" % ("", stats.prepare_time,
+                stats.bind_time, stats.execute_time, stats.fetch_time,
+                stats.round_trips, stats.row_time))
+    sys.stdout.flush()
+
+def CompareResults(results, fileName):
+    with open(fileName) as f:
+        previous = dict((r["name"], r) for r in json.load(f)["results"])
+    print()
+    print("Comparison with", fileName)
+    for result in results:
+        prev = previous.get(result.name)
+        if prev is None:
+            continue
+        change = (result.rowsPerSecond / prev["rows_per_second"] - 1) * 100
+        print("%-22s %10s/s -> %10s/s (%+.1f%%)" % (result.name,
+                FormatNumber(prev["rows_per_second"]),
+                FormatNumber(result.rowsPerSecond), change))
+
+def SaveResults(results, context, fileName):
+    data = dict(cx_Oracle_version=cx_Oracle.version,
+            client_version=".".join(str(i) for i in cx_Oracle.clientversion()),
+            server_version=context.connection.version,
+            python_version=sys.version.split()[0],
+            rows=context.args.rows, arraysize=context.args.arraysize,
+            iterations=context.args.iterations,
+            results=[r.asDict() for r in results])
+    with open(fileName, "w") as f:
+        json.dump(data, f, indent=4)
+
+parser = argparse.ArgumentParser(description="Run the cx_Oracle benchmarks.")
+parser.add_argument("benchmarks", nargs="*",
+        help="names (or prefixes of names) of the benchmarks to run")
+parser.add_argument("--rows", type=int, default=50000,
+        help="number of rows in the narrow, wide and strings tables; the LOB "
+             "and object tables contain 1/50th of this number")
+parser.add_argument("--iterations", type=int, default=3,
+        help="number of times each benchmark is run; the best is reported")
+parser.add_argument("--arraysize", type=int, default=1000,
+        help="array size used for fetching and for batches of executemany()")
+parser.add_argument("--output", help="file to write the results to as JSON")
+parser.add_argument("--compare",
+        help="file containing the results of a previous run to compare with")
+parser.add_argument("--list", action="store_true",
+        help="list the available benchmarks and exit")
+parser.add_argument("--drop", action="store_true",
+        help="drop the tables and types created by the benchmarks and exit")
+args = parser.parse_args()
+
+if args.list:
+    for name, schemaName, description, func in BENCHMARKS:
+        print("%-22s %s" % (name, description))
+    sys.exit(0)
+
+context = Context(args)
+if args.drop:
+    BenchEnv.DropTables(context.connection)
+    sys.exit(0)
+
+print("Running benchmarks for cx_Oracle version", cx_Oracle.version,
+        "built at", cx_Oracle.buildtime)
+print("Client Version:", ".".join(str(i) for i in cx_Oracle.clientversion()))
+print("Server Version:", context.connection.version)
+sys.stdout.flush()
+results = RunBenchmarks(context)
+if args.output:
+    SaveResults(results, context, args.output)
+if args.compare:
+    CompareResults(results, args.compare)
@@ -0,0 +1,41 @@
+#------------------------------------------------------------------------------
+# Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+#------------------------------------------------------------------------------
+
+#------------------------------------------------------------------------------
+# ConnectionPoolAcquire.py
+#   This script measures the time taken to acquire connections from a session
+# pool and release them again. SessionPool.acquire() acquires connections
+# directly when no user name, password or sharding keys are specified; this is
+# compared with creating the connection by calling Connection() with the pool,
+# which processes all of the parameters supported by Connection().
+#
+# This script requires cx_Oracle 8.1 and higher.
+#------------------------------------------------------------------------------
+
+import cx_Oracle
+import SampleEnv
+import time
+
+NUM_ITERS = 10000
+
+def AcquireWithPool(pool):
+    return pool.acquire()
+
+def AcquireWithConnection(pool):
+    return cx_Oracle.Connection(pool=pool)
+
+pool = cx_Oracle.SessionPool(SampleEnv.GetMainUser(),
+        SampleEnv.GetMainPassword(), SampleEnv.GetConnectString(), min=1,
+        max=1, increment=0)
+
+for name, func in (("SessionPool.acquire()", AcquireWithPool),
+                   ("Connection(pool=pool)", AcquireWithConnection)):
+    func(pool).close()
+    startTime = time.perf_counter()
+    for i in range(NUM_ITERS):
+        connection = func(pool)
+        pool.release(connection)
+    elapsed = time.perf_counter() - startTime
+    print("%s: %d acquire/release cycles in %.3f seconds (%.1f us each)" % \
+            (name, NUM_ITERS, elapsed, elapsed * 1e6 / NUM_ITERS))
@@ -57,6 +57,38 @@ class test(distutils.core.Command):
         fileName = os.path.join("test", "test.py")
         exec(open(fileName).read())
 
+class bench(distutils.core.Command):
+    description = "run the benchmark suite for the extension"
+    user_options = [
+        ("rows=", None, "number of rows in the tables used by the benchmarks"),
+        ("iterations=", None, "number of times each benchmark is run"),
+        ("output=", None, "file to write the results to as JSON"),
+        ("compare=", None, "file containing results to compare with"),
+        ("only=", None, "comma separated names of the benchmarks to run")
+    ]
+
+    def finalize_options(self):
+        pass
+
+    def initialize_options(self):
+        self.rows = self.iterations = self.output = self.compare = None
+        self.only = None
+
+    def run(self):
+        self.run_command("build")
+        buildCommand = self.distribution.get_command_obj("build")
+        sys.path.insert(0, os.path.abspath("benchmarks"))
+        sys.path.insert(0, os.path.abspath(buildCommand.build_lib))
+        fileName = os.path.join("benchmarks", "bench.py")
+        sys.argv = [fileName]
+        for name in ("rows", "iterations", "output", "compare"):
+            value = getattr(self, name)
+            if value is not None:
+                sys.argv.extend(["--" + name, value])
+        if self.only is not None:
+            sys.argv.extend(self.only.split(","))
+        exec(open(fileName).read(), dict(__name__="__main__"))
+
 # define classifiers for the package index
 classifiers = [
         "Development Status :: 6 - Mature",
@@ -114,7 +146,7 @@ setup(
         name = "cx_Oracle",
         version = BUILD_VERSION,
         description = "Python interface to Oracle",
-        cmdclass = dict(test = test),
+        cmdclass = dict(test = test, bench = bench),
         data_files = [ ("cx_Oracle-doc", ["LICENSE.txt", "README.txt"]) ],
         long_description = \
             "Python interface to Oracle Database conforming to the Python DB "
@@ -0,0 +1,259 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoAsyncCall.c
+//   Defines the routines used for performing database operations on behalf of
+// asyncio. The portion of the operation that makes use of Python objects
+// (such as binding) is performed by the calling thread and the round trip to
+// the database is queued to the pool of worker threads, which avoids the cost
+// of starting a thread for each round trip. Once the round trip is
+// complete, the worker thread schedules the call object with the event loop;
+// when the event loop calls it, the operation is completed and the result (or
+// exception) is set on the asyncio future returned to the caller.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+// the asyncio module, imported the first time it is needed
+static PyObject *cxoAsyncioModule = NULL;
+
+
+//-----------------------------------------------------------------------------
+// cxoAsyncCall_notify()
+//   Called by the worker thread once the round trip is complete in order to
+// schedule the call object with the event loop. The reference held on behalf
+// of the worker thread is released. This is called without the GIL held.
+//-----------------------------------------------------------------------------
+static void cxoAsyncCall_notify(void *arg)
+{
+    cxoAsyncCall *call = (cxoAsyncCall*) arg;
+    PyGILState_STATE gstate;
+    PyObject *result;
+
+    gstate = PyGILState_Ensure();
+    result = PyObject_CallMethod(call->loop, "call_soon_threadsafe", "(O)",
+            call);
+    if (result) {
+        Py_DECREF(result);
+    } else {
+        PyErr_WriteUnraisable((PyObject*) call);
+        if (call->connection)
+            call->connection->asyncInProgress = 0;
+    }
+    Py_DECREF(call);
+    PyGILState_Release(gstate);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoAsyncCall_new()
+//   Create a new call object along with the future that is returned to the
+// caller. The connection (if one is specified) is marked as busy while a
+// round trip is in progress, which prevents the connection and its cursors
+// from being used until the operation has completed. Since a native thread is
+// used to perform the round trip, this is only permitted in threaded mode.
+//-----------------------------------------------------------------------------
+cxoAsyncCall *cxoAsyncCall_new(PyObject *owner, cxoConnection *connection,
+        int threaded, cxoAsyncCompleteFunc completeFunc)
+{
+    cxoAsyncCall *call;
+
+    // asynchronous operations require threaded mode
+    if (!threaded) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "asynchronous operations require threaded mode");
+        return NULL;
+    }
+
+    // import the asyncio module, if needed
+    if (!cxoAsyncioModule) {
+        cxoAsyncioModule = PyImport_ImportModule("asyncio");
+        if (!cxoAsyncioModule)
+            return NULL;
+    }
+
+    // create the call object and its worker
+    call = (cxoAsyncCall*)
+            cxoPyTypeAsyncCall.tp_alloc(&cxoPyTypeAsyncCall, 0);
+    if (!call)
+        return NULL;
+    call->worker = PyMem_Malloc(sizeof(cxoWorker));
+    if (!call->worker) {
+        Py_DECREF(call);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    cxoWorker_init(call->worker);
+    call->worker->notifyFunc = cxoAsyncCall_notify;
+    Py_INCREF(owner);
+    call->owner = owner;
+    Py_XINCREF(connection);
+    call->connection = connection;
+    call->completeFunc = completeFunc;
+
+    // create the future using the running event loop; an exception is raised
+    // if no event loop is running
+#if PY_VERSION_HEX < 0x03070000
+    call->loop = PyObject_CallMethod(cxoAsyncioModule, "_get_running_loop",
+            NULL);
+    if (call->loop == Py_None) {
+        Py_CLEAR(call->loop);
+        PyErr_SetString(PyExc_RuntimeError, "no running event loop");
+    }
+#else
+    call->loop = PyObject_CallMethod(cxoAsyncioModule, "get_running_loop",
+            NULL);
+#endif
+    if (!call->loop) {
+        Py_DECREF(call);
+        return NULL;
+    }
+    call->future = PyObject_CallMethod(call->loop, "create_future", NULL);
+    if (!call->future) {
+        Py_DECREF(call);
+        return NULL;
+    }
+
+    return call;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoAsyncCall_free()
+//   Free the memory associated with the call object.
+//-----------------------------------------------------------------------------
+static void cxoAsyncCall_free(cxoAsyncCall *call)
+{
+    if (call->worker) {
+        cxoWorker_free(call->worker);
+        PyMem_Free(call->worker);
+        call->worker = NULL;
+    }
+    if (call->data && call->freeDataFunc) {
+        (*call->freeDataFunc)(call->data);
+        call->data = NULL;
+    }
+    Py_CLEAR(call->owner);
+    Py_CLEAR(call->connection);
+    Py_CLEAR(call->loop);
+    Py_CLEAR(call->future);
+    Py_CLEAR(call->result);
+    Py_TYPE(call)->tp_free((PyObject*) call);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoAsyncCall_setResult()
+//   Set the result of the future. If the result is NULL, the exception that
+// is currently set is used instead. If the future has been cancelled, the
+// result is simply discarded.
+//-----------------------------------------------------------------------------
+int cxoAsyncCall_setResult(cxoAsyncCall *call, PyObject *result)
+{
+    PyObject *type, *value, *traceback, *temp = NULL;
+    int isError, cancelled;
+
+    // acquire the exception, if applicable
+    isError = (result == NULL);
+    if (isError) {
+        PyErr_Fetch(&type, &value, &traceback);
+        PyErr_NormalizeException(&type, &value, &traceback);
+        if (!value)
+            return -1;
+        if (traceback) {
+            PyException_SetTraceback(value, traceback);
+            Py_DECREF(traceback);
+        }
+        Py_XDECREF(type);
+        result = value;
+    } else {
+        Py_INCREF(result);
+    }
+
+    // set the result if the future has not been cancelled
+    temp = PyObject_CallMethod(call->future, "cancelled", NULL);
+    if (!temp) {
+        Py_DECREF(result);
+        return -1;
+    }
+    cancelled = PyObject_IsTrue(temp);
+    Py_DECREF(temp);
+    if (cancelled == 0) {
+        temp = PyObject_CallMethod(call->future,
+                (isError) ? "set_exception" : "set_result", "(O)", result);
+        Py_XDECREF(temp);
+    }
+    Py_DECREF(result);
+    if (cancelled < 0 || (cancelled == 0 && !temp))
+        return -1;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoAsyncCall_start()
+//   Queue the round trip to be performed by the pool of worker threads. A
+// reference to the call object is held on behalf of the worker thread until
+// the call object has been scheduled with the event loop. Round trips that may
+// block while waiting for another operation to complete are flagged so that
+// they are given a thread of their own.
+//-----------------------------------------------------------------------------
+int cxoAsyncCall_start(cxoAsyncCall *call, cxoWorkerFunc func, int mayBlock)
+{
+    if (call->connection)
+        call->connection->asyncInProgress = 1;
+    Py_INCREF(call);
+    if (cxoWorker_queue(call->worker, func, call, mayBlock) < 0) {
+        if (call->connection)
+            call->connection->asyncInProgress = 0;
+        Py_DECREF(call);
+        return -1;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoAsyncCall_call()
+//   Called by the event loop once the round trip is complete. The completion
+// function is called to complete the operation; if it starts another round
+// trip, nothing further is done; otherwise, the result of the operation (or
+// the exception that was raised) is set on the future.
+//-----------------------------------------------------------------------------
+static PyObject *cxoAsyncCall_call(cxoAsyncCall *call, PyObject *args,
+        PyObject *keywordArgs)
+{
+    PyObject *result = NULL;
+    int status;
+
+    if (call->connection)
+        call->connection->asyncInProgress = 0;
+    status = cxoWorker_wait(call->worker);
+    status = (*call->completeFunc)(call, status, &result);
+    if (status == 0 && !result)
+        Py_RETURN_NONE;
+    status = cxoAsyncCall_setResult(call, (status < 0) ? NULL : result);
+    Py_XDECREF(result);
+    if (status < 0)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// Python type declaration
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypeAsyncCall = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.AsyncCall",
+    .tp_basicsize = sizeof(cxoAsyncCall),
+    .tp_dealloc = (destructor) cxoAsyncCall_free,
+    .tp_call = (ternaryfunc) cxoAsyncCall_call,
+    .tp_flags = Py_TPFLAGS_DEFAULT
+};
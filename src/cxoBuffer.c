@@ -16,21 +16,65 @@
 
 #include "cxoModule.h"
 
+//-----------------------------------------------------------------------------
+// cxoBuffer_fromBinaryObject()
+//   Populate the string buffer from a bytes object or any other object that
+// supports the buffer protocol. The contents of objects supporting the buffer
+// protocol are referenced directly (using a memoryview in order to prevent the
+// object from being resized) instead of being copied. This is only used when
+// binding binary values; all other callers use cxoBuffer_fromObject().
+//-----------------------------------------------------------------------------
+int cxoBuffer_fromBinaryObject(cxoBuffer *buf, PyObject *obj)
+{
+    Py_buffer *view;
+
+    if (!obj || obj == Py_None || !PyObject_CheckBuffer(obj) ||
+            PyBytes_Check(obj))
+        return cxoBuffer_fromObject(buf, obj, NULL);
+    cxoBuffer_init(buf);
+    buf->obj = PyMemoryView_FromObject(obj);
+    if (!buf->obj)
+        return -1;
+    view = PyMemoryView_GET_BUFFER(buf->obj);
+    if (!PyBuffer_IsContiguous(view, 'C')) {
+        Py_CLEAR(buf->obj);
+        PyErr_SetString(PyExc_TypeError, "expecting contiguous buffer object");
+        return -1;
+    }
+    buf->ptr = (const char*) view->buf;
+    buf->size = buf->numCharacters = (uint32_t) view->len;
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoBuffer_fromObject()
-//   Populate the string buffer from a unicode object.
+//   Populate the string buffer from a unicode object or a bytes object. When
+// the encoding is UTF-8, the UTF-8 representation cached by the unicode object
+// is used directly instead of creating a new bytes object.
 //-----------------------------------------------------------------------------
 int cxoBuffer_fromObject(cxoBuffer *buf, PyObject *obj, const char *encoding)
 {
+    Py_ssize_t size;
+
     cxoBuffer_init(buf);
     if (!obj || obj == Py_None)
         return 0;
     if (PyUnicode_Check(obj)) {
-        buf->obj = PyUnicode_AsEncodedString(obj, encoding, NULL);
-        if (!buf->obj)
-            return -1;
-        buf->ptr = PyBytes_AS_STRING(buf->obj);
-        buf->size = (uint32_t) PyBytes_GET_SIZE(buf->obj);
+        if (!encoding || strcmp(encoding, "UTF-8") == 0) {
+            buf->ptr = PyUnicode_AsUTF8AndSize(obj, &size);
+            if (!buf->ptr)
+                return -1;
+            Py_INCREF(obj);
+            buf->obj = obj;
+            buf->size = (uint32_t) size;
+        } else {
+            buf->obj = PyUnicode_AsEncodedString(obj, encoding, NULL);
+            if (!buf->obj)
+                return -1;
+            buf->ptr = PyBytes_AS_STRING(buf->obj);
+            buf->size = (uint32_t) PyBytes_GET_SIZE(buf->obj);
+        }
         buf->numCharacters = (uint32_t) PyUnicode_GET_LENGTH(obj);
     } else if (PyBytes_Check(obj)) {
         Py_INCREF(obj);
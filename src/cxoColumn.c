@@ -0,0 +1,632 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoColumn.c
+//   Defines the objects used for returning the values of a query column in
+// contiguous buffers instead of as Python objects (see Cursor.fetchcolumns).
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+// number of microseconds in one day
+#define CXO_COLUMN_MICROSECONDS_PER_DAY INT64_C(86400000000)
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_free()
+//   Free the column object.
+//-----------------------------------------------------------------------------
+static void cxoColumn_free(cxoColumn *column)
+{
+    Py_CLEAR(column->name);
+    Py_CLEAR(column->dbType);
+    Py_CLEAR(column->data);
+    Py_CLEAR(column->offsets);
+    Py_CLEAR(column->validity);
+    Py_TYPE(column)->tp_free((PyObject*) column);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_repr()
+//   Return a string representation of the column.
+//-----------------------------------------------------------------------------
+static PyObject *cxoColumn_repr(cxoColumn *column)
+{
+    PyObject *module, *name, *result, *numRows;
+
+    numRows = PyLong_FromUnsignedLongLong(column->numRows);
+    if (!numRows)
+        return NULL;
+    if (cxoUtils_getModuleAndName(Py_TYPE(column), &module, &name) < 0) {
+        Py_DECREF(numRows);
+        return NULL;
+    }
+    result = cxoUtils_formatString("<%s.%s %r with %d rows>",
+            PyTuple_Pack(4, module, name, column->name, numRows));
+    Py_DECREF(module);
+    Py_DECREF(name);
+    Py_DECREF(numRows);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_reserve()
+//   Ensure that the buffer (a bytearray) has space for the requested number of
+// additional bytes beyond those already in use. The capacity is doubled as
+// needed in order to minimize the number of reallocations; the buffer is
+// trimmed to its final size when the column is finalized.
+//-----------------------------------------------------------------------------
+static char *cxoColumn_reserve(PyObject *buffer, Py_ssize_t used,
+        Py_ssize_t extra)
+{
+    Py_ssize_t capacity, required;
+
+    capacity = PyByteArray_GET_SIZE(buffer);
+    required = used + extra;
+    if (required > capacity) {
+        if (capacity < 64)
+            capacity = 64;
+        while (capacity < required)
+            capacity *= 2;
+        if (PyByteArray_Resize(buffer, capacity) < 0)
+            return NULL;
+    }
+    return PyByteArray_AS_STRING(buffer) + used;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_epochMicroseconds()
+//   Return the number of microseconds since the Unix epoch for the timestamp.
+// The algorithm used for determining the number of days is the one described
+// by Howard Hinnant for the proleptic Gregorian calendar.
+//-----------------------------------------------------------------------------
+static int64_t cxoColumn_epochMicroseconds(dpiTimestamp *timestamp)
+{
+    unsigned yearOfEra, dayOfYear, dayOfEra, month;
+    int64_t days, seconds;
+    int year, era;
+
+    year = timestamp->year;
+    month = timestamp->month;
+    if (month <= 2)
+        year--;
+    era = (year >= 0 ? year : year - 399) / 400;
+    yearOfEra = (unsigned) (year - era * 400);
+    dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 +
+            timestamp->day - 1;
+    dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    days = (int64_t) era * 146097 + (int64_t) dayOfEra - 719468;
+    seconds = (int64_t) timestamp->hour * 3600 + timestamp->minute * 60 +
+            timestamp->second;
+    return days * CXO_COLUMN_MICROSECONDS_PER_DAY + seconds * 1000000 +
+            timestamp->fsecond / 1000;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_updateValidity()
+//   Update the validity bitmap for the rows being appended. The bitmap is only
+// created once the first null value is found in the column; set bits indicate
+// values that are not null (the same layout used by Apache Arrow).
+//-----------------------------------------------------------------------------
+static int cxoColumn_updateValidity(cxoColumn *column, dpiData *data,
+        uint32_t numRows)
+{
+    Py_ssize_t usedBytes, newBytes;
+    uint64_t rowNum, numNulls;
+    unsigned char *bits;
+    uint32_t i;
+
+    // determine the number of nulls in the rows being appended; if there
+    // are none and no bitmap has been created yet, nothing needs to be done
+    for (i = 0, numNulls = 0; i < numRows; i++) {
+        if (data[i].isNull)
+            numNulls++;
+    }
+    if (numNulls == 0 && !column->validity)
+        return 0;
+    column->numNulls += numNulls;
+
+    // create the bitmap the first time a null value is found; all of the
+    // rows that have already been appended are not null
+    usedBytes = (Py_ssize_t) ((column->numRows + 7) / 8);
+    if (!column->validity) {
+        column->validity = PyByteArray_FromStringAndSize(NULL, 0);
+        if (!column->validity)
+            return -1;
+        bits = (unsigned char*) cxoColumn_reserve(column->validity, 0,
+                usedBytes);
+        if (!bits)
+            return -1;
+        memset(bits, 0, usedBytes);
+        for (rowNum = 0; rowNum < column->numRows; rowNum++)
+            bits[rowNum / 8] |= (unsigned char) (1 << (rowNum % 8));
+    }
+
+    // make room for the new rows and set the bits for those that are not null
+    newBytes = (Py_ssize_t) ((column->numRows + numRows + 7) / 8) - usedBytes;
+    bits = (unsigned char*) cxoColumn_reserve(column->validity, usedBytes,
+            newBytes);
+    if (!bits)
+        return -1;
+    memset(bits, 0, newBytes);
+    bits = (unsigned char*) PyByteArray_AS_STRING(column->validity);
+    for (i = 0; i < numRows; i++) {
+        if (!data[i].isNull) {
+            rowNum = column->numRows + i;
+            bits[rowNum / 8] |= (unsigned char) (1 << (rowNum % 8));
+        }
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_convertToDouble()
+//   Convert the 64-bit integers already stored in the column to doubles. This
+// is needed when a number without a declared scale has a fractional part or
+// exceeds the range of a 64-bit integer.
+//-----------------------------------------------------------------------------
+static void cxoColumn_convertToDouble(cxoColumn *column, Py_ssize_t numValues)
+{
+    int64_t *intValues;
+    double *doubleValues;
+    Py_ssize_t i;
+
+    intValues = (int64_t*) PyByteArray_AS_STRING(column->data);
+    doubleValues = (double*) intValues;
+    for (i = 0; i < numValues; i++)
+        doubleValues[i] = (double) intValues[i];
+    column->format = "d";
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_appendFixed()
+//   Append the values for the given rows to a column with fixed width values.
+//-----------------------------------------------------------------------------
+static int cxoColumn_appendFixed(cxoColumn *column, cxoVar *var,
+        dpiData *data, uint32_t numRows)
+{
+    dpiIntervalDS *intervalDS;
+    dpiTimestamp *timestamp;
+    Py_ssize_t priorValues;
+    double *doubleValues;
+    int64_t *intValues;
+    dpiBytes *bytes;
+    char *ptr;
+    uint32_t i;
+
+    // make room for the new values; null values are stored as zero
+    priorValues = column->dataSize / column->itemSize;
+    ptr = cxoColumn_reserve(column->data, column->dataSize,
+            numRows * column->itemSize);
+    if (!ptr)
+        return -1;
+    memset(ptr, 0, numRows * column->itemSize);
+    intValues = (int64_t*) ptr;
+    doubleValues = (double*) ptr;
+
+    // copy the values from the variable
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_BOOLEAN:
+            for (i = 0; i < numRows; i++) {
+                if (!data[i].isNull)
+                    ptr[i] = (char) (data[i].value.asBoolean != 0);
+            }
+            break;
+        case CXO_TRANSFORM_NATIVE_INT:
+            for (i = 0; i < numRows; i++) {
+                if (!data[i].isNull)
+                    intValues[i] = data[i].value.asInt64;
+            }
+            break;
+        case CXO_TRANSFORM_NATIVE_DOUBLE:
+            for (i = 0; i < numRows; i++) {
+                if (!data[i].isNull)
+                    doubleValues[i] = data[i].value.asDouble;
+            }
+            break;
+        case CXO_TRANSFORM_NATIVE_FLOAT:
+            for (i = 0; i < numRows; i++) {
+                if (!data[i].isNull)
+                    ((float*) ptr)[i] = data[i].value.asFloat;
+            }
+            break;
+        case CXO_TRANSFORM_INT:
+            for (i = 0; i < numRows && column->format[0] == 'q'; i++) {
+                if (data[i].isNull)
+                    continue;
+                bytes = &data[i].value.asBytes;
+                if (cxoTransform_numberToInt64(bytes->ptr, bytes->length,
+                        &intValues[i]) < 0) {
+                    cxoColumn_convertToDouble(column, priorValues + i);
+                    break;
+                }
+            }
+            for (; i < numRows; i++) {
+                if (data[i].isNull)
+                    continue;
+                bytes = &data[i].value.asBytes;
+                if (cxoTransform_numberToDouble(bytes->ptr, bytes->length,
+                        &doubleValues[i]) < 0)
+                    return -1;
+            }
+            break;
+        case CXO_TRANSFORM_FLOAT:
+            for (i = 0; i < numRows; i++) {
+                if (data[i].isNull)
+                    continue;
+                bytes = &data[i].value.asBytes;
+                if (cxoTransform_numberToDouble(bytes->ptr, bytes->length,
+                        &doubleValues[i]) < 0)
+                    return -1;
+            }
+            break;
+        case CXO_TRANSFORM_DATE:
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ:
+            for (i = 0; i < numRows; i++) {
+                if (!data[i].isNull)
+                    intValues[i] = cxoColumn_epochMicroseconds(
+                            &data[i].value.asTimestamp);
+            }
+
+            // timestamps with time zones are normalized to UTC if the
+            // variable returns aware values
+            if (var->tzAware &&
+                    (var->transformNum == CXO_TRANSFORM_TIMESTAMP_LTZ ||
+                     var->transformNum == CXO_TRANSFORM_TIMESTAMP_TZ)) {
+                for (i = 0; i < numRows; i++) {
+                    if (data[i].isNull)
+                        continue;
+                    timestamp = &data[i].value.asTimestamp;
+                    intValues[i] -= ((int64_t) timestamp->tzHourOffset * 60 +
+                            timestamp->tzMinuteOffset) * 60 * 1000000;
+                }
+            }
+            break;
+        case CXO_TRANSFORM_TIMEDELTA:
+            for (i = 0; i < numRows; i++) {
+                if (data[i].isNull)
+                    continue;
+                intervalDS = &data[i].value.asIntervalDS;
+                intValues[i] = intervalDS->days *
+                        CXO_COLUMN_MICROSECONDS_PER_DAY +
+                        ((int64_t) intervalDS->hours * 3600 +
+                        intervalDS->minutes * 60 + intervalDS->seconds) *
+                        1000000 + intervalDS->fseconds / 1000;
+            }
+            break;
+        default:
+            break;
+    }
+    column->dataSize += numRows * column->itemSize;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_appendBytes()
+//   Append the bytes for a single variable length value to the column.
+//-----------------------------------------------------------------------------
+static int cxoColumn_appendBytes(cxoColumn *column, const char *value,
+        Py_ssize_t length)
+{
+    char *ptr;
+
+    ptr = cxoColumn_reserve(column->data, column->dataSize, length);
+    if (!ptr)
+        return -1;
+    memcpy(ptr, value, length);
+    column->dataSize += length;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_appendVariable()
+//   Append the values for the given rows to a column with variable length
+// values. Strings are always stored encoded in UTF-8; if the database
+// encoding is something else, each value is transcoded.
+//-----------------------------------------------------------------------------
+static int cxoColumn_appendVariable(cxoColumn *column, cxoVar *var,
+        dpiData *data, uint32_t numRows)
+{
+    const char *ptr, *encoding;
+    uint32_t i, rowidLength;
+    int64_t *offsets;
+    PyObject *temp;
+    dpiBytes *bytes;
+    Py_ssize_t size;
+    int status;
+
+    // make room for the new offsets
+    offsets = (int64_t*) cxoColumn_reserve(column->offsets,
+            (Py_ssize_t) ((column->numRows + 1) * sizeof(int64_t)),
+            (Py_ssize_t) (numRows * sizeof(int64_t)));
+    if (!offsets)
+        return -1;
+
+    // copy the values from the variable and calculate the offsets
+    for (i = 0; i < numRows; i++) {
+        if (!data[i].isNull) {
+            if (var->transformNum == CXO_TRANSFORM_ROWID) {
+                if (dpiRowid_getStringValue(data[i].value.asRowid, &ptr,
+                        &rowidLength) < 0)
+                    return cxoError_raiseAndReturnInt();
+                status = cxoColumn_appendBytes(column, ptr, rowidLength);
+            } else {
+                bytes = &data[i].value.asBytes;
+                encoding = bytes->encoding;
+                if (!column->isText || !encoding ||
+                        strcmp(encoding, "UTF-8") == 0) {
+                    status = cxoColumn_appendBytes(column, bytes->ptr,
+                            bytes->length);
+                } else {
+                    temp = PyUnicode_Decode(bytes->ptr, bytes->length,
+                            encoding, var->encodingErrors);
+                    if (!temp)
+                        return -1;
+                    ptr = PyUnicode_AsUTF8AndSize(temp, &size);
+                    status = (ptr) ? cxoColumn_appendBytes(column, ptr, size) :
+                            -1;
+                    Py_DECREF(temp);
+                }
+            }
+            if (status < 0)
+                return -1;
+        }
+        offsets = (int64_t*) PyByteArray_AS_STRING(column->offsets);
+        offsets[column->numRows + i + 1] = (int64_t) column->dataSize;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_new()
+//   Create a new column object for the given fetch variable. An exception is
+// raised if the type of data stored in the variable cannot be stored in a
+// column buffer.
+//-----------------------------------------------------------------------------
+cxoColumn *cxoColumn_new(cxoVar *var, PyObject *name)
+{
+    cxoColumn *column;
+    char message[120];
+    int64_t *offsets;
+
+    // output converters cannot be applied to column buffers
+    if (var->outConverter && var->outConverter != Py_None) {
+        cxoError_raiseFromString(cxoNotSupportedErrorException,
+                "output converters are not supported when fetching columns");
+        return NULL;
+    }
+
+    // create the column and populate it
+    column = (cxoColumn*) cxoPyTypeColumn.tp_alloc(&cxoPyTypeColumn, 0);
+    if (!column)
+        return NULL;
+    Py_INCREF(name);
+    column->name = name;
+    Py_INCREF(var->dbType);
+    column->dbType = var->dbType;
+    column->data = PyByteArray_FromStringAndSize(NULL, 0);
+    if (!column->data) {
+        Py_DECREF(column);
+        return NULL;
+    }
+
+    // determine the layout of the column
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_BOOLEAN:
+            column->format = "?";
+            column->itemSize = 1;
+            break;
+        case CXO_TRANSFORM_INT:
+        case CXO_TRANSFORM_NATIVE_INT:
+            column->format = "q";
+            column->itemSize = sizeof(int64_t);
+            break;
+        case CXO_TRANSFORM_FLOAT:
+        case CXO_TRANSFORM_NATIVE_DOUBLE:
+            column->format = "d";
+            column->itemSize = sizeof(double);
+            break;
+        case CXO_TRANSFORM_NATIVE_FLOAT:
+            column->format = "f";
+            column->itemSize = sizeof(float);
+            break;
+        case CXO_TRANSFORM_DATE:
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ:
+        case CXO_TRANSFORM_TIMEDELTA:
+            column->format = "q";
+            column->itemSize = sizeof(int64_t);
+            column->unit = "us";
+            break;
+        case CXO_TRANSFORM_DECIMAL:
+        case CXO_TRANSFORM_FIXED_CHAR:
+        case CXO_TRANSFORM_FIXED_NCHAR:
+        case CXO_TRANSFORM_LONG_STRING:
+        case CXO_TRANSFORM_NSTRING:
+        case CXO_TRANSFORM_ROWID:
+        case CXO_TRANSFORM_STRING:
+            column->isText = 1;
+            /* fall through */
+        case CXO_TRANSFORM_BINARY:
+        case CXO_TRANSFORM_LONG_BINARY:
+            column->format = "B";
+            column->itemSize = 1;
+            column->offsets = PyByteArray_FromStringAndSize(NULL, 0);
+            if (!column->offsets) {
+                Py_DECREF(column);
+                return NULL;
+            }
+            offsets = (int64_t*) cxoColumn_reserve(column->offsets, 0,
+                    sizeof(int64_t));
+            if (!offsets) {
+                Py_DECREF(column);
+                return NULL;
+            }
+            offsets[0] = 0;
+            break;
+        default:
+            Py_DECREF(column);
+            snprintf(message, sizeof(message),
+                    "values of type %s cannot be fetched as columns",
+                    var->dbType->name);
+            cxoError_raiseFromString(cxoNotSupportedErrorException, message);
+            return NULL;
+    }
+
+    return column;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_appendRows()
+//   Append the values found in the variable for the given rows of the fetch
+// buffer to the column.
+//-----------------------------------------------------------------------------
+int cxoColumn_appendRows(cxoColumn *column, cxoVar *var, uint32_t startPos,
+        uint32_t numRows)
+{
+    dpiData *data = &var->data[startPos];
+    int status;
+
+    if (cxoColumn_updateValidity(column, data, numRows) < 0)
+        return -1;
+    if (column->offsets)
+        status = cxoColumn_appendVariable(column, var, data, numRows);
+    else status = cxoColumn_appendFixed(column, var, data, numRows);
+    if (status < 0)
+        return -1;
+    column->numRows += numRows;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_finalize()
+//   Called once all rows have been appended to the column. The buffers are
+// trimmed to the space actually in use.
+//-----------------------------------------------------------------------------
+int cxoColumn_finalize(cxoColumn *column)
+{
+    if (PyByteArray_Resize(column->data, column->dataSize) < 0)
+        return -1;
+    if (column->offsets && PyByteArray_Resize(column->offsets,
+            (Py_ssize_t) ((column->numRows + 1) * sizeof(int64_t))) < 0)
+        return -1;
+    if (column->validity && PyByteArray_Resize(column->validity,
+            (Py_ssize_t) ((column->numRows + 7) / 8)) < 0)
+        return -1;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_getView()
+//   Return a memory view of the buffer using the specified format.
+//-----------------------------------------------------------------------------
+static PyObject *cxoColumn_getView(PyObject *buffer, const char *format)
+{
+    PyObject *view, *result;
+
+    if (!buffer)
+        Py_RETURN_NONE;
+    view = PyMemoryView_FromObject(buffer);
+    if (!view || format[0] == 'B')
+        return view;
+    result = PyObject_CallMethod(view, "cast", "s", format);
+    Py_DECREF(view);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_getData()
+//   Return a memory view of the values in the column.
+//-----------------------------------------------------------------------------
+static PyObject *cxoColumn_getData(cxoColumn *column, void *unused)
+{
+    return cxoColumn_getView(column->data, column->format);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_getOffsets()
+//   Return a memory view of the offsets of the values in the column or None
+// if the values in the column are of fixed width.
+//-----------------------------------------------------------------------------
+static PyObject *cxoColumn_getOffsets(cxoColumn *column, void *unused)
+{
+    return cxoColumn_getView(column->offsets, "q");
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoColumn_getValidity()
+//   Return a memory view of the validity bitmap of the column or None if the
+// column does not contain any null values.
+//-----------------------------------------------------------------------------
+static PyObject *cxoColumn_getValidity(cxoColumn *column, void *unused)
+{
+    return cxoColumn_getView(column->validity, "B");
+}
+
+
+//-----------------------------------------------------------------------------
+// declaration of members
+//-----------------------------------------------------------------------------
+static PyMemberDef cxoMembers[] = {
+    { "name", T_OBJECT, offsetof(cxoColumn, name), READONLY },
+    { "type", T_OBJECT, offsetof(cxoColumn, dbType), READONLY },
+    { "format", T_STRING, offsetof(cxoColumn, format), READONLY },
+    { "unit", T_STRING, offsetof(cxoColumn, unit), READONLY },
+    { "length", T_ULONGLONG, offsetof(cxoColumn, numRows), READONLY },
+    { "nullcount", T_ULONGLONG, offsetof(cxoColumn, numNulls), READONLY },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of calculated members
+//-----------------------------------------------------------------------------
+static PyGetSetDef cxoCalcMembers[] = {
+    { "data", (getter) cxoColumn_getData, 0, 0, 0 },
+    { "offsets", (getter) cxoColumn_getOffsets, 0, 0, 0 },
+    { "validity", (getter) cxoColumn_getValidity, 0, 0, 0 },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// Python type declaration
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypeColumn = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.Column",
+    .tp_basicsize = sizeof(cxoColumn),
+    .tp_dealloc = (destructor) cxoColumn_free,
+    .tp_repr = (reprfunc) cxoColumn_repr,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_members = cxoMembers,
+    .tp_getset = cxoCalcMembers
+};
@@ -303,8 +303,9 @@ int cxoConnection_getSodaFlags(cxoConnection *conn, uint32_t *flags)
 
 //-----------------------------------------------------------------------------
 // cxoConnection_isConnected()
-//   Determines if the connection object is connected to the database. If not,
-// a Python exception is raised.
+//   Determines if the connection object is connected to the database and is
+// not busy with an asynchronous operation. If not, a Python exception is
+// raised.
 //-----------------------------------------------------------------------------
 int cxoConnection_isConnected(cxoConnection *conn)
 {
@@ -312,6 +313,11 @@ int cxoConnection_isConnected(cxoConnection *conn)
         cxoError_raiseFromString(cxoInterfaceErrorException, "not connected");
         return -1;
     }
+    if (conn->asyncInProgress) {
+        cxoError_raiseFromString(cxoInterfaceErrorException,
+                "connection is busy with an asynchronous operation");
+        return -1;
+    }
     return 0;
 }
 
@@ -417,7 +423,12 @@ static PyObject *cxoConnection_changePassword(cxoConnection *conn,
 static PyObject *cxoConnection_new(PyTypeObject *type, PyObject *args,
         PyObject *keywordArgs)
 {
-    return type->tp_alloc(type, 0);
+    cxoConnection *conn;
+
+    conn = (cxoConnection*) type->tp_alloc(type, 0);
+    if (conn)
+        conn->fetchLobs = 1;
+    return (PyObject*) conn;
 }
 
 
@@ -460,6 +471,64 @@ static int cxoConnection_splitComponent(PyObject *sourceObj,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_isSessionCallbackRequired()
+//   Return whether the session callback should be invoked or not; this takes
+// place if the connection is newly created by the pool or if the requested tag
+// does not match the actual tag.
+//-----------------------------------------------------------------------------
+static int cxoConnection_isSessionCallbackRequired(
+        dpiConnCreateParams *createParams, cxoBuffer *tagBuffer)
+{
+    return (createParams->outNewSession ||
+            createParams->outTagLength != tagBuffer->size ||
+            (createParams->outTagLength > 0 &&
+            strncmp(createParams->outTag, tagBuffer->ptr,
+                    createParams->outTagLength) != 0));
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_completeCreate()
+//   Complete the creation of the connection once it has been established by
+// setting the tag property and invoking the session callback, if applicable.
+//-----------------------------------------------------------------------------
+static int cxoConnection_completeCreate(cxoConnection *conn,
+        cxoSessionPool *pool, dpiConnCreateParams *createParams,
+        int invokeSessionCallback, PyObject *tagObj)
+{
+    PyObject *tempObj;
+
+    // retain a reference to the pool so that statistics can be aggregated
+    if (pool) {
+        Py_INCREF(pool);
+        conn->sessionPool = pool;
+    }
+
+    // set tag property
+    if (createParams->outTagLength > 0) {
+        conn->tag = PyUnicode_Decode(createParams->outTag,
+                createParams->outTagLength, conn->encodingInfo.encoding,
+                NULL);
+        if (!conn->tag)
+            return -1;
+    }
+
+    // invoke the session callback if applicable
+    if (invokeSessionCallback && pool && pool->sessionCallback &&
+            PyCallable_Check(pool->sessionCallback)) {
+        pool->stats.numCallbacks++;
+        tempObj = PyObject_CallFunctionObjArgs(pool->sessionCallback,
+                (PyObject*) conn, tagObj, NULL);
+        if (!tempObj)
+            return -1;
+        Py_DECREF(tempObj);
+    }
+
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_init()
 //   Initialize the connection members.
@@ -469,12 +538,13 @@ static int cxoConnection_init(cxoConnection *conn, PyObject *args,
 {
     PyObject *tagObj, *matchAnyTagObj, *threadedObj, *eventsObj, *contextObj;
     PyObject *usernameObj, *passwordObj, *dsnObj, *cclassObj, *editionObj;
-    PyObject *shardingKeyObj, *superShardingKeyObj, *tempObj;
+    PyObject *shardingKeyObj, *superShardingKeyObj;
     int status, temp, invokeSessionCallback;
     PyObject *beforePartObj, *afterPartObj;
     dpiCommonCreateParams dpiCommonParams;
     dpiConnCreateParams dpiCreateParams;
     unsigned long long externalHandle;
+    double startTime, waitTime;
     cxoConnectionParams params;
     PyObject *newPasswordObj;
     cxoSessionPool *pool;
@@ -508,9 +578,9 @@ static int cxoConnection_init(cxoConnection *conn, PyObject *args,
             &superShardingKeyObj))
         return -1;
     dpiCreateParams.externalHandle = (void*) externalHandle;
-    if (cxoUtils_getBooleanValue(threadedObj, 0, &temp) < 0)
+    if (cxoUtils_getBooleanValue(threadedObj, 0, &conn->threaded) < 0)
         return -1;
-    if (temp)
+    if (conn->threaded)
         dpiCommonParams.createMode |= DPI_MODE_CREATE_THREADED;
     if (cxoUtils_getBooleanValue(eventsObj, 0, &temp) < 0)
         return -1;
@@ -551,6 +621,7 @@ static int cxoConnection_init(cxoConnection *conn, PyObject *args,
     // setup parameters
     cxoConnectionParams_initialize(&params);
     if (pool) {
+        conn->threaded = pool->threaded;
         dpiCreateParams.pool = pool->handle;
         params.encoding = pool->encodingInfo.encoding;
         params.nencoding = pool->encodingInfo.nencoding;
@@ -612,27 +683,25 @@ static int cxoConnection_init(cxoConnection *conn, PyObject *args,
 
     // create connection
     Py_BEGIN_ALLOW_THREADS
+    startTime = cxoUtils_getMonotonicTime();
     status = dpiConn_create(cxoDpiContext, params.userNameBuffer.ptr,
             params.userNameBuffer.size, params.passwordBuffer.ptr,
             params.passwordBuffer.size, params.dsnBuffer.ptr,
             params.dsnBuffer.size, &dpiCommonParams, &dpiCreateParams,
             &conn->handle);
+    waitTime = cxoUtils_getMonotonicTime() - startTime;
     Py_END_ALLOW_THREADS
+    if (pool)
+        cxoSessionPool_recordAcquire(pool, status, NULL, waitTime,
+                dpiCreateParams.outNewSession);
     if (status < 0) {
         cxoConnectionParams_finalize(&params);
         return cxoError_raiseAndReturnInt();
     }
 
-    // determine if session callback should be invoked; this takes place if
-    // the connection is newly created by the pool or if the requested tag
-    // does not match the actal tag
-    invokeSessionCallback = 0;
-    if (dpiCreateParams.outNewSession ||
-            dpiCreateParams.outTagLength != params.tagBuffer.size ||
-            (dpiCreateParams.outTagLength > 0 &&
-            strncmp(dpiCreateParams.outTag, params.tagBuffer.ptr,
-                    dpiCreateParams.outTagLength) != 0))
-        invokeSessionCallback = 1;
+    // determine if session callback should be invoked
+    invokeSessionCallback = cxoConnection_isSessionCallbackRequired(
+            &dpiCreateParams, &params.tagBuffer);
     cxoConnectionParams_finalize(&params);
 
     // determine encodings to use
@@ -647,35 +716,285 @@ static int cxoConnection_init(cxoConnection *conn, PyObject *args,
                 cxoUtils_getAdjustedEncoding(conn->encodingInfo.nencoding);
     }
 
-    // set tag property
-    if (dpiCreateParams.outTagLength > 0) {
-        conn->tag = PyUnicode_Decode(dpiCreateParams.outTag,
-                dpiCreateParams.outTagLength, conn->encodingInfo.encoding,
-                NULL);
-        if (!conn->tag)
+    return cxoConnection_completeCreate(conn, pool, &dpiCreateParams,
+            invokeSessionCallback, tagObj);
+}
+
+
+//-----------------------------------------------------------------------------
+// declaration of arguments used when acquiring a connection from the pool
+//-----------------------------------------------------------------------------
+typedef struct {
+    cxoSessionPool *pool;
+    cxoConnection *conn;
+    dpiCommonCreateParams commonParams;
+    dpiConnCreateParams createParams;
+    cxoBuffer cclassBuffer;
+    cxoBuffer tagBuffer;
+    PyObject *tagObj;
+    double waitTime;
+} cxoConnectionAcquireArgs;
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_clearAcquireArgs()
+//   Clear the arguments used when acquiring a connection from the pool.
+//-----------------------------------------------------------------------------
+static void cxoConnection_clearAcquireArgs(cxoConnectionAcquireArgs *args)
+{
+    cxoBuffer_clear(&args->cclassBuffer);
+    cxoBuffer_clear(&args->tagBuffer);
+    Py_CLEAR(args->tagObj);
+    Py_CLEAR(args->conn);
+    Py_CLEAR(args->pool);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_prepareAcquire()
+//   Prepare the arguments used when acquiring a connection from the pool. The
+// creation parameters are copied from the ones prepared when the pool was
+// created so that only the connection class and tag need to be processed. The
+// connection object is created as well. The arguments must be cleared by the
+// caller, even if an error takes place.
+//-----------------------------------------------------------------------------
+static int cxoConnection_prepareAcquire(cxoConnectionAcquireArgs *args,
+        cxoSessionPool *pool, PyObject *cclassObj, PyObject *purityObj,
+        PyObject *tagObj, PyObject *matchAnyTagObj)
+{
+    long purity;
+
+    // initialize arguments
+    cxoBuffer_init(&args->cclassBuffer);
+    cxoBuffer_init(&args->tagBuffer);
+    Py_INCREF(pool);
+    args->pool = pool;
+    args->conn = NULL;
+    args->waitTime = 0;
+    if (!tagObj)
+        tagObj = Py_None;
+    Py_INCREF(tagObj);
+    args->tagObj = tagObj;
+
+    // populate parameters
+    args->commonParams = pool->acquireCommonParams;
+    args->createParams = pool->acquireCreateParams;
+    if (purityObj) {
+        purity = PyLong_AsLong(purityObj);
+        if (PyErr_Occurred())
             return -1;
+        args->createParams.purity = (dpiPurity) purity;
+    }
+    if (cxoUtils_getBooleanValue(matchAnyTagObj, 0,
+            &args->createParams.matchAnyTag) < 0)
+        return -1;
+    if (cxoBuffer_fromObject(&args->cclassBuffer, cclassObj,
+            pool->encodingInfo.encoding) < 0)
+        return -1;
+    if (cxoBuffer_fromObject(&args->tagBuffer, tagObj,
+            pool->encodingInfo.encoding) < 0)
+        return -1;
+    args->createParams.connectionClass = args->cclassBuffer.ptr;
+    args->createParams.connectionClassLength = args->cclassBuffer.size;
+    args->createParams.tag = args->tagBuffer.ptr;
+    args->createParams.tagLength = args->tagBuffer.size;
+
+    // create the connection object
+    args->conn = (cxoConnection*)
+            cxoPyTypeConnection.tp_alloc(&cxoPyTypeConnection, 0);
+    if (!args->conn)
+        return -1;
+    args->conn->threaded = pool->threaded;
+    args->conn->fetchLobs = 1;
+    args->conn->encodingInfo = pool->encodingInfo;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_acquireWorker()
+//   Acquire the connection from the pool, measuring the time spent waiting
+// for it. This is called without the GIL held.
+//-----------------------------------------------------------------------------
+static int cxoConnection_acquireWorker(cxoConnectionAcquireArgs *args)
+{
+    double startTime;
+    int status;
+
+    startTime = cxoUtils_getMonotonicTime();
+    status = dpiConn_create(cxoDpiContext, NULL, 0, NULL, 0, NULL, 0,
+            &args->commonParams, &args->createParams, &args->conn->handle);
+    args->waitTime = cxoUtils_getMonotonicTime() - startTime;
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_completeAcquire()
+//   Complete the acquisition of a connection from the pool by recording the
+// statistics for the attempt and, if it was successful, setting the tag and
+// invoking the session callback, if applicable. If the attempt failed, the
+// exception is expected to have been raised already; the error information is
+// supplied if the attempt was made on another thread.
+//-----------------------------------------------------------------------------
+static cxoConnection *cxoConnection_completeAcquire(
+        cxoConnectionAcquireArgs *args, int status,
+        const dpiErrorInfo *errorInfo)
+{
+    int invokeSessionCallback;
+    cxoConnection *conn;
+
+    cxoSessionPool_recordAcquire(args->pool, status, errorInfo,
+            args->waitTime, args->createParams.outNewSession);
+    if (status < 0)
+        return NULL;
+    invokeSessionCallback = cxoConnection_isSessionCallbackRequired(
+            &args->createParams, &args->tagBuffer);
+    conn = args->conn;
+    args->conn = NULL;
+    if (cxoConnection_completeCreate(conn, args->pool, &args->createParams,
+            invokeSessionCallback, args->tagObj) < 0) {
+        Py_DECREF(conn);
+        return NULL;
     }
 
-    // invoke the session callback if applicable
-    if (invokeSessionCallback && pool && pool->sessionCallback &&
-            PyCallable_Check(pool->sessionCallback)) {
-        tempObj = PyObject_CallFunctionObjArgs(pool->sessionCallback,
-                (PyObject*) conn, tagObj, NULL);
-        if (!tempObj)
-            return -1;
-        Py_DECREF(tempObj);
+    return conn;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_acquireFromPool()
+//   Acquire a connection from the session pool without calling
+// Connection.__init__(). This is used by SessionPool.acquire() for the common
+// case where no user name, password or sharding keys are specified and the
+// pool creates instances of Connection itself.
+//-----------------------------------------------------------------------------
+cxoConnection *cxoConnection_acquireFromPool(cxoSessionPool *pool,
+        PyObject *cclassObj, PyObject *purityObj, PyObject *tagObj,
+        PyObject *matchAnyTagObj)
+{
+    cxoConnectionAcquireArgs args;
+    cxoConnection *conn;
+    int status;
+
+    if (cxoConnection_prepareAcquire(&args, pool, cclassObj, purityObj,
+            tagObj, matchAnyTagObj) < 0) {
+        cxoConnection_clearAcquireArgs(&args);
+        return NULL;
     }
+    Py_BEGIN_ALLOW_THREADS
+    status = cxoConnection_acquireWorker(&args);
+    Py_END_ALLOW_THREADS
+    if (status < 0)
+        cxoError_raiseAndReturnNull();
+    conn = cxoConnection_completeAcquire(&args, status, NULL);
+    cxoConnection_clearAcquireArgs(&args);
+    return conn;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_freeAcquireArgs()
+//   Free the arguments used when acquiring a connection asynchronously.
+//-----------------------------------------------------------------------------
+static void cxoConnection_freeAcquireArgs(void *data)
+{
+    cxoConnectionAcquireArgs *args = (cxoConnectionAcquireArgs*) data;
 
+    cxoConnection_clearAcquireArgs(args);
+    PyMem_Free(args);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_acquireAsyncWorker()
+//   Acquire the connection from the pool. This is called by a worker thread
+// without the GIL held.
+//-----------------------------------------------------------------------------
+static int cxoConnection_acquireAsyncWorker(void *arg)
+{
+    cxoAsyncCall *call = (cxoAsyncCall*) arg;
+
+    return cxoConnection_acquireWorker(
+            (cxoConnectionAcquireArgs*) call->data);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_acquireAsyncComplete()
+//   Complete the asynchronous acquisition of a connection from the pool. The
+// result is the connection that was acquired.
+//-----------------------------------------------------------------------------
+static int cxoConnection_acquireAsyncComplete(cxoAsyncCall *call, int status,
+        PyObject **result)
+{
+    cxoConnection *conn;
+
+    conn = cxoConnection_completeAcquire(
+            (cxoConnectionAcquireArgs*) call->data, status,
+            &call->worker->errorInfo);
+    if (!conn)
+        return -1;
+    *result = (PyObject*) conn;
     return 0;
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_acquireFromPoolAsync()
+//   Acquire a connection from the session pool asynchronously and return an
+// asyncio future which completes with the connection once it has been
+// acquired. This is used by SessionPool.acquireasync().
+//-----------------------------------------------------------------------------
+PyObject *cxoConnection_acquireFromPoolAsync(cxoSessionPool *pool,
+        PyObject *cclassObj, PyObject *purityObj, PyObject *tagObj,
+        PyObject *matchAnyTagObj)
+{
+    cxoConnectionAcquireArgs *args;
+    cxoAsyncCall *call;
+    PyObject *future;
+
+    // create the call object
+    call = cxoAsyncCall_new((PyObject*) pool, NULL, pool->threaded,
+            cxoConnection_acquireAsyncComplete);
+    if (!call)
+        return NULL;
+
+    // prepare the arguments, which are owned by the call object
+    args = PyMem_Malloc(sizeof(cxoConnectionAcquireArgs));
+    if (!args) {
+        Py_DECREF(call);
+        return PyErr_NoMemory();
+    }
+    if (cxoConnection_prepareAcquire(args, pool, cclassObj, purityObj,
+            tagObj, matchAnyTagObj) < 0) {
+        cxoConnection_freeAcquireArgs(args);
+        Py_DECREF(call);
+        return NULL;
+    }
+    call->data = args;
+    call->freeDataFunc = cxoConnection_freeAcquireArgs;
+
+    // start acquiring the connection
+    if (cxoAsyncCall_start(call, cxoConnection_acquireAsyncWorker, 1) < 0) {
+        Py_DECREF(call);
+        return NULL;
+    }
+    future = call->future;
+    Py_INCREF(future);
+    Py_DECREF(call);
+    return future;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_free()
 //   Deallocate the connection, disconnecting from the database if necessary.
 //-----------------------------------------------------------------------------
 static void cxoConnection_free(cxoConnection *conn)
 {
+    PyObject_GC_UnTrack(conn);
     if (conn->handle) {
         Py_BEGIN_ALLOW_THREADS
         dpiConn_release(conn->handle);
@@ -689,10 +1008,45 @@ static void cxoConnection_free(cxoConnection *conn)
     Py_CLEAR(conn->inputTypeHandler);
     Py_CLEAR(conn->outputTypeHandler);
     Py_CLEAR(conn->tag);
+    Py_CLEAR(conn->objectTypes);
+    Py_CLEAR(conn->statsHandler);
+    cxoStmtCache_clear(&conn->stmtCache);
     Py_TYPE(conn)->tp_free((PyObject*) conn);
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_traverse()
+//   Traverse the objects referenced by the connection. Cached object types
+// reference the connection so the garbage collector must be able to find the
+// cycle if the connection is not closed explicitly.
+//-----------------------------------------------------------------------------
+static int cxoConnection_traverse(cxoConnection *conn, visitproc visit,
+        void *arg)
+{
+    Py_VISIT(conn->inputTypeHandler);
+    Py_VISIT(conn->outputTypeHandler);
+    Py_VISIT(conn->objectTypes);
+    Py_VISIT(conn->statsHandler);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_clear()
+//   Clear the objects referenced by the connection that may be part of a
+// reference cycle.
+//-----------------------------------------------------------------------------
+static int cxoConnection_clear(cxoConnection *conn)
+{
+    Py_CLEAR(conn->inputTypeHandler);
+    Py_CLEAR(conn->outputTypeHandler);
+    Py_CLEAR(conn->objectTypes);
+    Py_CLEAR(conn->statsHandler);
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_repr()
 //   Return a string representation of the connection.
@@ -809,6 +1163,36 @@ static PyObject *cxoConnection_getType(cxoConnection *conn, PyObject *nameObj)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_stats()
+//   Return a snapshot of the statistics gathered for all cursors created by
+// the connection.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_stats(cxoConnection *conn, PyObject *args)
+{
+    return cxoStatementStats_toPython(&conn->stats);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_stmtCacheStats()
+//   Return a snapshot of the statistics gathered for the statement cache of
+// the connection, optionally including the statements most frequently not
+// found in the cache.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_stmtCacheStats(cxoConnection *conn,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "top", NULL };
+    unsigned int top = 0;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|I", keywordList,
+            &top))
+        return NULL;
+    return cxoStmtCache_toPython(&conn->stmtCache, top);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_createLob()
 //   Create a new temporary LOB and return it.
@@ -968,6 +1352,7 @@ static PyObject *cxoConnection_close(cxoConnection *conn, PyObject *args)
     if (status < 0)
         return cxoError_raiseAndReturnNull();
     conn->handle = NULL;
+    Py_CLEAR(conn->objectTypes);
 
     Py_RETURN_NONE;
 }
@@ -993,6 +1378,62 @@ static PyObject *cxoConnection_commit(cxoConnection *conn, PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_commitAsyncWorker()
+//   Commit the transaction on the connection. This is called by a worker
+// thread without the GIL held.
+//-----------------------------------------------------------------------------
+static int cxoConnection_commitAsyncWorker(void *arg)
+{
+    cxoAsyncCall *call = (cxoAsyncCall*) arg;
+
+    return dpiConn_commit(call->connection->handle);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_commitAsyncComplete()
+//   Complete the asynchronous commit. The result is always None.
+//-----------------------------------------------------------------------------
+static int cxoConnection_commitAsyncComplete(cxoAsyncCall *call, int status,
+        PyObject **result)
+{
+    if (status < 0)
+        return -1;
+    Py_INCREF(Py_None);
+    *result = Py_None;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_commitAsync()
+//   Commit the transaction on the connection asynchronously and return an
+// asyncio future which completes when the commit has been performed.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_commitAsync(cxoConnection *conn,
+        PyObject *args)
+{
+    cxoAsyncCall *call;
+    PyObject *future;
+
+    if (cxoConnection_isConnected(conn) < 0)
+        return NULL;
+    call = cxoAsyncCall_new((PyObject*) conn, conn, conn->threaded,
+            cxoConnection_commitAsyncComplete);
+    if (!call)
+        return NULL;
+    if (cxoAsyncCall_start(call, cxoConnection_commitAsyncWorker, 0) < 0) {
+        Py_DECREF(call);
+        return NULL;
+    }
+    future = call->future;
+    Py_INCREF(future);
+    Py_DECREF(call);
+    return future;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_begin()
 //   Begin a new transaction on the connection.
@@ -1107,12 +1548,14 @@ static PyObject *cxoConnection_newCursor(cxoConnection *conn, PyObject *args,
 //-----------------------------------------------------------------------------
 // cxoConnection_cancel()
 //   Cause Oracle to issue an immediate (asynchronous) abort of any currently
-// executing statement.
+// executing statement. This is permitted while an asynchronous operation is in
+// progress since that is one of the statements that may need to be aborted.
 //-----------------------------------------------------------------------------
 static PyObject *cxoConnection_cancel(cxoConnection *conn, PyObject *args)
 {
-    if (cxoConnection_isConnected(conn) < 0)
-        return NULL;
+    if (!conn->handle)
+        return cxoError_raiseFromString(cxoInterfaceErrorException,
+                "not connected");
     if (dpiConn_breakExecution(conn->handle) < 0)
         return cxoError_raiseAndReturnNull();
 
@@ -1422,6 +1865,19 @@ static PyObject *cxoConnection_contextManagerExit(cxoConnection *conn,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_newPipeline()
+//   Create a new pipeline for the connection.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_newPipeline(cxoConnection *conn,
+        PyObject *args)
+{
+    if (cxoConnection_isConnected(conn) < 0)
+        return NULL;
+    return (PyObject*) cxoPipeline_new(conn);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_ping()
 //   Makes a round trip call to the server to confirm that the connection and
@@ -1443,6 +1899,29 @@ static PyObject *cxoConnection_ping(cxoConnection *conn, PyObject* args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_newResultCache()
+//   Create a new result cache for the connection.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_newResultCache(cxoConnection *conn,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "maxentries", "clientInitiated", NULL };
+    uint32_t maxEntries = CXO_RESULT_CACHE_MAX_ENTRIES;
+    PyObject *clientInitiatedObj = NULL;
+    int clientInitiated;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|IO", keywordList,
+            &maxEntries, &clientInitiatedObj))
+        return NULL;
+    if (cxoConnection_isConnected(conn) < 0)
+        return NULL;
+    if (cxoUtils_getBooleanValue(clientInitiatedObj, 0, &clientInitiated) < 0)
+        return NULL;
+    return (PyObject*) cxoResultCache_new(conn, maxEntries, clientInitiated);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_shutdown()
 //   Shuts down the database. Note that this must be done in two phases except
@@ -1534,30 +2013,35 @@ static PyObject *cxoConnection_subscribe(cxoConnection *conn, PyObject* args,
     static char *keywordList[] = { "namespace", "protocol", "callback",
             "timeout", "operations", "port", "qos", "ipAddress",
             "groupingClass", "groupingValue", "groupingType", "name",
-            "clientInitiated", NULL };
-    PyObject *callback, *ipAddress, *name, *clientInitiatedObj;
+            "clientInitiated", "coalesce", "coalesceWindow", NULL };
+    PyObject *callback, *ipAddress, *name, *clientInitiatedObj, *coalesceObj;
     cxoBuffer ipAddressBuffer, nameBuffer;
     dpiSubscrCreateParams params;
+    uint32_t coalesceWindow;
     cxoSubscr *subscr;
+    int coalesce;
 
     // get default values for subscription parameters
     if (dpiContext_initSubscrCreateParams(cxoDpiContext, &params) < 0)
         return cxoError_raiseAndReturnNull();
 
     // validate parameters
-    callback = name = ipAddress = clientInitiatedObj = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|IIOIIIIObIbOO",
+    callback = name = ipAddress = clientInitiatedObj = coalesceObj = NULL;
+    coalesceWindow = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|IIOIIIIObIbOOOI",
             keywordList, &params.subscrNamespace, &params.protocol, &callback,
             &params.timeout, &params.operations, &params.portNumber,
             &params.qos, &ipAddress, &params.groupingClass,
             &params.groupingValue, &params.groupingType, &name,
-            &clientInitiatedObj))
+            &clientInitiatedObj, &coalesceObj, &coalesceWindow))
         return NULL;
     if (cxoConnection_isConnected(conn) < 0)
         return NULL;
     if (cxoUtils_getBooleanValue(clientInitiatedObj, 0,
             &params.clientInitiated) < 0)
         return NULL;
+    if (cxoUtils_getBooleanValue(coalesceObj, 0, &coalesce) < 0)
+        return NULL;
 
     // populate IP address in parameters, if applicable
     cxoBuffer_init(&ipAddressBuffer);
@@ -1606,8 +2090,16 @@ static PyObject *cxoConnection_subscribe(cxoConnection *conn, PyObject* args,
     subscr->groupingValue = params.groupingValue;
     subscr->groupingType = params.groupingType;
 
+    // create the queue used for coalesced delivery, if applicable
+    if (coalesce && cxoSubscr_initQueue(subscr, coalesceWindow) < 0) {
+        cxoBuffer_clear(&ipAddressBuffer);
+        cxoBuffer_clear(&nameBuffer);
+        Py_DECREF(subscr);
+        return NULL;
+    }
+
     // populate callback in parameters, if applicable
-    if (callback) {
+    if (callback || coalesce) {
         params.callback = (dpiSubscrCallback) cxoSubscr_callback;
         params.callbackContext = subscr;
     }
@@ -1748,6 +2240,33 @@ static PyObject *cxoConnection_getInternalName(cxoConnection* conn,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_getCollectStats()
+//   Return whether statistics are gathered by default for cursors created by
+// the connection.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_getCollectStats(cxoConnection* conn,
+        void* unused)
+{
+    if (conn->collectStats)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_getFetchLobs()
+//   Return whether LOB columns are fetched as LOB objects by default for
+// cursors created by the connection.
+//-----------------------------------------------------------------------------
+static PyObject *cxoConnection_getFetchLobs(cxoConnection* conn, void* unused)
+{
+    if (conn->fetchLobs)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_getException()
 //   Return the requested exception.
@@ -1794,6 +2313,30 @@ static int cxoConnection_setClientInfo(cxoConnection* conn, PyObject *value,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoConnection_setCollectStats()
+//   Set whether statistics are gathered by default for cursors created by the
+// connection.
+//-----------------------------------------------------------------------------
+static int cxoConnection_setCollectStats(cxoConnection* conn, PyObject *value,
+        void* unused)
+{
+    return cxoUtils_getBooleanValue(value, 0, &conn->collectStats);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoConnection_setFetchLobs()
+//   Set whether LOB columns are fetched as LOB objects by default for cursors
+// created by the connection.
+//-----------------------------------------------------------------------------
+static int cxoConnection_setFetchLobs(cxoConnection* conn, PyObject *value,
+        void* unused)
+{
+    return cxoUtils_getBooleanValue(value, 1, &conn->fetchLobs);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoConnection_setCurrentSchema()
 //   Set the current schema associated with the connection.
@@ -1896,6 +2439,7 @@ static PyMethodDef cxoMethods[] = {
     { "cursor", (PyCFunction) cxoConnection_newCursor,
             METH_VARARGS | METH_KEYWORDS },
     { "commit", (PyCFunction) cxoConnection_commit, METH_NOARGS },
+    { "commitasync", (PyCFunction) cxoConnection_commitAsync, METH_NOARGS },
     { "rollback", (PyCFunction) cxoConnection_rollback, METH_NOARGS },
     { "begin", (PyCFunction) cxoConnection_begin, METH_VARARGS },
     { "prepare", (PyCFunction) cxoConnection_prepare, METH_NOARGS },
@@ -1906,6 +2450,9 @@ static PyMethodDef cxoMethods[] = {
     { "__exit__", (PyCFunction) cxoConnection_contextManagerExit,
             METH_VARARGS },
     { "ping", (PyCFunction) cxoConnection_ping, METH_NOARGS },
+    { "pipeline", (PyCFunction) cxoConnection_newPipeline, METH_NOARGS },
+    { "resultcache", (PyCFunction) cxoConnection_newResultCache,
+            METH_VARARGS | METH_KEYWORDS },
     { "shutdown", (PyCFunction) cxoConnection_shutdown,
             METH_VARARGS | METH_KEYWORDS},
     { "startup", (PyCFunction) cxoConnection_startup,
@@ -1917,6 +2464,9 @@ static PyMethodDef cxoMethods[] = {
     { "changepassword", (PyCFunction) cxoConnection_changePassword,
             METH_VARARGS },
     { "gettype", (PyCFunction) cxoConnection_getType, METH_O },
+    { "stats", (PyCFunction) cxoConnection_stats, METH_NOARGS },
+    { "stmtcachestats", (PyCFunction) cxoConnection_stmtCacheStats,
+            METH_VARARGS | METH_KEYWORDS },
     { "deqoptions", (PyCFunction) cxoConnection_newDequeueOptions,
             METH_NOARGS },
     { "enqoptions", (PyCFunction) cxoConnection_newEnqueueOptions,
@@ -1953,6 +2503,7 @@ static PyMemberDef cxoMembers[] = {
             offsetof(cxoConnection, inputTypeHandler), 0 },
     { "outputtypehandler", T_OBJECT,
             offsetof(cxoConnection, outputTypeHandler), 0 },
+    { "statshandler", T_OBJECT, offsetof(cxoConnection, statsHandler), 0 },
     { NULL }
 };
 
@@ -1970,6 +2521,10 @@ static PyGetSetDef cxoCalcMembers[] = {
             0, 0, 0 },
     { "stmtcachesize", (getter) cxoConnection_getStmtCacheSize,
             (setter) cxoConnection_setStmtCacheSize, 0, 0 },
+    { "collectstats", (getter) cxoConnection_getCollectStats,
+            (setter) cxoConnection_setCollectStats, 0, 0 },
+    { "fetchlobs", (getter) cxoConnection_getFetchLobs,
+            (setter) cxoConnection_setFetchLobs, 0, 0 },
     { "module", 0, (setter) cxoConnection_setModule, 0, 0 },
     { "action", 0, (setter) cxoConnection_setAction, 0, 0 },
     { "clientinfo", 0, (setter) cxoConnection_setClientInfo, 0, 0 },
@@ -2018,7 +2573,10 @@ PyTypeObject cxoPyTypeConnection = {
     .tp_basicsize = sizeof(cxoConnection),
     .tp_dealloc = (destructor) cxoConnection_free,
     .tp_repr = (reprfunc) cxoConnection_repr,
-    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_BASETYPE |
+            Py_TPFLAGS_HAVE_GC,
+    .tp_traverse = (traverseproc) cxoConnection_traverse,
+    .tp_clear = (inquiry) cxoConnection_clear,
     .tp_methods = cxoMethods,
     .tp_members = cxoMembers,
     .tp_getset = cxoCalcMembers,
@@ -14,6 +14,10 @@
 
 #include "cxoModule.h"
 
+// forward declarations
+static void cxoCursor_discardBackgroundFetch(cxoCursor *cursor);
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_new()
 //   Create a new cursor object.
@@ -52,7 +56,11 @@ static int cxoCursor_init(cxoCursor *cursor, PyObject *args,
     cursor->arraySize = 100;
     cursor->fetchArraySize = 100;
     cursor->prefetchRows = DPI_DEFAULT_PREFETCH_ROWS;
+    cursor->fetchBytes = CXO_DEFAULT_FETCH_BYTES;
+    cursor->fetchBatchSize = CXO_AUTO_ARRAY_SIZE_INITIAL;
     cursor->bindArraySize = 1;
+    cursor->collectStats = connection->collectStats;
+    cursor->fetchLobs = connection->fetchLobs;
     cursor->isOpen = 1;
 
     return 0;
@@ -92,7 +100,18 @@ static void cxoCursor_free(cxoCursor *cursor)
     Py_CLEAR(cursor->statement);
     Py_CLEAR(cursor->statementTag);
     Py_CLEAR(cursor->bindVariables);
+    cxoCursor_discardBackgroundFetch(cursor);
+    if (cursor->fetchWorker) {
+        cxoWorker_free(cursor->fetchWorker);
+        PyMem_Free(cursor->fetchWorker);
+        cursor->fetchWorker = NULL;
+    }
     Py_CLEAR(cursor->fetchVariables);
+    Py_CLEAR(cursor->prefetchVariables);
+    Py_CLEAR(cursor->varPool);
+    Py_CLEAR(cursor->rowTemplate);
+    Py_CLEAR(cursor->batchErrors);
+    Py_CLEAR(cursor->arrayDMLRowCounts);
     if (cursor->handle) {
         dpiStmt_release(cursor->handle);
         cursor->handle = NULL;
@@ -101,17 +120,19 @@ static void cxoCursor_free(cxoCursor *cursor)
     Py_CLEAR(cursor->rowFactory);
     Py_CLEAR(cursor->inputTypeHandler);
     Py_CLEAR(cursor->outputTypeHandler);
+    Py_CLEAR(cursor->statsHandler);
     Py_TYPE(cursor)->tp_free((PyObject*) cursor);
 }
 
 
 //-----------------------------------------------------------------------------
-// cxoCursor_isOpen()
+// cxoCursor_isOpenForFetch()
 //   Determines if the cursor object is open. Since the same cursor can be
 // used to execute multiple statements, simply checking for the DPI statement
-// handle is insufficient.
+// handle is insufficient. This is used by the methods that consume fetched
+// rows, which may proceed while a background fetch is in progress.
 //-----------------------------------------------------------------------------
-static int cxoCursor_isOpen(cxoCursor *cursor)
+static int cxoCursor_isOpenForFetch(cxoCursor *cursor)
 {
     if (!cursor->isOpen) {
         cxoError_raiseFromString(cxoInterfaceErrorException, "not open");
@@ -121,6 +142,274 @@ static int cxoCursor_isOpen(cxoCursor *cursor)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_waitForBackgroundFetch()
+//   Wait for any background fetch in progress to complete. The rows that were
+// fetched (or the error that took place) are retained for the next fetch.
+// This must be done before the statement handle is used for anything other
+// than consuming fetched rows since the worker thread uses the statement
+// handle while the fetch is in progress.
+//-----------------------------------------------------------------------------
+static void cxoCursor_waitForBackgroundFetch(cxoCursor *cursor)
+{
+    if (cursor->fetchWorker)
+        cxoWorker_sync(cursor->fetchWorker);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_isOpen()
+//   Determines if the cursor object is open and waits for any background
+// fetch in progress to complete, so that all other operations on the cursor
+// are blocked while a fetch is in progress.
+//-----------------------------------------------------------------------------
+static int cxoCursor_isOpen(cxoCursor *cursor)
+{
+    if (cxoCursor_isOpenForFetch(cursor) < 0)
+        return -1;
+    cxoCursor_waitForBackgroundFetch(cursor);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_backgroundFetchWorker()
+//   Fetch the next batch of rows into the second set of fetch variables. This
+// is called without the GIL held, usually by the worker thread.
+//-----------------------------------------------------------------------------
+static int cxoCursor_backgroundFetchWorker(void *arg)
+{
+    cxoCursor *cursor = (cxoCursor*) arg;
+    double startTime;
+    int status;
+
+    startTime = cxoUtils_getMonotonicTime();
+    status = dpiStmt_fetchRows(cursor->handle, cursor->fetchArraySize,
+            &cursor->prefetchBufferRowIndex,
+            &cursor->numRowsInPrefetchBuffer, &cursor->moreRowsToPrefetch);
+    cursor->fetchRoundTripTime = cxoUtils_getMonotonicTime() - startTime;
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_discardBackgroundFetch()
+//   Wait for any background fetch in progress to complete and discard the rows
+// that were fetched (and any error that took place). This must be done before
+// the statement is prepared again or the cursor is closed.
+//-----------------------------------------------------------------------------
+static void cxoCursor_discardBackgroundFetch(cxoCursor *cursor)
+{
+    if (cursor->fetchWorker)
+        cxoWorker_discard(cursor->fetchWorker);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_defineVariables()
+//   Define the statement with the given set of fetch variables.
+//-----------------------------------------------------------------------------
+static int cxoCursor_defineVariables(cxoCursor *cursor, PyObject *vars)
+{
+    Py_ssize_t i;
+    cxoVar *var;
+
+    for (i = 0; i < PyList_GET_SIZE(vars); i++) {
+        var = (cxoVar*) PyList_GET_ITEM(vars, i);
+        if (dpiStmt_define(cursor->handle, (uint32_t) i + 1, var->handle) < 0)
+            return cxoError_raiseAndReturnInt();
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_copyPrefetchedRows()
+//   Copy the rows fetched into the second set of fetch variables into the
+// fetch variables, which become the fetch buffer. The fetch variables are
+// never replaced so the variables returned by Cursor.fetchvars (and any
+// output converters set on them) remain the same for the whole query.
+//-----------------------------------------------------------------------------
+static int cxoCursor_copyPrefetchedRows(cxoCursor *cursor)
+{
+    cxoVar *sourceVar, *targetVar;
+    Py_ssize_t i;
+    uint32_t row;
+
+    for (i = 0; i < PyList_GET_SIZE(cursor->fetchVariables); i++) {
+        sourceVar = (cxoVar*) PyList_GET_ITEM(cursor->prefetchVariables, i);
+        targetVar = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+        for (row = 0; row < cursor->numRowsInPrefetchBuffer; row++) {
+            if (dpiVar_copyData(targetVar->handle, row, sourceVar->handle,
+                    cursor->prefetchBufferRowIndex + row) < 0)
+                return cxoError_raiseAndReturnInt();
+        }
+    }
+    cursor->fetchBufferRowIndex = 0;
+    cursor->numRowsInFetchBuffer = cursor->numRowsInPrefetchBuffer;
+    cursor->moreRowsToFetch = cursor->moreRowsToPrefetch;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_startBackgroundFetch()
+//   Start fetching the next batch of rows on the worker thread of the cursor
+// into the second set of fetch variables. The second set of variables and the
+// worker (along with its thread) are created the first time they are needed
+// and are reused for the rest of the query; the second set of variables is
+// only defined once for each execution. This is only done if background
+// fetching is enabled and more rows are available.
+//-----------------------------------------------------------------------------
+static int cxoCursor_startBackgroundFetch(cxoCursor *cursor)
+{
+    Py_ssize_t i, numVars;
+    cxoVar *var;
+
+    // nothing to do if disabled or no more rows are available
+    if (!cursor->backgroundFetch || !cursor->moreRowsToFetch ||
+            cursor->isScrollable)
+        return 0;
+
+    // create the second set of fetch variables, if needed
+    numVars = PyList_GET_SIZE(cursor->fetchVariables);
+    if (!cursor->prefetchVariables) {
+        cursor->prefetchVariables = PyList_New(numVars);
+        if (!cursor->prefetchVariables)
+            return -1;
+        for (i = 0; i < numVars; i++) {
+            var = cxoVar_newByVar(cursor,
+                    (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i));
+            if (!var) {
+                Py_CLEAR(cursor->prefetchVariables);
+                return -1;
+            }
+            PyList_SET_ITEM(cursor->prefetchVariables, i, (PyObject*) var);
+        }
+    }
+
+    // create the worker, if needed
+    if (!cursor->fetchWorker) {
+        cursor->fetchWorker = PyMem_Malloc(sizeof(cxoWorker));
+        if (!cursor->fetchWorker) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        cxoWorker_init(cursor->fetchWorker);
+    }
+
+    // define the second set of variables, if needed; if this fails, the
+    // original set of variables is defined again
+    if (!cursor->prefetchDefined) {
+        if (cxoCursor_defineVariables(cursor, cursor->prefetchVariables) < 0) {
+            cxoCursor_defineVariables(cursor, cursor->fetchVariables);
+            return -1;
+        }
+        cursor->prefetchDefined = 1;
+    }
+
+    // start the fetch; if it cannot be started, the next batch is fetched
+    // into the second set of variables when it is needed instead
+    return cxoWorker_start(cursor->fetchWorker,
+            cxoCursor_backgroundFetchWorker, cursor, 1);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_tuneFetchBatchSize()
+//   When the array size is determined automatically, adjust the number of rows
+// fetched by each round trip using the time taken by the round trip that just
+// completed. The batch size is doubled (up to the number of rows allocated for
+// the fetch variables) for as long as doing so reduces the time taken per row
+// significantly; if it increases the time taken per row instead, the previous
+// batch size is restored. Tuning stops in both cases. The first round trip of
+// each execution is ignored since it is at least partially satisfied by the
+// rows prefetched during execute; partial batches are ignored since they
+// indicate the end of the result set.
+//-----------------------------------------------------------------------------
+static int cxoCursor_tuneFetchBatchSize(cxoCursor *cursor)
+{
+    uint32_t batchSize;
+    double timePerRow;
+
+    // determine if the round trip is suitable for tuning
+    cursor->fetchRoundTrips++;
+    if (!cursor->autoArraySize || cursor->fetchBatchSizeTuned ||
+            cursor->fetchRoundTrips == 1 ||
+            cursor->numRowsInFetchBuffer < cursor->fetchBatchSize)
+        return 0;
+    timePerRow = cursor->fetchRoundTripTime / cursor->numRowsInFetchBuffer;
+
+    // determine the new batch size
+    batchSize = cursor->fetchBatchSize;
+    if (cursor->fetchTimePerRow > 0 && timePerRow >=
+            cursor->fetchTimePerRow * CXO_AUTO_ARRAY_SIZE_MIN_GAIN) {
+        cursor->fetchBatchSizeTuned = 1;
+        if (timePerRow > cursor->fetchTimePerRow && batchSize > 1)
+            batchSize /= 2;
+    } else if (batchSize < cursor->fetchArraySize) {
+        cursor->fetchTimePerRow = timePerRow;
+        batchSize = (batchSize > cursor->fetchArraySize / 2) ?
+                cursor->fetchArraySize : batchSize * 2;
+    } else {
+        cursor->fetchBatchSizeTuned = 1;
+    }
+
+    // adjust the number of rows fetched by the next round trip, if needed
+    if (batchSize != cursor->fetchBatchSize) {
+        if (dpiStmt_setFetchArraySize(cursor->handle, batchSize) < 0)
+            return cxoError_raiseAndReturnInt();
+        cursor->fetchBatchSize = batchSize;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_fetchRows()
+//   Populate the fetch buffer with the next batch of rows. Once the second set
+// of fetch variables has been defined, rows are always fetched into it: if a
+// background fetch is in progress, wait for it to complete; otherwise, fetch
+// the rows now. The rows are then copied into the fetch variables. If the
+// second set of fetch variables has not been defined, the rows are fetched
+// directly into the fetch variables. In all cases, start a background fetch
+// of the following batch, if applicable.
+//-----------------------------------------------------------------------------
+static int cxoCursor_fetchRows(cxoCursor *cursor)
+{
+    double startTime;
+    int status;
+
+    if (cursor->prefetchDefined) {
+        if (!cursor->fetchWorker->isStarted &&
+                cxoWorker_start(cursor->fetchWorker,
+                        cxoCursor_backgroundFetchWorker, cursor, 0) < 0)
+            return -1;
+        if (cxoWorker_wait(cursor->fetchWorker) < 0)
+            return -1;
+        if (cxoCursor_copyPrefetchedRows(cursor) < 0)
+            return -1;
+    } else {
+        Py_BEGIN_ALLOW_THREADS
+        startTime = cxoUtils_getMonotonicTime();
+        status = dpiStmt_fetchRows(cursor->handle, cursor->fetchArraySize,
+                &cursor->fetchBufferRowIndex, &cursor->numRowsInFetchBuffer,
+                &cursor->moreRowsToFetch);
+        cursor->fetchRoundTripTime = cxoUtils_getMonotonicTime() - startTime;
+        Py_END_ALLOW_THREADS
+        if (status < 0)
+            return cxoError_raiseAndReturnInt();
+    }
+    if (cursor->collectStats && cxoStatementStats_record(cursor,
+            CXO_STATEMENT_PHASE_FETCH, cursor->fetchRoundTripTime,
+            cursor->numRowsInFetchBuffer) < 0)
+        return -1;
+    if (cxoCursor_tuneFetchBatchSize(cursor) < 0)
+        return -1;
+    return cxoCursor_startBackgroundFetch(cursor);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_fetchRow()
 //   Fetch a single row from the cursor. Internally the number of rows left in
@@ -130,19 +419,12 @@ static int cxoCursor_isOpen(cxoCursor *cursor)
 static int cxoCursor_fetchRow(cxoCursor *cursor, int *found,
         uint32_t *bufferRowIndex)
 {
-    int status;
-
     // if the number of rows in the fetch buffer is zero and there are more
     // rows to fetch, call DPI with threading enabled in order to perform any
     // fetch requiring a network round trip
     if (cursor->numRowsInFetchBuffer == 0 && cursor->moreRowsToFetch) {
-        Py_BEGIN_ALLOW_THREADS
-        status = dpiStmt_fetchRows(cursor->handle, cursor->fetchArraySize,
-                &cursor->fetchBufferRowIndex, &cursor->numRowsInFetchBuffer,
-                &cursor->moreRowsToFetch);
-        Py_END_ALLOW_THREADS
-        if (status < 0)
-            return cxoError_raiseAndReturnInt();
+        if (cxoCursor_fetchRows(cursor) < 0)
+            return -1;
     }
 
     // keep track of where we are in the fetch buffer
@@ -158,12 +440,265 @@ static int cxoCursor_fetchRow(cxoCursor *cursor, int *found,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_calculateAutoArraySize()
+//   Calculate the number of rows to allocate for each fetch variable when the
+// array size is determined automatically. The size of each row is estimated
+// from the query metadata and as many rows are allocated as fit in the number
+// of bytes specified by the cursor. The number of rows fetched by each round
+// trip starts from the value used by the previous query (limited to the number
+// of rows allocated) and is tuned as rows are fetched.
+//-----------------------------------------------------------------------------
+static int cxoCursor_calculateAutoArraySize(cxoCursor *cursor,
+        uint32_t numQueryColumns)
+{
+    dpiQueryInfo queryInfo;
+    uint64_t rowSize;
+    uint32_t pos;
+
+    // estimate the size of each row
+    rowSize = 0;
+    for (pos = 1; pos <= numQueryColumns; pos++) {
+        if (dpiStmt_getQueryInfo(cursor->handle, pos, &queryInfo) < 0)
+            return cxoError_raiseAndReturnInt();
+        if (queryInfo.typeInfo.clientSizeInBytes > 0)
+            rowSize += queryInfo.typeInfo.clientSizeInBytes;
+        else rowSize += CXO_AUTO_HANDLE_SIZE_IN_BYTES;
+        rowSize += sizeof(dpiData);
+    }
+
+    // determine the number of rows to allocate
+    if (rowSize == 0 || rowSize >= cursor->fetchBytes)
+        cursor->fetchArraySize = 1;
+    else if (cursor->fetchBytes / rowSize > CXO_AUTO_ARRAY_SIZE_MAX)
+        cursor->fetchArraySize = CXO_AUTO_ARRAY_SIZE_MAX;
+    else cursor->fetchArraySize = (uint32_t) (cursor->fetchBytes / rowSize);
+    cursor->arraySize = cursor->fetchArraySize;
+
+    // determine the number of rows to fetch in each round trip
+    if (cursor->fetchBatchSize == 0 ||
+            cursor->fetchBatchSize > cursor->fetchArraySize)
+        cursor->fetchBatchSize = cursor->fetchArraySize;
+    cursor->fetchBatchSizeTuned = 0;
+    cursor->fetchTimePerRow = 0;
+    if (dpiStmt_setFetchArraySize(cursor->handle, cursor->fetchBatchSize) < 0)
+        return cxoError_raiseAndReturnInt();
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_createRowTemplate()
+//   Create the template used for creating rows when a row mode other than
+// tuples is in use. For rows returned as dictionaries this is a tuple of the
+// column names, which are used as the keys of each dictionary; for rows
+// returned as named tuples this is the named tuple type, created with the
+// column names as the field names (invalid names are replaced with names of
+// the form _N).
+//-----------------------------------------------------------------------------
+static int cxoCursor_createRowTemplate(cxoCursor *cursor,
+        uint32_t numQueryColumns)
+{
+    PyObject *names, *name, *module, *func, *args, *keywordArgs, *rowType;
+    dpiQueryInfo queryInfo;
+    uint32_t i;
+
+    // create a tuple containing the names of the columns
+    names = PyTuple_New(numQueryColumns);
+    if (!names)
+        return -1;
+    for (i = 0; i < numQueryColumns; i++) {
+        if (dpiStmt_getQueryInfo(cursor->handle, i + 1, &queryInfo) < 0) {
+            Py_DECREF(names);
+            return cxoError_raiseAndReturnInt();
+        }
+        name = PyUnicode_Decode(queryInfo.name, queryInfo.nameLength,
+                cursor->connection->encodingInfo.encoding, NULL);
+        if (!name) {
+            Py_DECREF(names);
+            return -1;
+        }
+        PyUnicode_InternInPlace(&name);
+        PyTuple_SET_ITEM(names, i, name);
+    }
+    if (cursor->rowMode == CXO_ROW_MODE_DICT) {
+        cursor->rowTemplate = names;
+        return 0;
+    }
+
+    // create the named tuple type
+    args = Py_BuildValue("(sN)", "Row", names);
+    if (!args)
+        return -1;
+    keywordArgs = Py_BuildValue("{sO}", "rename", Py_True);
+    if (!keywordArgs) {
+        Py_DECREF(args);
+        return -1;
+    }
+    rowType = NULL;
+    module = PyImport_ImportModule("collections");
+    if (module) {
+        func = PyObject_GetAttrString(module, "namedtuple");
+        Py_DECREF(module);
+        if (func) {
+            rowType = PyObject_Call(func, args, keywordArgs);
+            Py_DECREF(func);
+        }
+    }
+    Py_DECREF(args);
+    Py_DECREF(keywordArgs);
+    if (!rowType)
+        return -1;
+    if (!PyType_Check(rowType) ||
+            !PyType_IsSubtype((PyTypeObject*) rowType, &PyTuple_Type)) {
+        Py_DECREF(rowType);
+        PyErr_SetString(PyExc_TypeError, "expecting named tuple type");
+        return -1;
+    }
+    cursor->rowTemplate = rowType;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_getPooledVar()
+//   Return a variable from the pool of variables kept by the cursor with the
+// type and number of elements requested and a size of at least the size
+// requested but no more than twice that size. The variable is removed from
+// the pool. NULL is returned, without an exception being set, if no such
+// variable is available.
+//-----------------------------------------------------------------------------
+cxoVar *cxoCursor_getPooledVar(cxoCursor *cursor, uint32_t numElements,
+        cxoTransformNum transformNum, uint32_t size)
+{
+    Py_ssize_t i;
+    cxoVar *var;
+
+    if (!cursor->varPool)
+        return NULL;
+    if (numElements == 0)
+        numElements = 1;
+    if (size == 0)
+        size = cxoTransform_getDefaultSize(transformNum);
+    for (i = PyList_GET_SIZE(cursor->varPool) - 1; i >= 0; i--) {
+        var = (cxoVar*) PyList_GET_ITEM(cursor->varPool, i);
+        if (var->transformNum != transformNum ||
+                var->allocatedElements != numElements || var->size < size ||
+                var->size / 2 > size)
+            continue;
+        Py_INCREF(var);
+        if (PyList_SetSlice(cursor->varPool, i, i + 1, NULL) < 0) {
+            PyErr_Clear();
+            Py_DECREF(var);
+            return NULL;
+        }
+        var->isValueSet = 0;
+        return var;
+    }
+
+    return NULL;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_recycleVar()
+//   Add the variable to the pool of variables kept by the cursor if the pool
+// is not full and the variable can safely be used again for a different
+// statement; that is, nothing else references it and nothing about it other
+// than its type, size and number of elements was specified.
+//-----------------------------------------------------------------------------
+static void cxoCursor_recycleVar(cxoCursor *cursor, PyObject *obj)
+{
+    cxoVar *var = (cxoVar*) obj;
+
+    if (!obj || !cxoVar_check(obj) || Py_REFCNT(obj) != 1 ||
+            PyList_GET_SIZE(cursor->varPool) >= cursor->varPoolSize)
+        return;
+    if (var->connection != cursor->connection || var->isArray ||
+            var->objectType || var->inConverter || var->outConverter ||
+            var->encodingErrors || var->stringCache || var->dateCache ||
+            var->tzAware || var->getReturnedData)
+        return;
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_BINARY:
+        case CXO_TRANSFORM_DATE:
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_DECIMAL:
+        case CXO_TRANSFORM_FIXED_CHAR:
+        case CXO_TRANSFORM_FIXED_NCHAR:
+        case CXO_TRANSFORM_FLOAT:
+        case CXO_TRANSFORM_INT:
+        case CXO_TRANSFORM_NATIVE_DOUBLE:
+        case CXO_TRANSFORM_NATIVE_FLOAT:
+        case CXO_TRANSFORM_NATIVE_INT:
+        case CXO_TRANSFORM_NSTRING:
+        case CXO_TRANSFORM_STRING:
+        case CXO_TRANSFORM_TIMEDELTA:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ:
+            break;
+        default:
+            return;
+    }
+    if (PyList_Append(cursor->varPool, obj) < 0)
+        PyErr_Clear();
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_recycleVars()
+//   Clear the list or dictionary of variables referenced by the cursor. If
+// the cursor keeps a pool of variables, the variables that can be used again
+// are first added to it so that subsequent statements can use them instead
+// of allocating new buffers.
+//-----------------------------------------------------------------------------
+static void cxoCursor_recycleVars(cxoCursor *cursor, PyObject **vars)
+{
+    PyObject *temp, *value;
+    Py_ssize_t i, size;
+
+    // discard any pooled variables beyond the size of the pool, which may
+    // have been reduced since they were added
+    if (cursor->varPool) {
+        size = PyList_GET_SIZE(cursor->varPool);
+        if (size > cursor->varPoolSize && PyList_SetSlice(cursor->varPool,
+                cursor->varPoolSize, size, NULL) < 0)
+            PyErr_Clear();
+    }
+
+    // only variables in lists and dictionaries not referenced elsewhere are
+    // considered for the pool
+    temp = *vars;
+    if (!temp)
+        return;
+    *vars = NULL;
+    if (cursor->varPoolSize > 0 && Py_REFCNT(temp) == 1) {
+        if (!cursor->varPool)
+            cursor->varPool = PyList_New(0);
+        if (!cursor->varPool)
+            PyErr_Clear();
+        else if (PyList_Check(temp)) {
+            for (i = 0; i < PyList_GET_SIZE(temp); i++)
+                cxoCursor_recycleVar(cursor, PyList_GET_ITEM(temp, i));
+        } else if (PyDict_Check(temp)) {
+            i = 0;
+            while (PyDict_Next(temp, &i, NULL, &value))
+                cxoCursor_recycleVar(cursor, value);
+        }
+    }
+    Py_DECREF(temp);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_performDefine()
 //   Perform the defines for the cursor. At this point it is assumed that the
 // statement being executed is in fact a query.
 //-----------------------------------------------------------------------------
-static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
+int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
 {
     PyObject *outputTypeHandler, *result;
     cxoTransformNum transformNum;
@@ -179,20 +714,34 @@ static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
     // there is a significant amount of overhead in making these calls
     cursor->numRowsInFetchBuffer = 0;
     cursor->moreRowsToFetch = 1;
+    cursor->fetchRoundTrips = 0;
 
     // if fetch variables already exist, nothing more to do (we are executing
     // the same statement and therefore all defines have already been
-    // performed)
-    if (cursor->fetchVariables)
+    // performed) unless the second set of fetch variables was defined for
+    // background fetching, in which case the fetch variables are defined again
+    if (cursor->fetchVariables) {
+        if (cursor->prefetchDefined) {
+            cursor->prefetchDefined = 0;
+            if (cxoCursor_defineVariables(cursor, cursor->fetchVariables) < 0)
+                return -1;
+        }
         return 0;
+    }
+    cursor->prefetchDefined = 0;
 
     // create a list corresponding to the number of items
     cursor->fetchVariables = PyList_New(numQueryColumns);
     if (!cursor->fetchVariables)
         return -1;
 
+    // determine the number of rows to allocate for each variable
+    if (cursor->autoArraySize) {
+        if (cxoCursor_calculateAutoArraySize(cursor, numQueryColumns) < 0)
+            return -1;
+    } else cursor->fetchArraySize = cursor->arraySize;
+
     // create a variable for each of the query columns
-    cursor->fetchArraySize = cursor->arraySize;
     for (pos = 1; pos <= numQueryColumns; pos++) {
 
         // get query information for the column position
@@ -263,7 +812,30 @@ static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
             }
         }
 
-        // if no variable created yet, use the database metadata
+        // if LOB objects are not wanted, fetch LOB columns as long strings or
+        // long raw values instead so that their values are returned with the
+        // rows rather than requiring further round trips to read them
+        if (!var && !cursor->fetchLobs) {
+            switch (transformNum) {
+                case CXO_TRANSFORM_CLOB:
+                case CXO_TRANSFORM_NCLOB:
+                    transformNum = CXO_TRANSFORM_LONG_STRING;
+                    size = 0;
+                    break;
+                case CXO_TRANSFORM_BLOB:
+                    transformNum = CXO_TRANSFORM_LONG_BINARY;
+                    size = 0;
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // if no variable created yet, use the database metadata; a variable
+        // from the pool is used, if one is suitable
+        if (!var && !objectType)
+            var = cxoCursor_getPooledVar(cursor, cursor->fetchArraySize,
+                    transformNum, size);
         if (!var) {
             var = cxoVar_new(cursor, cursor->fetchArraySize, transformNum,
                     size, 0, objectType);
@@ -273,6 +845,55 @@ static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
             }
         }
 
+        // use the cursor's string cache size for string columns, unless a
+        // cache was already requested for the variable
+        if (cursor->stringCacheSize > 0 && !var->stringCache) {
+            switch (var->transformNum) {
+                case CXO_TRANSFORM_FIXED_CHAR:
+                case CXO_TRANSFORM_FIXED_NCHAR:
+                case CXO_TRANSFORM_LONG_STRING:
+                case CXO_TRANSFORM_NSTRING:
+                case CXO_TRANSFORM_STRING:
+                    if (cxoVar_setStringCacheSize(var,
+                            cursor->stringCacheSize) < 0) {
+                        Py_DECREF(var);
+                        Py_XDECREF(objectType);
+                        return -1;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // use the cursor's date cache size for date columns in the same way
+        if (cursor->dateCacheSize > 0 && !var->dateCache) {
+            switch (var->transformNum) {
+                case CXO_TRANSFORM_DATE:
+                case CXO_TRANSFORM_DATETIME:
+                case CXO_TRANSFORM_TIMESTAMP:
+                    if (cxoVar_setDateCacheSize(var,
+                            cursor->dateCacheSize) < 0) {
+                        Py_DECREF(var);
+                        Py_XDECREF(objectType);
+                        return -1;
+                    }
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        // return timestamps with time zones as aware datetimes, if requested;
+        // only those variables are marked so that the others can still be
+        // recycled by the variable pool
+        if (cursor->tzAware && !var->tzAware &&
+                (var->transformNum == CXO_TRANSFORM_TIMESTAMP_TZ ||
+                 var->transformNum == CXO_TRANSFORM_TIMESTAMP_LTZ)) {
+            var->tzAware = 1;
+            cxoVar_resolveGetValueFunc(var);
+        }
+
         // add the variable to the fetch variables and perform define
         Py_XDECREF(objectType);
         PyList_SET_ITEM(cursor->fetchVariables, pos - 1, (PyObject *) var);
@@ -281,6 +902,11 @@ static int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns)
 
     }
 
+    // create the template used for creating rows, if applicable
+    Py_CLEAR(cursor->rowTemplate);
+    if (cursor->rowMode != CXO_ROW_MODE_TUPLE)
+        return cxoCursor_createRowTemplate(cursor, numQueryColumns);
+
     return 0;
 }
 
@@ -294,7 +920,7 @@ static int cxoCursor_verifyFetch(cxoCursor *cursor)
     uint32_t numQueryColumns;
 
     // make sure the cursor is open
-    if (cxoCursor_isOpen(cursor) < 0)
+    if (cxoCursor_isOpenForFetch(cursor) < 0)
         return -1;
 
     // fixup REF cursor, if applicable
@@ -422,6 +1048,67 @@ static PyObject *cxoCursor_itemDescription(cxoCursor *cursor, uint32_t pos)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_getArraySize()
+//   Return the number of rows fetched and buffered by internal calls to the
+// database. When the array size is determined automatically, this is the
+// number of rows allocated for the most recent query.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_getArraySize(cxoCursor *cursor, void *unused)
+{
+    return PyLong_FromUnsignedLong(cursor->arraySize);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_getBackgroundFetch()
+//   Return whether rows are fetched in the background or not.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_getBackgroundFetch(cxoCursor *cursor, void *unused)
+{
+    if (cursor->backgroundFetch)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_getCollectStats()
+//   Return whether statistics are being gathered for the cursor or not.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_getCollectStats(cxoCursor *cursor, void *unused)
+{
+    if (cursor->collectStats)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_getFetchLobs()
+//   Return whether LOB columns are fetched as LOB objects or not.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_getFetchLobs(cxoCursor *cursor, void *unused)
+{
+    if (cursor->fetchLobs)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_getTzAware()
+//   Return whether timestamps with time zones are fetched as aware datetimes
+// or not.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_getTzAware(cxoCursor *cursor, void *unused)
+{
+    if (cursor->tzAware)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_getDescription()
 //   Return a list of 7-tuples consisting of the description of the define
@@ -545,8 +1232,17 @@ static PyObject *cxoCursor_close(cxoCursor *cursor, PyObject *args)
 {
     if (cxoCursor_isOpen(cursor) < 0)
         return NULL;
+    if (cursor->fetchWorker) {
+        cxoWorker_free(cursor->fetchWorker);
+        PyMem_Free(cursor->fetchWorker);
+        cursor->fetchWorker = NULL;
+    }
+    cursor->prefetchDefined = 0;
     Py_CLEAR(cursor->bindVariables);
     Py_CLEAR(cursor->fetchVariables);
+    Py_CLEAR(cursor->prefetchVariables);
+    Py_CLEAR(cursor->varPool);
+    Py_CLEAR(cursor->rowTemplate);
     if (cursor->handle) {
         if (dpiStmt_close(cursor->handle, NULL, 0) < 0)
             return cxoError_raiseAndReturnNull();
@@ -756,6 +1452,197 @@ int cxoCursor_setBindVariables(cxoCursor *cursor, PyObject *parameters,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_setBindVariableColumn()
+//   Helper for setting a bind variable from a column of values (a list or
+// tuple as returned by PySequence_Fast()). The column is scanned once in order
+// to determine the type and size of the variable required; the values are
+// then set in a single pass.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setBindVariableColumn(cxoCursor *cursor,
+        uint32_t numRows, PyObject *values, cxoVar *origVar, cxoVar **newVar)
+{
+    PyObject *value, *firstValue = NULL;
+    uint32_t i, size, maxSize = 0;
+    cxoVar *varToSet;
+
+    // initialization
+    *newVar = NULL;
+
+    // determine the first value that is not None (which determines the type
+    // of the variable) and the size of the largest string or bytes value
+    for (i = 0; i < numRows; i++) {
+        value = PySequence_Fast_GET_ITEM(values, i);
+        if (value == Py_None)
+            continue;
+        if (!firstValue) {
+            if (cxoVar_check(value)) {
+                cxoError_raiseFromString(cxoInterfaceErrorException,
+                        "variables cannot be bound with columnar data");
+                return -1;
+            }
+            firstValue = value;
+        }
+        if (PyUnicode_Check(value))
+            size = (uint32_t) PyUnicode_GET_LENGTH(value);
+        else if (PyBytes_Check(value))
+            size = (uint32_t) PyBytes_GET_SIZE(value);
+        else continue;
+        if (size > maxSize)
+            maxSize = size;
+    }
+
+    // handle case where variable is already bound, either from a prior
+    // execution or a call to setinputsizes(); as with setting values by row,
+    // if this fails, the original variable is ignored and a new one created
+    if (origVar) {
+        varToSet = origVar;
+        if (origVar->transformNum == CXO_TRANSFORM_NONE && firstValue) {
+            varToSet = NULL;
+        } else if (numRows > origVar->allocatedElements) {
+            *newVar = cxoVar_new(cursor, numRows, origVar->transformNum,
+                    origVar->size, origVar->isArray, origVar->objectType);
+            if (!*newVar)
+                return -1;
+            varToSet = *newVar;
+        }
+        if (varToSet && cxoVar_setColumnValues(varToSet, values, numRows,
+                maxSize) == 0)
+            return 0;
+        PyErr_Clear();
+        Py_CLEAR(*newVar);
+    }
+
+    // create a new variable using the first value that is not None
+    *newVar = cxoVar_newByValue(cursor, (firstValue) ? firstValue : Py_None,
+            numRows);
+    if (!*newVar)
+        return -1;
+    if (cxoVar_setColumnValues(*newVar, values, numRows, maxSize) < 0) {
+        Py_CLEAR(*newVar);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_setBindVariablesByColumn()
+//   Create or set bind variables from columnar data: either a sequence
+// containing one sequence of values for each bind position or a dictionary
+// containing one sequence of values for each bind name. All of the sequences
+// must be the same length, which is returned as the number of rows.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setBindVariablesByColumn(cxoCursor *cursor,
+        PyObject *parameters, uint32_t *numRows)
+{
+    PyObject *keys = NULL, *columns, *column, *values, *origVar;
+    uint32_t i, numColumns, origNumParams = 0;
+    Py_ssize_t temp;
+    int boundByPos;
+    cxoVar *newVar;
+
+    // get the list of columns and the names (for named binds)
+    boundByPos = !PyDict_Check(parameters);
+    if (boundByPos) {
+        columns = PySequence_Fast(parameters,
+                "expecting a sequence or dictionary of columns");
+    } else {
+        keys = PyDict_Keys(parameters);
+        if (!keys)
+            return -1;
+        columns = PyDict_Values(parameters);
+    }
+    if (!columns) {
+        Py_XDECREF(keys);
+        return -1;
+    }
+    numColumns = (uint32_t) PySequence_Fast_GET_SIZE(columns);
+
+    // make sure positional and named binds are not being intermixed
+    if (cursor->bindVariables) {
+        if (boundByPos != PyList_Check(cursor->bindVariables)) {
+            cxoError_raiseFromString(cxoProgrammingErrorException,
+                    "positional and named binds cannot be intermixed");
+            goto error;
+        }
+        if (boundByPos)
+            origNumParams = (uint32_t) PyList_GET_SIZE(cursor->bindVariables);
+    } else {
+        if (boundByPos)
+            cursor->bindVariables = PyList_New(0);
+        else cursor->bindVariables = PyDict_New();
+        if (!cursor->bindVariables)
+            goto error;
+    }
+
+    // set a variable for each column
+    *numRows = 0;
+    for (i = 0; i < numColumns; i++) {
+        values = PySequence_Fast(PySequence_Fast_GET_ITEM(columns, i),
+                "expecting a sequence of values for each column");
+        if (!values)
+            goto error;
+        temp = PySequence_Fast_GET_SIZE(values);
+        if (i == 0) {
+            *numRows = (uint32_t) temp;
+        } else if (temp != (Py_ssize_t) *numRows) {
+            Py_DECREF(values);
+            cxoError_raiseFromString(cxoProgrammingErrorException,
+                    "all columns must contain the same number of values");
+            goto error;
+        }
+        if (boundByPos) {
+            origVar = (i < origNumParams) ?
+                    PyList_GET_ITEM(cursor->bindVariables, i) : NULL;
+        } else {
+            origVar = PyDict_GetItem(cursor->bindVariables,
+                    PyList_GET_ITEM(keys, i));
+        }
+        if (origVar == Py_None)
+            origVar = NULL;
+        if (cxoCursor_setBindVariableColumn(cursor, *numRows, values,
+                (cxoVar*) origVar, &newVar) < 0) {
+            Py_DECREF(values);
+            goto error;
+        }
+        Py_DECREF(values);
+        if (!newVar)
+            continue;
+        if (!boundByPos) {
+            column = PyList_GET_ITEM(keys, i);
+            if (PyDict_SetItem(cursor->bindVariables, column,
+                    (PyObject*) newVar) < 0) {
+                Py_DECREF(newVar);
+                goto error;
+            }
+            Py_DECREF(newVar);
+        } else if (i < (uint32_t) PyList_GET_SIZE(cursor->bindVariables)) {
+            if (PyList_SetItem(cursor->bindVariables, i,
+                    (PyObject*) newVar) < 0)
+                goto error;
+        } else {
+            if (PyList_Append(cursor->bindVariables,
+                    (PyObject*) newVar) < 0) {
+                Py_DECREF(newVar);
+                goto error;
+            }
+            Py_DECREF(newVar);
+        }
+    }
+
+    Py_DECREF(columns);
+    Py_XDECREF(keys);
+    return 0;
+
+error:
+    Py_DECREF(columns);
+    Py_XDECREF(keys);
+    return -1;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_performBind()
 //   Perform the binds on the cursor.
@@ -792,7 +1679,56 @@ int cxoCursor_performBind(cxoCursor *cursor)
         }
     }
 
-    return 0;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_addRowTime()
+//   Add the time spent creating a row to the statistics of the cursor and its
+// connection. The stats handler is not called for each row since that would
+// add significant overhead.
+//-----------------------------------------------------------------------------
+static void cxoCursor_addRowTime(cxoCursor *cursor, double elapsed)
+{
+    cursor->stats.rowTime += elapsed;
+    cursor->connection->stats.rowTime += elapsed;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_createRowDict()
+//   Create a dictionary for the row, using the column names stored in the row
+// template as the keys.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_createRowDict(cxoCursor *cursor, uint32_t pos)
+{
+    PyObject *dict, *item;
+    Py_ssize_t numItems, i;
+    cxoVar *var;
+    int status;
+
+    dict = PyDict_New();
+    if (!dict)
+        return NULL;
+    numItems = PyList_GET_SIZE(cursor->fetchVariables);
+    for (i = 0; i < numItems; i++) {
+        var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+        item = (*var->getValueFunc)(var, &var->data[pos]);
+        if (!item) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+        status = PyDict_SetItem(dict, PyTuple_GET_ITEM(cursor->rowTemplate, i),
+                item);
+        Py_DECREF(item);
+        if (status < 0) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+    }
+
+    return dict;
 }
 
 
@@ -801,27 +1737,49 @@ int cxoCursor_performBind(cxoCursor *cursor)
 //   Create an object for the row. The object created is a tuple unless a row
 // factory function has been defined in which case it is the result of the
 // row factory function called with the argument tuple that would otherwise be
-// returned.
+// returned. If no row factory function has been defined and a row mode other
+// than tuples is in use, a dictionary or an instance of the named tuple type
+// is created directly from the fetched values instead.
 //-----------------------------------------------------------------------------
 static PyObject *cxoCursor_createRow(cxoCursor *cursor, uint32_t pos)
 {
     PyObject *tuple, *item, *result;
     Py_ssize_t numItems, i;
+    double startTime = 0;
+    int useRowFactory;
     cxoVar *var;
 
     // bump row count as a new row has been found
     cursor->rowCount++;
+    if (cursor->collectStats)
+        startTime = cxoUtils_getMonotonicTime();
 
-    // create a new tuple
+    // create the row template, if needed; this happens when the row mode is
+    // changed after the query was executed
     numItems = PyList_GET_SIZE(cursor->fetchVariables);
-    tuple = PyTuple_New(numItems);
+    useRowFactory = (cursor->rowFactory && cursor->rowFactory != Py_None);
+    if (!useRowFactory && cursor->rowMode != CXO_ROW_MODE_TUPLE &&
+            !cursor->rowTemplate && cxoCursor_createRowTemplate(cursor,
+            (uint32_t) numItems) < 0)
+        return NULL;
+
+    // create a new tuple (or dictionary or named tuple)
+    if (!useRowFactory && cursor->rowMode == CXO_ROW_MODE_DICT) {
+        tuple = cxoCursor_createRowDict(cursor, pos);
+        numItems = 0;
+    } else if (!useRowFactory && cursor->rowMode == CXO_ROW_MODE_NAMEDTUPLE) {
+        tuple = ((PyTypeObject*) cursor->rowTemplate)->tp_alloc(
+                (PyTypeObject*) cursor->rowTemplate, numItems);
+    } else {
+        tuple = PyTuple_New(numItems);
+    }
     if (!tuple)
         return NULL;
 
     // acquire the value for each item
     for (i = 0; i < numItems; i++) {
         var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
-        item = cxoVar_getSingleValue(var, var->data, pos);
+        item = (*var->getValueFunc)(var, &var->data[pos]);
         if (!item) {
             Py_DECREF(tuple);
             return NULL;
@@ -830,13 +1788,37 @@ static PyObject *cxoCursor_createRow(cxoCursor *cursor, uint32_t pos)
     }
 
     // if a row factory is defined, call it
-    if (cursor->rowFactory && cursor->rowFactory != Py_None) {
+    result = tuple;
+    if (useRowFactory) {
         result = PyObject_CallObject(cursor->rowFactory, tuple);
         Py_DECREF(tuple);
-        return result;
     }
 
-    return tuple;
+    // track the time spent creating the row, if applicable
+    if (cursor->collectStats)
+        cxoCursor_addRowTime(cursor, cxoUtils_getMonotonicTime() - startTime);
+
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_setAutoPrefetchRows()
+//   When the array size is determined automatically and the number of rows to
+// prefetch has not been set explicitly, prefetch the given number of rows
+// during execute. Queries that are executed again prefetch the tuned number of
+// rows fetched by each round trip; new queries prefetch a smaller number since
+// the size of their rows is not yet known.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setAutoPrefetchRows(cxoCursor *cursor, uint32_t numRows)
+{
+    if (!cursor->autoArraySize ||
+            cursor->prefetchRowsSet ||
+            cursor->stmtInfo.statementType != DPI_STMT_TYPE_SELECT)
+        return 0;
+    if (dpiStmt_setPrefetchRows(cursor->handle, numRows) < 0)
+        return cxoError_raiseAndReturnInt();
+    return 0;
 }
 
 
@@ -848,8 +1830,15 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
         PyObject *statementTag)
 {
     cxoBuffer statementBuffer, tagBuffer;
+    double startTime, elapsed;
     int status;
 
+    // any background fetch from a previous execution is no longer required
+    // and neither is any information gathered by a previous load
+    cxoCursor_discardBackgroundFetch(cursor);
+    Py_CLEAR(cursor->batchErrors);
+    Py_CLEAR(cursor->arrayDMLRowCounts);
+
     // make sure we don't get a situation where nothing is to be executed
     if (statement == Py_None && !cursor->statement) {
         cxoError_raiseFromString(cxoProgrammingErrorException,
@@ -860,8 +1849,12 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
     // nothing to do if the statement is identical to the one already stored
     // but go ahead and prepare anyway for create, alter and drop statments
     if (statement == Py_None || statement == cursor->statement) {
-        if (cursor->handle && !cursor->stmtInfo.isDDL)
+        if (cursor->handle && !cursor->stmtInfo.isDDL) {
+            if (cxoCursor_setAutoPrefetchRows(cursor,
+                    cursor->fetchBatchSize) < 0)
+                return -1;
             return 0;
+        }
         statement = cursor->statement;
     }
 
@@ -876,9 +1869,12 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
     cursor->statementTag = statementTag;
 
     // clear fetch and bind variables if applicable
-    Py_CLEAR(cursor->fetchVariables);
+    cxoCursor_recycleVars(cursor, &cursor->fetchVariables);
+    cxoCursor_recycleVars(cursor, &cursor->prefetchVariables);
+    cursor->prefetchDefined = 0;
+    Py_CLEAR(cursor->rowTemplate);
     if (!cursor->setInputSizes)
-        Py_CLEAR(cursor->bindVariables);
+        cxoCursor_recycleVars(cursor, &cursor->bindVariables);
 
     // prepare statement
     if (cxoBuffer_fromObject(&statementBuffer, statement,
@@ -892,15 +1888,23 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
     Py_BEGIN_ALLOW_THREADS
     if (cursor->handle)
         dpiStmt_release(cursor->handle);
+    startTime = cxoUtils_getMonotonicTime();
     status = dpiConn_prepareStmt(cursor->connection->handle,
             cursor->isScrollable, (const char*) statementBuffer.ptr,
             statementBuffer.size, (const char*) tagBuffer.ptr, tagBuffer.size,
             &cursor->handle);
+    elapsed = cxoUtils_getMonotonicTime() - startTime;
     Py_END_ALLOW_THREADS
+    if (status == DPI_SUCCESS)
+        cxoStmtCache_record(cursor->connection, &statementBuffer, &tagBuffer,
+                statement, statementTag, elapsed);
     cxoBuffer_clear(&statementBuffer);
     cxoBuffer_clear(&tagBuffer);
     if (status < 0)
         return cxoError_raiseAndReturnInt();
+    if (cursor->collectStats && cxoStatementStats_record(cursor,
+            CXO_STATEMENT_PHASE_PREPARE, elapsed, 0) < 0)
+        return -1;
 
     // get statement information
     if (dpiStmt_getInfo(cursor->handle, &cursor->stmtInfo) < 0)
@@ -916,7 +1920,10 @@ static int cxoCursor_internalPrepare(cxoCursor *cursor, PyObject *statement,
     if (cursor->prefetchRows != DPI_DEFAULT_PREFETCH_ROWS) {
         if (dpiStmt_setPrefetchRows(cursor->handle, cursor->prefetchRows) < 0)
             return cxoError_raiseAndReturnInt();
-    }
+    } else if (cxoCursor_setAutoPrefetchRows(cursor,
+            (cursor->fetchBatchSize < CXO_AUTO_ARRAY_SIZE_INITIAL) ?
+            cursor->fetchBatchSize : CXO_AUTO_ARRAY_SIZE_INITIAL) < 0)
+        return -1;
 
     // clear row factory, if applicable
     Py_CLEAR(cursor->rowFactory);
@@ -1282,24 +2289,27 @@ static PyObject *cxoCursor_callProc(cxoCursor *cursor, PyObject *args,
 
 
 //-----------------------------------------------------------------------------
-// cxoCursor_execute()
-//   Execute the statement.
+// cxoCursor_prepareExecute()
+//   Prepare the statement for execution and perform the binds. This is the
+// part of execute() that takes place before the statement is executed.
 //-----------------------------------------------------------------------------
-static PyObject *cxoCursor_execute(cxoCursor *cursor, PyObject *args,
+static int cxoCursor_prepareExecute(cxoCursor *cursor, PyObject *args,
         PyObject *keywordArgs)
 {
     PyObject *statement, *executeArgs;
-    uint32_t numQueryColumns, mode;
-    int status;
+    double startTime = 0;
 
     executeArgs = NULL;
     if (!PyArg_ParseTuple(args, "O|O", &statement, &executeArgs))
-        return NULL;
+        return -1;
     if (executeArgs && keywordArgs) {
         if (PyDict_Size(keywordArgs) == 0)
             keywordArgs = NULL;
-        else return cxoError_raiseFromString(cxoInterfaceErrorException,
-                "expecting argument or keyword arguments, not both");
+        else {
+            cxoError_raiseFromString(cxoInterfaceErrorException,
+                    "expecting argument or keyword arguments, not both");
+            return -1;
+        }
     }
     if (keywordArgs)
         executeArgs = keywordArgs;
@@ -1307,33 +2317,49 @@ static PyObject *cxoCursor_execute(cxoCursor *cursor, PyObject *args,
         if (!PyDict_Check(executeArgs) && !PySequence_Check(executeArgs)) {
             PyErr_SetString(PyExc_TypeError,
                     "expecting a dictionary, sequence or keyword args");
-            return NULL;
+            return -1;
         }
     }
 
     // make sure the cursor is open
     if (cxoCursor_isOpen(cursor) < 0)
-        return NULL;
+        return -1;
 
     // prepare the statement, if applicable
     if (cxoCursor_internalPrepare(cursor, statement, NULL) < 0)
-        return NULL;
+        return -1;
 
     // perform binds
+    if (cursor->collectStats)
+        startTime = cxoUtils_getMonotonicTime();
     if (executeArgs && cxoCursor_setBindVariables(cursor, executeArgs, 1, 0,
             0) < 0)
-        return NULL;
+        return -1;
     if (cxoCursor_performBind(cursor) < 0)
-        return NULL;
+        return -1;
+    if (cursor->collectStats && cxoStatementStats_record(cursor,
+            CXO_STATEMENT_PHASE_BIND,
+            cxoUtils_getMonotonicTime() - startTime, 0) < 0)
+        return -1;
+
+    return 0;
+}
 
-    // execute the statement
-    Py_BEGIN_ALLOW_THREADS
-    mode = (cursor->connection->autocommit) ? DPI_MODE_EXEC_COMMIT_ON_SUCCESS :
-            DPI_MODE_EXEC_DEFAULT;
-    status = dpiStmt_execute(cursor->handle, mode, &numQueryColumns);
-    Py_END_ALLOW_THREADS
-    if (status < 0)
-        return cxoError_raiseAndReturnNull();
+
+//-----------------------------------------------------------------------------
+// cxoCursor_completeExecute()
+//   Complete the execution of the statement by recording the time spent
+// executing it, determining the number of rows affected and, for queries,
+// defining the fetch variables. The cursor is returned for queries and None
+// for all other statements.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_completeExecute(cxoCursor *cursor,
+        uint32_t numQueryColumns, double elapsed)
+{
+    // record the time spent executing the statement
+    if (cursor->collectStats && cxoStatementStats_record(cursor,
+            CXO_STATEMENT_PHASE_EXECUTE, elapsed, 0) < 0)
+        return NULL;
 
     // get the count of the rows affected
     if (dpiStmt_getRowCount(cursor->handle, &cursor->rowCount) < 0)
@@ -1343,6 +2369,8 @@ static PyObject *cxoCursor_execute(cxoCursor *cursor, PyObject *args,
     if (numQueryColumns > 0) {
         if (cxoCursor_performDefine(cursor, numQueryColumns) < 0) {
             Py_CLEAR(cursor->fetchVariables);
+            Py_CLEAR(cursor->prefetchVariables);
+            Py_CLEAR(cursor->rowTemplate);
             return NULL;
         }
         Py_INCREF(cursor);
@@ -1354,6 +2382,345 @@ static PyObject *cxoCursor_execute(cxoCursor *cursor, PyObject *args,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_execute()
+//   Execute the statement.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_execute(cxoCursor *cursor, PyObject *args,
+        PyObject *keywordArgs)
+{
+    uint32_t numQueryColumns, mode;
+    double startTime = 0, elapsed = 0;
+    int status;
+
+    // prepare the statement and perform binds
+    if (cxoCursor_prepareExecute(cursor, args, keywordArgs) < 0)
+        return NULL;
+
+    // execute the statement
+    Py_BEGIN_ALLOW_THREADS
+    mode = (cursor->connection->autocommit) ? DPI_MODE_EXEC_COMMIT_ON_SUCCESS :
+            DPI_MODE_EXEC_DEFAULT;
+    if (cursor->collectStats)
+        startTime = cxoUtils_getMonotonicTime();
+    status = dpiStmt_execute(cursor->handle, mode, &numQueryColumns);
+    if (cursor->collectStats)
+        elapsed = cxoUtils_getMonotonicTime() - startTime;
+    Py_END_ALLOW_THREADS
+    if (status < 0)
+        return cxoError_raiseAndReturnNull();
+
+    return cxoCursor_completeExecute(cursor, numQueryColumns, elapsed);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_executeAsyncWorker()
+//   Execute the statement. This is called by a worker thread without the GIL
+// held.
+//-----------------------------------------------------------------------------
+static int cxoCursor_executeAsyncWorker(void *arg)
+{
+    cxoAsyncCall *call = (cxoAsyncCall*) arg;
+    cxoCursor *cursor = (cxoCursor*) call->owner;
+    double startTime;
+    uint32_t mode;
+    int status;
+
+    mode = (cursor->connection->autocommit) ? DPI_MODE_EXEC_COMMIT_ON_SUCCESS :
+            DPI_MODE_EXEC_DEFAULT;
+    startTime = cxoUtils_getMonotonicTime();
+    status = dpiStmt_execute(cursor->handle, mode, &call->numQueryColumns);
+    call->elapsed = cxoUtils_getMonotonicTime() - startTime;
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_executeAsyncComplete()
+//   Complete the asynchronous execution of the statement. The result is the
+// same as the one returned by execute().
+//-----------------------------------------------------------------------------
+static int cxoCursor_executeAsyncComplete(cxoAsyncCall *call, int status,
+        PyObject **result)
+{
+    if (status < 0)
+        return -1;
+    *result = cxoCursor_completeExecute((cxoCursor*) call->owner,
+            call->numQueryColumns, call->elapsed);
+    return (*result) ? 0 : -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_executeAsync()
+//   Execute the statement asynchronously and return an asyncio future which
+// completes with the same result as execute(). The statement is prepared and
+// the binds are performed before this method returns; only the execution of
+// the statement takes place on a worker thread.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_executeAsync(cxoCursor *cursor, PyObject *args,
+        PyObject *keywordArgs)
+{
+    cxoAsyncCall *call;
+    PyObject *future;
+
+    call = cxoAsyncCall_new((PyObject*) cursor, cursor->connection,
+            cursor->connection->threaded, cxoCursor_executeAsyncComplete);
+    if (!call)
+        return NULL;
+    if (cxoCursor_prepareExecute(cursor, args, keywordArgs) < 0) {
+        Py_DECREF(call);
+        return NULL;
+    }
+    if (cxoAsyncCall_start(call, cxoCursor_executeAsyncWorker, 0) < 0) {
+        Py_DECREF(call);
+        return NULL;
+    }
+    future = call->future;
+    Py_INCREF(future);
+    Py_DECREF(call);
+    return future;
+}
+
+
+//-----------------------------------------------------------------------------
+// declaration of arguments used by cxoCursor_executeManyWorker()
+//-----------------------------------------------------------------------------
+typedef struct {
+    dpiStmt *handle;
+    dpiExecMode mode;
+    uint32_t numRows;
+} cxoCursorExecuteManyArgs;
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_executeManyWorker()
+//   Execute the statement for one batch of rows. This is called without the
+// GIL held, possibly on a worker thread.
+//-----------------------------------------------------------------------------
+static int cxoCursor_executeManyWorker(void *arg)
+{
+    cxoCursorExecuteManyArgs *args = (cxoCursorExecuteManyArgs*) arg;
+
+    return dpiStmt_executeMany(args->handle, args->mode, args->numRows);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_waitForBatch()
+//   Wait for the batch being executed by cxoCursor_executeManyInBatches() to
+// complete, if one is being executed, and update the row count.
+//-----------------------------------------------------------------------------
+static int cxoCursor_waitForBatch(cxoWorker *worker,
+        cxoCursorExecuteManyArgs *executeArgs, uint64_t *rowCount,
+        cxoCursor *cursor)
+{
+    uint64_t batchRowCount;
+    int status;
+
+    if (!worker->isStarted)
+        return 0;
+    status = cxoWorker_wait(worker);
+    if (dpiStmt_getRowCount(executeArgs->handle, &batchRowCount) == 0)
+        *rowCount += batchRowCount;
+    cursor->rowCount = *rowCount;
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_cloneBindVariables()
+//   Create a new set of bind variables with the same types as the current set
+// of bind variables, for use by cxoCursor_executeManyInBatches().
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_cloneBindVariables(cxoCursor *cursor)
+{
+    PyObject *clone, *key, *value;
+    Py_ssize_t pos;
+    cxoVar *newVar;
+    int status;
+
+    // if no bind variables have been set, nothing to clone
+    if (!cursor->bindVariables)
+        return NULL;
+
+    // create a list or dictionary of the same size
+    if (PyList_Check(cursor->bindVariables))
+        clone = PyList_New(PyList_GET_SIZE(cursor->bindVariables));
+    else clone = PyDict_New();
+    if (!clone)
+        return NULL;
+
+    // create a variable of the same type for each of the bind variables
+    pos = 0;
+    while (1) {
+        if (PyList_Check(clone)) {
+            if (pos >= PyList_GET_SIZE(clone))
+                break;
+            key = NULL;
+            value = PyList_GET_ITEM(cursor->bindVariables, pos++);
+        } else if (!PyDict_Next(cursor->bindVariables, &pos, &key, &value))
+            break;
+        if (value == Py_None) {
+            Py_INCREF(Py_None);
+            newVar = (cxoVar*) Py_None;
+        } else {
+            newVar = cxoVar_newByVar(cursor, (cxoVar*) value);
+            if (!newVar) {
+                Py_DECREF(clone);
+                return NULL;
+            }
+        }
+        if (key) {
+            status = PyDict_SetItem(clone, key, (PyObject*) newVar);
+            Py_DECREF(newVar);
+            if (status < 0) {
+                Py_DECREF(clone);
+                return NULL;
+            }
+        } else PyList_SET_ITEM(clone, pos - 1, (PyObject*) newVar);
+    }
+
+    return clone;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_executeManyInBatches()
+//   Execute the statement for each of the rows returned by the iterable, in
+// batches of the given size. Two sets of bind variables are used: while one
+// batch is being executed (without the GIL held), the values for the next
+// batch are set in the other set of bind variables. The execution takes place
+// on a worker thread only if the connection was created in threaded mode;
+// otherwise, each batch is executed before the next one is populated. A
+// single worker thread is used for all of the batches: it is started for the
+// first batch, signalled for each subsequent batch and stopped once the last
+// batch has completed.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_executeManyInBatches(cxoCursor *cursor,
+        PyObject *parameters, uint32_t batchSize, dpiExecMode mode)
+{
+    PyObject *iterator, *batch = NULL, *arguments, *bindVariables[2];
+    uint64_t rowCount = 0, batchRowCount;
+    cxoCursorExecuteManyArgs executeArgs;
+    uint32_t i, numRows, batchNum;
+    int status, isExhausted = 0;
+    cxoWorker worker;
+
+    // get an iterator for the parameters
+    iterator = PyObject_GetIter(parameters);
+    if (!iterator)
+        return NULL;
+
+    // initialization; a reference to the statement is retained while work is
+    // being performed on the worker thread
+    cxoWorker_init(&worker);
+    Py_XINCREF(cursor->bindVariables);
+    bindVariables[0] = cursor->bindVariables;
+    bindVariables[1] = NULL;
+    executeArgs.handle = cursor->handle;
+    executeArgs.mode = mode;
+    dpiStmt_addRef(executeArgs.handle);
+    cursor->rowCount = 0;
+
+    for (batchNum = 0; !isExhausted; batchNum++) {
+
+        // acquire the rows for the next batch
+        batch = PyList_New(0);
+        if (!batch)
+            goto error;
+        while (PyList_GET_SIZE(batch) < (Py_ssize_t) batchSize) {
+            arguments = PyIter_Next(iterator);
+            if (!arguments) {
+                if (PyErr_Occurred())
+                    goto error;
+                isExhausted = 1;
+                break;
+            }
+            status = PyList_Append(batch, arguments);
+            Py_DECREF(arguments);
+            if (status < 0)
+                goto error;
+        }
+        numRows = (uint32_t) PyList_GET_SIZE(batch);
+
+        // switch to the set of bind variables not used by the batch that is
+        // currently being executed; the second set is created the first time
+        // it is needed with the same types as the first set
+        if (numRows > 0) {
+            if (batchNum == 1) {
+                bindVariables[1] = cxoCursor_cloneBindVariables(cursor);
+                if (!bindVariables[1] && PyErr_Occurred())
+                    goto error;
+            }
+            Py_XINCREF(bindVariables[batchNum % 2]);
+            Py_XDECREF(cursor->bindVariables);
+            cursor->bindVariables = bindVariables[batchNum % 2];
+        }
+
+        // set the values for each of the rows in the batch
+        for (i = 0; i < numRows; i++) {
+            arguments = PyList_GET_ITEM(batch, i);
+            if (!PyDict_Check(arguments) && !PySequence_Check(arguments)) {
+                cxoError_raiseFromString(cxoInterfaceErrorException,
+                        "expecting an iterable of dictionaries or sequences");
+                goto error;
+            }
+            if (cxoCursor_setBindVariables(cursor, arguments, batchSize, i,
+                    (i < numRows - 1)) < 0)
+                goto error;
+        }
+        Py_CLEAR(batch);
+        if (numRows > 0 && !bindVariables[batchNum % 2]) {
+            Py_XINCREF(cursor->bindVariables);
+            bindVariables[batchNum % 2] = cursor->bindVariables;
+        }
+
+        // wait for the previous batch to complete
+        if (cxoCursor_waitForBatch(&worker, &executeArgs, &rowCount,
+                cursor) < 0)
+            goto error;
+
+        // start execution of this batch
+        if (numRows > 0) {
+            if (cxoCursor_performBind(cursor) < 0)
+                goto error;
+            executeArgs.numRows = numRows;
+            if (cxoWorker_start(&worker, cxoCursor_executeManyWorker,
+                    &executeArgs, cursor->connection->threaded) < 0)
+                goto error;
+        }
+
+    }
+
+    // wait for the last batch to complete
+    if (cxoCursor_waitForBatch(&worker, &executeArgs, &rowCount, cursor) < 0)
+        goto error;
+
+    cxoWorker_free(&worker);
+    dpiStmt_release(executeArgs.handle);
+    Py_XDECREF(bindVariables[0]);
+    Py_XDECREF(bindVariables[1]);
+    Py_DECREF(iterator);
+    Py_RETURN_NONE;
+
+error:
+    if (worker.isStarted) {
+        cxoWorker_free(&worker);
+        if (dpiStmt_getRowCount(executeArgs.handle, &batchRowCount) == 0)
+            cursor->rowCount = rowCount + batchRowCount;
+    }
+    cxoWorker_free(&worker);
+    dpiStmt_release(executeArgs.handle);
+    Py_XDECREF(bindVariables[0]);
+    Py_XDECREF(bindVariables[1]);
+    Py_XDECREF(batch);
+    Py_DECREF(iterator);
+    return NULL;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_executeMany()
 //   Execute the statement many times. The number of times is equivalent to the
@@ -1364,18 +2731,39 @@ static PyObject *cxoCursor_executeMany(cxoCursor *cursor, PyObject *args,
         PyObject *keywordArgs)
 {
     static char *keywordList[] = { "statement", "parameters", "batcherrors",
-            "arraydmlrowcounts", NULL };
-    int arrayDMLRowCountsEnabled = 0, batchErrorsEnabled = 0;
+            "arraydmlrowcounts", "columnar", "batchsize", NULL };
+    int arrayDMLRowCountsEnabled = 0, batchErrorsEnabled = 0, columnar = 0;
     PyObject *arguments, *parameters, *statement;
-    uint32_t mode, i, numRows;
+    uint32_t mode, i, numRows, batchSize = 0;
+    double startTime = 0;
     int status;
 
     // validate parameters
-    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "OO|ii", keywordList,
-            &statement, &parameters, &batchErrorsEnabled,
-            &arrayDMLRowCountsEnabled))
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "OO|iipI",
+            keywordList, &statement, &parameters, &batchErrorsEnabled,
+            &arrayDMLRowCountsEnabled, &columnar, &batchSize))
         return NULL;
-    if (!PyList_Check(parameters) && !PyLong_Check(parameters)) {
+    if (batchSize > 0) {
+        if (columnar || batchErrorsEnabled || arrayDMLRowCountsEnabled)
+            return cxoError_raiseFromString(cxoProgrammingErrorException,
+                    "batchsize cannot be combined with columnar, "
+                    "batcherrors or arraydmlrowcounts");
+        if (PyLong_Check(parameters)) {
+            PyErr_SetString(PyExc_TypeError,
+                    "parameters should be an iterable of "
+                    "sequences/dictionaries when batchsize is specified");
+            return NULL;
+        }
+    } else if (columnar && !PyDict_Check(parameters) &&
+            (!PySequence_Check(parameters) || PyUnicode_Check(parameters) ||
+            PyBytes_Check(parameters))) {
+        PyErr_SetString(PyExc_TypeError,
+                "parameters should be a sequence or dictionary of columns "
+                "when columnar is True");
+        return NULL;
+    }
+    if (batchSize == 0 && !columnar && !PyList_Check(parameters) &&
+            !PyLong_Check(parameters)) {
         PyErr_SetString(PyExc_TypeError,
                 "parameters should be a list of sequences/dictionaries "
                 "or an integer specifying the number of times to execute "
@@ -1399,8 +2787,20 @@ static PyObject *cxoCursor_executeMany(cxoCursor *cursor, PyObject *args,
     if (cxoCursor_internalPrepare(cursor, statement, NULL) < 0)
         return NULL;
 
+    // if a batch size was specified, the rows are bound and executed in
+    // batches
+    if (batchSize > 0)
+        return cxoCursor_executeManyInBatches(cursor, parameters, batchSize,
+                mode);
+
     // perform binds, as required
-    if (PyLong_Check(parameters))
+    if (cursor->collectStats)
+        startTime = cxoUtils_getMonotonicTime();
+    if (columnar) {
+        if (cxoCursor_setBindVariablesByColumn(cursor, parameters,
+                &numRows) < 0)
+            return NULL;
+    } else if (PyLong_Check(parameters))
         numRows = (uint32_t) PyLong_AsLong(parameters);
     else {
         numRows = (uint32_t) PyList_GET_SIZE(parameters);
@@ -1416,11 +2816,17 @@ static PyObject *cxoCursor_executeMany(cxoCursor *cursor, PyObject *args,
     }
     if (cxoCursor_performBind(cursor) < 0)
         return NULL;
+    if (cursor->collectStats && cxoStatementStats_record(cursor,
+            CXO_STATEMENT_PHASE_BIND,
+            cxoUtils_getMonotonicTime() - startTime, 0) < 0)
+        return NULL;
 
     // execute the statement, but only if the number of rows is greater than
     // zero since Oracle raises an error otherwise
     if (numRows > 0) {
         Py_BEGIN_ALLOW_THREADS
+        if (cursor->collectStats)
+            startTime = cxoUtils_getMonotonicTime();
         status = dpiStmt_executeMany(cursor->handle, mode, numRows);
         Py_END_ALLOW_THREADS
         if (status < 0) {
@@ -1428,11 +2834,138 @@ static PyObject *cxoCursor_executeMany(cxoCursor *cursor, PyObject *args,
             dpiStmt_getRowCount(cursor->handle, &cursor->rowCount);
             return NULL;
         }
-        if (dpiStmt_getRowCount(cursor->handle, &cursor->rowCount) < 0)
-            return cxoError_raiseAndReturnNull();
+        if (cursor->collectStats && cxoStatementStats_record(cursor,
+                CXO_STATEMENT_PHASE_EXECUTE,
+                cxoUtils_getMonotonicTime() - startTime, 0) < 0)
+            return NULL;
+        if (dpiStmt_getRowCount(cursor->handle, &cursor->rowCount) < 0)
+            return cxoError_raiseAndReturnNull();
+    }
+
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_loadChunk()
+//   Process a chunk of the data being loaded by cxoCursor_load(). Strings are
+// processed encoded in UTF-8; anything else must support the buffer protocol.
+// Returns 1 if the chunk is empty.
+//-----------------------------------------------------------------------------
+static int cxoCursor_loadChunk(cxoLoad *load, PyObject *chunk)
+{
+    Py_buffer buffer;
+    const char *ptr;
+    Py_ssize_t size;
+    int status;
+
+    if (PyUnicode_Check(chunk)) {
+        ptr = PyUnicode_AsUTF8AndSize(chunk, &size);
+        if (!ptr)
+            return -1;
+        if (size == 0)
+            return 1;
+        return cxoLoad_processData(load, ptr, (size_t) size);
+    }
+    if (PyObject_GetBuffer(chunk, &buffer, PyBUF_SIMPLE) < 0)
+        return -1;
+    status = (buffer.len == 0) ? 1 :
+            cxoLoad_processData(load, buffer.buf, (size_t) buffer.len);
+    PyBuffer_Release(&buffer);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_load()
+//   Execute the statement once for each record found in the delimited text
+// supplied by the source, which is a string, a bytes-like object or an object
+// with a read() method. The fields of each record are parsed directly into
+// the bind variables and the statement is executed in batches. The number of
+// records loaded is returned.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_load(cxoCursor *cursor, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "statement", "source", "types",
+            "batchsize", "header", "delimiter", "batcherrors",
+            "arraydmlrowcounts", NULL };
+    int arrayDMLRowCountsEnabled = 0, batchErrorsEnabled = 0, header = 0;
+    PyObject *statement, *source, *types, *chunk;
+    const char *delimiter = ",";
+    uint32_t batchSize = 1000;
+    dpiExecMode mode;
+    cxoLoad load;
+    int status;
+
+    // parse arguments
+    types = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "OO|OIpspp",
+            keywordList, &statement, &source, &types, &batchSize, &header,
+            &delimiter, &batchErrorsEnabled, &arrayDMLRowCountsEnabled))
+        return NULL;
+    if (batchSize == 0)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "batch size must be greater than zero");
+    if (strlen(delimiter) != 1 || delimiter[0] == '"' ||
+            delimiter[0] == '\n' || delimiter[0] == '\r')
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "delimiter must be a single character other than a double "
+                "quote or line break");
+
+    // make sure the cursor is open
+    if (cxoCursor_isOpen(cursor) < 0)
+        return NULL;
+
+    // determine execution mode
+    mode = (cursor->connection->autocommit) ? DPI_MODE_EXEC_COMMIT_ON_SUCCESS :
+            DPI_MODE_EXEC_DEFAULT;
+    if (batchErrorsEnabled)
+        mode |= DPI_MODE_EXEC_BATCH_ERRORS;
+    if (arrayDMLRowCountsEnabled)
+        mode |= DPI_MODE_EXEC_ARRAY_DML_ROWCOUNTS;
+
+    // prepare the statement and the load
+    if (cxoCursor_internalPrepare(cursor, statement, NULL) < 0)
+        return NULL;
+    cursor->rowCount = 0;
+    if (cxoLoad_init(&load, cursor, types, batchSize, delimiter[0], header,
+            mode) < 0) {
+        cxoLoad_clear(&load);
+        return NULL;
+    }
+
+    // process the data in the source; a string or bytes-like object is
+    // processed all at once, otherwise the data is read in chunks until an
+    // empty chunk is returned
+    if (PyUnicode_Check(source) || PyObject_CheckBuffer(source)) {
+        status = cxoCursor_loadChunk(&load, source);
+    } else {
+        while (1) {
+            chunk = PyObject_CallMethod(source, "read", "i",
+                    CXO_LOAD_READ_SIZE);
+            if (!chunk) {
+                status = -1;
+                break;
+            }
+            status = cxoCursor_loadChunk(&load, chunk);
+            Py_DECREF(chunk);
+            if (status != 0)
+                break;
+        }
     }
+    if (status >= 0)
+        status = cxoLoad_finalize(&load);
+
+    // retain the batch errors and row counts gathered, if applicable
+    cursor->batchErrors = load.batchErrors;
+    cursor->arrayDMLRowCounts = load.arrayDMLRowCounts;
+    load.batchErrors = load.arrayDMLRowCounts = NULL;
+    cxoLoad_clear(&load);
+    if (status < 0)
+        return NULL;
 
-    Py_RETURN_NONE;
+    return PyLong_FromUnsignedLongLong(load.numRowsExecuted);
 }
 
 
@@ -1454,6 +2987,7 @@ static PyObject *cxoCursor_executeManyPrepared(cxoCursor *cursor,
     // make sure the cursor is open
     if (cxoCursor_isOpen(cursor) < 0)
         return NULL;
+    cxoCursor_discardBackgroundFetch(cursor);
 
     // perform binds
     if (cxoCursor_performBind(cursor) < 0)
@@ -1557,6 +3091,147 @@ static PyObject *cxoCursor_fetchMany(cxoCursor *cursor, PyObject *args,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_fetchAsyncWorker()
+//   Fetch the next batch of rows into the fetch buffer. This is called by a
+// worker thread without the GIL held.
+//-----------------------------------------------------------------------------
+static int cxoCursor_fetchAsyncWorker(void *arg)
+{
+    cxoAsyncCall *call = (cxoAsyncCall*) arg;
+    cxoCursor *cursor = (cxoCursor*) call->owner;
+    double startTime;
+    int status;
+
+    startTime = cxoUtils_getMonotonicTime();
+    status = dpiStmt_fetchRows(cursor->handle, cursor->fetchArraySize,
+            &cursor->fetchBufferRowIndex, &cursor->numRowsInFetchBuffer,
+            &cursor->moreRowsToFetch);
+    cursor->fetchRoundTripTime = cxoUtils_getMonotonicTime() - startTime;
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_fetchManyAsyncRows()
+//   Add rows from the fetch buffer to the list of rows being fetched until
+// the row limit is reached or the fetch buffer is exhausted. In the latter
+// case, if more rows are available, a round trip is started on a worker
+// thread and no result is returned; otherwise, the list of rows is returned.
+//-----------------------------------------------------------------------------
+static int cxoCursor_fetchManyAsyncRows(cxoCursor *cursor,
+        cxoAsyncCall *call, PyObject **result)
+{
+    PyObject *row;
+
+    while (call->numRows == 0 ||
+            PyList_GET_SIZE(call->result) < (Py_ssize_t) call->numRows) {
+        if (cursor->numRowsInFetchBuffer == 0) {
+            if (!cursor->moreRowsToFetch)
+                break;
+            return cxoAsyncCall_start(call, cxoCursor_fetchAsyncWorker, 0);
+        }
+        row = cxoCursor_createRow(cursor, cursor->fetchBufferRowIndex++);
+        cursor->numRowsInFetchBuffer--;
+        if (!row)
+            return -1;
+        if (PyList_Append(call->result, row) < 0) {
+            Py_DECREF(row);
+            return -1;
+        }
+        Py_DECREF(row);
+    }
+
+    Py_INCREF(call->result);
+    *result = call->result;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_fetchManyAsyncComplete()
+//   Complete a round trip made on behalf of fetchmanyasync() and continue
+// adding rows to the list of rows being fetched.
+//-----------------------------------------------------------------------------
+static int cxoCursor_fetchManyAsyncComplete(cxoAsyncCall *call, int status,
+        PyObject **result)
+{
+    cxoCursor *cursor = (cxoCursor*) call->owner;
+
+    if (status < 0)
+        return -1;
+    if (cursor->collectStats && cxoStatementStats_record(cursor,
+            CXO_STATEMENT_PHASE_FETCH, cursor->fetchRoundTripTime,
+            cursor->numRowsInFetchBuffer) < 0)
+        return -1;
+    if (cxoCursor_tuneFetchBatchSize(cursor) < 0)
+        return -1;
+    return cxoCursor_fetchManyAsyncRows(cursor, call, result);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_fetchManyAsync()
+//   Fetch multiple rows from the cursor asynchronously and return an asyncio
+// future which completes with the same result as fetchmany(). Rows already
+// available in the fetch buffer are used first; round trips to the database
+// are made on a worker thread. Background fetching must not be enabled.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_fetchManyAsync(cxoCursor *cursor, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "numRows", NULL };
+    PyObject *future, *result = NULL;
+    cxoAsyncCall *call;
+    int rowLimit;
+
+    // parse arguments -- optional rowlimit expected
+    rowLimit = cursor->arraySize;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|i", keywordList,
+            &rowLimit))
+        return NULL;
+
+    // verify fetch can be performed
+    if (cxoCursor_verifyFetch(cursor) < 0)
+        return NULL;
+    if (cursor->backgroundFetch || cursor->prefetchDefined)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "asynchronous fetching cannot be combined with background "
+                "fetching");
+
+    // create the call object and the list of rows
+    call = cxoAsyncCall_new((PyObject*) cursor, cursor->connection,
+            cursor->connection->threaded, cxoCursor_fetchManyAsyncComplete);
+    if (!call)
+        return NULL;
+    call->numRows = (rowLimit > 0) ? (uint32_t) rowLimit : 0;
+    call->result = PyList_New(0);
+    if (!call->result) {
+        Py_DECREF(call);
+        return NULL;
+    }
+
+    // add the rows that are already available; if no round trip is required
+    // the future is completed immediately
+    if (cxoCursor_fetchManyAsyncRows(cursor, call, &result) < 0) {
+        Py_DECREF(call);
+        return NULL;
+    }
+    if (result) {
+        if (cxoAsyncCall_setResult(call, result) < 0) {
+            Py_DECREF(result);
+            Py_DECREF(call);
+            return NULL;
+        }
+        Py_DECREF(result);
+    }
+    future = call->future;
+    Py_INCREF(future);
+    Py_DECREF(call);
+    return future;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_fetchAll()
 //   Fetch all remaining rows from the cursor.
@@ -1567,6 +3242,204 @@ static PyObject *cxoCursor_fetchAll(cxoCursor *cursor, PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_fetchColumns()
+//   Fetch the remaining rows from the cursor up to the given row limit (if
+// specified) and return them as a list of column objects, one for each column
+// in the query. The values are copied directly from the fetch buffers into the
+// contiguous buffers of the columns without creating Python objects for them.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_fetchColumns(cxoCursor *cursor, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "numRows", NULL };
+    uint32_t i, numColumns, numRows, rowNum, rowLimit;
+    PyObject *columns, *name;
+    dpiQueryInfo queryInfo;
+    cxoColumn *column;
+    cxoVar *var;
+
+    // parse arguments -- optional row limit expected
+    rowLimit = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|I", keywordList,
+            &rowLimit))
+        return NULL;
+
+    // verify fetch can be performed
+    if (cxoCursor_verifyFetch(cursor) < 0)
+        return NULL;
+
+    // create a column object for each of the fetch variables
+    numColumns = (uint32_t) PyList_GET_SIZE(cursor->fetchVariables);
+    columns = PyList_New(numColumns);
+    if (!columns)
+        return NULL;
+    for (i = 0; i < numColumns; i++) {
+        if (dpiStmt_getQueryInfo(cursor->handle, i + 1, &queryInfo) < 0) {
+            Py_DECREF(columns);
+            return cxoError_raiseAndReturnNull();
+        }
+        name = PyUnicode_Decode(queryInfo.name, queryInfo.nameLength,
+                cursor->connection->encodingInfo.encoding, NULL);
+        if (!name) {
+            Py_DECREF(columns);
+            return NULL;
+        }
+        var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+        column = cxoColumn_new(var, name);
+        Py_DECREF(name);
+        if (!column) {
+            Py_DECREF(columns);
+            return NULL;
+        }
+        PyList_SET_ITEM(columns, i, (PyObject*) column);
+    }
+
+    // copy the rows from the fetch buffers, one batch at a time
+    for (rowNum = 0; rowLimit == 0 || rowNum < rowLimit; rowNum += numRows) {
+
+        // if the fetch buffer is empty, perform a fetch if more rows are
+        // available
+        if (cursor->numRowsInFetchBuffer == 0) {
+            if (!cursor->moreRowsToFetch)
+                break;
+            if (cxoCursor_fetchRows(cursor) < 0) {
+                Py_DECREF(columns);
+                return NULL;
+            }
+            if (cursor->numRowsInFetchBuffer == 0)
+                break;
+        }
+
+        // append the rows found in the fetch buffer to each of the columns
+        numRows = cursor->numRowsInFetchBuffer;
+        if (rowLimit > 0 && numRows > rowLimit - rowNum)
+            numRows = rowLimit - rowNum;
+        for (i = 0; i < numColumns; i++) {
+            var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+            column = (cxoColumn*) PyList_GET_ITEM(columns, i);
+            if (cxoColumn_appendRows(column, var, cursor->fetchBufferRowIndex,
+                    numRows) < 0) {
+                Py_DECREF(columns);
+                return NULL;
+            }
+        }
+        cursor->fetchBufferRowIndex += numRows;
+        cursor->numRowsInFetchBuffer -= numRows;
+        cursor->rowCount += numRows;
+
+    }
+
+    // trim the buffers of each of the columns
+    for (i = 0; i < numColumns; i++) {
+        column = (cxoColumn*) PyList_GET_ITEM(columns, i);
+        if (cxoColumn_finalize(column) < 0) {
+            Py_DECREF(columns);
+            return NULL;
+        }
+    }
+
+    return columns;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_export()
+//   Fetch the remaining rows from the cursor up to the given row limit (if
+// specified) and write them to the file in CSV or JSON lines format. The
+// values are formatted directly from the fetch buffers without creating
+// Python objects for them. The number of rows written is returned.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_export(cxoCursor *cursor, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "file", "format", "header", "delimiter",
+            "numRows", NULL };
+    const char *formatStr, *delimiter;
+    uint32_t numRows, rowNum, rowLimit;
+    PyObject *file, *headerObj;
+    cxoExportFormat format;
+    cxoExport export;
+    int header;
+
+    // parse arguments
+    formatStr = "csv";
+    delimiter = ",";
+    headerObj = NULL;
+    rowLimit = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|sOsI",
+            keywordList, &file, &formatStr, &headerObj, &delimiter,
+            &rowLimit))
+        return NULL;
+    if (strcmp(formatStr, "csv") == 0)
+        format = CXO_EXPORT_FORMAT_CSV;
+    else if (strcmp(formatStr, "jsonl") == 0)
+        format = CXO_EXPORT_FORMAT_JSONL;
+    else return cxoError_raiseFromString(cxoProgrammingErrorException,
+            "format must be 'csv' or 'jsonl'");
+    if (strlen(delimiter) != 1 || delimiter[0] == '"' ||
+            delimiter[0] == '\n' || delimiter[0] == '\r')
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "delimiter must be a single character other than a double "
+                "quote or line break");
+    if (cxoUtils_getBooleanValue(headerObj, 1, &header) < 0)
+        return NULL;
+
+    // verify fetch can be performed
+    if (cxoCursor_verifyFetch(cursor) < 0)
+        return NULL;
+
+    // prepare the export; the column names are acquired from the statement so
+    // any background fetch in progress must complete first
+    cxoCursor_waitForBackgroundFetch(cursor);
+    if (cxoExport_init(&export, cursor, file, format, delimiter[0],
+            header) < 0) {
+        cxoExport_clear(&export);
+        return NULL;
+    }
+
+    // write the rows from the fetch buffers, one batch at a time
+    for (rowNum = 0; rowLimit == 0 || rowNum < rowLimit; rowNum += numRows) {
+
+        // if the fetch buffer is empty, perform a fetch if more rows are
+        // available
+        if (cursor->numRowsInFetchBuffer == 0) {
+            if (!cursor->moreRowsToFetch)
+                break;
+            if (cxoCursor_fetchRows(cursor) < 0) {
+                cxoExport_clear(&export);
+                return NULL;
+            }
+            if (cursor->numRowsInFetchBuffer == 0)
+                break;
+        }
+
+        // append the rows found in the fetch buffer to the export
+        numRows = cursor->numRowsInFetchBuffer;
+        if (rowLimit > 0 && numRows > rowLimit - rowNum)
+            numRows = rowLimit - rowNum;
+        if (cxoExport_appendRows(&export, cursor->fetchBufferRowIndex,
+                numRows) < 0) {
+            cxoExport_clear(&export);
+            return NULL;
+        }
+        cursor->fetchBufferRowIndex += numRows;
+        cursor->numRowsInFetchBuffer -= numRows;
+        cursor->rowCount += numRows;
+
+    }
+
+    // write any remaining data to the file
+    if (cxoExport_finalize(&export) < 0) {
+        cxoExport_clear(&export);
+        return NULL;
+    }
+    cxoExport_clear(&export);
+
+    return PyLong_FromUnsignedLongLong(export.numRows);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_fetchRaw()
 //   Perform raw fetch on the cursor; return the actual number of rows fetched.
@@ -1586,6 +3459,10 @@ static PyObject *cxoCursor_fetchRaw(cxoCursor *cursor, PyObject *args,
     if (numRowsToFetch > cursor->fetchArraySize)
         return cxoError_raiseFromString(cxoInterfaceErrorException,
                 "rows to fetch exceeds array size");
+    if (cursor->prefetchDefined)
+        return cxoError_raiseFromString(cxoInterfaceErrorException,
+                "fetchraw() cannot be used once a background fetch has taken "
+                "place for the query");
 
     // perform the fetch
     if (dpiStmt_fetchRows(cursor->handle, numRowsToFetch, &bufferRowIndex,
@@ -1793,11 +3670,12 @@ static PyObject *cxoCursor_var(cxoCursor *cursor, PyObject *args,
 {
     static char *keywordList[] = { "type", "size", "arraysize",
             "inconverter", "outconverter", "typename", "encodingErrors",
-            NULL };
+            "stringcachesize", NULL };
     PyObject *inConverter, *outConverter, *typeNameObj;
     Py_ssize_t encodingErrorsLength;
     cxoTransformNum transformNum;
     const char *encodingErrors;
+    unsigned stringCacheSize;
     cxoObjectType *objType;
     int size, arraySize;
     PyObject *type;
@@ -1805,12 +3683,14 @@ static PyObject *cxoCursor_var(cxoCursor *cursor, PyObject *args,
 
     // parse arguments
     size = 0;
+    stringCacheSize = 0;
     encodingErrors = NULL;
     arraySize = cursor->bindArraySize;
     inConverter = outConverter = typeNameObj = NULL;
-    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|iiOOOz#",
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|iiOOOz#I",
             keywordList, &type, &size, &arraySize, &inConverter, &outConverter,
-            &typeNameObj, &encodingErrors, &encodingErrorsLength))
+            &typeNameObj, &encodingErrors, &encodingErrorsLength,
+            &stringCacheSize))
         return NULL;
 
     // determine the type of variable
@@ -1832,6 +3712,7 @@ static PyObject *cxoCursor_var(cxoCursor *cursor, PyObject *args,
     var->inConverter = inConverter;
     Py_XINCREF(outConverter);
     var->outConverter = outConverter;
+    cxoVar_resolveGetValueFunc(var);
 
     // assign encoding errors, if applicable
     if (encodingErrors) {
@@ -1843,6 +3724,13 @@ static PyObject *cxoCursor_var(cxoCursor *cursor, PyObject *args,
         strcpy((char*) var->encodingErrors, encodingErrors);
     }
 
+    // create the string cache, if applicable
+    if (stringCacheSize > 0 &&
+            cxoVar_setStringCacheSize(var, stringCacheSize) < 0) {
+        Py_DECREF(var);
+        return NULL;
+    }
+
     return (PyObject*) var;
 }
 
@@ -2005,6 +3893,11 @@ static PyObject* cxoCursor_getBatchErrors(cxoCursor *cursor)
     PyObject *result;
     cxoError *error;
 
+    // if the errors were gathered by a load, return them
+    if (cursor->batchErrors)
+        return PyList_GetSlice(cursor->batchErrors, 0,
+                PyList_GET_SIZE(cursor->batchErrors));
+
     // determine the number of errors
     if (dpiStmt_getBatchErrorCount(cursor->handle, &numErrors) < 0)
         return cxoError_raiseAndReturnNull();
@@ -2049,6 +3942,11 @@ static PyObject* cxoCursor_getArrayDMLRowCounts(cxoCursor *cursor)
     uint32_t numRowCounts, i;
     uint64_t *rowCounts;
 
+    // if the row counts were gathered by a load, return them
+    if (cursor->arrayDMLRowCounts)
+        return PyList_GetSlice(cursor->arrayDMLRowCounts, 0,
+                PyList_GET_SIZE(cursor->arrayDMLRowCounts));
+
     // get row counts from DPI
     if (dpiStmt_getRowCounts(cursor->handle, &numRowCounts, &rowCounts) < 0)
         return cxoError_raiseAndReturnNull();
@@ -2120,6 +4018,16 @@ static PyObject *cxoCursor_getImplicitResults(cxoCursor *cursor)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_stats()
+//   Return a snapshot of the statistics gathered for the cursor.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_stats(cxoCursor *cursor, PyObject *args)
+{
+    return cxoStatementStats_toPython(&cursor->stats);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_contextManagerEnter()
 //   Called when the cursor is used as a context manager and simply returns it
@@ -2154,6 +4062,156 @@ static PyObject *cxoCursor_contextManagerExit(cxoCursor *cursor,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoCursor_setArraySize()
+//   Set the number of rows fetched and buffered by internal calls to the
+// database. The string "auto" specifies that the number is to be determined
+// automatically from the size of the rows being fetched and the time taken by
+// each round trip.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setArraySize(cxoCursor* cursor, PyObject *value,
+        void* arg)
+{
+    unsigned long arraySize;
+
+    if (!value) {
+        PyErr_SetString(PyExc_TypeError, "cannot delete arraysize");
+        return -1;
+    }
+    if (PyUnicode_Check(value)) {
+        if (PyUnicode_CompareWithASCIIString(value, "auto") != 0) {
+            PyErr_SetString(PyExc_ValueError,
+                    "arraysize must be an integer or the string 'auto'");
+            return -1;
+        }
+        cursor->autoArraySize = 1;
+        return 0;
+    }
+    arraySize = PyLong_AsUnsignedLong(value);
+    if (PyErr_Occurred())
+        return -1;
+    if (arraySize > UINT32_MAX) {
+        PyErr_SetString(PyExc_OverflowError, "arraysize is too large");
+        return -1;
+    }
+    cursor->arraySize = (uint32_t) arraySize;
+    cursor->autoArraySize = 0;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_setBackgroundFetch()
+//   Set whether rows are fetched in the background or not. Since a native
+// thread is used to perform the fetch, this is only permitted when the
+// connection was created in threaded mode.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setBackgroundFetch(cxoCursor* cursor, PyObject *value,
+        void* arg)
+{
+    int backgroundFetch;
+
+    if (cxoUtils_getBooleanValue(value, 0, &backgroundFetch) < 0)
+        return -1;
+    if (backgroundFetch && !cursor->connection->threaded) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "background fetching requires a threaded connection");
+        return -1;
+    }
+    cursor->backgroundFetch = backgroundFetch;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_setCollectStats()
+//   Set whether statistics are gathered for the cursor or not.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setCollectStats(cxoCursor* cursor, PyObject *value,
+        void* arg)
+{
+    return cxoUtils_getBooleanValue(value, 0, &cursor->collectStats);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_setFetchLobs()
+//   Set whether LOB columns are fetched as LOB objects or not. This takes
+// effect when the next query that is not already defined is executed.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setFetchLobs(cxoCursor* cursor, PyObject *value,
+        void* arg)
+{
+    return cxoUtils_getBooleanValue(value, 1, &cursor->fetchLobs);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_setTzAware()
+//   Set whether timestamps with time zones are fetched as aware datetimes or
+// not. This takes effect when the next query that is not already defined is
+// executed.
+//-----------------------------------------------------------------------------
+static int cxoCursor_setTzAware(cxoCursor* cursor, PyObject *value,
+        void* arg)
+{
+    return cxoUtils_getBooleanValue(value, 0, &cursor->tzAware);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_getRowMode()
+//   Return the name of the type of object used for rows fetched from the
+// cursor.
+//-----------------------------------------------------------------------------
+static PyObject *cxoCursor_getRowMode(cxoCursor *cursor, void *unused)
+{
+    switch (cursor->rowMode) {
+        case CXO_ROW_MODE_DICT:
+            return PyUnicode_FromString("dict");
+        case CXO_ROW_MODE_NAMEDTUPLE:
+            return PyUnicode_FromString("namedtuple");
+        default:
+            break;
+    }
+    return PyUnicode_FromString("tuple");
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoCursor_setRowMode()
+//   Set the type of object used for rows fetched from the cursor. The value
+// None is the same as "tuple".
+//-----------------------------------------------------------------------------
+static int cxoCursor_setRowMode(cxoCursor *cursor, PyObject *value,
+        void *unused)
+{
+    cxoRowMode rowMode;
+
+    if (!value || value == Py_None) {
+        rowMode = CXO_ROW_MODE_TUPLE;
+    } else if (!PyUnicode_Check(value)) {
+        PyErr_SetString(PyExc_TypeError, "expecting a string or None");
+        return -1;
+    } else if (PyUnicode_CompareWithASCIIString(value, "tuple") == 0) {
+        rowMode = CXO_ROW_MODE_TUPLE;
+    } else if (PyUnicode_CompareWithASCIIString(value, "dict") == 0) {
+        rowMode = CXO_ROW_MODE_DICT;
+    } else if (PyUnicode_CompareWithASCIIString(value, "namedtuple") == 0) {
+        rowMode = CXO_ROW_MODE_NAMEDTUPLE;
+    } else {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "row mode must be one of 'tuple', 'dict' or 'namedtuple'");
+        return -1;
+    }
+    if (rowMode != cursor->rowMode) {
+        cursor->rowMode = rowMode;
+        Py_CLEAR(cursor->rowTemplate);
+    }
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoCursor_setPrefetchRows()
 //   Set the number of rows that are prefetched by the Oracle Client library.
@@ -2169,6 +4227,7 @@ static int cxoCursor_setPrefetchRows(cxoCursor* cursor, PyObject *value,
     if (PyErr_Occurred())
         return -1;
     cursor->prefetchRows = (uint32_t) numRows;
+    cursor->prefetchRowsSet = 1;
     if (cursor->handle && dpiStmt_setPrefetchRows(cursor->handle,
             cursor->prefetchRows) < 0)
         return cxoError_raiseAndReturnInt();
@@ -2182,10 +4241,19 @@ static int cxoCursor_setPrefetchRows(cxoCursor* cursor, PyObject *value,
 static PyMethodDef cxoMethods[] = {
     { "execute", (PyCFunction) cxoCursor_execute,
             METH_VARARGS | METH_KEYWORDS },
+    { "executeasync", (PyCFunction) cxoCursor_executeAsync,
+            METH_VARARGS | METH_KEYWORDS },
+    { "export", (PyCFunction) cxoCursor_export,
+            METH_VARARGS | METH_KEYWORDS },
     { "fetchall", (PyCFunction) cxoCursor_fetchAll, METH_NOARGS },
+    { "load", (PyCFunction) cxoCursor_load, METH_VARARGS | METH_KEYWORDS },
+    { "fetchcolumns", (PyCFunction) cxoCursor_fetchColumns,
+              METH_VARARGS | METH_KEYWORDS },
     { "fetchone", (PyCFunction) cxoCursor_fetchOne, METH_NOARGS },
     { "fetchmany", (PyCFunction) cxoCursor_fetchMany,
               METH_VARARGS | METH_KEYWORDS },
+    { "fetchmanyasync", (PyCFunction) cxoCursor_fetchManyAsync,
+              METH_VARARGS | METH_KEYWORDS },
     { "fetchraw", (PyCFunction) cxoCursor_fetchRaw,
               METH_VARARGS | METH_KEYWORDS },
     { "prepare", (PyCFunction) cxoCursor_prepare, METH_VARARGS },
@@ -2211,6 +4279,7 @@ static PyMethodDef cxoMethods[] = {
               METH_NOARGS },
     { "getimplicitresults", (PyCFunction) cxoCursor_getImplicitResults,
               METH_NOARGS },
+    { "stats", (PyCFunction) cxoCursor_stats, METH_NOARGS },
     { "__enter__", (PyCFunction) cxoCursor_contextManagerEnter, METH_NOARGS },
     { "__exit__", (PyCFunction) cxoCursor_contextManagerExit, METH_VARARGS },
     { "_get_oci_attr", (PyCFunction) cxoCursor_getOciAttr,
@@ -2225,7 +4294,6 @@ static PyMethodDef cxoMethods[] = {
 // declaration of members for Python type
 //-----------------------------------------------------------------------------
 static PyMemberDef cxoMembers[] = {
-    { "arraysize", T_UINT, offsetof(cxoCursor, arraySize), 0 },
     { "bindarraysize", T_UINT, offsetof(cxoCursor, bindArraySize), 0 },
     { "rowcount", T_ULONGLONG, offsetof(cxoCursor, rowCount), READONLY },
     { "statement", T_OBJECT, offsetof(cxoCursor, statement), READONLY },
@@ -2238,6 +4306,11 @@ static PyMemberDef cxoMembers[] = {
     { "outputtypehandler", T_OBJECT, offsetof(cxoCursor, outputTypeHandler),
             0 },
     { "scrollable", T_BOOL, offsetof(cxoCursor, isScrollable), 0 },
+    { "stringcachesize", T_UINT, offsetof(cxoCursor, stringCacheSize), 0 },
+    { "datecachesize", T_UINT, offsetof(cxoCursor, dateCacheSize), 0 },
+    { "fetchbytes", T_UINT, offsetof(cxoCursor, fetchBytes), 0 },
+    { "statshandler", T_OBJECT, offsetof(cxoCursor, statsHandler), 0 },
+    { "varpoolsize", T_UINT, offsetof(cxoCursor, varPoolSize), 0 },
     { NULL }
 };
 
@@ -2246,10 +4319,22 @@ static PyMemberDef cxoMembers[] = {
 // declaration of calculated members for Python type
 //-----------------------------------------------------------------------------
 static PyGetSetDef cxoCalcMembers[] = {
+    { "arraysize", (getter) cxoCursor_getArraySize,
+            (setter) cxoCursor_setArraySize, 0, 0 },
+    { "backgroundfetch", (getter) cxoCursor_getBackgroundFetch,
+            (setter) cxoCursor_setBackgroundFetch, 0, 0 },
+    { "collectstats", (getter) cxoCursor_getCollectStats,
+            (setter) cxoCursor_setCollectStats, 0, 0 },
     { "description", (getter) cxoCursor_getDescription, 0, 0, 0 },
+    { "fetchlobs", (getter) cxoCursor_getFetchLobs,
+            (setter) cxoCursor_setFetchLobs, 0, 0 },
     { "lastrowid", (getter) cxoCursor_getLastRowid, 0, 0, 0 },
     { "prefetchrows", (getter) cxoCursor_getPrefetchRows,
             (setter) cxoCursor_setPrefetchRows, 0, 0 },
+    { "rowmode", (getter) cxoCursor_getRowMode,
+            (setter) cxoCursor_setRowMode, 0, 0 },
+    { "tzaware", (getter) cxoCursor_getTzAware,
+            (setter) cxoCursor_setTzAware, 0, 0 },
     { NULL }
 };
 
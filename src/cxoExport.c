@@ -0,0 +1,655 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoExport.c
+//   Defines the routines for writing the rows of a query directly to a file
+// in CSV or JSON lines format (see Cursor.export). The values are formatted
+// directly from the fetch buffers into a write buffer without creating Python
+// objects for them. Text is always written encoded in UTF-8.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+#ifdef _WIN32
+#include <io.h>
+#define cxoExport_writeToFd(fd, ptr, length) \
+        _write(fd, ptr, (unsigned int) (length))
+#else
+#include <unistd.h>
+#define cxoExport_writeToFd(fd, ptr, length) \
+        write(fd, ptr, length)
+#endif
+
+// number of microseconds in one day
+#define CXO_EXPORT_MICROSECONDS_PER_DAY INT64_C(86400000000)
+
+// characters used for writing binary values in hexadecimal
+static const char cxoExportHexDigits[] = "0123456789ABCDEF";
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_reserve()
+//   Ensure that the write buffer has space for the requested number of
+// additional bytes beyond those already in use and return a pointer to the
+// first free byte.
+//-----------------------------------------------------------------------------
+static char *cxoExport_reserve(cxoExport *export, size_t extra)
+{
+    size_t capacity;
+    char *buffer;
+
+    if (export->bufferSize + extra > export->bufferCapacity) {
+        capacity = export->bufferCapacity;
+        while (capacity < export->bufferSize + extra)
+            capacity *= 2;
+        buffer = PyMem_Realloc(export->buffer, capacity);
+        if (!buffer) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        export->buffer = buffer;
+        export->bufferCapacity = capacity;
+    }
+    return export->buffer + export->bufferSize;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendBytes()
+//   Append the bytes to the write buffer as is.
+//-----------------------------------------------------------------------------
+static int cxoExport_appendBytes(cxoExport *export, const char *value,
+        size_t length)
+{
+    char *ptr;
+
+    ptr = cxoExport_reserve(export, length);
+    if (!ptr)
+        return -1;
+    memcpy(ptr, value, length);
+    export->bufferSize += length;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendCsvField()
+//   Append a field in CSV format. The field is enclosed in double quotes only
+// if it contains the delimiter, a double quote or a line break; double quotes
+// within the field are doubled.
+//-----------------------------------------------------------------------------
+static int cxoExport_appendCsvField(cxoExport *export, const char *value,
+        size_t length)
+{
+    size_t i, numQuotes;
+    int needsQuotes;
+    char *ptr;
+
+    // determine if quoting is required
+    for (i = 0, numQuotes = 0, needsQuotes = 0; i < length; i++) {
+        if (value[i] == '"')
+            numQuotes++;
+        else if (value[i] == export->delimiter || value[i] == '\n' ||
+                value[i] == '\r')
+            needsQuotes = 1;
+    }
+    if (!needsQuotes && numQuotes == 0)
+        return cxoExport_appendBytes(export, value, length);
+
+    // write the quoted value
+    ptr = cxoExport_reserve(export, length + numQuotes + 2);
+    if (!ptr)
+        return -1;
+    *ptr++ = '"';
+    for (i = 0; i < length; i++) {
+        if (value[i] == '"')
+            *ptr++ = '"';
+        *ptr++ = value[i];
+    }
+    *ptr++ = '"';
+    export->bufferSize += length + numQuotes + 2;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendJsonString()
+//   Append a string in JSON format. Double quotes, backslashes and control
+// characters are escaped; all other characters are written as is.
+//-----------------------------------------------------------------------------
+static int cxoExport_appendJsonString(cxoExport *export, const char *value,
+        size_t length)
+{
+    unsigned char ch;
+    char *ptr, *start;
+    size_t i;
+
+    // reserve space for the worst case (every character escaped as \u00XX)
+    ptr = start = cxoExport_reserve(export, length * 6 + 2);
+    if (!ptr)
+        return -1;
+    *ptr++ = '"';
+    for (i = 0; i < length; i++) {
+        ch = (unsigned char) value[i];
+        if (ch == '"' || ch == '\\') {
+            *ptr++ = '\\';
+            *ptr++ = (char) ch;
+        } else if (ch == '\n') {
+            *ptr++ = '\\';
+            *ptr++ = 'n';
+        } else if (ch == '\r') {
+            *ptr++ = '\\';
+            *ptr++ = 'r';
+        } else if (ch == '\t') {
+            *ptr++ = '\\';
+            *ptr++ = 't';
+        } else if (ch < 0x20) {
+            *ptr++ = '\\';
+            *ptr++ = 'u';
+            *ptr++ = '0';
+            *ptr++ = '0';
+            *ptr++ = cxoExportHexDigits[ch >> 4];
+            *ptr++ = cxoExportHexDigits[ch & 0x0f];
+        } else {
+            *ptr++ = (char) ch;
+        }
+    }
+    *ptr++ = '"';
+    export->bufferSize += (size_t) (ptr - start);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendField()
+//   Append a field to the write buffer in the format of the export. Text
+// fields are written as strings in JSON; all other fields are written as is.
+//-----------------------------------------------------------------------------
+static int cxoExport_appendField(cxoExport *export, const char *value,
+        size_t length, int isText)
+{
+    if (export->format == CXO_EXPORT_FORMAT_CSV)
+        return cxoExport_appendCsvField(export, value, length);
+    if (isText)
+        return cxoExport_appendJsonString(export, value, length);
+    return cxoExport_appendBytes(export, value, length);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendText()
+//   Append a text value to the write buffer. If the value is not encoded in
+// UTF-8 it is transcoded first.
+//-----------------------------------------------------------------------------
+static int cxoExport_appendText(cxoExport *export, cxoVar *var,
+        const char *value, size_t length, const char *encoding)
+{
+    const char *ptr;
+    PyObject *temp;
+    Py_ssize_t size;
+    int status;
+
+    if (!encoding || strcmp(encoding, "UTF-8") == 0)
+        return cxoExport_appendField(export, value, length, 1);
+    temp = PyUnicode_Decode(value, (Py_ssize_t) length, encoding,
+            var->encodingErrors);
+    if (!temp)
+        return -1;
+    ptr = PyUnicode_AsUTF8AndSize(temp, &size);
+    status = (ptr) ? cxoExport_appendField(export, ptr, (size_t) size, 1) : -1;
+    Py_DECREF(temp);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendBinary()
+//   Append a binary value to the write buffer as a string of hexadecimal
+// digits (the same representation used by the database).
+//-----------------------------------------------------------------------------
+static int cxoExport_appendBinary(cxoExport *export, const char *value,
+        size_t length)
+{
+    int isJson = (export->format == CXO_EXPORT_FORMAT_JSONL);
+    char *ptr;
+    size_t i;
+
+    ptr = cxoExport_reserve(export, length * 2 + 2);
+    if (!ptr)
+        return -1;
+    if (isJson)
+        *ptr++ = '"';
+    for (i = 0; i < length; i++) {
+        *ptr++ = cxoExportHexDigits[((unsigned char) value[i]) >> 4];
+        *ptr++ = cxoExportHexDigits[((unsigned char) value[i]) & 0x0f];
+    }
+    if (isJson)
+        *ptr++ = '"';
+    export->bufferSize += length * 2 + (isJson ? 2 : 0);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendDouble()
+//   Append a floating point value to the write buffer using the shortest
+// representation that round trips (the same one used by repr()). JSON has no
+// representation for infinity or NaN so null is written for them instead.
+//-----------------------------------------------------------------------------
+static int cxoExport_appendDouble(cxoExport *export, double value)
+{
+    char *text;
+    int status;
+
+    if (export->format == CXO_EXPORT_FORMAT_JSONL &&
+            (Py_IS_NAN(value) || Py_IS_INFINITY(value)))
+        return cxoExport_appendBytes(export, "null", 4);
+    text = PyOS_double_to_string(value, 'r', 0, 0, NULL);
+    if (!text)
+        return -1;
+    status = cxoExport_appendField(export, text, strlen(text), 0);
+    PyMem_Free(text);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_formatTimeDelta()
+//   Format an interval in the same way as str() does for a timedelta object.
+// Returns the number of characters written to the buffer.
+//-----------------------------------------------------------------------------
+static int cxoExport_formatTimeDelta(dpiIntervalDS *value, char *buffer,
+        size_t bufferSize)
+{
+    int64_t totalMicroseconds, days, seconds, microseconds;
+    int length;
+
+    totalMicroseconds = value->days * CXO_EXPORT_MICROSECONDS_PER_DAY +
+            ((int64_t) value->hours * 3600 + value->minutes * 60 +
+            value->seconds) * 1000000 + value->fseconds / 1000;
+    days = totalMicroseconds / CXO_EXPORT_MICROSECONDS_PER_DAY;
+    microseconds = totalMicroseconds % CXO_EXPORT_MICROSECONDS_PER_DAY;
+    if (microseconds < 0) {
+        days--;
+        microseconds += CXO_EXPORT_MICROSECONDS_PER_DAY;
+    }
+    seconds = microseconds / 1000000;
+    microseconds %= 1000000;
+    length = 0;
+    if (days != 0)
+        length = snprintf(buffer, bufferSize, "%lld day%s, ", (long long) days,
+                (days == 1 || days == -1) ? "" : "s");
+    length += snprintf(buffer + length, bufferSize - length, "%d:%02d:%02d",
+            (int) (seconds / 3600), (int) ((seconds / 60) % 60),
+            (int) (seconds % 60));
+    if (microseconds != 0)
+        length += snprintf(buffer + length, bufferSize - length, ".%06d",
+                (int) microseconds);
+    return length;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendValue()
+//   Append the value found in the fetch buffer of the variable to the write
+// buffer. Null values are written as empty fields in CSV and null in JSON.
+//-----------------------------------------------------------------------------
+static int cxoExport_appendValue(cxoExport *export, cxoVar *var,
+        dpiData *data)
+{
+    dpiTimestamp *timestamp;
+    uint32_t rowidLength;
+    const char *rowid;
+    char buffer[64];
+    dpiBytes *bytes;
+    int length;
+
+    // null values
+    if (data->isNull) {
+        if (export->format == CXO_EXPORT_FORMAT_JSONL)
+            return cxoExport_appendBytes(export, "null", 4);
+        return 0;
+    }
+
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_FIXED_CHAR:
+        case CXO_TRANSFORM_FIXED_NCHAR:
+        case CXO_TRANSFORM_LONG_STRING:
+        case CXO_TRANSFORM_NSTRING:
+        case CXO_TRANSFORM_STRING:
+            bytes = &data->value.asBytes;
+            return cxoExport_appendText(export, var, bytes->ptr,
+                    bytes->length, bytes->encoding);
+        case CXO_TRANSFORM_ROWID:
+            if (dpiRowid_getStringValue(data->value.asRowid, &rowid,
+                    &rowidLength) < 0)
+                return cxoError_raiseAndReturnInt();
+            return cxoExport_appendField(export, rowid, rowidLength, 1);
+        case CXO_TRANSFORM_DECIMAL:
+        case CXO_TRANSFORM_FLOAT:
+        case CXO_TRANSFORM_INT:
+            bytes = &data->value.asBytes;
+            return cxoExport_appendField(export, bytes->ptr, bytes->length,
+                    0);
+        case CXO_TRANSFORM_NATIVE_INT:
+            length = snprintf(buffer, sizeof(buffer), "%lld",
+                    (long long) data->value.asInt64);
+            return cxoExport_appendField(export, buffer, (size_t) length, 0);
+        case CXO_TRANSFORM_NATIVE_DOUBLE:
+            return cxoExport_appendDouble(export, data->value.asDouble);
+        case CXO_TRANSFORM_NATIVE_FLOAT:
+            return cxoExport_appendDouble(export, data->value.asFloat);
+        case CXO_TRANSFORM_BOOLEAN:
+            if (export->format == CXO_EXPORT_FORMAT_JSONL)
+                return (data->value.asBoolean) ?
+                        cxoExport_appendBytes(export, "true", 4) :
+                        cxoExport_appendBytes(export, "false", 5);
+            return (data->value.asBoolean) ?
+                    cxoExport_appendBytes(export, "True", 4) :
+                    cxoExport_appendBytes(export, "False", 5);
+        case CXO_TRANSFORM_DATE:
+            timestamp = &data->value.asTimestamp;
+            length = snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d",
+                    timestamp->year, timestamp->month, timestamp->day);
+            return cxoExport_appendField(export, buffer, (size_t) length, 1);
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+        case CXO_TRANSFORM_TIMESTAMP_TZ:
+            timestamp = &data->value.asTimestamp;
+            length = snprintf(buffer, sizeof(buffer),
+                    "%04d-%02d-%02d %02d:%02d:%02d", timestamp->year,
+                    timestamp->month, timestamp->day, timestamp->hour,
+                    timestamp->minute, timestamp->second);
+            if (timestamp->fsecond / 1000 != 0)
+                length += snprintf(buffer + length, sizeof(buffer) - length,
+                        ".%06d", (int) (timestamp->fsecond / 1000));
+            return cxoExport_appendField(export, buffer, (size_t) length, 1);
+        case CXO_TRANSFORM_TIMEDELTA:
+            length = cxoExport_formatTimeDelta(&data->value.asIntervalDS,
+                    buffer, sizeof(buffer));
+            return cxoExport_appendField(export, buffer, (size_t) length, 1);
+        case CXO_TRANSFORM_BINARY:
+        case CXO_TRANSFORM_LONG_BINARY:
+            bytes = &data->value.asBytes;
+            return cxoExport_appendBinary(export, bytes->ptr, bytes->length);
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_flush()
+//   Write the contents of the write buffer to the file. When writing to a file
+// descriptor, the GIL is released while the data is written.
+//-----------------------------------------------------------------------------
+static int cxoExport_flush(cxoExport *export)
+{
+    PyObject *data, *result;
+    size_t offset = 0;
+    int errorNum = 0;
+    Py_ssize_t size;
+
+    // nothing to do if the buffer is empty
+    if (export->bufferSize == 0)
+        return 0;
+
+    // write to a file object by calling its write() method
+    if (export->file) {
+        data = PyBytes_FromStringAndSize(export->buffer,
+                (Py_ssize_t) export->bufferSize);
+        if (!data)
+            return -1;
+        result = PyObject_CallMethod(export->file, "write", "O", data);
+        Py_DECREF(data);
+        if (!result)
+            return -1;
+        Py_DECREF(result);
+
+    // write to a file descriptor directly
+    } else {
+        Py_BEGIN_ALLOW_THREADS
+        while (offset < export->bufferSize) {
+            size = cxoExport_writeToFd(export->fd, export->buffer + offset,
+                    export->bufferSize - offset);
+            if (size < 0) {
+                if (errno == EINTR)
+                    continue;
+                errorNum = errno;
+                break;
+            }
+            offset += (size_t) size;
+        }
+        Py_END_ALLOW_THREADS
+        if (errorNum != 0) {
+            errno = errorNum;
+            PyErr_SetFromErrno(PyExc_OSError);
+            return -1;
+        }
+    }
+
+    export->bufferSize = 0;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_init()
+//   Initialize the export for the query columns of the cursor. An exception is
+// raised if the file is not a file descriptor or an object with a write()
+// method or if any of the columns cannot be exported. For CSV, the column
+// names are written as the first line if requested; for JSON lines, the
+// column names are formatted once as the keys of each object.
+//-----------------------------------------------------------------------------
+int cxoExport_init(cxoExport *export, cxoCursor *cursor, PyObject *file,
+        cxoExportFormat format, char delimiter, int header)
+{
+    uint32_t i, numColumns;
+    PyObject *name, *key;
+    dpiQueryInfo queryInfo;
+    size_t savedSize;
+    Py_ssize_t size;
+    char message[120];
+    const char *ptr;
+    cxoVar *var;
+    int status;
+
+    // initialize the export
+    memset(export, 0, sizeof(cxoExport));
+    export->cursor = cursor;
+    export->format = format;
+    export->delimiter = delimiter;
+    if (PyLong_Check(file)) {
+        export->fd = (int) PyLong_AsLong(file);
+        if (PyErr_Occurred())
+            return -1;
+    } else if (PyObject_HasAttrString(file, "write")) {
+        Py_INCREF(file);
+        export->file = file;
+    } else {
+        PyErr_SetString(PyExc_TypeError,
+                "expecting file descriptor or object with a write() method");
+        return -1;
+    }
+    export->bufferCapacity = CXO_EXPORT_BUFFER_SIZE;
+    export->buffer = PyMem_Malloc(export->bufferCapacity);
+    if (!export->buffer) {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    // verify that all of the columns can be exported
+    numColumns = (uint32_t) PyList_GET_SIZE(cursor->fetchVariables);
+    for (i = 0; i < numColumns; i++) {
+        var = (cxoVar*) PyList_GET_ITEM(cursor->fetchVariables, i);
+        if (var->outConverter && var->outConverter != Py_None) {
+            cxoError_raiseFromString(cxoNotSupportedErrorException,
+                    "output converters are not supported when exporting");
+            return -1;
+        }
+        switch (var->transformNum) {
+            case CXO_TRANSFORM_BINARY:
+            case CXO_TRANSFORM_BOOLEAN:
+            case CXO_TRANSFORM_DATE:
+            case CXO_TRANSFORM_DATETIME:
+            case CXO_TRANSFORM_DECIMAL:
+            case CXO_TRANSFORM_FIXED_CHAR:
+            case CXO_TRANSFORM_FIXED_NCHAR:
+            case CXO_TRANSFORM_FLOAT:
+            case CXO_TRANSFORM_INT:
+            case CXO_TRANSFORM_LONG_BINARY:
+            case CXO_TRANSFORM_LONG_STRING:
+            case CXO_TRANSFORM_NATIVE_DOUBLE:
+            case CXO_TRANSFORM_NATIVE_FLOAT:
+            case CXO_TRANSFORM_NATIVE_INT:
+            case CXO_TRANSFORM_NSTRING:
+            case CXO_TRANSFORM_ROWID:
+            case CXO_TRANSFORM_STRING:
+            case CXO_TRANSFORM_TIMEDELTA:
+            case CXO_TRANSFORM_TIMESTAMP:
+            case CXO_TRANSFORM_TIMESTAMP_LTZ:
+            case CXO_TRANSFORM_TIMESTAMP_TZ:
+                break;
+            default:
+                snprintf(message, sizeof(message),
+                        "values of type %s cannot be exported",
+                        var->dbType->name);
+                cxoError_raiseFromString(cxoNotSupportedErrorException,
+                        message);
+                return -1;
+        }
+    }
+
+    // process the column names, if needed
+    if (format == CXO_EXPORT_FORMAT_JSONL) {
+        export->keys = PyList_New(numColumns);
+        if (!export->keys)
+            return -1;
+    } else if (!header) {
+        return 0;
+    }
+    for (i = 0; i < numColumns; i++) {
+        if (dpiStmt_getQueryInfo(cursor->handle, i + 1, &queryInfo) < 0)
+            return cxoError_raiseAndReturnInt();
+        name = PyUnicode_Decode(queryInfo.name, queryInfo.nameLength,
+                cursor->connection->encodingInfo.encoding, NULL);
+        if (!name)
+            return -1;
+        ptr = PyUnicode_AsUTF8AndSize(name, &size);
+        if (!ptr) {
+            Py_DECREF(name);
+            return -1;
+        }
+
+        // for CSV, write the name as a field of the header line
+        if (format == CXO_EXPORT_FORMAT_CSV) {
+            status = (i > 0) ?
+                    cxoExport_appendBytes(export, &delimiter, 1) : 0;
+            if (status == 0)
+                status = cxoExport_appendCsvField(export, ptr, (size_t) size);
+            if (status == 0 && i == numColumns - 1)
+                status = cxoExport_appendBytes(export, "\n", 1);
+            Py_DECREF(name);
+            if (status < 0)
+                return -1;
+            continue;
+        }
+
+        // for JSON lines, retain the formatted key (including the separator
+        // that precedes it); the write buffer is used for formatting it
+        savedSize = export->bufferSize;
+        status = cxoExport_appendBytes(export, (i == 0) ? "{" : ",", 1);
+        if (status == 0)
+            status = cxoExport_appendJsonString(export, ptr, (size_t) size);
+        if (status == 0)
+            status = cxoExport_appendBytes(export, ":", 1);
+        Py_DECREF(name);
+        if (status < 0)
+            return -1;
+        key = PyBytes_FromStringAndSize(export->buffer + savedSize,
+                (Py_ssize_t) (export->bufferSize - savedSize));
+        export->bufferSize = savedSize;
+        if (!key)
+            return -1;
+        PyList_SET_ITEM(export->keys, i, key);
+
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_appendRows()
+//   Append the given rows of the fetch buffer of the cursor to the write
+// buffer. The write buffer is flushed to the file whenever it is full.
+//-----------------------------------------------------------------------------
+int cxoExport_appendRows(cxoExport *export, uint32_t startPos,
+        uint32_t numRows)
+{
+    PyObject *vars = export->cursor->fetchVariables;
+    uint32_t i, rowNum, numColumns;
+    PyObject *key;
+    cxoVar *var;
+
+    numColumns = (uint32_t) PyList_GET_SIZE(vars);
+    for (rowNum = startPos; rowNum < startPos + numRows; rowNum++) {
+        for (i = 0; i < numColumns; i++) {
+            if (export->keys) {
+                key = PyList_GET_ITEM(export->keys, i);
+                if (cxoExport_appendBytes(export, PyBytes_AS_STRING(key),
+                        (size_t) PyBytes_GET_SIZE(key)) < 0)
+                    return -1;
+            } else if (i > 0) {
+                if (cxoExport_appendBytes(export, &export->delimiter, 1) < 0)
+                    return -1;
+            }
+            var = (cxoVar*) PyList_GET_ITEM(vars, i);
+            if (cxoExport_appendValue(export, var, &var->data[rowNum]) < 0)
+                return -1;
+        }
+        if (export->keys && cxoExport_appendBytes(export, "}", 1) < 0)
+            return -1;
+        if (cxoExport_appendBytes(export, "\n", 1) < 0)
+            return -1;
+        export->numRows++;
+        if (export->bufferSize >= CXO_EXPORT_BUFFER_SIZE &&
+                cxoExport_flush(export) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_finalize()
+//   Called once all rows have been appended. Any data remaining in the write
+// buffer is written to the file.
+//-----------------------------------------------------------------------------
+int cxoExport_finalize(cxoExport *export)
+{
+    return cxoExport_flush(export);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoExport_clear()
+//   Free the resources used by the export.
+//-----------------------------------------------------------------------------
+void cxoExport_clear(cxoExport *export)
+{
+    Py_CLEAR(export->file);
+    Py_CLEAR(export->keys);
+    if (export->buffer) {
+        PyMem_Free(export->buffer);
+        export->buffer = NULL;
+    }
+}
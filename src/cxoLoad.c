@@ -0,0 +1,707 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoLoad.c
+//   Defines the routines for loading delimited text directly into the bind
+// variables of a statement which is executed once for each record (see
+// Cursor.load). The fields of each record are parsed directly into the
+// buffers of the bind variables without creating Python objects for them and
+// the statement is executed in batches. The text is expected to be encoded in
+// UTF-8.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_raiseDataError()
+//   Raise a data error for the current record.
+//-----------------------------------------------------------------------------
+static int cxoLoad_raiseDataError(cxoLoad *load, const char *format, ...)
+{
+    char message[200];
+    va_list args;
+    int length;
+
+    length = snprintf(message, sizeof(message), "record %llu: ",
+            (unsigned long long) load->numRecords + 1);
+    va_start(args, format);
+    vsnprintf(message + length, sizeof(message) - length, format, args);
+    va_end(args);
+    cxoError_raiseFromString(cxoDataErrorException, message);
+    return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_parseDigits()
+//   Parse the given number of decimal digits. Returns -1 if any of the
+// characters is not a digit.
+//-----------------------------------------------------------------------------
+static int cxoLoad_parseDigits(const char **ptr, const char *end,
+        uint32_t numDigits, uint32_t *value)
+{
+    uint32_t i;
+
+    *value = 0;
+    for (i = 0; i < numDigits; i++, (*ptr)++) {
+        if (*ptr >= end || **ptr < '0' || **ptr > '9')
+            return -1;
+        *value = *value * 10 + (uint32_t) (**ptr - '0');
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_parseTimestamp()
+//   Parse a timestamp in the form YYYY-MM-DD, optionally followed by a space
+// or the letter T and the time in the form HH:MI:SS, optionally followed by
+// up to nine digits of fractional seconds. This is the form written by
+// Cursor.export() and by the isoformat() method of datetime objects.
+//-----------------------------------------------------------------------------
+static int cxoLoad_parseTimestamp(const char *ptr, size_t length,
+        dpiTimestamp *timestamp)
+{
+    const char *end = ptr + length;
+    uint32_t value, numDigits;
+
+    memset(timestamp, 0, sizeof(dpiTimestamp));
+    if (cxoLoad_parseDigits(&ptr, end, 4, &value) < 0 || ptr >= end ||
+            *ptr++ != '-')
+        return -1;
+    timestamp->year = (int16_t) value;
+    if (cxoLoad_parseDigits(&ptr, end, 2, &value) < 0 || ptr >= end ||
+            *ptr++ != '-')
+        return -1;
+    timestamp->month = (uint8_t) value;
+    if (cxoLoad_parseDigits(&ptr, end, 2, &value) < 0)
+        return -1;
+    timestamp->day = (uint8_t) value;
+    if (ptr == end)
+        return 0;
+    if (*ptr != ' ' && *ptr != 'T')
+        return -1;
+    ptr++;
+    if (cxoLoad_parseDigits(&ptr, end, 2, &value) < 0 || ptr >= end ||
+            *ptr++ != ':')
+        return -1;
+    timestamp->hour = (uint8_t) value;
+    if (cxoLoad_parseDigits(&ptr, end, 2, &value) < 0 || ptr >= end ||
+            *ptr++ != ':')
+        return -1;
+    timestamp->minute = (uint8_t) value;
+    if (cxoLoad_parseDigits(&ptr, end, 2, &value) < 0)
+        return -1;
+    timestamp->second = (uint8_t) value;
+    if (ptr == end)
+        return 0;
+    if (*ptr++ != '.')
+        return -1;
+    for (numDigits = 0; ptr < end && numDigits < 9; numDigits++, ptr++) {
+        if (*ptr < '0' || *ptr > '9')
+            return -1;
+        timestamp->fsecond = timestamp->fsecond * 10 +
+                (uint32_t) (*ptr - '0');
+    }
+    if (numDigits == 0 || ptr != end)
+        return -1;
+    for (; numDigits < 9; numDigits++)
+        timestamp->fsecond *= 10;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_parseHex()
+//   Convert a string of hexadecimal digits to the bytes they represent. The
+// conversion is done in place. Returns -1 if the string is not valid.
+//-----------------------------------------------------------------------------
+static int cxoLoad_parseHex(char *value, size_t length)
+{
+    unsigned char digit, byte;
+    size_t i;
+
+    if (length % 2 != 0)
+        return -1;
+    for (i = 0; i < length; i++) {
+        digit = (unsigned char) value[i];
+        if (digit >= '0' && digit <= '9')
+            digit -= '0';
+        else if (digit >= 'A' && digit <= 'F')
+            digit -= 'A' - 10;
+        else if (digit >= 'a' && digit <= 'f')
+            digit -= 'a' - 10;
+        else return -1;
+        if (i % 2 == 0)
+            byte = (unsigned char) (digit << 4);
+        else value[i / 2] = (char) (byte | digit);
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_setText()
+//   Set a text value in the variable. If the variable does not use UTF-8, the
+// value is transcoded first.
+//-----------------------------------------------------------------------------
+static int cxoLoad_setText(cxoLoad *load, cxoVar *var, uint32_t pos,
+        const char *value, size_t length)
+{
+    uint32_t numCharacters;
+    PyObject *temp, *encoded;
+    const char *encoding;
+    size_t i;
+    int status;
+
+    encoding = load->cursor->connection->encodingInfo.encoding;
+    if (var->transformNum == CXO_TRANSFORM_NSTRING ||
+            var->transformNum == CXO_TRANSFORM_FIXED_NCHAR)
+        encoding = load->cursor->connection->encodingInfo.nencoding;
+    if (strcmp(encoding, "UTF-8") == 0) {
+        for (i = 0, numCharacters = 0; i < length; i++) {
+            if ((value[i] & 0xC0) != 0x80)
+                numCharacters++;
+        }
+        return cxoVar_setFromBytes(var, pos, value, (uint32_t) length,
+                numCharacters);
+    }
+    temp = PyUnicode_Decode(value, (Py_ssize_t) length, "UTF-8", NULL);
+    if (!temp)
+        return -1;
+    numCharacters = (uint32_t) PyUnicode_GET_LENGTH(temp);
+    encoded = PyUnicode_AsEncodedString(temp, encoding, NULL);
+    Py_DECREF(temp);
+    if (!encoded)
+        return -1;
+    status = cxoVar_setFromBytes(var, pos, PyBytes_AS_STRING(encoded),
+            (uint32_t) PyBytes_GET_SIZE(encoded), numCharacters);
+    Py_DECREF(encoded);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_setValue()
+//   Set the value of the variable at the given position from the text of a
+// field. Empty fields are treated as null values.
+//-----------------------------------------------------------------------------
+static int cxoLoad_setValue(cxoLoad *load, cxoVar *var, uint32_t pos,
+        uint32_t fieldNum, char *value, size_t length)
+{
+    dpiData *data = &var->data[pos];
+    double doubleValue;
+    char *end;
+
+    // empty fields are null
+    if (length == 0) {
+        data->isNull = 1;
+        return 0;
+    }
+
+    // set the value in the variable
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_FIXED_CHAR:
+        case CXO_TRANSFORM_FIXED_NCHAR:
+        case CXO_TRANSFORM_LONG_STRING:
+        case CXO_TRANSFORM_NSTRING:
+        case CXO_TRANSFORM_STRING:
+            return cxoLoad_setText(load, var, pos, value, length);
+        case CXO_TRANSFORM_DECIMAL:
+        case CXO_TRANSFORM_FLOAT:
+        case CXO_TRANSFORM_INT:
+            return cxoVar_setFromBytes(var, pos, value, (uint32_t) length,
+                    (uint32_t) length);
+        case CXO_TRANSFORM_BINARY:
+        case CXO_TRANSFORM_LONG_BINARY:
+            if (cxoLoad_parseHex(value, length) < 0)
+                return cxoLoad_raiseDataError(load,
+                        "field %u is not a valid hexadecimal string",
+                        fieldNum + 1);
+            return cxoVar_setFromBytes(var, pos, value,
+                    (uint32_t) (length / 2), (uint32_t) (length / 2));
+        case CXO_TRANSFORM_NATIVE_INT:
+            errno = 0;
+            data->value.asInt64 = (int64_t) strtoll(value, &end, 10);
+            if (errno != 0 || end != value + length)
+                return cxoLoad_raiseDataError(load,
+                        "field %u is not a valid integer", fieldNum + 1);
+            break;
+        case CXO_TRANSFORM_NATIVE_DOUBLE:
+        case CXO_TRANSFORM_NATIVE_FLOAT:
+            doubleValue = PyOS_string_to_double(value, NULL, NULL);
+            if (doubleValue == -1.0 && PyErr_Occurred()) {
+                PyErr_Clear();
+                return cxoLoad_raiseDataError(load,
+                        "field %u is not a valid floating point number",
+                        fieldNum + 1);
+            }
+            if (var->transformNum == CXO_TRANSFORM_NATIVE_FLOAT)
+                data->value.asFloat = (float) doubleValue;
+            else data->value.asDouble = doubleValue;
+            break;
+        case CXO_TRANSFORM_DATE:
+        case CXO_TRANSFORM_DATETIME:
+        case CXO_TRANSFORM_TIMESTAMP:
+        case CXO_TRANSFORM_TIMESTAMP_LTZ:
+            if (cxoLoad_parseTimestamp(value, length,
+                    &data->value.asTimestamp) < 0)
+                return cxoLoad_raiseDataError(load,
+                        "field %u is not a valid date or timestamp",
+                        fieldNum + 1);
+            break;
+        default:
+            break;
+    }
+    data->isNull = 0;
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_executeBatch()
+//   Execute the statement for the records that have been placed in the bind
+// variables. The row count of the cursor is updated and, if requested, the
+// batch errors and array DML row counts are gathered; the offsets of the
+// batch errors are adjusted to be relative to the first record loaded.
+//-----------------------------------------------------------------------------
+static int cxoLoad_executeBatch(cxoLoad *load)
+{
+    cxoCursor *cursor = load->cursor;
+    uint32_t i, numErrors, numRowCounts;
+    uint64_t rowCount, *rowCounts;
+    dpiErrorInfo *errors;
+    PyObject *element;
+    cxoError *error;
+    int status;
+
+    // nothing to do if no records are waiting to be executed
+    if (load->batchRow == 0)
+        return 0;
+
+    // bind the variables and execute the statement
+    Py_INCREF(load->vars);
+    Py_XDECREF(cursor->bindVariables);
+    cursor->bindVariables = load->vars;
+    if (cxoCursor_performBind(cursor) < 0)
+        return -1;
+    Py_BEGIN_ALLOW_THREADS
+    status = dpiStmt_executeMany(cursor->handle, load->mode, load->batchRow);
+    Py_END_ALLOW_THREADS
+    if (status < 0) {
+        cxoError_raiseAndReturnInt();
+        if (dpiStmt_getRowCount(cursor->handle, &rowCount) == 0)
+            cursor->rowCount = load->rowCount + rowCount;
+        return -1;
+    }
+    if (dpiStmt_getRowCount(cursor->handle, &rowCount) < 0)
+        return cxoError_raiseAndReturnInt();
+    load->rowCount += rowCount;
+    cursor->rowCount = load->rowCount;
+
+    // gather the batch errors, if applicable
+    if (load->batchErrors) {
+        if (dpiStmt_getBatchErrorCount(cursor->handle, &numErrors) < 0)
+            return cxoError_raiseAndReturnInt();
+        if (numErrors > 0) {
+            errors = PyMem_Malloc(numErrors * sizeof(dpiErrorInfo));
+            if (!errors) {
+                PyErr_NoMemory();
+                return -1;
+            }
+            if (dpiStmt_getBatchErrors(cursor->handle, numErrors,
+                    errors) < 0) {
+                PyMem_Free(errors);
+                return cxoError_raiseAndReturnInt();
+            }
+            for (i = 0; i < numErrors; i++) {
+                error = cxoError_newFromInfo(&errors[i]);
+                if (!error)
+                    break;
+                error->offset += (unsigned) load->numRowsExecuted;
+                status = PyList_Append(load->batchErrors, (PyObject*) error);
+                Py_DECREF(error);
+                if (status < 0)
+                    break;
+            }
+            PyMem_Free(errors);
+            if (i < numErrors)
+                return -1;
+        }
+    }
+
+    // gather the array DML row counts, if applicable
+    if (load->arrayDMLRowCounts) {
+        if (dpiStmt_getRowCounts(cursor->handle, &numRowCounts,
+                &rowCounts) < 0)
+            return cxoError_raiseAndReturnInt();
+        for (i = 0; i < numRowCounts; i++) {
+            element = PyLong_FromUnsignedLongLong(rowCounts[i]);
+            if (!element)
+                return -1;
+            status = PyList_Append(load->arrayDMLRowCounts, element);
+            Py_DECREF(element);
+            if (status < 0)
+                return -1;
+        }
+    }
+
+    load->numRowsExecuted += load->batchRow;
+    load->batchRow = 0;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_createVars()
+//   Create the bind variables, one for each field in a record, using the
+// types specified or strings if no types were specified. An exception is
+// raised if any of the types cannot be loaded.
+//-----------------------------------------------------------------------------
+static int cxoLoad_createVars(cxoLoad *load, PyObject *types,
+        uint32_t numFields)
+{
+    cxoTransformNum transformNum;
+    cxoObjectType *objType;
+    char message[120];
+    cxoDbType *dbType;
+    uint32_t i;
+    cxoVar *var;
+
+    load->vars = PyList_New(numFields);
+    if (!load->vars)
+        return -1;
+    for (i = 0; i < numFields; i++) {
+        transformNum = CXO_TRANSFORM_STRING;
+        if (types && cxoTransform_getNumFromType(PySequence_Fast_GET_ITEM(
+                types, i), &transformNum, &objType) < 0)
+            return -1;
+        switch (transformNum) {
+            case CXO_TRANSFORM_BINARY:
+            case CXO_TRANSFORM_DATE:
+            case CXO_TRANSFORM_DATETIME:
+            case CXO_TRANSFORM_DECIMAL:
+            case CXO_TRANSFORM_FIXED_CHAR:
+            case CXO_TRANSFORM_FIXED_NCHAR:
+            case CXO_TRANSFORM_FLOAT:
+            case CXO_TRANSFORM_INT:
+            case CXO_TRANSFORM_LONG_BINARY:
+            case CXO_TRANSFORM_LONG_STRING:
+            case CXO_TRANSFORM_NATIVE_DOUBLE:
+            case CXO_TRANSFORM_NATIVE_FLOAT:
+            case CXO_TRANSFORM_NATIVE_INT:
+            case CXO_TRANSFORM_NSTRING:
+            case CXO_TRANSFORM_STRING:
+            case CXO_TRANSFORM_TIMESTAMP:
+            case CXO_TRANSFORM_TIMESTAMP_LTZ:
+                break;
+            default:
+                dbType = cxoDbType_fromTransformNum(transformNum);
+                snprintf(message, sizeof(message),
+                        "values of type %s cannot be loaded",
+                        (dbType) ? dbType->name : "unknown");
+                cxoError_raiseFromString(cxoNotSupportedErrorException,
+                        message);
+                return -1;
+        }
+        var = cxoVar_new(load->cursor, load->batchSize, transformNum, 0, 0,
+                NULL);
+        if (!var)
+            return -1;
+        PyList_SET_ITEM(load->vars, i, (PyObject*) var);
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_endRecord()
+//   Called when the end of a record has been reached. The fields are placed
+// in the bind variables and the batch is executed once it is full. Empty
+// lines and the header line (if one is expected) are skipped.
+//-----------------------------------------------------------------------------
+static int cxoLoad_endRecord(cxoLoad *load)
+{
+    uint32_t i, numFields, numVars;
+    size_t start, end;
+    cxoVar *var;
+
+    // reset the state for the next record
+    numFields = load->numFields;
+    load->numFields = 0;
+    load->state = CXO_LOAD_STATE_FIELD_START;
+
+    // skip empty lines and the header line; a line containing only an empty
+    // quoted field is not empty
+    if (!load->lineHasData) {
+        load->recordSize = 0;
+        return 0;
+    }
+    load->lineHasData = 0;
+    if (load->skipHeader) {
+        load->skipHeader = 0;
+        load->recordSize = 0;
+        return 0;
+    }
+
+    // create the variables, if needed, and verify the number of fields
+    if (!load->vars && cxoLoad_createVars(load, NULL, numFields) < 0)
+        return -1;
+    numVars = (uint32_t) PyList_GET_SIZE(load->vars);
+    if (numFields != numVars)
+        return cxoLoad_raiseDataError(load, "found %u fields, expecting %u",
+                numFields, numVars);
+
+    // set the values of each of the variables; each field is terminated
+    // by a null character in the record buffer
+    for (i = 0; i < numFields; i++) {
+        start = load->fieldStarts[i];
+        end = (i < numFields - 1) ? load->fieldStarts[i + 1] - 1 :
+                load->recordSize - 1;
+        var = (cxoVar*) PyList_GET_ITEM(load->vars, i);
+        if (cxoLoad_setValue(load, var, load->batchRow, i,
+                load->record + start, end - start) < 0)
+            return -1;
+    }
+    load->recordSize = 0;
+    load->numRecords++;
+
+    // execute the batch if it is full
+    if (++load->batchRow == load->batchSize)
+        return cxoLoad_executeBatch(load);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_reserve()
+//   Ensure that the record buffer has space for the requested number of
+// additional bytes.
+//-----------------------------------------------------------------------------
+static int cxoLoad_reserve(cxoLoad *load, size_t extra)
+{
+    size_t capacity;
+    char *record;
+
+    if (load->recordSize + extra <= load->recordCapacity)
+        return 0;
+    capacity = (load->recordCapacity == 0) ? 1024 : load->recordCapacity;
+    while (capacity < load->recordSize + extra)
+        capacity *= 2;
+    record = PyMem_Realloc(load->record, capacity);
+    if (!record) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    load->record = record;
+    load->recordCapacity = capacity;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_startField()
+//   Called when a new field starts. Its offset in the record buffer is
+// retained.
+//-----------------------------------------------------------------------------
+static int cxoLoad_startField(cxoLoad *load)
+{
+    uint32_t capacity;
+    size_t *starts;
+
+    if (load->numFields == load->fieldsCapacity) {
+        capacity = (load->fieldsCapacity == 0) ? 16 :
+                load->fieldsCapacity * 2;
+        starts = PyMem_Realloc(load->fieldStarts, capacity * sizeof(size_t));
+        if (!starts) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        load->fieldStarts = starts;
+        load->fieldsCapacity = capacity;
+    }
+    load->fieldStarts[load->numFields++] = load->recordSize;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_endField()
+//   Called when the end of a field has been reached. The field is terminated
+// by a null character.
+//-----------------------------------------------------------------------------
+static int cxoLoad_endField(cxoLoad *load)
+{
+    if (load->state == CXO_LOAD_STATE_FIELD_START &&
+            cxoLoad_startField(load) < 0)
+        return -1;
+    if (cxoLoad_reserve(load, 1) < 0)
+        return -1;
+    load->record[load->recordSize++] = '\0';
+    load->state = CXO_LOAD_STATE_FIELD_START;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_processData()
+//   Parse the data, which may contain any part of the text being loaded. The
+// state of the parser is retained between calls so that records and fields
+// may span chunks. Fields may be enclosed in double quotes, in which case
+// they may contain the delimiter and line breaks; double quotes within such
+// fields are doubled. Carriage returns outside of quoted fields are ignored.
+//-----------------------------------------------------------------------------
+int cxoLoad_processData(cxoLoad *load, const char *data, size_t length)
+{
+    size_t i, end;
+    char ch;
+
+    for (i = 0; i < length; i++) {
+        ch = data[i];
+        switch (load->state) {
+            case CXO_LOAD_STATE_FIELD_START:
+            case CXO_LOAD_STATE_UNQUOTED:
+            case CXO_LOAD_STATE_QUOTE:
+                if (ch == load->delimiter) {
+                    load->lineHasData = 1;
+                    if (cxoLoad_endField(load) < 0)
+                        return -1;
+                    continue;
+                } else if (ch == '\n') {
+                    if (cxoLoad_endField(load) < 0 ||
+                            cxoLoad_endRecord(load) < 0)
+                        return -1;
+                    continue;
+                } else if (ch == '\r') {
+                    continue;
+                }
+                load->lineHasData = 1;
+                if (load->state == CXO_LOAD_STATE_FIELD_START) {
+                    if (cxoLoad_startField(load) < 0)
+                        return -1;
+                    if (ch == '"') {
+                        load->state = CXO_LOAD_STATE_QUOTED;
+                        continue;
+                    }
+                } else if (load->state == CXO_LOAD_STATE_QUOTE &&
+                        ch == '"') {
+                    load->state = CXO_LOAD_STATE_QUOTED;
+                    break;
+                }
+                load->state = CXO_LOAD_STATE_UNQUOTED;
+                break;
+            case CXO_LOAD_STATE_QUOTED:
+                if (ch == '"') {
+                    load->state = CXO_LOAD_STATE_QUOTE;
+                    continue;
+                }
+                break;
+        }
+
+        // copy the character along with any that follow it in the same field
+        // which do not change the state of the parser
+        end = i + 1;
+        if (load->state == CXO_LOAD_STATE_QUOTED) {
+            while (end < length && data[end] != '"')
+                end++;
+        } else {
+            while (end < length && data[end] != load->delimiter &&
+                    data[end] != '\n' && data[end] != '\r')
+                end++;
+        }
+        if (cxoLoad_reserve(load, end - i) < 0)
+            return -1;
+        memcpy(load->record + load->recordSize, data + i, end - i);
+        load->recordSize += end - i;
+        i = end - 1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_init()
+//   Initialize the load. If types are specified, the bind variables are
+// created immediately; otherwise, they are created as strings once the number
+// of fields in the first record is known.
+//-----------------------------------------------------------------------------
+int cxoLoad_init(cxoLoad *load, cxoCursor *cursor, PyObject *types,
+        uint32_t batchSize, char delimiter, int header, dpiExecMode mode)
+{
+    memset(load, 0, sizeof(cxoLoad));
+    load->cursor = cursor;
+    load->batchSize = batchSize;
+    load->delimiter = delimiter;
+    load->skipHeader = header;
+    load->mode = mode;
+    load->state = CXO_LOAD_STATE_FIELD_START;
+    if (mode & DPI_MODE_EXEC_BATCH_ERRORS) {
+        load->batchErrors = PyList_New(0);
+        if (!load->batchErrors)
+            return -1;
+    }
+    if (mode & DPI_MODE_EXEC_ARRAY_DML_ROWCOUNTS) {
+        load->arrayDMLRowCounts = PyList_New(0);
+        if (!load->arrayDMLRowCounts)
+            return -1;
+    }
+    if (types && types != Py_None) {
+        load->types = PySequence_Fast(types, "expecting sequence of types");
+        if (!load->types)
+            return -1;
+        if (cxoLoad_createVars(load, load->types,
+                (uint32_t) PySequence_Fast_GET_SIZE(load->types)) < 0)
+            return -1;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_finalize()
+//   Called once all of the data has been processed. The last record is
+// completed if it was not terminated by a line break and the final batch is
+// executed.
+//-----------------------------------------------------------------------------
+int cxoLoad_finalize(cxoLoad *load)
+{
+    if (load->state == CXO_LOAD_STATE_QUOTED) {
+        cxoError_raiseFromString(cxoDataErrorException,
+                "unterminated quoted field at end of data");
+        return -1;
+    }
+    if (load->numFields > 0 || load->state != CXO_LOAD_STATE_FIELD_START) {
+        if (cxoLoad_endField(load) < 0 || cxoLoad_endRecord(load) < 0)
+            return -1;
+    }
+    return cxoLoad_executeBatch(load);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLoad_clear()
+//   Free the resources used by the load.
+//-----------------------------------------------------------------------------
+void cxoLoad_clear(cxoLoad *load)
+{
+    Py_CLEAR(load->types);
+    Py_CLEAR(load->vars);
+    Py_CLEAR(load->batchErrors);
+    Py_CLEAR(load->arrayDMLRowCounts);
+    if (load->record) {
+        PyMem_Free(load->record);
+        load->record = NULL;
+    }
+    if (load->fieldStarts) {
+        PyMem_Free(load->fieldStarts);
+        load->fieldStarts = NULL;
+    }
+}
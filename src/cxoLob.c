@@ -53,7 +53,9 @@ static void cxoLob_free(cxoLob *lob)
 
 //-----------------------------------------------------------------------------
 // cxoLob_internalRead()
-//   Return a portion (or all) of the data in the LOB.
+//   Return a portion (or all) of the data in the LOB. Binary data is read
+// directly into the bytes object that is returned in order to avoid an
+// additional copy of the data.
 //-----------------------------------------------------------------------------
 static PyObject *cxoLob_internalRead(cxoLob *lob, uint64_t offset,
         uint64_t amount)
@@ -72,9 +74,31 @@ static PyObject *cxoLob_internalRead(cxoLob *lob, uint64_t offset,
         else amount = 1;
     }
 
-    // create a buffer of the correct size
+    // determine the size of the buffer required
     if (dpiLob_getBufferSize(lob->handle, amount, &bufferSize) < 0)
         return cxoError_raiseAndReturnNull();
+    if (bufferSize > PY_SSIZE_T_MAX)
+        return PyErr_NoMemory();
+
+    // binary data is read directly into the bytes object
+    if (lob->dbType != cxoDbTypeClob && lob->dbType != cxoDbTypeNclob) {
+        result = PyBytes_FromStringAndSize(NULL, (Py_ssize_t) bufferSize);
+        if (!result)
+            return NULL;
+        Py_BEGIN_ALLOW_THREADS
+        status = dpiLob_readBytes(lob->handle, offset, amount,
+                PyBytes_AS_STRING(result), &bufferSize);
+        Py_END_ALLOW_THREADS
+        if (status < 0) {
+            Py_DECREF(result);
+            return cxoError_raiseAndReturnNull();
+        }
+        if (_PyBytes_Resize(&result, (Py_ssize_t) bufferSize) < 0)
+            return NULL;
+        return result;
+    }
+
+    // character data is read into a temporary buffer and decoded
     buffer = (char*) PyMem_Malloc((Py_ssize_t) bufferSize);
     if (!buffer)
         return PyErr_NoMemory();
@@ -93,11 +117,9 @@ static PyObject *cxoLob_internalRead(cxoLob *lob, uint64_t offset,
     if (lob->dbType == cxoDbTypeNclob) {
         result = PyUnicode_Decode(buffer, (Py_ssize_t) bufferSize,
                 lob->connection->encodingInfo.nencoding, NULL);
-    } else if (lob->dbType == cxoDbTypeClob) {
+    } else {
         result = PyUnicode_Decode(buffer, (Py_ssize_t) bufferSize,
                 lob->connection->encodingInfo.encoding, NULL);
-    } else {
-        result = PyBytes_FromStringAndSize(buffer, (Py_ssize_t) bufferSize);
     }
     PyMem_Free(buffer);
     return result;
@@ -179,6 +201,24 @@ static PyObject *cxoLob_close(cxoLob *lob, PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoLob_openStream()
+//   Return a stream which reads the data in the LOB sequentially in chunks.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLob_openStream(cxoLob *lob, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "chunksize", NULL };
+    unsigned int amount;
+
+    amount = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|I", keywordList,
+            &amount))
+        return NULL;
+    return (PyObject*) cxoLobStream_new(lob, (uint32_t) amount);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoLob_read()
 //   Return a portion (or all) of the data in the LOB.
@@ -408,6 +448,8 @@ static PyMethodDef cxoLobMethods[] = {
     { "open", (PyCFunction) cxoLob_open, METH_NOARGS },
     { "close", (PyCFunction) cxoLob_close, METH_NOARGS },
     { "read", (PyCFunction) cxoLob_read, METH_VARARGS | METH_KEYWORDS },
+    { "openstream", (PyCFunction) cxoLob_openStream,
+            METH_VARARGS | METH_KEYWORDS },
     { "write", (PyCFunction) cxoLob_write, METH_VARARGS | METH_KEYWORDS },
     { "trim", (PyCFunction) cxoLob_trim, METH_VARARGS | METH_KEYWORDS },
     { "getchunksize", (PyCFunction) cxoLob_getChunkSize, METH_NOARGS },
@@ -0,0 +1,424 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoLobStream.c
+//   Defines the routines for reading LOB values sequentially in chunks (see
+// LOB.openstream). Only one chunk of the LOB is resident in memory at a time
+// and it can be read directly into a buffer supplied by the caller.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+// number of LOB chunks read at a time by default
+#define CXO_LOB_STREAM_DEFAULT_CHUNKS   16
+
+// number of bytes read at a time by default from BFILEs (which do not have a
+// chunk size)
+#define CXO_LOB_STREAM_DEFAULT_FILE_BYTES 131072
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_new()
+//   Create a new LOB stream. The size of the LOB is determined when the stream
+// is created. The amount read by each iteration is a multiple of the chunk
+// size of the LOB; if none is specified, a default multiple is used.
+//-----------------------------------------------------------------------------
+cxoLobStream *cxoLobStream_new(cxoLob *lob, uint32_t amount)
+{
+    cxoLobStream *stream;
+    uint32_t chunkSize;
+    uint64_t size;
+
+    // determine the size of the LOB and the amount read by each iteration
+    if (dpiLob_getSize(lob->handle, &size) < 0)
+        return (cxoLobStream*) cxoError_raiseAndReturnNull();
+    if (lob->dbType == cxoDbTypeBfile) {
+        if (amount == 0)
+            amount = CXO_LOB_STREAM_DEFAULT_FILE_BYTES;
+    } else {
+        if (dpiLob_getChunkSize(lob->handle, &chunkSize) < 0)
+            return (cxoLobStream*) cxoError_raiseAndReturnNull();
+        if (chunkSize == 0)
+            chunkSize = 1;
+        if (amount == 0)
+            amount = chunkSize * CXO_LOB_STREAM_DEFAULT_CHUNKS;
+        else if (amount % chunkSize != 0)
+            amount += chunkSize - amount % chunkSize;
+    }
+
+    // create the stream
+    stream = (cxoLobStream*)
+            cxoPyTypeLobStream.tp_alloc(&cxoPyTypeLobStream, 0);
+    if (!stream)
+        return NULL;
+    Py_INCREF(lob);
+    stream->lob = lob;
+    stream->offset = 1;
+    stream->size = size;
+    stream->amount = amount;
+    return stream;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_free()
+//   Free the LOB stream.
+//-----------------------------------------------------------------------------
+static void cxoLobStream_free(cxoLobStream *stream)
+{
+    if (stream->buffer) {
+        PyMem_Free(stream->buffer);
+        stream->buffer = NULL;
+    }
+    Py_CLEAR(stream->lob);
+    Py_TYPE(stream)->tp_free((PyObject*) stream);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_isOpen()
+//   Verify that the stream has not been closed.
+//-----------------------------------------------------------------------------
+static int cxoLobStream_isOpen(cxoLobStream *stream)
+{
+    if (stream->isClosed) {
+        PyErr_SetString(PyExc_ValueError, "I/O operation on closed stream");
+        return -1;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_isCharacterData()
+//   Return whether the LOB contains character data or not. The amount read
+// from such LOBs is in characters instead of bytes.
+//-----------------------------------------------------------------------------
+static int cxoLobStream_isCharacterData(cxoLobStream *stream)
+{
+    return (stream->lob->dbType == cxoDbTypeClob ||
+            stream->lob->dbType == cxoDbTypeNclob);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_internalRead()
+//   Read the given amount of data from the current offset into the buffer and
+// advance the offset. The amount must not exceed the amount remaining.
+//-----------------------------------------------------------------------------
+static int cxoLobStream_internalRead(cxoLobStream *stream, uint64_t amount,
+        char *buffer, uint64_t *bufferSize)
+{
+    int status;
+
+    Py_BEGIN_ALLOW_THREADS
+    status = dpiLob_readBytes(stream->lob->handle, stream->offset, amount,
+            buffer, bufferSize);
+    Py_END_ALLOW_THREADS
+    if (status < 0)
+        return cxoError_raiseAndReturnInt();
+    stream->offset += amount;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_readValue()
+//   Read up to the given amount of data and return it as a bytes object (for
+// BLOBs and BFILEs) or as a string (for CLOBs and NCLOBs). Binary data is read
+// directly into the bytes object that is returned. Character data is read into
+// a buffer retained by the stream, which is reused for subsequent reads, and
+// decoded from there.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_readValue(cxoLobStream *stream, uint64_t amount)
+{
+    const char *encoding;
+    uint64_t bufferSize;
+    PyObject *result;
+
+    // limit the amount to the amount remaining
+    if (stream->offset > stream->size)
+        amount = 0;
+    else if (amount > stream->size - stream->offset + 1)
+        amount = stream->size - stream->offset + 1;
+    if (dpiLob_getBufferSize(stream->lob->handle, amount, &bufferSize) < 0)
+        return cxoError_raiseAndReturnNull();
+    if (bufferSize > PY_SSIZE_T_MAX)
+        return PyErr_NoMemory();
+
+    // binary data is read directly into the bytes object
+    if (!cxoLobStream_isCharacterData(stream)) {
+        result = PyBytes_FromStringAndSize(NULL, (Py_ssize_t) bufferSize);
+        if (!result || amount == 0)
+            return result;
+        if (cxoLobStream_internalRead(stream, amount,
+                PyBytes_AS_STRING(result), &bufferSize) < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        if (_PyBytes_Resize(&result, (Py_ssize_t) bufferSize) < 0)
+            return NULL;
+        return result;
+    }
+
+    // character data is read into the buffer retained by the stream
+    if (stream->lob->dbType == cxoDbTypeNclob)
+        encoding = stream->lob->connection->encodingInfo.nencoding;
+    else encoding = stream->lob->connection->encodingInfo.encoding;
+    if (amount == 0)
+        return PyUnicode_New(0, 0);
+    if (bufferSize > stream->bufferSize) {
+        if (stream->buffer)
+            PyMem_Free(stream->buffer);
+        stream->bufferSize = 0;
+        stream->buffer = PyMem_Malloc((size_t) bufferSize);
+        if (!stream->buffer)
+            return PyErr_NoMemory();
+        stream->bufferSize = bufferSize;
+    }
+    if (cxoLobStream_internalRead(stream, amount, stream->buffer,
+            &bufferSize) < 0)
+        return NULL;
+    return PyUnicode_Decode(stream->buffer, (Py_ssize_t) bufferSize, encoding,
+            NULL);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_close()
+//   Close the stream and release the buffer it retains. The LOB itself is not
+// affected.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_close(cxoLobStream *stream, PyObject *args)
+{
+    if (stream->buffer) {
+        PyMem_Free(stream->buffer);
+        stream->buffer = NULL;
+        stream->bufferSize = 0;
+    }
+    stream->isClosed = 1;
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_enter()
+//   Called when the stream is used as a context manager and simply returns it
+// as a convenience to the caller.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_enter(cxoLobStream *stream, PyObject* args)
+{
+    if (cxoLobStream_isOpen(stream) < 0)
+        return NULL;
+    Py_INCREF(stream);
+    return (PyObject*) stream;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_exit()
+//   Called when the stream is used as a context manager and closes it.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_exit(cxoLobStream *stream, PyObject* args)
+{
+    return cxoLobStream_close(stream, NULL);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_getClosed()
+//   Return whether the stream has been closed or not.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_getClosed(cxoLobStream *stream, void *unused)
+{
+    if (stream->isClosed)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_getIter()
+//   Return a reference to the stream which supports the iteration protocol.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_getIter(cxoLobStream *stream)
+{
+    if (cxoLobStream_isOpen(stream) < 0)
+        return NULL;
+    Py_INCREF(stream);
+    return (PyObject*) stream;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_getNext()
+//   Return the next chunk of data from the LOB or NULL if no more data is
+// available.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_getNext(cxoLobStream *stream)
+{
+    if (cxoLobStream_isOpen(stream) < 0)
+        return NULL;
+    if (stream->offset > stream->size)
+        return NULL;
+    return cxoLobStream_readValue(stream, stream->amount);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_read()
+//   Read up to the specified amount of data from the LOB. If no amount is
+// specified (or it is negative) all of the remaining data is read.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_read(cxoLobStream *stream, PyObject *args)
+{
+    PY_LONG_LONG amount;
+
+    amount = -1;
+    if (!PyArg_ParseTuple(args, "|L", &amount))
+        return NULL;
+    if (cxoLobStream_isOpen(stream) < 0)
+        return NULL;
+    if (amount < 0)
+        return cxoLobStream_readValue(stream, stream->size);
+    return cxoLobStream_readValue(stream, (uint64_t) amount);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_readInto()
+//   Read data from the LOB directly into the writable buffer supplied by the
+// caller and return the number of bytes read, which is zero once all of the
+// data has been read. Character data is placed in the buffer encoded in the
+// encoding of the connection; the number of characters read is limited so
+// that they are guaranteed to fit in the buffer.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_readInto(cxoLobStream *stream, PyObject *args)
+{
+    uint64_t amount, bufferSize;
+    int32_t maxBytesPerChar;
+    Py_buffer view;
+
+    // parse arguments
+    if (!PyArg_ParseTuple(args, "w*", &view))
+        return NULL;
+    if (cxoLobStream_isOpen(stream) < 0) {
+        PyBuffer_Release(&view);
+        return NULL;
+    }
+
+    // determine the amount to read
+    amount = (uint64_t) view.len;
+    if (cxoLobStream_isCharacterData(stream)) {
+        if (stream->lob->dbType == cxoDbTypeNclob)
+            maxBytesPerChar =
+                    stream->lob->connection->encodingInfo.nmaxBytesPerCharacter;
+        else maxBytesPerChar =
+                stream->lob->connection->encodingInfo.maxBytesPerCharacter;
+        if (maxBytesPerChar > 1)
+            amount /= (uint64_t) maxBytesPerChar;
+        if (amount == 0 && view.len > 0) {
+            PyBuffer_Release(&view);
+            PyErr_SetString(PyExc_ValueError,
+                    "buffer is too small to hold a character");
+            return NULL;
+        }
+    }
+    if (stream->offset > stream->size)
+        amount = 0;
+    else if (amount > stream->size - stream->offset + 1)
+        amount = stream->size - stream->offset + 1;
+
+    // perform the read
+    bufferSize = 0;
+    if (amount > 0) {
+        bufferSize = (uint64_t) view.len;
+        if (cxoLobStream_internalRead(stream, amount, view.buf,
+                &bufferSize) < 0) {
+            PyBuffer_Release(&view);
+            return NULL;
+        }
+    }
+    PyBuffer_Release(&view);
+    return PyLong_FromUnsignedLongLong(bufferSize);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_readable()
+//   Return whether the stream can be read or not.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_readable(cxoLobStream *stream, PyObject *args)
+{
+    if (cxoLobStream_isOpen(stream) < 0)
+        return NULL;
+    Py_RETURN_TRUE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoLobStream_tell()
+//   Return the current position of the stream. This is the number of bytes
+// (for BLOBs and BFILEs) or characters (for CLOBs and NCLOBs) read so far.
+//-----------------------------------------------------------------------------
+static PyObject *cxoLobStream_tell(cxoLobStream *stream, PyObject *args)
+{
+    if (cxoLobStream_isOpen(stream) < 0)
+        return NULL;
+    return PyLong_FromUnsignedLongLong(stream->offset - 1);
+}
+
+
+//-----------------------------------------------------------------------------
+// declaration of methods
+//-----------------------------------------------------------------------------
+static PyMethodDef cxoMethods[] = {
+    { "close", (PyCFunction) cxoLobStream_close, METH_NOARGS },
+    { "read", (PyCFunction) cxoLobStream_read, METH_VARARGS },
+    { "readinto", (PyCFunction) cxoLobStream_readInto, METH_VARARGS },
+    { "readable", (PyCFunction) cxoLobStream_readable, METH_NOARGS },
+    { "tell", (PyCFunction) cxoLobStream_tell, METH_NOARGS },
+    { "__enter__", (PyCFunction) cxoLobStream_enter, METH_NOARGS },
+    { "__exit__", (PyCFunction) cxoLobStream_exit, METH_VARARGS },
+    { NULL, NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of members
+//-----------------------------------------------------------------------------
+static PyMemberDef cxoMembers[] = {
+    { "lob", T_OBJECT, offsetof(cxoLobStream, lob), READONLY },
+    { "chunksize", T_UINT, offsetof(cxoLobStream, amount), READONLY },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of calculated members
+//-----------------------------------------------------------------------------
+static PyGetSetDef cxoCalcMembers[] = {
+    { "closed", (getter) cxoLobStream_getClosed, 0, 0, 0 },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// Python type declaration
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypeLobStream = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.LobStream",
+    .tp_basicsize = sizeof(cxoLobStream),
+    .tp_dealloc = (destructor) cxoLobStream_free,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_iter = (getiterfunc) cxoLobStream_getIter,
+    .tp_iternext = (iternextfunc) cxoLobStream_getNext,
+    .tp_methods = cxoMethods,
+    .tp_members = cxoMembers,
+    .tp_getset = cxoCalcMembers
+};
@@ -379,8 +379,14 @@ static PyObject *cxoModule_initialize(void)
     if (cxoTransform_init() < 0)
         return NULL;
 
+    // initialize struct sequence types
+    if (cxoStatementStats_init() < 0)
+        return NULL;
+
     // prepare the types for use by the module
     CXO_MAKE_TYPE_READY(&cxoPyTypeApiType);
+    CXO_MAKE_TYPE_READY(&cxoPyTypeAsyncCall);
+    CXO_MAKE_TYPE_READY(&cxoPyTypeColumn);
     CXO_MAKE_TYPE_READY(&cxoPyTypeConnection);
     CXO_MAKE_TYPE_READY(&cxoPyTypeCursor);
     CXO_MAKE_TYPE_READY(&cxoPyTypeDbType);
@@ -389,6 +395,7 @@ static PyObject *cxoModule_initialize(void)
     CXO_MAKE_TYPE_READY(&cxoPyTypeError);
     CXO_MAKE_TYPE_READY(&cxoPyTypeFuture);
     CXO_MAKE_TYPE_READY(&cxoPyTypeLob);
+    CXO_MAKE_TYPE_READY(&cxoPyTypeLobStream);
     CXO_MAKE_TYPE_READY(&cxoPyTypeMsgProps);
     CXO_MAKE_TYPE_READY(&cxoPyTypeMessage);
     CXO_MAKE_TYPE_READY(&cxoPyTypeMessageQuery);
@@ -397,7 +404,11 @@ static PyObject *cxoModule_initialize(void)
     CXO_MAKE_TYPE_READY(&cxoPyTypeObjectAttr);
     CXO_MAKE_TYPE_READY(&cxoPyTypeObject);
     CXO_MAKE_TYPE_READY(&cxoPyTypeObjectType);
+    CXO_MAKE_TYPE_READY(&cxoPyTypeParallelFetch);
+    CXO_MAKE_TYPE_READY(&cxoPyTypePipeline);
     CXO_MAKE_TYPE_READY(&cxoPyTypeQueue);
+    CXO_MAKE_TYPE_READY(&cxoPyTypeQueueIter);
+    CXO_MAKE_TYPE_READY(&cxoPyTypeResultCache);
     CXO_MAKE_TYPE_READY(&cxoPyTypeSessionPool);
     CXO_MAKE_TYPE_READY(&cxoPyTypeSodaCollection);
     CXO_MAKE_TYPE_READY(&cxoPyTypeSodaDatabase);
@@ -447,6 +458,7 @@ static PyObject *cxoModule_initialize(void)
     // set up the types that are available
     CXO_ADD_TYPE_OBJECT("ApiType", &cxoPyTypeApiType)
     CXO_ADD_TYPE_OBJECT("Binary", &PyBytes_Type)
+    CXO_ADD_TYPE_OBJECT("Column", &cxoPyTypeColumn)
     CXO_ADD_TYPE_OBJECT("Connection", &cxoPyTypeConnection)
     CXO_ADD_TYPE_OBJECT("Cursor", &cxoPyTypeCursor)
     CXO_ADD_TYPE_OBJECT("Date", cxoPyTypeDate)
@@ -455,15 +467,19 @@ static PyObject *cxoModule_initialize(void)
     CXO_ADD_TYPE_OBJECT("EnqOptions", &cxoPyTypeEnqOptions)
     CXO_ADD_TYPE_OBJECT("_Error", &cxoPyTypeError)
     CXO_ADD_TYPE_OBJECT("LOB", &cxoPyTypeLob)
+    CXO_ADD_TYPE_OBJECT("LobStream", &cxoPyTypeLobStream)
     CXO_ADD_TYPE_OBJECT("MessageProperties", &cxoPyTypeMsgProps)
     CXO_ADD_TYPE_OBJECT("Object", &cxoPyTypeObject)
     CXO_ADD_TYPE_OBJECT("ObjectType", &cxoPyTypeObjectType)
+    CXO_ADD_TYPE_OBJECT("Pipeline", &cxoPyTypePipeline)
+    CXO_ADD_TYPE_OBJECT("ResultCache", &cxoPyTypeResultCache)
     CXO_ADD_TYPE_OBJECT("SessionPool", &cxoPyTypeSessionPool)
     CXO_ADD_TYPE_OBJECT("SodaCollection", &cxoPyTypeSodaCollection)
     CXO_ADD_TYPE_OBJECT("SodaDatabase", &cxoPyTypeSodaDatabase)
     CXO_ADD_TYPE_OBJECT("SodaDoc", &cxoPyTypeSodaDoc)
     CXO_ADD_TYPE_OBJECT("SodaDocCursor", &cxoPyTypeSodaDocCursor)
     CXO_ADD_TYPE_OBJECT("SodaOperation", &cxoPyTypeSodaOperation)
+    CXO_ADD_TYPE_OBJECT("StatementStats", &cxoPyTypeStatementStats)
     CXO_ADD_TYPE_OBJECT("Timestamp", cxoPyTypeDateTime)
     CXO_ADD_TYPE_OBJECT("Var", &cxoPyTypeVar)
 
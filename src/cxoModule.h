@@ -22,6 +22,48 @@
 #define CXO_BUILD_VERSION_STRING        xstr(CXO_BUILD_VERSION)
 #define CXO_DRIVER_NAME                 "cx_Oracle : "CXO_BUILD_VERSION_STRING
 
+// define maximum number of characters in the text representation of a number
+#define CXO_MAX_NUMBER_CHARS            172
+
+// define constants used for tuning the fetch array size automatically
+#define CXO_AUTO_ARRAY_SIZE_INITIAL     100
+#define CXO_AUTO_ARRAY_SIZE_MAX         100000
+#define CXO_AUTO_ARRAY_SIZE_MIN_GAIN    0.9
+#define CXO_AUTO_HANDLE_SIZE_IN_BYTES   512
+#define CXO_DEFAULT_FETCH_BYTES         1048576
+
+// define the number of buckets in the histogram of session pool wait times;
+// bucket N counts waits of less than 2^N milliseconds and the last bucket
+// counts all longer waits
+#define CXO_POOL_STATS_NUM_BUCKETS      16
+
+// define the default number of queries for which rows are cached by a result
+// cache
+#define CXO_RESULT_CACHE_MAX_ENTRIES    1000
+
+// define the number of SODA documents fetched at a time when retrieving all of
+// the documents that match the criteria of an operation, unless a fetch array
+// size was specified
+#define CXO_SODA_DEFAULT_BATCH_SIZE     100
+
+// define the number of bytes buffered before rows exported by a cursor are
+// written to the file
+#define CXO_EXPORT_BUFFER_SIZE          1048576
+
+// define the number of bytes read at a time by a cursor loading rows from a
+// file
+#define CXO_LOAD_READ_SIZE              1048576
+
+// define maximum sizes of error information retained by worker threads
+#define CXO_WORKER_MAX_ERROR_MESSAGE    3072
+#define CXO_WORKER_MAX_ERROR_ENCODING   100
+
+// define the maximum number of native threads used to perform the round trips
+// of asynchronous operations; additional operations wait for a thread to
+// become available, except for operations that may block (such as acquiring a
+// session from a pool) which are given an additional thread
+#define CXO_WORKER_POOL_MAX_THREADS     8
+
 // define macro for clearing buffers
 #define cxoBuffer_clear(buf)            Py_CLEAR((buf)->obj)
 
@@ -30,15 +72,21 @@
 // Forward Declarations
 //-----------------------------------------------------------------------------
 typedef struct cxoApiType cxoApiType;
+typedef struct cxoAsyncCall cxoAsyncCall;
 typedef struct cxoBuffer cxoBuffer;
+typedef struct cxoColumn cxoColumn;
 typedef struct cxoConnection cxoConnection;
 typedef struct cxoCursor cxoCursor;
+typedef struct cxoDateCacheEntry cxoDateCacheEntry;
 typedef struct cxoDbType cxoDbType;
 typedef struct cxoDeqOptions cxoDeqOptions;
 typedef struct cxoEnqOptions cxoEnqOptions;
 typedef struct cxoError cxoError;
+typedef struct cxoExport cxoExport;
 typedef struct cxoFuture cxoFuture;
+typedef struct cxoLoad cxoLoad;
 typedef struct cxoLob cxoLob;
+typedef struct cxoLobStream cxoLobStream;
 typedef struct cxoMessage cxoMessage;
 typedef struct cxoMessageQuery cxoMessageQuery;
 typedef struct cxoMessageRow cxoMessageRow;
@@ -47,15 +95,28 @@ typedef struct cxoMsgProps cxoMsgProps;
 typedef struct cxoObject cxoObject;
 typedef struct cxoObjectAttr cxoObjectAttr;
 typedef struct cxoObjectType cxoObjectType;
+typedef struct cxoParallelFetch cxoParallelFetch;
+typedef struct cxoParallelFetchState cxoParallelFetchState;
+typedef struct cxoPipeline cxoPipeline;
 typedef struct cxoQueue cxoQueue;
+typedef struct cxoQueueIter cxoQueueIter;
+typedef struct cxoResultCache cxoResultCache;
 typedef struct cxoSessionPool cxoSessionPool;
+typedef struct cxoSessionPoolStats cxoSessionPoolStats;
 typedef struct cxoSodaCollection cxoSodaCollection;
 typedef struct cxoSodaDatabase cxoSodaDatabase;
 typedef struct cxoSodaDoc cxoSodaDoc;
 typedef struct cxoSodaDocCursor cxoSodaDocCursor;
 typedef struct cxoSodaOperation cxoSodaOperation;
+typedef struct cxoStatementStats cxoStatementStats;
+typedef struct cxoStmtCache cxoStmtCache;
+typedef struct cxoStmtCacheEntry cxoStmtCacheEntry;
+typedef struct cxoStringCacheEntry cxoStringCacheEntry;
 typedef struct cxoSubscr cxoSubscr;
+typedef struct cxoSubscrEntry cxoSubscrEntry;
+typedef struct cxoSubscrQueue cxoSubscrQueue;
 typedef struct cxoVar cxoVar;
+typedef struct cxoWorker cxoWorker;
 
 
 //-----------------------------------------------------------------------------
@@ -76,6 +137,8 @@ extern PyObject *cxoNotSupportedErrorException;
 
 // type objects
 extern PyTypeObject cxoPyTypeApiType;
+extern PyTypeObject cxoPyTypeAsyncCall;
+extern PyTypeObject cxoPyTypeColumn;
 extern PyTypeObject cxoPyTypeConnection;
 extern PyTypeObject cxoPyTypeCursor;
 extern PyTypeObject cxoPyTypeDbType;
@@ -84,6 +147,7 @@ extern PyTypeObject cxoPyTypeEnqOptions;
 extern PyTypeObject cxoPyTypeError;
 extern PyTypeObject cxoPyTypeFuture;
 extern PyTypeObject cxoPyTypeLob;
+extern PyTypeObject cxoPyTypeLobStream;
 extern PyTypeObject cxoPyTypeMsgProps;
 extern PyTypeObject cxoPyTypeMessage;
 extern PyTypeObject cxoPyTypeMessageQuery;
@@ -92,13 +156,18 @@ extern PyTypeObject cxoPyTypeMessageTable;
 extern PyTypeObject cxoPyTypeObject;
 extern PyTypeObject cxoPyTypeObjectAttr;
 extern PyTypeObject cxoPyTypeObjectType;
+extern PyTypeObject cxoPyTypeParallelFetch;
+extern PyTypeObject cxoPyTypePipeline;
 extern PyTypeObject cxoPyTypeQueue;
+extern PyTypeObject cxoPyTypeQueueIter;
+extern PyTypeObject cxoPyTypeResultCache;
 extern PyTypeObject cxoPyTypeSessionPool;
 extern PyTypeObject cxoPyTypeSodaCollection;
 extern PyTypeObject cxoPyTypeSodaDatabase;
 extern PyTypeObject cxoPyTypeSodaDoc;
 extern PyTypeObject cxoPyTypeSodaDocCursor;
 extern PyTypeObject cxoPyTypeSodaOperation;
+extern PyTypeObject cxoPyTypeStatementStats;
 extern PyTypeObject cxoPyTypeSubscr;
 extern PyTypeObject cxoPyTypeVar;
 
@@ -187,6 +256,18 @@ typedef enum {
     CXO_TRANSFORM_UNSUPPORTED
 } cxoTransformNum;
 
+typedef enum {
+    CXO_EXPORT_FORMAT_CSV = 0,
+    CXO_EXPORT_FORMAT_JSONL
+} cxoExportFormat;
+
+typedef enum {
+    CXO_LOAD_STATE_FIELD_START = 0,
+    CXO_LOAD_STATE_UNQUOTED,
+    CXO_LOAD_STATE_QUOTED,
+    CXO_LOAD_STATE_QUOTE
+} cxoLoadState;
+
 typedef enum {
     CXO_OCI_ATTR_TYPE_STRING = 1,
     CXO_OCI_ATTR_TYPE_BOOLEAN = 2,
@@ -196,6 +277,32 @@ typedef enum {
     CXO_OCI_ATTR_TYPE_UINT64 = 64
 } cxoOciAttrType;
 
+typedef enum {
+    CXO_ROW_MODE_TUPLE = 0,
+    CXO_ROW_MODE_DICT,
+    CXO_ROW_MODE_NAMEDTUPLE
+} cxoRowMode;
+
+typedef enum {
+    CXO_STATEMENT_PHASE_PREPARE = 0,
+    CXO_STATEMENT_PHASE_BIND,
+    CXO_STATEMENT_PHASE_EXECUTE,
+    CXO_STATEMENT_PHASE_FETCH
+} cxoStatementPhase;
+
+
+//-----------------------------------------------------------------------------
+// Function Types
+//-----------------------------------------------------------------------------
+typedef PyObject *(*cxoTransformToPythonFunc)(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors);
+typedef PyObject *(*cxoVarGetValueFunc)(cxoVar *var, dpiData *data);
+typedef int (*cxoWorkerFunc)(void *arg);
+typedef void (*cxoWorkerNotifyFunc)(void *arg);
+typedef int (*cxoAsyncCompleteFunc)(cxoAsyncCall *call, int status,
+        PyObject **result);
+
 
 //-----------------------------------------------------------------------------
 // Structures
@@ -207,6 +314,22 @@ struct cxoApiType {
     cxoTransformNum defaultTransformNum;
 };
 
+struct cxoAsyncCall {
+    PyObject_HEAD
+    cxoWorker *worker;
+    PyObject *owner;
+    cxoConnection *connection;
+    PyObject *loop;
+    PyObject *future;
+    PyObject *result;
+    cxoAsyncCompleteFunc completeFunc;
+    void *data;
+    void (*freeDataFunc)(void *data);
+    double elapsed;
+    uint32_t numRows;
+    uint32_t numQueryColumns;
+};
+
 struct cxoBuffer {
     const char *ptr;
     uint32_t numCharacters;
@@ -214,6 +337,22 @@ struct cxoBuffer {
     PyObject *obj;
 };
 
+struct cxoColumn {
+    PyObject_HEAD
+    PyObject *name;
+    cxoDbType *dbType;
+    PyObject *data;
+    PyObject *offsets;
+    PyObject *validity;
+    const char *format;
+    const char *unit;
+    Py_ssize_t itemSize;
+    Py_ssize_t dataSize;
+    uint64_t numRows;
+    uint64_t numNulls;
+    int isText;
+};
+
 struct cxoError {
     PyObject_HEAD
     long code;
@@ -223,6 +362,52 @@ struct cxoError {
     char isRecoverable;
 };
 
+struct cxoExport {
+    cxoCursor *cursor;
+    PyObject *file;
+    PyObject *keys;
+    char *buffer;
+    size_t bufferSize;
+    size_t bufferCapacity;
+    uint64_t numRows;
+    cxoExportFormat format;
+    char delimiter;
+    int fd;
+};
+
+struct cxoStatementStats {
+    uint64_t numPrepares;
+    uint64_t numExecutes;
+    uint64_t numFetchCalls;
+    uint64_t numRowsFetched;
+    double prepareTime;
+    double bindTime;
+    double executeTime;
+    double fetchTime;
+    double rowTime;
+};
+
+struct cxoStmtCacheEntry {
+    uint64_t hash;
+    uint64_t lastUsed;
+    uint64_t numPrepares;
+    uint64_t numMisses;
+    double prepareTime;
+    PyObject *statement;
+    PyObject *tag;
+};
+
+struct cxoStmtCache {
+    cxoStmtCacheEntry *entries;
+    uint32_t numEntries;
+    uint32_t allocatedEntries;
+    uint64_t clock;
+    uint64_t numPrepares;
+    uint64_t numHits;
+    uint64_t numMisses;
+    double prepareTime;
+};
+
 struct cxoConnection {
     PyObject_HEAD
     dpiConn *handle;
@@ -233,8 +418,16 @@ struct cxoConnection {
     PyObject *dsn;
     PyObject *version;
     PyObject *tag;
+    PyObject *objectTypes;
+    PyObject *statsHandler;
     dpiEncodingInfo encodingInfo;
+    cxoStatementStats stats;
+    cxoStmtCache stmtCache;
     int autocommit;
+    int threaded;
+    int collectStats;
+    int fetchLobs;
+    int asyncInProgress;
 };
 
 struct cxoCursor {
@@ -246,23 +439,56 @@ struct cxoCursor {
     PyObject *statementTag;
     PyObject *bindVariables;
     PyObject *fetchVariables;
+    PyObject *prefetchVariables;
+    PyObject *batchErrors;
+    PyObject *arrayDMLRowCounts;
+    PyObject *varPool;
     PyObject *rowFactory;
+    PyObject *rowTemplate;
     PyObject *inputTypeHandler;
     PyObject *outputTypeHandler;
+    PyObject *statsHandler;
+    cxoStatementStats stats;
     uint32_t arraySize;
     uint32_t bindArraySize;
     uint32_t fetchArraySize;
     uint32_t prefetchRows;
+    uint32_t stringCacheSize;
+    uint32_t dateCacheSize;
+    uint32_t varPoolSize;
+    uint32_t fetchBytes;
+    uint32_t fetchBatchSize;
+    uint32_t fetchRoundTrips;
+    double fetchTimePerRow;
+    double fetchRoundTripTime;
+    int fetchBatchSizeTuned;
+    int autoArraySize;
     int setInputSizes;
+    int prefetchRowsSet;
     uint64_t rowCount;
     uint32_t fetchBufferRowIndex;
     uint32_t numRowsInFetchBuffer;
     int moreRowsToFetch;
+    cxoWorker *fetchWorker;
+    uint32_t prefetchBufferRowIndex;
+    uint32_t numRowsInPrefetchBuffer;
+    int moreRowsToPrefetch;
+    int prefetchDefined;
+    int backgroundFetch;
+    int collectStats;
+    int fetchLobs;
+    int tzAware;
+    cxoRowMode rowMode;
     char isScrollable;
     int fixupRefCursor;
     int isOpen;
 };
 
+struct cxoDateCacheEntry {
+    uint64_t key;
+    PyObject *value;
+};
+
 struct cxoDbType {
     PyObject_HEAD
     uint32_t num;
@@ -286,6 +512,30 @@ struct cxoFuture {
     PyObject_HEAD
 };
 
+struct cxoLoad {
+    cxoCursor *cursor;
+    PyObject *types;
+    PyObject *vars;
+    PyObject *batchErrors;
+    PyObject *arrayDMLRowCounts;
+    char *record;
+    size_t recordSize;
+    size_t recordCapacity;
+    size_t *fieldStarts;
+    uint32_t numFields;
+    uint32_t fieldsCapacity;
+    uint32_t batchSize;
+    uint32_t batchRow;
+    uint64_t numRecords;
+    uint64_t numRowsExecuted;
+    uint64_t rowCount;
+    cxoLoadState state;
+    dpiExecMode mode;
+    char delimiter;
+    int lineHasData;
+    int skipHeader;
+};
+
 struct cxoLob {
     PyObject_HEAD
     cxoConnection *connection;
@@ -293,6 +543,17 @@ struct cxoLob {
     dpiLob *handle;
 };
 
+struct cxoLobStream {
+    PyObject_HEAD
+    cxoLob *lob;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t amount;
+    char *buffer;
+    uint64_t bufferSize;
+    int isClosed;
+};
+
 struct cxoMessage {
     PyObject_HEAD
     cxoSubscr *subscription;
@@ -361,9 +622,42 @@ struct cxoObjectType {
     cxoTransformNum elementTransformNum;
     cxoObjectType *elementObjectType;
     cxoDbType *elementDbType;
+    PyObject *weakRefList;
     char isCollection;
 };
 
+struct cxoParallelFetch {
+    PyObject_HEAD
+    cxoParallelFetchState *state;
+};
+
+struct cxoParallelFetchState {
+    cxoSessionPool *pool;
+    PyObject *statement;
+    PyObject *partitions;
+    PyObject *results;
+    PyObject *errorType;
+    PyObject *errorValue;
+    PyObject *errorTraceback;
+    PyThread_type_lock dataEvent;
+    PyThread_type_lock spaceEvent;
+    int dataSignalled;
+    int spaceSignalled;
+    Py_ssize_t nextPartition;
+    uint32_t batchSize;
+    uint32_t maxPending;
+    uint32_t numActive;
+    uint32_t refCount;
+    int columnar;
+    int stop;
+};
+
+struct cxoPipeline {
+    PyObject_HEAD
+    cxoConnection *connection;
+    PyObject *operations;
+};
+
 struct cxoQueue {
     PyObject_HEAD
     cxoConnection *conn;
@@ -372,6 +666,46 @@ struct cxoQueue {
     PyObject *deqOptions;
     PyObject *enqOptions;
     cxoObjectType *payloadType;
+    dpiMsgProps **deqHandles;
+    uint32_t numDeqHandles;
+    int deqHandlesInUse;
+};
+
+struct cxoQueueIter {
+    PyObject_HEAD
+    cxoQueue *queue;
+    uint32_t batchSize;
+    int withMsgId;
+};
+
+struct cxoResultCache {
+    PyObject_HEAD
+    cxoConnection *connection;
+    cxoSubscr *subscription;
+    PyObject *entries;
+    PyObject *queryIds;
+    PyObject *queryKeys;
+    uint32_t maxEntries;
+    uint64_t generation;
+    unsigned long long hits;
+    unsigned long long misses;
+    unsigned long long invalidations;
+    unsigned long long evictions;
+};
+
+struct cxoSessionPoolStats {
+    uint64_t numAcquires;
+    uint64_t numAcquireErrors;
+    uint64_t numTimeouts;
+    uint64_t numSessionsCreated;
+    uint64_t numSessionsDropped;
+    uint64_t numCallbacks;
+    uint64_t numStatementPrepares;
+    uint64_t numStatementCacheHits;
+    uint64_t numStatementCacheMisses;
+    double acquireTime;
+    double statementPrepareTime;
+    uint64_t acquireWaits[CXO_POOL_STATS_NUM_BUCKETS];
 };
 
 struct cxoSessionPool {
@@ -384,11 +718,15 @@ struct cxoSessionPool {
     dpiEncodingInfo encodingInfo;
     int homogeneous;
     int externalAuth;
+    int threaded;
     PyObject *username;
     PyObject *dsn;
     PyObject *name;
     PyObject *sessionCallback;
     PyTypeObject *connectionType;
+    dpiCommonCreateParams acquireCommonParams;
+    dpiConnCreateParams acquireCreateParams;
+    cxoSessionPoolStats stats;
 };
 
 struct cxoSodaCollection {
@@ -428,6 +766,11 @@ struct cxoSodaOperation {
 };
 
 
+struct cxoStringCacheEntry {
+    PyObject *key;
+    PyObject *value;
+};
+
 struct cxoSubscr {
     PyObject_HEAD
     dpiSubscr *handle;
@@ -445,6 +788,27 @@ struct cxoSubscr {
     uint32_t groupingValue;
     uint8_t groupingType;
     uint64_t id;
+    cxoResultCache *resultCache;
+    cxoSubscrQueue *queue;
+};
+
+struct cxoSubscrEntry {
+    cxoSubscrEntry *next;
+    dpiSubscrMessage message;
+};
+
+struct cxoSubscrQueue {
+    PyThread_type_lock mutex;
+    PyThread_type_lock availableEvent;
+    PyThread_type_lock closedEvent;
+    PyThread_type_lock consumerLock;
+    cxoSubscrEntry *head;
+    cxoSubscrEntry *tail;
+    cxoSubscr *subscr;
+    uint32_t window;
+    uint32_t refCount;
+    int signalled;
+    int closed;
 };
 
 struct cxoVar {
@@ -465,19 +829,64 @@ struct cxoVar {
     cxoTransformNum transformNum;
     dpiNativeTypeNum nativeTypeNum;
     cxoDbType *dbType;
+    cxoTransformToPythonFunc toPythonFunc;
+    cxoVarGetValueFunc getValueFunc;
+    cxoStringCacheEntry *stringCache;
+    uint32_t stringCacheSize;
+    cxoDateCacheEntry *dateCache;
+    uint32_t dateCacheSize;
+    int tzAware;
 };
 
 
+struct cxoWorker {
+    PyThread_type_lock completedLock;
+    PyThread_type_lock startLock;
+    cxoWorkerFunc func;
+    cxoWorkerNotifyFunc notifyFunc;
+    void *arg;
+    cxoWorker *next;
+    int inBackground;
+    int mayBlock;
+    int isStarted;
+    int hasThread;
+    int stopRequested;
+    int status;
+    dpiErrorInfo errorInfo;
+    char errorMessage[CXO_WORKER_MAX_ERROR_MESSAGE];
+    char errorEncoding[CXO_WORKER_MAX_ERROR_ENCODING];
+};
+
 //-----------------------------------------------------------------------------
 // Functions
 //-----------------------------------------------------------------------------
+cxoAsyncCall *cxoAsyncCall_new(PyObject *owner, cxoConnection *connection,
+        int threaded, cxoAsyncCompleteFunc completeFunc);
+int cxoAsyncCall_setResult(cxoAsyncCall *call, PyObject *result);
+int cxoAsyncCall_start(cxoAsyncCall *call, cxoWorkerFunc func, int mayBlock);
+
+int cxoBuffer_fromBinaryObject(cxoBuffer *buf, PyObject *obj);
 int cxoBuffer_fromObject(cxoBuffer *buf, PyObject *obj, const char *encoding);
 int cxoBuffer_init(cxoBuffer *buf);
 
+int cxoColumn_appendRows(cxoColumn *column, cxoVar *var, uint32_t startPos,
+        uint32_t numRows);
+int cxoColumn_finalize(cxoColumn *column);
+cxoColumn *cxoColumn_new(cxoVar *var, PyObject *name);
+
+cxoConnection *cxoConnection_acquireFromPool(cxoSessionPool *pool,
+        PyObject *cclassObj, PyObject *purityObj, PyObject *tagObj,
+        PyObject *matchAnyTagObj);
+PyObject *cxoConnection_acquireFromPoolAsync(cxoSessionPool *pool,
+        PyObject *cclassObj, PyObject *purityObj, PyObject *tagObj,
+        PyObject *matchAnyTagObj);
 int cxoConnection_getSodaFlags(cxoConnection *conn, uint32_t *flags);
 int cxoConnection_isConnected(cxoConnection *conn);
 
+cxoVar *cxoCursor_getPooledVar(cxoCursor *cursor, uint32_t numElements,
+        cxoTransformNum transformNum, uint32_t size);
 int cxoCursor_performBind(cxoCursor *cursor);
+int cxoCursor_performDefine(cxoCursor *cursor, uint32_t numQueryColumns);
 int cxoCursor_setBindVariables(cxoCursor *cursor, PyObject *parameters,
         unsigned numElements, unsigned arrayPos, int deferTypeAssignment);
 
@@ -497,13 +906,32 @@ int cxoError_raiseFromInfo(dpiErrorInfo *errorInfo);
 PyObject *cxoError_raiseFromString(PyObject *exceptionType,
         const char *message);
 
+int cxoExport_appendRows(cxoExport *export, uint32_t startPos,
+        uint32_t numRows);
+void cxoExport_clear(cxoExport *export);
+int cxoExport_finalize(cxoExport *export);
+int cxoExport_init(cxoExport *export, cxoCursor *cursor, PyObject *file,
+        cxoExportFormat format, char delimiter, int header);
+
+void cxoLoad_clear(cxoLoad *load);
+int cxoLoad_finalize(cxoLoad *load);
+int cxoLoad_init(cxoLoad *load, cxoCursor *cursor, PyObject *types,
+        uint32_t batchSize, char delimiter, int header, dpiExecMode mode);
+int cxoLoad_processData(cxoLoad *load, const char *data, size_t length);
+
 PyObject *cxoLob_new(cxoConnection *connection, cxoDbType *dbType,
         dpiLob *handle);
 
+cxoLobStream *cxoLobStream_new(cxoLob *lob, uint32_t amount);
+
 cxoMsgProps *cxoMsgProps_new(cxoConnection*, dpiMsgProps *handle);
 
+PyObject *cxoObject_collectionToPython(cxoObjectType *objType,
+        dpiObject *handle, int asDict, int deep);
 int cxoObject_internalExtend(cxoObject *obj, PyObject *sequence);
 PyObject *cxoObject_new(cxoObjectType *objectType, dpiObject *handle);
+PyObject *cxoObject_recordToPython(cxoObjectType *objType, dpiObject *handle,
+        int deep);
 
 cxoObjectAttr *cxoObjectAttr_new(cxoConnection *connection,
         dpiObjectAttr *handle);
@@ -513,8 +941,22 @@ cxoObjectType *cxoObjectType_new(cxoConnection *connection,
 cxoObjectType *cxoObjectType_newByName(cxoConnection *connection,
         PyObject *name);
 
+cxoParallelFetch *cxoParallelFetch_new(cxoSessionPool *pool,
+        PyObject *statement, PyObject *partitions, uint32_t numSessions,
+        uint32_t batchSize, int columnar);
+
+cxoPipeline *cxoPipeline_new(cxoConnection *connection);
+
 cxoQueue *cxoQueue_new(cxoConnection *conn, dpiQueue *handle);
 
+cxoResultCache *cxoResultCache_new(cxoConnection *connection,
+        uint32_t maxEntries, int clientInitiated);
+int cxoResultCache_processMessage(cxoResultCache *cache,
+        dpiSubscrMessage *message);
+
+void cxoSessionPool_recordAcquire(cxoSessionPool *pool, int status,
+        const dpiErrorInfo *errorInfo, double waitTime, int newSession);
+
 cxoSodaCollection *cxoSodaCollection_new(cxoSodaDatabase *db,
         dpiSodaColl *handle);
 
@@ -522,12 +964,26 @@ cxoSodaDatabase *cxoSodaDatabase_new(cxoConnection *connection);
 
 cxoSodaDoc *cxoSodaDoc_new(cxoSodaDatabase *db, dpiSodaDoc *handle);
 
+int cxoSodaDocCursor_fetch(cxoSodaDatabase *db, dpiSodaDocCursor *handle,
+        uint32_t numDocs, int contents, PyObject *list);
 cxoSodaDocCursor *cxoSodaDocCursor_new(cxoSodaDatabase *db,
         dpiSodaDocCursor *handle);
 
 cxoSodaOperation *cxoSodaOperation_new(cxoSodaCollection *collection);
 
+int cxoStatementStats_init(void);
+int cxoStatementStats_record(cxoCursor *cursor, cxoStatementPhase phase,
+        double elapsed, uint32_t numRows);
+PyObject *cxoStatementStats_toPython(cxoStatementStats *stats);
+
+void cxoStmtCache_clear(cxoStmtCache *cache);
+void cxoStmtCache_record(cxoConnection *conn, cxoBuffer *statementBuffer,
+        cxoBuffer *tagBuffer, PyObject *statement, PyObject *tag,
+        double elapsed);
+PyObject *cxoStmtCache_toPython(cxoStmtCache *cache, uint32_t top);
+
 void cxoSubscr_callback(cxoSubscr *subscr, dpiSubscrMessage *message);
+int cxoSubscr_initQueue(cxoSubscr *subscr, uint32_t window);
 
 PyObject *cxoTransform_dateFromTicks(PyObject *args);
 int cxoTransform_fromPython(cxoTransformNum transformNum,
@@ -543,13 +999,22 @@ int cxoTransform_getNumFromType(PyObject *type, cxoTransformNum *transformNum,
 int cxoTransform_getNumFromValue(PyObject *value, int *isArray,
         Py_ssize_t *size, Py_ssize_t *numElements, int plsql,
         cxoTransformNum *transformNum);
+cxoTransformToPythonFunc cxoTransform_getToPythonFunc(
+        cxoTransformNum transformNum);
 void cxoTransform_getTypeInfo(cxoTransformNum transformNum,
         dpiOracleTypeNum *oracleTypeNum, dpiNativeTypeNum *nativeTypeNum);
 int cxoTransform_init(void);
+int cxoTransform_numberToDouble(const char *ptr, uint32_t length,
+        double *value);
+int cxoTransform_numberToInt64(const char *ptr, uint32_t length,
+        int64_t *value);
 PyObject *cxoTransform_timestampFromTicks(PyObject *args);
 PyObject *cxoTransform_toPython(cxoTransformNum transformNum, 
         cxoConnection *connection, cxoObjectType *objType,
         dpiDataBuffer *dbValue, const char *encodingErrors);
+PyObject *cxoTransform_toPythonDateTimeWithTimeZone(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors);
 
 PyObject *cxoUtils_convertOciAttrToPythonValue(unsigned attrType,
         dpiDataBuffer *value, uint32_t valueLength, const char *encoding);
@@ -561,6 +1026,7 @@ const char *cxoUtils_getAdjustedEncoding(const char *encoding);
 int cxoUtils_getBooleanValue(PyObject *obj, int defaultValue, int *value);
 int cxoUtils_getModuleAndName(PyTypeObject *type, PyObject **module,
         PyObject **name);
+double cxoUtils_getMonotonicTime(void);
 int cxoUtils_initializeDPI(dpiContextCreateParams *params);
 int cxoUtils_processJsonArg(PyObject *arg, cxoBuffer *buffer);
 int cxoUtils_processSodaDocArg(cxoSodaDatabase *db, PyObject *arg,
@@ -577,4 +1043,22 @@ cxoVar *cxoVar_newByType(cxoCursor *cursor, PyObject *value,
         uint32_t numElements);
 cxoVar *cxoVar_newByValue(cxoCursor *cursor, PyObject *value,
         Py_ssize_t numElements);
+cxoVar *cxoVar_newByVar(cxoCursor *cursor, cxoVar *var);
+void cxoVar_resolveGetValueFunc(cxoVar *var);
+int cxoVar_setColumnValues(cxoVar *var, PyObject *values, uint32_t numValues,
+        uint32_t maxSize);
+int cxoVar_setDateCacheSize(cxoVar *var, uint32_t size);
+int cxoVar_setFromBytes(cxoVar *var, uint32_t pos, const char *value,
+        uint32_t length, uint32_t numCharacters);
+int cxoVar_setStringCacheSize(cxoVar *var, uint32_t size);
 int cxoVar_setValue(cxoVar *var, uint32_t arrayPos, PyObject *value);
+
+void cxoWorker_discard(cxoWorker *worker);
+void cxoWorker_free(cxoWorker *worker);
+void cxoWorker_init(cxoWorker *worker);
+int cxoWorker_queue(cxoWorker *worker, cxoWorkerFunc func, void *arg,
+        int mayBlock);
+int cxoWorker_start(cxoWorker *worker, cxoWorkerFunc func, void *arg,
+        int inBackground);
+void cxoWorker_sync(cxoWorker *worker);
+int cxoWorker_wait(cxoWorker *worker);
@@ -96,49 +96,211 @@ static int cxoObject_convertFromPython(cxoObject *obj, PyObject *value,
 
 //-----------------------------------------------------------------------------
 // cxoObject_convertToPython()
-//   Convert an Oracle value to a Python value.
-//-----------------------------------------------------------------------------
-static PyObject *cxoObject_convertToPython(cxoObject *obj,
-        cxoTransformNum transformNum, dpiData *data, cxoObjectType *objType)
+//   Convert an Oracle value to a Python value. If a deep conversion is
+// requested, objects are converted directly to lists (for collections) or
+// dictionaries (for records) without creating an intermediate object; the
+// reference to the object handle is released in that case.
+//-----------------------------------------------------------------------------
+static PyObject *cxoObject_convertToPython(cxoConnection *connection,
+        cxoTransformNum transformNum, dpiData *data, cxoObjectType *objType,
+        int deep)
 {
+    PyObject *result;
+
     if (data->isNull)
         Py_RETURN_NONE;
-    return cxoTransform_toPython(transformNum, obj->objectType->connection,
-            objType, &data->value, NULL);
+    if (deep && transformNum == CXO_TRANSFORM_OBJECT) {
+        if (objType->isCollection)
+            result = cxoObject_collectionToPython(objType,
+                    data->value.asObject, 0, 1);
+        else result = cxoObject_recordToPython(objType, data->value.asObject,
+                1);
+        dpiObject_release(data->value.asObject);
+        return result;
+    }
+    return cxoTransform_toPython(transformNum, connection, objType,
+            &data->value, NULL);
 }
 
 
 //-----------------------------------------------------------------------------
-// cxoObject_getAttributeValue()
-//   Retrieve an attribute on the object.
+// cxoObject_prepareValue()
+//   Determine the native type to use for retrieving values of the given
+// transform and point the buffer at the space used for numbers, if needed. An
+// exception is raised if the Oracle type is not supported.
 //-----------------------------------------------------------------------------
-static PyObject *cxoObject_getAttributeValue(cxoObject *obj,
-        cxoObjectAttr *attribute)
+static int cxoObject_prepareValue(cxoTransformNum transformNum,
+        dpiOracleTypeNum oracleTypeNum, dpiNativeTypeNum *nativeTypeNum,
+        int *isNumberAsBytes)
 {
-    char numberAsStringBuffer[200], message[120];
-    dpiOracleTypeNum oracleTypeNum;
-    dpiNativeTypeNum nativeTypeNum;
-    dpiData data;
+    dpiOracleTypeNum tempOracleTypeNum;
+    char message[120];
 
-    if (attribute->transformNum == CXO_TRANSFORM_UNSUPPORTED) {
+    if (transformNum == CXO_TRANSFORM_UNSUPPORTED) {
         snprintf(message, sizeof(message), "Oracle type %d not supported.",
-                attribute->oracleTypeNum);
-        return cxoError_raiseFromString(cxoNotSupportedErrorException,
-                message);
+                oracleTypeNum);
+        cxoError_raiseFromString(cxoNotSupportedErrorException, message);
+        return -1;
     }
-    cxoTransform_getTypeInfo(attribute->transformNum, &oracleTypeNum,
-            &nativeTypeNum);
-    if (oracleTypeNum == DPI_ORACLE_TYPE_NUMBER &&
-            nativeTypeNum == DPI_NATIVE_TYPE_BYTES) {
+    cxoTransform_getTypeInfo(transformNum, &tempOracleTypeNum, nativeTypeNum);
+    *isNumberAsBytes = (tempOracleTypeNum == DPI_ORACLE_TYPE_NUMBER &&
+            *nativeTypeNum == DPI_NATIVE_TYPE_BYTES);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_internalGetAttributeValue()
+//   Retrieve an attribute on the object identified by the given handle.
+//-----------------------------------------------------------------------------
+static PyObject *cxoObject_internalGetAttributeValue(cxoObjectType *objType,
+        dpiObject *handle, cxoObjectAttr *attribute, int deep)
+{
+    char numberAsStringBuffer[CXO_MAX_NUMBER_CHARS];
+    dpiNativeTypeNum nativeTypeNum;
+    int isNumberAsBytes;
+    dpiData data;
+
+    if (cxoObject_prepareValue(attribute->transformNum,
+            attribute->oracleTypeNum, &nativeTypeNum, &isNumberAsBytes) < 0)
+        return NULL;
+    if (isNumberAsBytes) {
         data.value.asBytes.ptr = numberAsStringBuffer;
         data.value.asBytes.length = sizeof(numberAsStringBuffer);
         data.value.asBytes.encoding = NULL;
     }
-    if (dpiObject_getAttributeValue(obj->handle, attribute->handle,
+    if (dpiObject_getAttributeValue(handle, attribute->handle,
             nativeTypeNum, &data) < 0)
         return cxoError_raiseAndReturnNull();
-    return cxoObject_convertToPython(obj, attribute->transformNum, &data,
-            attribute->objectType);
+    return cxoObject_convertToPython(objType->connection,
+            attribute->transformNum, &data, attribute->objectType, deep);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_getAttributeValue()
+//   Retrieve an attribute on the object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoObject_getAttributeValue(cxoObject *obj,
+        cxoObjectAttr *attribute)
+{
+    return cxoObject_internalGetAttributeValue(obj->objectType, obj->handle,
+            attribute, 0);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_recordToPython()
+//   Return a dictionary mapping the attribute names of the object identified
+// by the given handle to their values. If a deep conversion is requested,
+// nested collections are returned as lists and nested records as
+// dictionaries.
+//-----------------------------------------------------------------------------
+PyObject *cxoObject_recordToPython(cxoObjectType *objType, dpiObject *handle,
+        int deep)
+{
+    PyObject *dict, *value;
+    cxoObjectAttr *attr;
+    Py_ssize_t i;
+
+    dict = PyDict_New();
+    if (!dict)
+        return NULL;
+    for (i = 0; i < PyList_GET_SIZE(objType->attributes); i++) {
+        attr = (cxoObjectAttr*) PyList_GET_ITEM(objType->attributes, i);
+        value = cxoObject_internalGetAttributeValue(objType, handle, attr,
+                deep);
+        if (!value) {
+            Py_DECREF(dict);
+            return NULL;
+        }
+        if (PyDict_SetItem(dict, attr->name, value) < 0) {
+            Py_DECREF(value);
+            Py_DECREF(dict);
+            return NULL;
+        }
+        Py_DECREF(value);
+    }
+
+    return dict;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObject_collectionToPython()
+//   Return the elements of the collection identified by the given handle as a
+// list or as a dictionary mapping indices to values. The element type is
+// resolved once for the whole collection. If a deep conversion is requested,
+// nested collections are returned as lists and nested records as
+// dictionaries.
+//-----------------------------------------------------------------------------
+PyObject *cxoObject_collectionToPython(cxoObjectType *objType,
+        dpiObject *handle, int asDict, int deep)
+{
+    char numberAsStringBuffer[CXO_MAX_NUMBER_CHARS];
+    PyObject *result, *key, *value;
+    dpiNativeTypeNum nativeTypeNum;
+    int32_t index, nextIndex;
+    int exists, isNumberAsBytes;
+    dpiData data;
+
+    // determine how elements are to be retrieved
+    if (cxoObject_prepareValue(objType->elementTransformNum,
+            objType->elementOracleTypeNum, &nativeTypeNum,
+            &isNumberAsBytes) < 0)
+        return NULL;
+
+    // create the result list or dictionary
+    result = (asDict) ? PyDict_New() : PyList_New(0);
+    if (!result)
+        return NULL;
+
+    // populate it with each of the elements in the collection
+    if (dpiObject_getFirstIndex(handle, &index, &exists) < 0) {
+        Py_DECREF(result);
+        return cxoError_raiseAndReturnNull();
+    }
+    while (exists) {
+        if (isNumberAsBytes) {
+            data.value.asBytes.ptr = numberAsStringBuffer;
+            data.value.asBytes.length = sizeof(numberAsStringBuffer);
+            data.value.asBytes.encoding = NULL;
+        }
+        if (dpiObject_getElementValueByIndex(handle, index, nativeTypeNum,
+                &data) < 0) {
+            Py_DECREF(result);
+            return cxoError_raiseAndReturnNull();
+        }
+        value = cxoObject_convertToPython(objType->connection,
+                objType->elementTransformNum, &data,
+                objType->elementObjectType, deep);
+        if (!value) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        if (asDict) {
+            key = PyLong_FromLong(index);
+            if (!key || PyDict_SetItem(result, key, value) < 0) {
+                Py_XDECREF(key);
+                Py_DECREF(value);
+                Py_DECREF(result);
+                return NULL;
+            }
+            Py_DECREF(key);
+        } else if (PyList_Append(result, value) < 0) {
+            Py_DECREF(value);
+            Py_DECREF(result);
+            return NULL;
+        }
+        Py_DECREF(value);
+        if (dpiObject_getNextIndex(handle, index, &nextIndex, &exists) < 0) {
+            Py_DECREF(result);
+            return cxoError_raiseAndReturnNull();
+        }
+        index = nextIndex;
+    }
+
+    return result;
 }
 
 
@@ -271,21 +433,16 @@ static PyObject *cxoObject_append(cxoObject *obj, PyObject *value)
 static PyObject *cxoObject_internalGetElementByIndex(cxoObject *obj,
         int32_t index)
 {
-    char numberAsStringBuffer[200], message[120];
-    dpiOracleTypeNum oracleTypeNum;
+    char numberAsStringBuffer[CXO_MAX_NUMBER_CHARS];
     dpiNativeTypeNum nativeTypeNum;
+    int isNumberAsBytes;
     dpiData data;
 
-    if (obj->objectType->elementTransformNum == CXO_TRANSFORM_UNSUPPORTED) {
-        snprintf(message, sizeof(message), "Oracle type %d not supported.",
-                obj->objectType->elementOracleTypeNum);
-        return cxoError_raiseFromString(cxoNotSupportedErrorException,
-                message);
-    }
-    cxoTransform_getTypeInfo(obj->objectType->elementTransformNum,
-            &oracleTypeNum, &nativeTypeNum);
-    if (oracleTypeNum == DPI_ORACLE_TYPE_NUMBER &&
-            nativeTypeNum == DPI_NATIVE_TYPE_BYTES) {
+    if (cxoObject_prepareValue(obj->objectType->elementTransformNum,
+            obj->objectType->elementOracleTypeNum, &nativeTypeNum,
+            &isNumberAsBytes) < 0)
+        return NULL;
+    if (isNumberAsBytes) {
         data.value.asBytes.ptr = numberAsStringBuffer;
         data.value.asBytes.length = sizeof(numberAsStringBuffer);
         data.value.asBytes.encoding = NULL;
@@ -293,106 +450,58 @@ static PyObject *cxoObject_internalGetElementByIndex(cxoObject *obj,
     if (dpiObject_getElementValueByIndex(obj->handle, index, nativeTypeNum,
                 &data) < 0)
         return cxoError_raiseAndReturnNull();
-    return cxoObject_convertToPython(obj, obj->objectType->elementTransformNum,
-            &data, obj->objectType->elementObjectType);
+    return cxoObject_convertToPython(obj->objectType->connection,
+            obj->objectType->elementTransformNum, &data,
+            obj->objectType->elementObjectType, 0);
 }
 
 
 //-----------------------------------------------------------------------------
 // cxoObject_asDict()
-//   Returns a collection as a dictionary. If the object is not a collection,
-// an error is returned.
+//   Returns a collection as a dictionary mapping indices to elements or, if the
+// object is not a collection, a dictionary mapping attribute names to values.
+// If a deep conversion is requested, nested collections are returned as lists
+// and nested objects as dictionaries.
 //-----------------------------------------------------------------------------
-static PyObject *cxoObject_asDict(cxoObject *obj, PyObject *args)
+static PyObject *cxoObject_asDict(cxoObject *obj, PyObject *args,
+        PyObject *keywordArgs)
 {
-    PyObject *dict, *key, *value;
-    int32_t index, nextIndex;
-    int exists;
+    static char *keywordList[] = { "deep", NULL };
+    PyObject *deepObj = NULL;
+    int deep;
 
-    // create the result dictionary
-    dict = PyDict_New();
-    if (!dict)
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|O", keywordList,
+            &deepObj))
         return NULL;
-
-    // populate it with each of the elements in the collection
-    if (dpiObject_getFirstIndex(obj->handle, &index, &exists) < 0) {
-        Py_DECREF(dict);
-        return cxoError_raiseAndReturnNull();
-    }
-    while (exists) {
-        value = cxoObject_internalGetElementByIndex(obj, index);
-        if (!value) {
-            Py_DECREF(dict);
-            return NULL;
-        }
-        key = PyLong_FromLong(index);
-        if (!key) {
-            Py_DECREF(value);
-            Py_DECREF(dict);
-            return NULL;
-        }
-        if (PyDict_SetItem(dict, key, value) < 0) {
-            Py_DECREF(key);
-            Py_DECREF(value);
-            Py_DECREF(dict);
-            return NULL;
-        }
-        Py_DECREF(key);
-        Py_DECREF(value);
-        if (dpiObject_getNextIndex(obj->handle, index, &nextIndex,
-                &exists) < 0) {
-            Py_DECREF(dict);
-            return cxoError_raiseAndReturnNull();
-        }
-        index = nextIndex;
-    }
-
-    return dict;
+    if (cxoUtils_getBooleanValue(deepObj, 0, &deep) < 0)
+        return NULL;
+    if (!obj->objectType->isCollection)
+        return cxoObject_recordToPython(obj->objectType, obj->handle, deep);
+    return cxoObject_collectionToPython(obj->objectType, obj->handle, 1,
+            deep);
 }
 
 
 //-----------------------------------------------------------------------------
 // cxoObject_asList()
 //   Returns a collection as a list of elements. If the object is not a
-// collection, an error is returned.
+// collection, an error is returned. If a deep conversion is requested, nested
+// collections are returned as lists and nested objects as dictionaries.
 //-----------------------------------------------------------------------------
-static PyObject *cxoObject_asList(cxoObject *obj, PyObject *args)
+static PyObject *cxoObject_asList(cxoObject *obj, PyObject *args,
+        PyObject *keywordArgs)
 {
-    PyObject *list, *elementValue;
-    int32_t index, nextIndex;
-    int exists;
+    static char *keywordList[] = { "deep", NULL };
+    PyObject *deepObj = NULL;
+    int deep;
 
-    // create the result list
-    list = PyList_New(0);
-    if (!list)
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|O", keywordList,
+            &deepObj))
         return NULL;
-
-    // populate it with each of the elements in the list
-    if (dpiObject_getFirstIndex(obj->handle, &index, &exists) < 0) {
-        Py_DECREF(list);
-        return cxoError_raiseAndReturnNull();
-    }
-    while (exists) {
-        elementValue = cxoObject_internalGetElementByIndex(obj, index);
-        if (!elementValue) {
-            Py_DECREF(list);
-            return NULL;
-        }
-        if (PyList_Append(list, elementValue) < 0) {
-            Py_DECREF(elementValue);
-            Py_DECREF(list);
-            return NULL;
-        }
-        Py_DECREF(elementValue);
-        if (dpiObject_getNextIndex(obj->handle, index, &nextIndex,
-                &exists) < 0) {
-            Py_DECREF(list);
-            return cxoError_raiseAndReturnNull();
-        }
-        index = nextIndex;
-    }
-
-    return list;
+    if (cxoUtils_getBooleanValue(deepObj, 0, &deep) < 0)
+        return NULL;
+    return cxoObject_collectionToPython(obj->objectType, obj->handle, 0,
+            deep);
 }
 
 
@@ -617,8 +726,10 @@ static PyObject *cxoObject_trim(cxoObject *obj, PyObject *args)
 //-----------------------------------------------------------------------------
 static PyMethodDef cxoObjectMethods[] = {
     { "append", (PyCFunction) cxoObject_append, METH_O },
-    { "asdict", (PyCFunction) cxoObject_asDict, METH_NOARGS },
-    { "aslist", (PyCFunction) cxoObject_asList, METH_NOARGS },
+    { "asdict", (PyCFunction) cxoObject_asDict,
+            METH_VARARGS | METH_KEYWORDS },
+    { "aslist", (PyCFunction) cxoObject_asList,
+            METH_VARARGS | METH_KEYWORDS },
     { "copy", (PyCFunction) cxoObject_copy, METH_NOARGS },
     { "delete", (PyCFunction) cxoObject_delete, METH_VARARGS },
     { "exists", (PyCFunction) cxoObject_exists, METH_VARARGS },
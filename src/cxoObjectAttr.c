@@ -72,6 +72,7 @@ cxoObjectAttr *cxoObjectAttr_new(cxoConnection *connection,
 //-----------------------------------------------------------------------------
 static void cxoObjectAttr_free(cxoObjectAttr *attr)
 {
+    PyObject_GC_UnTrack(attr);
     if (attr->handle) {
         dpiObjectAttr_release(attr->handle);
         attr->handle = NULL;
@@ -83,6 +84,19 @@ static void cxoObjectAttr_free(cxoObjectAttr *attr)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoObjectAttr_traverse()
+//   Traverse the objects referenced by the object attribute for the garbage
+// collector.
+//-----------------------------------------------------------------------------
+static int cxoObjectAttr_traverse(cxoObjectAttr *attr, visitproc visit,
+        void *arg)
+{
+    Py_VISIT(attr->objectType);
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoObjectAttr_getType()
 //   Return the type associated with the attribute. This is either an object
@@ -145,7 +159,8 @@ PyTypeObject cxoPyTypeObjectAttr = {
     .tp_basicsize = sizeof(cxoObjectAttr),
     .tp_dealloc = (destructor) cxoObjectAttr_free,
     .tp_repr = (reprfunc) cxoObjectAttr_repr,
-    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_traverse = (traverseproc) cxoObjectAttr_traverse,
     .tp_members = cxoMembers,
     .tp_getset = cxoCalcMembers
 };
@@ -19,46 +19,34 @@
 //   Initialize the object type with the information that is required.
 //-----------------------------------------------------------------------------
 static int cxoObjectType_initialize(cxoObjectType *objType,
-        cxoConnection *connection)
+        cxoConnection *connection, dpiObjectTypeInfo *info)
 {
     dpiObjectAttr **attributes;
-    dpiObjectTypeInfo info;
     cxoObjectAttr *attr;
     uint16_t i;
 
-    // get object type information
-    if (dpiObjectType_getInfo(objType->handle, &info) < 0)
-        return cxoError_raiseAndReturnInt();
     Py_INCREF(connection);
     objType->connection = connection;
-    objType->schema = PyUnicode_Decode(info.schema, info.schemaLength,
-            connection->encodingInfo.encoding, NULL);
-    if (!objType->schema)
-        return -1;
-    objType->name = PyUnicode_Decode(info.name, info.nameLength,
-            connection->encodingInfo.encoding, NULL);
-    if (!objType->name)
-        return -1;
-    objType->isCollection = info.isCollection;
-    if (info.isCollection) {
-        objType->elementOracleTypeNum = info.elementTypeInfo.oracleTypeNum;
+    objType->isCollection = info->isCollection;
+    if (info->isCollection) {
+        objType->elementOracleTypeNum = info->elementTypeInfo.oracleTypeNum;
         objType->elementTransformNum =
-                cxoTransform_getNumFromDataTypeInfo(&info.elementTypeInfo);
+                cxoTransform_getNumFromDataTypeInfo(&info->elementTypeInfo);
         objType->elementDbType =
                 cxoDbType_fromTransformNum(objType->elementTransformNum);
         if (!objType->elementDbType)
             return -1;
         Py_INCREF(objType->elementDbType);
-        if (info.elementTypeInfo.objectType) {
+        if (info->elementTypeInfo.objectType) {
             objType->elementObjectType = cxoObjectType_new(connection,
-                    info.elementTypeInfo.objectType);
+                    info->elementTypeInfo.objectType);
             if (!objType->elementObjectType)
                 return -1;
         }
     }
 
     // allocate the attribute list (temporary and permanent) and dictionary
-    objType->attributes = PyList_New(info.numAttributes);
+    objType->attributes = PyList_New(info->numAttributes);
     if (!objType->attributes)
         return -1;
     objType->attributesByName = PyDict_New();
@@ -66,19 +54,19 @@ static int cxoObjectType_initialize(cxoObjectType *objType,
         return -1;
 
     // get the list of attributes from DPI
-    attributes = PyMem_Malloc(sizeof(dpiObjectAttr*) * info.numAttributes);
+    attributes = PyMem_Malloc(sizeof(dpiObjectAttr*) * info->numAttributes);
     if (!attributes) {
         PyErr_NoMemory();
         return -1;
     }
-    if (dpiObjectType_getAttributes(objType->handle, info.numAttributes,
+    if (dpiObjectType_getAttributes(objType->handle, info->numAttributes,
             attributes) < 0) {
         PyMem_Free(attributes);
         return cxoError_raiseAndReturnInt();
     }
 
     // create attribute information for each attribute
-    for (i = 0; i < info.numAttributes; i++) {
+    for (i = 0; i < info->numAttributes; i++) {
         attr = cxoObjectAttr_new(connection, attributes[i]);
         if (!attr) {
             PyMem_Free(attributes);
@@ -96,29 +84,111 @@ static int cxoObjectType_initialize(cxoObjectType *objType,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoObjectType_cache()
+//   Add the object type to the cache maintained by the connection so that
+// subsequent lookups with the same key can return it directly. The cached
+// object types reference the connection; the cache is cleared when the
+// connection is closed or released back to its pool, and by the garbage
+// collector if the connection is simply dropped.
+//-----------------------------------------------------------------------------
+static int cxoObjectType_cache(cxoConnection *connection, PyObject *key,
+        cxoObjectType *objType)
+{
+    if (!connection->objectTypes) {
+        connection->objectTypes = PyDict_New();
+        if (!connection->objectTypes)
+            return -1;
+    }
+    return PyDict_SetItem(connection->objectTypes, key, (PyObject*) objType);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoObjectType_getCached()
+//   Return a new reference to the object type cached by the connection with
+// the given key or NULL if no such object type has been cached.
+//-----------------------------------------------------------------------------
+static cxoObjectType *cxoObjectType_getCached(cxoConnection *connection,
+        PyObject *key)
+{
+    cxoObjectType *objType;
+
+    if (!connection->objectTypes)
+        return NULL;
+    objType = (cxoObjectType*) PyDict_GetItem(connection->objectTypes, key);
+    Py_XINCREF(objType);
+    return objType;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoObjectType_new()
-//   Allocate a new object type.
+//   Return the object type for the given handle. The connection caches object
+// types by schema and name so the attribute and element type information is
+// only built the first time a type is encountered on the connection.
 //-----------------------------------------------------------------------------
 cxoObjectType *cxoObjectType_new(cxoConnection *connection,
         dpiObjectType *handle)
 {
+    PyObject *schema, *name, *key;
     cxoObjectType *objType;
+    dpiObjectTypeInfo info;
+
+    // get object type information and build the key used for the cache
+    if (dpiObjectType_getInfo(handle, &info) < 0)
+        return (cxoObjectType*) cxoError_raiseAndReturnNull();
+    schema = PyUnicode_Decode(info.schema, info.schemaLength,
+            connection->encodingInfo.encoding, NULL);
+    if (!schema)
+        return NULL;
+    name = PyUnicode_Decode(info.name, info.nameLength,
+            connection->encodingInfo.encoding, NULL);
+    if (!name) {
+        Py_DECREF(schema);
+        return NULL;
+    }
+    key = PyTuple_Pack(2, schema, name);
+    if (!key) {
+        Py_DECREF(schema);
+        Py_DECREF(name);
+        return NULL;
+    }
+
+    // return the cached object type, if one is available
+    objType = cxoObjectType_getCached(connection, key);
+    if (objType) {
+        Py_DECREF(schema);
+        Py_DECREF(name);
+        Py_DECREF(key);
+        return objType;
+    }
 
+    // otherwise, create a new object type
     objType = (cxoObjectType*)
             cxoPyTypeObjectType.tp_alloc(&cxoPyTypeObjectType, 0);
-    if (!objType)
+    if (!objType) {
+        Py_DECREF(schema);
+        Py_DECREF(name);
+        Py_DECREF(key);
         return NULL;
+    }
+    objType->schema = schema;
+    objType->name = name;
     if (dpiObjectType_addRef(handle) < 0) {
         Py_DECREF(objType);
+        Py_DECREF(key);
         cxoError_raiseAndReturnNull();
         return NULL;
     }
     objType->handle = handle;
-    if (cxoObjectType_initialize(objType, connection) < 0) {
+    if (cxoObjectType_initialize(objType, connection, &info) < 0 ||
+            cxoObjectType_cache(connection, key, objType) < 0) {
         Py_DECREF(objType);
+        Py_DECREF(key);
         return NULL;
     }
+    Py_DECREF(key);
 
     return objType;
 }
@@ -126,7 +196,9 @@ cxoObjectType *cxoObjectType_new(cxoConnection *connection,
 
 //-----------------------------------------------------------------------------
 // cxoObjectType_newByName()
-//   Create a new object type given its name.
+//   Create a new object type given its name. The name as supplied is also
+// cached on the connection so that repeated lookups avoid a round trip to the
+// database.
 //-----------------------------------------------------------------------------
 cxoObjectType *cxoObjectType_newByName(cxoConnection *connection,
         PyObject *name)
@@ -136,6 +208,11 @@ cxoObjectType *cxoObjectType_newByName(cxoConnection *connection,
     cxoBuffer buffer;
     int status;
 
+    if (PyUnicode_Check(name)) {
+        objType = cxoObjectType_getCached(connection, name);
+        if (objType)
+            return objType;
+    }
     if (cxoBuffer_fromObject(&buffer, name,
             connection->encodingInfo.encoding) < 0)
         return NULL;
@@ -146,6 +223,11 @@ cxoObjectType *cxoObjectType_newByName(cxoConnection *connection,
         return (cxoObjectType*) cxoError_raiseAndReturnNull();
     objType = cxoObjectType_new(connection, handle);
     dpiObjectType_release(handle);
+    if (objType && PyUnicode_Check(name) &&
+            cxoObjectType_cache(connection, name, objType) < 0) {
+        Py_DECREF(objType);
+        return NULL;
+    }
     return objType;
 }
 
@@ -156,6 +238,9 @@ cxoObjectType *cxoObjectType_newByName(cxoConnection *connection,
 //-----------------------------------------------------------------------------
 static void cxoObjectType_free(cxoObjectType *objType)
 {
+    PyObject_GC_UnTrack(objType);
+    if (objType->weakRefList)
+        PyObject_ClearWeakRefs((PyObject*) objType);
     if (objType->handle) {
         dpiObjectType_release(objType->handle);
         objType->handle = NULL;
@@ -171,6 +256,23 @@ static void cxoObjectType_free(cxoObjectType *objType)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoObjectType_traverse()
+//   Traverse the objects referenced by the object type. The connection caches
+// the object types that reference it so the garbage collector must be able to
+// find these references.
+//-----------------------------------------------------------------------------
+static int cxoObjectType_traverse(cxoObjectType *objType, visitproc visit,
+        void *arg)
+{
+    Py_VISIT(objType->connection);
+    Py_VISIT(objType->attributes);
+    Py_VISIT(objType->attributesByName);
+    Py_VISIT(objType->elementObjectType);
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoObjectType_getElementType()
 //   Return the element type associated with a collection. This is either an
@@ -342,7 +444,9 @@ PyTypeObject cxoPyTypeObjectType = {
     .tp_dealloc = (destructor) cxoObjectType_free,
     .tp_repr = (reprfunc) cxoObjectType_repr,
     .tp_call = (ternaryfunc) cxoObjectType_newObject,
-    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .tp_traverse = (traverseproc) cxoObjectType_traverse,
+    .tp_weaklistoffset = offsetof(cxoObjectType, weakRefList),
     .tp_methods = cxoMethods,
     .tp_members = cxoMembers,
     .tp_getset = cxoCalcMembers,
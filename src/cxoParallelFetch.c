@@ -0,0 +1,396 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch.c
+//   Defines the routines for fetching the rows of a partitioned query in
+// parallel using several sessions acquired from a session pool. The query is
+// executed once for each partition with the parameters supplied for that
+// partition. Each native worker thread acquires a session and then executes
+// partitions and fetches their rows in batches until no partitions remain.
+// The worker threads hold the GIL only while they are creating Python
+// objects; executes and fetches release it so that the round trips performed
+// by the workers take place concurrently. The batches are handed to the
+// iterator returned to the caller in the order in which they are fetched.
+// The number of batches that have been fetched but not yet returned by the
+// iterator is limited so that a slow consumer does not cause all of the rows
+// to be retained in memory.
+//
+// As the worker threads may outlive the iterator, the state shared by the
+// iterator and the worker threads is kept in a separate structure which is
+// reference counted; the counts are only manipulated with the GIL held.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+#ifndef PYTHREAD_INVALID_THREAD_ID
+#define PYTHREAD_INVALID_THREAD_ID      ((unsigned long) -1)
+#endif
+
+// number of microseconds to wait before checking for interrupts or for space
+// to become available for more batches
+#define CXO_PARALLEL_FETCH_WAIT_MICROSECONDS    100000
+
+// number of batches that may be pending per session
+#define CXO_PARALLEL_FETCH_PENDING_PER_SESSION  2
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_signal()
+//   Signal an event. Each event is a lock which is released when the event is
+// signalled and acquired by the thread waiting for it; the flag tracks the
+// state of the lock and is only examined or changed with the GIL held.
+//-----------------------------------------------------------------------------
+static void cxoParallelFetch_signal(PyThread_type_lock event, int *signalled)
+{
+    if (!*signalled) {
+        *signalled = 1;
+        PyThread_release_lock(event);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_wait()
+//   Wait for an event to be signalled or for the timeout to expire. The GIL is
+// released while waiting. The caller must check the condition it is waiting
+// for when this function returns.
+//-----------------------------------------------------------------------------
+static void cxoParallelFetch_wait(PyThread_type_lock event, int *signalled)
+{
+    PyLockStatus status;
+
+    Py_BEGIN_ALLOW_THREADS
+    status = PyThread_acquire_lock_timed(event,
+            CXO_PARALLEL_FETCH_WAIT_MICROSECONDS, 0);
+    Py_END_ALLOW_THREADS
+    if (status == PY_LOCK_ACQUIRED)
+        *signalled = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_releaseState()
+//   Release a reference to the shared state and free it once the last
+// reference has been released. This is called with the GIL held.
+//-----------------------------------------------------------------------------
+static void cxoParallelFetch_releaseState(cxoParallelFetchState *state)
+{
+    if (--state->refCount > 0)
+        return;
+    Py_CLEAR(state->pool);
+    Py_CLEAR(state->statement);
+    Py_CLEAR(state->partitions);
+    Py_CLEAR(state->results);
+    Py_CLEAR(state->errorType);
+    Py_CLEAR(state->errorValue);
+    Py_CLEAR(state->errorTraceback);
+    if (state->dataEvent)
+        PyThread_free_lock(state->dataEvent);
+    if (state->spaceEvent)
+        PyThread_free_lock(state->spaceEvent);
+    PyMem_Free(state);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_waitForSpace()
+//   Wait until the number of pending batches is below the limit. Returns -1
+// if the workers have been asked to stop.
+//-----------------------------------------------------------------------------
+static int cxoParallelFetch_waitForSpace(cxoParallelFetchState *state)
+{
+    while (!state->stop &&
+            PyList_GET_SIZE(state->results) >= (Py_ssize_t) state->maxPending)
+        cxoParallelFetch_wait(state->spaceEvent, &state->spaceSignalled);
+    return (state->stop) ? -1 : 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_fetchPartition()
+//   Execute the query for the partition and add the batches of rows fetched
+// to the list of pending batches. If the workers are asked to stop, the
+// remaining rows are not fetched.
+//-----------------------------------------------------------------------------
+static int cxoParallelFetch_fetchPartition(cxoParallelFetchState *state,
+        cxoCursor *cursor, Py_ssize_t partitionNum)
+{
+    PyObject *parameters, *result, *batch;
+    uint64_t rowCount;
+    int status;
+
+    // execute the query with the parameters for the partition
+    parameters = PyTuple_GET_ITEM(state->partitions, partitionNum);
+    result = PyObject_CallMethod((PyObject*) cursor, "execute", "OO",
+            state->statement, parameters);
+    if (!result)
+        return -1;
+    Py_DECREF(result);
+
+    // fetch the rows in batches until none remain
+    while (cxoParallelFetch_waitForSpace(state) == 0) {
+        rowCount = cursor->rowCount;
+        if (state->columnar) {
+            batch = PyObject_CallMethod((PyObject*) cursor, "fetchcolumns",
+                    "I", state->batchSize);
+        } else {
+            batch = PyObject_CallMethod((PyObject*) cursor, "fetchmany", "I",
+                    state->batchSize);
+        }
+        if (!batch)
+            return -1;
+        if (cursor->rowCount == rowCount) {
+            Py_DECREF(batch);
+            break;
+        }
+        result = Py_BuildValue("(nN)", partitionNum, batch);
+        if (!result)
+            return -1;
+        status = PyList_Append(state->results, result);
+        Py_DECREF(result);
+        if (status < 0)
+            return -1;
+        cxoParallelFetch_signal(state->dataEvent, &state->dataSignalled);
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_work()
+//   Acquire a session from the pool and fetch the rows of partitions until
+// none remain. The session is released back to the pool when done.
+//-----------------------------------------------------------------------------
+static int cxoParallelFetch_work(cxoParallelFetchState *state)
+{
+    PyObject *conn, *cursor, *temp;
+    Py_ssize_t partitionNum;
+    int status = 0;
+
+    // acquire a session and create a cursor for performing the queries
+    conn = PyObject_CallMethod((PyObject*) state->pool, "acquire", NULL);
+    if (!conn)
+        return -1;
+    cursor = PyObject_CallMethod(conn, "cursor", NULL);
+    if (!cursor) {
+        Py_DECREF(conn);
+        return -1;
+    }
+    ((cxoCursor*) cursor)->arraySize = state->batchSize;
+
+    // fetch partitions until none remain
+    while (status == 0 && !state->stop) {
+        partitionNum = state->nextPartition;
+        if (partitionNum >= PyTuple_GET_SIZE(state->partitions))
+            break;
+        state->nextPartition++;
+        status = cxoParallelFetch_fetchPartition(state, (cxoCursor*) cursor,
+                partitionNum);
+    }
+
+    // release the session back to the pool
+    Py_DECREF(cursor);
+    temp = PyObject_CallMethod((PyObject*) state->pool, "release", "O", conn);
+    Py_DECREF(conn);
+    if (!temp)
+        return -1;
+    Py_DECREF(temp);
+    return status;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_threadMain()
+//   Main routine for each of the native worker threads. The first error that
+// takes place in any worker is retained so that it can be raised by the
+// iterator; all of the workers are then asked to stop.
+//-----------------------------------------------------------------------------
+static void cxoParallelFetch_threadMain(void *arg)
+{
+    cxoParallelFetchState *state = (cxoParallelFetchState*) arg;
+    PyGILState_STATE gstate;
+
+    gstate = PyGILState_Ensure();
+    if (cxoParallelFetch_work(state) < 0) {
+        if (!state->errorType) {
+            PyErr_Fetch(&state->errorType, &state->errorValue,
+                    &state->errorTraceback);
+        } else {
+            PyErr_Clear();
+        }
+        state->stop = 1;
+    }
+    state->numActive--;
+    cxoParallelFetch_signal(state->dataEvent, &state->dataSignalled);
+    cxoParallelFetch_signal(state->spaceEvent, &state->spaceSignalled);
+    cxoParallelFetch_releaseState(state);
+    PyGILState_Release(gstate);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_new()
+//   Create a new parallel fetch and start the worker threads.
+//-----------------------------------------------------------------------------
+cxoParallelFetch *cxoParallelFetch_new(cxoSessionPool *pool,
+        PyObject *statement, PyObject *partitions, uint32_t numSessions,
+        uint32_t batchSize, int columnar)
+{
+    cxoParallelFetchState *state;
+    cxoParallelFetch *fetch;
+    uint32_t i;
+
+    // create the iterator and the shared state
+    fetch = (cxoParallelFetch*)
+            cxoPyTypeParallelFetch.tp_alloc(&cxoPyTypeParallelFetch, 0);
+    if (!fetch)
+        return NULL;
+    state = PyMem_Malloc(sizeof(cxoParallelFetchState));
+    if (!state) {
+        Py_DECREF(fetch);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    memset(state, 0, sizeof(cxoParallelFetchState));
+    state->refCount = 1;
+    fetch->state = state;
+    Py_INCREF(pool);
+    state->pool = pool;
+    Py_INCREF(statement);
+    state->statement = statement;
+    state->batchSize = batchSize;
+    state->maxPending = numSessions * CXO_PARALLEL_FETCH_PENDING_PER_SESSION;
+    state->columnar = columnar;
+    state->partitions = PySequence_Tuple(partitions);
+    if (!state->partitions) {
+        Py_DECREF(fetch);
+        return NULL;
+    }
+    state->results = PyList_New(0);
+    if (!state->results) {
+        Py_DECREF(fetch);
+        return NULL;
+    }
+
+    // create the events; they start out not signalled (acquired)
+    state->dataEvent = PyThread_allocate_lock();
+    state->spaceEvent = PyThread_allocate_lock();
+    if (!state->dataEvent || !state->spaceEvent) {
+        Py_DECREF(fetch);
+        PyErr_NoMemory();
+        return NULL;
+    }
+    PyThread_acquire_lock(state->dataEvent, WAIT_LOCK);
+    PyThread_acquire_lock(state->spaceEvent, WAIT_LOCK);
+
+    // start the worker threads; no more are started than there are
+    // partitions
+    if (numSessions > (uint32_t) PyTuple_GET_SIZE(state->partitions))
+        numSessions = (uint32_t) PyTuple_GET_SIZE(state->partitions);
+#if PY_VERSION_HEX < 0x03070000
+    PyEval_InitThreads();
+#endif
+    for (i = 0; i < numSessions; i++) {
+        state->refCount++;
+        state->numActive++;
+        if (PyThread_start_new_thread(cxoParallelFetch_threadMain,
+                state) == PYTHREAD_INVALID_THREAD_ID) {
+            state->refCount--;
+            state->numActive--;
+            if (i > 0)
+                break;
+            Py_DECREF(fetch);
+            cxoError_raiseFromString(cxoInterfaceErrorException,
+                    "unable to start worker thread");
+            return NULL;
+        }
+    }
+
+    return fetch;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_free()
+//   Free the memory associated with the parallel fetch. Any worker threads
+// that are still running are asked to stop.
+//-----------------------------------------------------------------------------
+static void cxoParallelFetch_free(cxoParallelFetch *fetch)
+{
+    cxoParallelFetchState *state = fetch->state;
+
+    if (state) {
+        state->stop = 1;
+        cxoParallelFetch_signal(state->spaceEvent, &state->spaceSignalled);
+        cxoParallelFetch_releaseState(state);
+        fetch->state = NULL;
+    }
+    Py_TYPE(fetch)->tp_free((PyObject*) fetch);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoParallelFetch_next()
+//   Return the next batch of rows as a 2-tuple containing the index of the
+// partition and the batch, waiting for one to be fetched if needed. Iteration
+// stops when all partitions have been fetched. If any of the workers failed,
+// the error is raised.
+//-----------------------------------------------------------------------------
+static PyObject *cxoParallelFetch_next(cxoParallelFetch *fetch)
+{
+    cxoParallelFetchState *state = fetch->state;
+    PyObject *result;
+
+    while (1) {
+
+        // raise the error that took place in a worker, if applicable
+        if (state->errorType) {
+            PyErr_Restore(state->errorType, state->errorValue,
+                    state->errorTraceback);
+            state->errorType = state->errorValue = NULL;
+            state->errorTraceback = NULL;
+            return NULL;
+        }
+
+        // return the first pending batch, if there is one
+        if (PyList_GET_SIZE(state->results) > 0) {
+            result = PyList_GET_ITEM(state->results, 0);
+            Py_INCREF(result);
+            if (PyList_SetSlice(state->results, 0, 1, NULL) < 0) {
+                Py_DECREF(result);
+                return NULL;
+            }
+            cxoParallelFetch_signal(state->spaceEvent, &state->spaceSignalled);
+            return result;
+        }
+
+        // if all of the workers have finished, nothing more to return
+        if (state->numActive == 0)
+            return NULL;
+
+        // wait for more batches, checking for interrupts periodically
+        cxoParallelFetch_wait(state->dataEvent, &state->dataSignalled);
+        if (PyErr_CheckSignals() < 0)
+            return NULL;
+
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// Python type declaration
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypeParallelFetch = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.ParallelFetch",
+    .tp_basicsize = sizeof(cxoParallelFetch),
+    .tp_dealloc = (destructor) cxoParallelFetch_free,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc) cxoParallelFetch_next
+};
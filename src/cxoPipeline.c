@@ -0,0 +1,739 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoPipeline.c
+//   Defines the routines for handling pipelines, which collect a number of
+// operations and perform them one after the other when run, returning the
+// results in order. Consecutive DML statements (and a commit following them)
+// are bundled into a single anonymous PL/SQL block which executes each of
+// them with EXECUTE IMMEDIATE so that they require only one round trip. The
+// statements and their values are passed as bind variables so the text of the
+// block depends only on the number of statements and values.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+// maximum length (in characters) of a statement that can be bundled; the
+// statement is bound as the PL/SQL string executed by EXECUTE IMMEDIATE, which
+// is limited to 32767 bytes, and a character may need up to 4 bytes in UTF-8
+// so this is 32767 / 4, rounded down; longer statements are executed on their
+// own instead
+#define CXO_PIPELINE_MAX_BUNDLED_LENGTH     8191
+
+// default number of rows returned by fetchmany()
+#define CXO_PIPELINE_DEFAULT_NUM_ROWS       100
+
+//-----------------------------------------------------------------------------
+// types of operations that can be added to a pipeline
+//-----------------------------------------------------------------------------
+typedef enum {
+    CXO_PIPELINE_OP_EXECUTE = 0,
+    CXO_PIPELINE_OP_FETCH_ONE,
+    CXO_PIPELINE_OP_FETCH_MANY,
+    CXO_PIPELINE_OP_FETCH_ALL,
+    CXO_PIPELINE_OP_COMMIT
+} cxoPipelineOpType;
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_new()
+//   Create a new pipeline for the connection.
+//-----------------------------------------------------------------------------
+cxoPipeline *cxoPipeline_new(cxoConnection *connection)
+{
+    cxoPipeline *pipeline;
+
+    pipeline = (cxoPipeline*)
+            cxoPyTypePipeline.tp_alloc(&cxoPyTypePipeline, 0);
+    if (!pipeline)
+        return NULL;
+    Py_INCREF(connection);
+    pipeline->connection = connection;
+    pipeline->operations = PyList_New(0);
+    if (!pipeline->operations) {
+        Py_DECREF(pipeline);
+        return NULL;
+    }
+
+    return pipeline;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_free()
+//   Free the memory associated with the pipeline.
+//-----------------------------------------------------------------------------
+static void cxoPipeline_free(cxoPipeline *pipeline)
+{
+    Py_CLEAR(pipeline->connection);
+    Py_CLEAR(pipeline->operations);
+    Py_TYPE(pipeline)->tp_free((PyObject*) pipeline);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_length()
+//   Return the number of operations in the pipeline.
+//-----------------------------------------------------------------------------
+static Py_ssize_t cxoPipeline_length(cxoPipeline *pipeline)
+{
+    return PyList_GET_SIZE(pipeline->operations);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_addOperation()
+//   Add an operation to the pipeline. Each operation is stored as a tuple
+// containing the type of operation, the statement, the parameters and the
+// number of rows to fetch.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_addOperation(cxoPipeline *pipeline,
+        cxoPipelineOpType opType, PyObject *statement, PyObject *parameters,
+        int numRows)
+{
+    PyObject *op;
+    int status;
+
+    if (statement && !PyUnicode_Check(statement)) {
+        PyErr_SetString(PyExc_TypeError, "expecting a string");
+        return NULL;
+    }
+    if (!parameters)
+        parameters = Py_None;
+    if (parameters != Py_None && !PyDict_Check(parameters) &&
+            !PySequence_Check(parameters)) {
+        PyErr_SetString(PyExc_TypeError,
+                "expecting a dictionary or sequence");
+        return NULL;
+    }
+    op = Py_BuildValue("(iOOi)", opType, (statement) ? statement : Py_None,
+            parameters, numRows);
+    if (!op)
+        return NULL;
+    status = PyList_Append(pipeline->operations, op);
+    Py_DECREF(op);
+    if (status < 0)
+        return NULL;
+
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_addStatement()
+//   Parse the arguments for an operation that requires a statement and
+// optional parameters and add the operation to the pipeline.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_addStatement(cxoPipeline *pipeline,
+        cxoPipelineOpType opType, PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "statement", "parameters", NULL };
+    PyObject *statement, *parameters = NULL;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|O", keywordList,
+            &statement, &parameters))
+        return NULL;
+    return cxoPipeline_addOperation(pipeline, opType, statement, parameters,
+            0);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_execute()
+//   Add the execution of a statement to the pipeline.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_execute(cxoPipeline *pipeline, PyObject *args,
+        PyObject *keywordArgs)
+{
+    return cxoPipeline_addStatement(pipeline, CXO_PIPELINE_OP_EXECUTE, args,
+            keywordArgs);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_fetchOne()
+//   Add the execution of a query returning its first row to the pipeline.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_fetchOne(cxoPipeline *pipeline, PyObject *args,
+        PyObject *keywordArgs)
+{
+    return cxoPipeline_addStatement(pipeline, CXO_PIPELINE_OP_FETCH_ONE, args,
+            keywordArgs);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_fetchMany()
+//   Add the execution of a query returning a number of its rows to the
+// pipeline.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_fetchMany(cxoPipeline *pipeline, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "statement", "parameters", "numRows",
+            NULL };
+    PyObject *statement, *parameters = NULL;
+    int numRows = CXO_PIPELINE_DEFAULT_NUM_ROWS;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|Oi", keywordList,
+            &statement, &parameters, &numRows))
+        return NULL;
+    if (numRows <= 0) {
+        PyErr_SetString(PyExc_ValueError, "numRows must be positive");
+        return NULL;
+    }
+    return cxoPipeline_addOperation(pipeline, CXO_PIPELINE_OP_FETCH_MANY,
+            statement, parameters, numRows);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_fetchAll()
+//   Add the execution of a query returning all of its rows to the pipeline.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_fetchAll(cxoPipeline *pipeline, PyObject *args,
+        PyObject *keywordArgs)
+{
+    return cxoPipeline_addStatement(pipeline, CXO_PIPELINE_OP_FETCH_ALL, args,
+            keywordArgs);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_commit()
+//   Add a commit to the pipeline.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_commit(cxoPipeline *pipeline, PyObject *args)
+{
+    return cxoPipeline_addOperation(pipeline, CXO_PIPELINE_OP_COMMIT, NULL,
+            NULL, 0);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_clear()
+//   Remove all operations from the pipeline.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_clear(cxoPipeline *pipeline, PyObject *args)
+{
+    if (PyList_SetSlice(pipeline->operations, 0,
+            PyList_GET_SIZE(pipeline->operations), NULL) < 0)
+        return NULL;
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_isBundledValue()
+//   Return whether the value can be passed to a statement executed with
+// EXECUTE IMMEDIATE. Variables (which may be used for output), arrays and
+// booleans (which are not SQL types) are excluded.
+//-----------------------------------------------------------------------------
+static int cxoPipeline_isBundledValue(PyObject *value)
+{
+    return (!PyBool_Check(value) && !PyList_Check(value) &&
+            !PyObject_TypeCheck(value, &cxoPyTypeVar));
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_getBundledValues()
+//   Determine if the operation can be bundled with others and, if so, return
+// the list of values to pass to the statement in the order in which its bind
+// variables appear. Only DML statements without a RETURNING clause are
+// bundled. Values bound by name are only bundled if each bind variable
+// appears once in the statement and is found in the dictionary using the name
+// as written in the statement or in lowercase; in all other cases the
+// operation is simply performed on its own. The statement is prepared on the
+// cursor in order to examine it.
+//-----------------------------------------------------------------------------
+static int cxoPipeline_getBundledValues(cxoCursor *cursor, PyObject *op,
+        PyObject **values)
+{
+    PyObject *statement, *parameters, *names, *name, *value, *temp;
+    uint32_t numBinds;
+    Py_ssize_t i;
+
+    // only statements which are not too long can be bundled
+    *values = NULL;
+    statement = PyTuple_GET_ITEM(op, 1);
+    parameters = PyTuple_GET_ITEM(op, 2);
+    if (PyUnicode_GET_LENGTH(statement) > CXO_PIPELINE_MAX_BUNDLED_LENGTH)
+        return 0;
+
+    // prepare the statement and determine if it is a suitable DML statement
+    temp = PyObject_CallMethod((PyObject*) cursor, "prepare", "(O)",
+            statement);
+    if (!temp)
+        return -1;
+    Py_DECREF(temp);
+    if (!cursor->stmtInfo.isDML || cursor->stmtInfo.isReturning)
+        return 0;
+    if (dpiStmt_getBindCount(cursor->handle, &numBinds) < 0)
+        return cxoError_raiseAndReturnInt();
+
+    // values bound by position are passed in the same order
+    if (parameters == Py_None || PyList_Check(parameters) ||
+            PyTuple_Check(parameters)) {
+        *values = (parameters == Py_None) ? PyList_New(0) :
+                PySequence_List(parameters);
+        if (!*values)
+            return -1;
+        if (PyList_GET_SIZE(*values) != (Py_ssize_t) numBinds) {
+            Py_CLEAR(*values);
+            return 0;
+        }
+        for (i = 0; i < (Py_ssize_t) numBinds; i++) {
+            if (!cxoPipeline_isBundledValue(PyList_GET_ITEM(*values, i))) {
+                Py_CLEAR(*values);
+                return 0;
+            }
+        }
+        return 0;
+    }
+
+    // values bound by name are passed in the order of the bind variables
+    if (!PyDict_Check(parameters) ||
+            PyDict_Size(parameters) != (Py_ssize_t) numBinds)
+        return 0;
+    names = PyObject_CallMethod((PyObject*) cursor, "bindnames", NULL);
+    if (!names)
+        return -1;
+    if (PyList_GET_SIZE(names) != (Py_ssize_t) numBinds) {
+        Py_DECREF(names);
+        return 0;
+    }
+    *values = PyList_New(numBinds);
+    if (!*values) {
+        Py_DECREF(names);
+        return -1;
+    }
+    for (i = 0; i < (Py_ssize_t) numBinds; i++) {
+        name = PyList_GET_ITEM(names, i);
+        value = PyDict_GetItem(parameters, name);
+        if (!value) {
+            temp = PyObject_CallMethod(name, "lower", NULL);
+            if (!temp) {
+                Py_DECREF(names);
+                Py_CLEAR(*values);
+                return -1;
+            }
+            value = PyDict_GetItem(parameters, temp);
+            Py_DECREF(temp);
+        }
+        if (!value || !cxoPipeline_isBundledValue(value)) {
+            Py_DECREF(names);
+            Py_CLEAR(*values);
+            return 0;
+        }
+        Py_INCREF(value);
+        PyList_SET_ITEM(*values, i, value);
+    }
+    Py_DECREF(names);
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_addBundledStatement()
+//   Add the PL/SQL needed to execute one bundled statement to the list of
+// lines making up the anonymous block. The bind variables for the statement,
+// its values and its row count are added to the dictionary of bind variables
+// and the variable which will hold the row count is returned.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_addBundledStatement(cxoCursor *cursor,
+        PyObject *lines, PyObject *bindVars, Py_ssize_t stmtNum,
+        PyObject *statement, PyObject *values)
+{
+    PyObject *line, *name, *rowCountVar;
+    Py_ssize_t i;
+
+    // bind the statement itself
+    name = PyUnicode_FromFormat("s%zd", stmtNum);
+    if (!name)
+        return NULL;
+    if (PyDict_SetItem(bindVars, name, statement) < 0) {
+        Py_DECREF(name);
+        return NULL;
+    }
+    Py_DECREF(name);
+    line = PyUnicode_FromFormat("    execute immediate :s%zd", stmtNum);
+    if (!line)
+        return NULL;
+
+    // bind each of the values and pass them to the statement
+    for (i = 0; i < PyList_GET_SIZE(values); i++) {
+        name = PyUnicode_FromFormat("b%zd_%zd", stmtNum, i + 1);
+        if (!name) {
+            Py_DECREF(line);
+            return NULL;
+        }
+        if (PyDict_SetItem(bindVars, name, PyList_GET_ITEM(values, i)) < 0) {
+            Py_DECREF(name);
+            Py_DECREF(line);
+            return NULL;
+        }
+        Py_DECREF(name);
+        PyUnicode_AppendAndDel(&line, PyUnicode_FromFormat("%s:b%zd_%zd",
+                (i == 0) ? " using " : ", ", stmtNum, i + 1));
+        if (!line)
+            return NULL;
+    }
+    PyUnicode_AppendAndDel(&line, PyUnicode_FromFormat(
+            ";\n    :r%zd := sql%%rowcount;", stmtNum));
+    if (!line)
+        return NULL;
+    if (PyList_Append(lines, line) < 0) {
+        Py_DECREF(line);
+        return NULL;
+    }
+    Py_DECREF(line);
+
+    // bind a variable to hold the row count
+    rowCountVar = PyObject_CallMethod((PyObject*) cursor, "var", "(O)",
+            &PyLong_Type);
+    if (!rowCountVar)
+        return NULL;
+    name = PyUnicode_FromFormat("r%zd", stmtNum);
+    if (!name || PyDict_SetItem(bindVars, name, rowCountVar) < 0) {
+        Py_XDECREF(name);
+        Py_DECREF(rowCountVar);
+        return NULL;
+    }
+    Py_DECREF(name);
+
+    return rowCountVar;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_runBundle()
+//   Run the operations starting at the given position as a single anonymous
+// PL/SQL block, if at least two of them (or one of them followed by a commit)
+// can be bundled. The row count of each statement is placed in the list of
+// results. The number of operations that were performed is returned (zero if
+// no bundle was run).
+//-----------------------------------------------------------------------------
+static int cxoPipeline_runBundle(PyObject *operations, cxoCursor *cursor,
+        Py_ssize_t pos, PyObject *results, Py_ssize_t *numProcessed)
+{
+    PyObject *allValues, *values, *op, *lines, *bindVars, *rowCountVars;
+    PyObject *var, *block, *separator, *temp;
+    Py_ssize_t i, numOps, numStatements;
+    int includesCommit = 0;
+    long opType;
+
+    // determine which operations can be bundled
+    *numProcessed = 0;
+    allValues = PyList_New(0);
+    if (!allValues)
+        return -1;
+    numOps = PyList_GET_SIZE(operations);
+    for (i = pos; i < numOps; i++) {
+        op = PyList_GET_ITEM(operations, i);
+        opType = PyLong_AsLong(PyTuple_GET_ITEM(op, 0));
+        if (opType == CXO_PIPELINE_OP_COMMIT) {
+            includesCommit = (PyList_GET_SIZE(allValues) > 0);
+            break;
+        }
+        if (opType != CXO_PIPELINE_OP_EXECUTE)
+            break;
+        if (cxoPipeline_getBundledValues(cursor, op, &values) < 0) {
+            Py_DECREF(allValues);
+            return -1;
+        }
+        if (!values)
+            break;
+        if (PyList_Append(allValues, values) < 0) {
+            Py_DECREF(values);
+            Py_DECREF(allValues);
+            return -1;
+        }
+        Py_DECREF(values);
+    }
+    numStatements = PyList_GET_SIZE(allValues);
+    if (numStatements < 2 && !includesCommit) {
+        Py_DECREF(allValues);
+        return 0;
+    }
+
+    // build the anonymous block and its bind variables
+    block = separator = NULL;
+    lines = Py_BuildValue("[s]", "begin");
+    bindVars = PyDict_New();
+    rowCountVars = PyList_New(numStatements);
+    if (!lines || !bindVars || !rowCountVars)
+        goto error;
+    for (i = 0; i < numStatements; i++) {
+        op = PyList_GET_ITEM(operations, pos + i);
+        var = cxoPipeline_addBundledStatement(cursor, lines, bindVars, i + 1,
+                PyTuple_GET_ITEM(op, 1), PyList_GET_ITEM(allValues, i));
+        if (!var)
+            goto error;
+        PyList_SET_ITEM(rowCountVars, i, var);
+    }
+    if (includesCommit) {
+        temp = PyUnicode_FromString("    commit;");
+        if (!temp || PyList_Append(lines, temp) < 0) {
+            Py_XDECREF(temp);
+            goto error;
+        }
+        Py_DECREF(temp);
+    }
+    temp = PyUnicode_FromString("end;");
+    if (!temp || PyList_Append(lines, temp) < 0) {
+        Py_XDECREF(temp);
+        goto error;
+    }
+    Py_DECREF(temp);
+    separator = PyUnicode_FromString("\n");
+    if (!separator)
+        goto error;
+    block = PyUnicode_Join(separator, lines);
+    if (!block)
+        goto error;
+
+    // execute the block and populate the results
+    temp = PyObject_CallMethod((PyObject*) cursor, "execute", "(OO)", block,
+            bindVars);
+    if (!temp)
+        goto error;
+    Py_DECREF(temp);
+    for (i = 0; i < numStatements; i++) {
+        temp = PyObject_CallMethod(PyList_GET_ITEM(rowCountVars, i),
+                "getvalue", NULL);
+        if (!temp)
+            goto error;
+        PyList_SET_ITEM(results, pos + i, temp);
+    }
+    if (includesCommit) {
+        Py_INCREF(Py_None);
+        PyList_SET_ITEM(results, pos + numStatements, Py_None);
+    }
+    *numProcessed = numStatements + includesCommit;
+
+    Py_DECREF(allValues);
+    Py_DECREF(lines);
+    Py_DECREF(bindVars);
+    Py_DECREF(rowCountVars);
+    Py_DECREF(separator);
+    Py_DECREF(block);
+    return 0;
+
+error:
+    Py_DECREF(allValues);
+    Py_XDECREF(lines);
+    Py_XDECREF(bindVars);
+    Py_XDECREF(rowCountVars);
+    Py_XDECREF(separator);
+    Py_XDECREF(block);
+    return -1;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_runOperation()
+//   Run a single operation on its own and place its result in the list of
+// results. A new cursor is used for each statement so that the number of rows
+// fetched by the execution of queries can be tailored to the operation; for
+// queries returning a limited number of rows, this permits all of the rows to
+// be returned by the round trip which executes the query.
+//-----------------------------------------------------------------------------
+static int cxoPipeline_runOperation(cxoPipeline *pipeline,
+        PyObject *operations, Py_ssize_t pos, PyObject *results)
+{
+    PyObject *op, *statement, *parameters, *result, *temp;
+    cxoCursor *cursor;
+    long opType;
+    int numRows;
+
+    // perform commit, if applicable
+    op = PyList_GET_ITEM(operations, pos);
+    opType = PyLong_AsLong(PyTuple_GET_ITEM(op, 0));
+    if (opType == CXO_PIPELINE_OP_COMMIT) {
+        result = PyObject_CallMethod((PyObject*) pipeline->connection,
+                "commit", NULL);
+        if (!result)
+            return -1;
+        PyList_SET_ITEM(results, pos, result);
+        return 0;
+    }
+
+    // create a cursor suitable for the operation
+    statement = PyTuple_GET_ITEM(op, 1);
+    parameters = PyTuple_GET_ITEM(op, 2);
+    numRows = (int) PyLong_AsLong(PyTuple_GET_ITEM(op, 3));
+    cursor = (cxoCursor*) PyObject_CallFunctionObjArgs(
+            (PyObject*) &cxoPyTypeCursor, pipeline->connection, NULL);
+    if (!cursor)
+        return -1;
+    if (opType == CXO_PIPELINE_OP_FETCH_ONE) {
+        cursor->arraySize = 1;
+        cursor->prefetchRows = 2;
+        cursor->prefetchRowsSet = 1;
+    } else if (opType == CXO_PIPELINE_OP_FETCH_MANY) {
+        cursor->arraySize = (uint32_t) numRows;
+        cursor->prefetchRows = (uint32_t) numRows + 1;
+        cursor->prefetchRowsSet = 1;
+    }
+
+    // execute the statement
+    if (parameters == Py_None)
+        temp = PyObject_CallMethod((PyObject*) cursor, "execute", "(O)",
+                statement);
+    else temp = PyObject_CallMethod((PyObject*) cursor, "execute", "(OO)",
+            statement, parameters);
+    if (!temp) {
+        Py_DECREF(cursor);
+        return -1;
+    }
+    Py_DECREF(temp);
+
+    // determine the result
+    switch (opType) {
+        case CXO_PIPELINE_OP_FETCH_ONE:
+            result = PyObject_CallMethod((PyObject*) cursor, "fetchone",
+                    NULL);
+            break;
+        case CXO_PIPELINE_OP_FETCH_MANY:
+            result = PyObject_CallMethod((PyObject*) cursor, "fetchmany",
+                    "(i)", numRows);
+            break;
+        case CXO_PIPELINE_OP_FETCH_ALL:
+            result = PyObject_CallMethod((PyObject*) cursor, "fetchall",
+                    NULL);
+            break;
+        default:
+            if (cursor->fetchVariables) {
+                result = PyObject_CallMethod((PyObject*) cursor, "fetchall",
+                        NULL);
+            } else if (cursor->stmtInfo.isDML) {
+                result = PyLong_FromUnsignedLongLong(cursor->rowCount);
+            } else {
+                Py_INCREF(Py_None);
+                result = Py_None;
+            }
+            break;
+    }
+    Py_DECREF(cursor);
+    if (!result)
+        return -1;
+    PyList_SET_ITEM(results, pos, result);
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoPipeline_run()
+//   Run all of the operations in the pipeline in order and return a list
+// containing the result of each operation. If an operation fails, the
+// exception is raised and the remaining operations are not performed. The
+// operations are retained so that the pipeline can be run again.
+//-----------------------------------------------------------------------------
+static PyObject *cxoPipeline_run(cxoPipeline *pipeline, PyObject *args)
+{
+    Py_ssize_t pos, numOps, numProcessed;
+    PyObject *results, *operations;
+    cxoCursor *cursor;
+
+    // make sure the connection is usable
+    if (cxoConnection_isConnected(pipeline->connection) < 0)
+        return NULL;
+
+    // the list of operations is copied in case it is modified while running
+    operations = PyList_GetSlice(pipeline->operations, 0,
+            PyList_GET_SIZE(pipeline->operations));
+    if (!operations)
+        return NULL;
+    numOps = PyList_GET_SIZE(operations);
+    results = PyList_New(numOps);
+    if (!results) {
+        Py_DECREF(operations);
+        return NULL;
+    }
+    cursor = (cxoCursor*) PyObject_CallFunctionObjArgs(
+            (PyObject*) &cxoPyTypeCursor, pipeline->connection, NULL);
+    if (!cursor) {
+        Py_DECREF(operations);
+        Py_DECREF(results);
+        return NULL;
+    }
+
+    // run the operations, bundling them where possible
+    for (pos = 0; pos < numOps; pos += numProcessed) {
+        if (cxoPipeline_runBundle(operations, cursor, pos, results,
+                &numProcessed) < 0)
+            break;
+        if (numProcessed == 0) {
+            if (cxoPipeline_runOperation(pipeline, operations, pos,
+                    results) < 0)
+                break;
+            numProcessed = 1;
+        }
+    }
+    Py_DECREF(operations);
+    Py_DECREF(cursor);
+    if (pos < numOps) {
+        Py_DECREF(results);
+        return NULL;
+    }
+
+    return results;
+}
+
+
+//-----------------------------------------------------------------------------
+// declaration of methods
+//-----------------------------------------------------------------------------
+static PyMethodDef cxoMethods[] = {
+    { "execute", (PyCFunction) cxoPipeline_execute,
+            METH_VARARGS | METH_KEYWORDS },
+    { "fetchone", (PyCFunction) cxoPipeline_fetchOne,
+            METH_VARARGS | METH_KEYWORDS },
+    { "fetchmany", (PyCFunction) cxoPipeline_fetchMany,
+            METH_VARARGS | METH_KEYWORDS },
+    { "fetchall", (PyCFunction) cxoPipeline_fetchAll,
+            METH_VARARGS | METH_KEYWORDS },
+    { "commit", (PyCFunction) cxoPipeline_commit, METH_NOARGS },
+    { "clear", (PyCFunction) cxoPipeline_clear, METH_NOARGS },
+    { "run", (PyCFunction) cxoPipeline_run, METH_NOARGS },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of members
+//-----------------------------------------------------------------------------
+static PyMemberDef cxoMembers[] = {
+    { "connection", T_OBJECT, offsetof(cxoPipeline, connection), READONLY },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of sequence methods
+//-----------------------------------------------------------------------------
+static PySequenceMethods cxoSequenceMethods = {
+    .sq_length = (lenfunc) cxoPipeline_length
+};
+
+
+//-----------------------------------------------------------------------------
+// Python type declaration
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypePipeline = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.Pipeline",
+    .tp_basicsize = sizeof(cxoPipeline),
+    .tp_dealloc = (destructor) cxoPipeline_free,
+    .tp_as_sequence = &cxoSequenceMethods,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_methods = cxoMethods,
+    .tp_members = cxoMembers
+};
@@ -73,6 +73,10 @@ static void cxoQueue_free(cxoQueue *queue)
     Py_CLEAR(queue->payloadType);
     Py_CLEAR(queue->deqOptions);
     Py_CLEAR(queue->enqOptions);
+    if (queue->deqHandles) {
+        PyMem_Free(queue->deqHandles);
+        queue->deqHandles = NULL;
+    }
     Py_TYPE(queue)->tp_free((PyObject*) queue);
 }
 
@@ -227,6 +231,291 @@ int cxoQueue_enqHelper(cxoQueue *queue, uint32_t numProps,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoQueue_releaseHandles()
+//   Release the message property handles returned by cxoQueue_deqHandles()
+// and make the array available again. Handles that have already been released
+// are set to NULL in the array and are skipped.
+//-----------------------------------------------------------------------------
+static void cxoQueue_releaseHandles(cxoQueue *queue, dpiMsgProps **handles,
+        uint32_t numProps)
+{
+    uint32_t i;
+
+    for (i = 0; i < numProps; i++) {
+        if (handles[i])
+            dpiMsgProps_release(handles[i]);
+    }
+    if (handles == queue->deqHandles)
+        queue->deqHandlesInUse = 0;
+    else PyMem_Free(handles);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_deqHandles()
+//   Dequeue up to the specified number of messages and return the array of
+// message property handles provided by ODPI-C. The array retained by the
+// queue is used; it is allocated the first time it is needed and enlarged
+// when more messages are requested. If the array is already being used by
+// another thread a temporary array is allocated instead. The array must be
+// passed to cxoQueue_releaseHandles() once the messages have been processed.
+//-----------------------------------------------------------------------------
+static dpiMsgProps **cxoQueue_deqHandles(cxoQueue *queue, uint32_t *numProps)
+{
+    dpiMsgProps **handles;
+    int status;
+
+    // acquire an array large enough for the requested number of messages
+    if (!queue->deqHandlesInUse) {
+        if (*numProps > queue->numDeqHandles) {
+            handles = PyMem_Realloc(queue->deqHandles,
+                    *numProps * sizeof(dpiMsgProps*));
+            if (!handles) {
+                PyErr_NoMemory();
+                return NULL;
+            }
+            queue->deqHandles = handles;
+            queue->numDeqHandles = *numProps;
+        }
+        handles = queue->deqHandles;
+        queue->deqHandlesInUse = 1;
+    } else {
+        handles = PyMem_Malloc(*numProps * sizeof(dpiMsgProps*));
+        if (!handles) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+    }
+
+    // perform dequeue
+    Py_BEGIN_ALLOW_THREADS
+    status = dpiQueue_deqMany(queue->handle, numProps, handles);
+    Py_END_ALLOW_THREADS
+    if (status < 0) {
+        cxoError_raiseAndReturnNull();
+        cxoQueue_releaseHandles(queue, handles, 0);
+        return NULL;
+    }
+
+    return handles;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_getPayload()
+//   Return the payload of the message as a Python object: a bytes object for
+// RAW queues and an object for queues with an object type payload.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_getPayload(cxoQueue *queue, dpiMsgProps *handle)
+{
+    uint32_t bufferLength;
+    dpiObject *objHandle;
+    const char *buffer;
+    cxoObject *obj;
+
+    if (dpiMsgProps_getPayload(handle, &objHandle, &buffer,
+            &bufferLength) < 0)
+        return cxoError_raiseAndReturnNull();
+    if (!objHandle)
+        return PyBytes_FromStringAndSize(buffer, bufferLength);
+    obj = (cxoObject*) cxoObject_new(queue->payloadType, objHandle);
+    if (obj && dpiObject_addRef(objHandle) < 0) {
+        cxoError_raiseAndReturnNull();
+        obj->handle = NULL;
+        Py_CLEAR(obj);
+    }
+    return (PyObject*) obj;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_getMsgId()
+//   Return the id of the message as a bytes object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_getMsgId(dpiMsgProps *handle)
+{
+    uint32_t valueLength;
+    const char *value;
+
+    if (dpiMsgProps_getMsgId(handle, &value, &valueLength) < 0)
+        return cxoError_raiseAndReturnNull();
+    if (!value)
+        Py_RETURN_NONE;
+    return PyBytes_FromStringAndSize(value, valueLength);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_payloadsToList()
+//   Return a list containing the payloads of the messages. If the message ids
+// are requested as well, each element of the list is a 2-tuple containing the
+// payload and the message id. Each message property handle is released (and
+// cleared in the array) as soon as its payload has been converted.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_payloadsToList(cxoQueue *queue,
+        dpiMsgProps **handles, uint32_t numProps, int withMsgId)
+{
+    PyObject *result, *payload, *msgId, *item;
+    uint32_t i;
+
+    result = PyList_New(numProps);
+    if (!result)
+        return NULL;
+    for (i = 0; i < numProps; i++) {
+        item = payload = cxoQueue_getPayload(queue, handles[i]);
+        if (payload && withMsgId) {
+            msgId = cxoQueue_getMsgId(handles[i]);
+            item = (msgId) ? PyTuple_Pack(2, payload, msgId) : NULL;
+            Py_XDECREF(msgId);
+            Py_DECREF(payload);
+        }
+        if (!item) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        PyList_SET_ITEM(result, i, item);
+        dpiMsgProps_release(handles[i]);
+        handles[i] = NULL;
+    }
+
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_payloadsToBuffer()
+//   Return the payloads of the messages concatenated in a single bytes
+// object, along with a list of the offsets at which each payload starts
+// (followed by the total length) and, if requested, a list of the message
+// ids. This is only possible for RAW queues. Each message property handle is
+// released (and cleared in the array) as soon as its payload has been copied
+// into the buffer.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_payloadsToBuffer(cxoQueue *queue,
+        dpiMsgProps **handles, uint32_t numProps, int withMsgId)
+{
+    PyObject *buffer, *offsets, *msgIds, *temp, *result;
+    uint32_t bufferLength, i;
+    dpiObject *objHandle;
+    const char *ptr;
+    Py_ssize_t size;
+    char *data;
+
+    // payloads can only be concatenated for RAW queues
+    if (queue->payloadType) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "payloads can only be returned in a buffer for RAW queues");
+        return NULL;
+    }
+
+    // determine the size of the buffer and the offset of each payload
+    offsets = PyList_New(numProps + 1);
+    if (!offsets)
+        return NULL;
+    for (i = 0, size = 0; i <= numProps; i++) {
+        if (i < numProps && dpiMsgProps_getPayload(handles[i], &objHandle,
+                &ptr, &bufferLength) < 0) {
+            Py_DECREF(offsets);
+            return cxoError_raiseAndReturnNull();
+        }
+        temp = PyLong_FromSsize_t(size);
+        if (!temp) {
+            Py_DECREF(offsets);
+            return NULL;
+        }
+        PyList_SET_ITEM(offsets, i, temp);
+        if (i < numProps)
+            size += bufferLength;
+    }
+
+    // create the buffer and the list of message ids, if applicable
+    buffer = PyBytes_FromStringAndSize(NULL, size);
+    if (!buffer) {
+        Py_DECREF(offsets);
+        return NULL;
+    }
+    msgIds = NULL;
+    if (withMsgId) {
+        msgIds = PyList_New(numProps);
+        if (!msgIds) {
+            Py_DECREF(offsets);
+            Py_DECREF(buffer);
+            return NULL;
+        }
+    }
+
+    // populate the buffer and the list of message ids, releasing each handle
+    // once it is no longer needed
+    data = PyBytes_AS_STRING(buffer);
+    for (i = 0; i < numProps; i++) {
+        if (dpiMsgProps_getPayload(handles[i], &objHandle, &ptr,
+                &bufferLength) < 0) {
+            Py_DECREF(offsets);
+            Py_DECREF(buffer);
+            Py_XDECREF(msgIds);
+            return cxoError_raiseAndReturnNull();
+        }
+        memcpy(data, ptr, bufferLength);
+        data += bufferLength;
+        if (msgIds) {
+            temp = cxoQueue_getMsgId(handles[i]);
+            if (!temp) {
+                Py_DECREF(offsets);
+                Py_DECREF(buffer);
+                Py_DECREF(msgIds);
+                return NULL;
+            }
+            PyList_SET_ITEM(msgIds, i, temp);
+        }
+        dpiMsgProps_release(handles[i]);
+        handles[i] = NULL;
+    }
+    if (msgIds) {
+        result = PyTuple_Pack(3, buffer, offsets, msgIds);
+        Py_DECREF(msgIds);
+    } else {
+        result = PyTuple_Pack(2, buffer, offsets);
+    }
+    Py_DECREF(buffer);
+    Py_DECREF(offsets);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_deqPayloadsHelper()
+//   Helper for dequeuing messages from a queue and returning only their
+// payloads (and, optionally, their message ids). No message property objects
+// are created and each message property handle is released as soon as its
+// payload has been transferred to Python objects; any handles remaining after
+// an error are released here.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_deqPayloadsHelper(cxoQueue *queue,
+        uint32_t numProps, int withMsgId, int asBuffer)
+{
+    dpiMsgProps **handles;
+    PyObject *result;
+
+    if (numProps == 0) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "number of messages must be greater than zero");
+        return NULL;
+    }
+    handles = cxoQueue_deqHandles(queue, &numProps);
+    if (!handles)
+        return NULL;
+    if (asBuffer) {
+        result = cxoQueue_payloadsToBuffer(queue, handles, numProps,
+                withMsgId);
+    } else {
+        result = cxoQueue_payloadsToList(queue, handles, numProps, withMsgId);
+    }
+    cxoQueue_releaseHandles(queue, handles, numProps);
+    return result;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoQueue_deqMany()
 //   Dequeue a single message to the queue.
@@ -279,6 +568,69 @@ static PyObject *cxoQueue_deqOne(cxoQueue *queue, PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoQueue_deqIter()
+//   Return an iterator which dequeues messages from the queue in batches of
+// the specified size and returns the payloads of each batch as a list.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_deqIter(cxoQueue *queue, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "batchSize", "withMsgId", NULL };
+    PyObject *withMsgIdObj = NULL;
+    unsigned int batchSize;
+    cxoQueueIter *iter;
+    int withMsgId;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "I|O", keywordList,
+            &batchSize, &withMsgIdObj))
+        return NULL;
+    if (cxoUtils_getBooleanValue(withMsgIdObj, 0, &withMsgId) < 0)
+        return NULL;
+    if (batchSize == 0) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "number of messages must be greater than zero");
+        return NULL;
+    }
+    iter = (cxoQueueIter*)
+            cxoPyTypeQueueIter.tp_alloc(&cxoPyTypeQueueIter, 0);
+    if (!iter)
+        return NULL;
+    Py_INCREF(queue);
+    iter->queue = queue;
+    iter->batchSize = (uint32_t) batchSize;
+    iter->withMsgId = withMsgId;
+
+    return (PyObject*) iter;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueue_deqPayloads()
+//   Dequeue up to the specified number of messages from the queue and return
+// only their payloads.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueue_deqPayloads(cxoQueue *queue, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "maxMessages", "withMsgId", "asBuffer",
+            NULL };
+    PyObject *withMsgIdObj = NULL, *asBufferObj = NULL;
+    unsigned int numPropsFromPython;
+    int withMsgId, asBuffer;
+
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "I|OO", keywordList,
+            &numPropsFromPython, &withMsgIdObj, &asBufferObj))
+        return NULL;
+    if (cxoUtils_getBooleanValue(withMsgIdObj, 0, &withMsgId) < 0)
+        return NULL;
+    if (cxoUtils_getBooleanValue(asBufferObj, 0, &asBuffer) < 0)
+        return NULL;
+    return cxoQueue_deqPayloadsHelper(queue, (uint32_t) numPropsFromPython,
+            withMsgId, asBuffer);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoQueue_enqMany()
 //   Enqueue multiple messages to the queue.
@@ -351,12 +703,47 @@ static PyObject *cxoQueue_enqOne(cxoQueue *queue, PyObject *args)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoQueueIter_free()
+//   Free the memory associated with a queue iterator.
+//-----------------------------------------------------------------------------
+static void cxoQueueIter_free(cxoQueueIter *iter)
+{
+    Py_CLEAR(iter->queue);
+    Py_TYPE(iter)->tp_free((PyObject*) iter);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoQueueIter_next()
+//   Dequeue the next batch of messages and return their payloads. The wait
+// for messages (as specified by the dequeue options of the queue) takes place
+// without the GIL held. Iteration stops when no messages are dequeued.
+//-----------------------------------------------------------------------------
+static PyObject *cxoQueueIter_next(cxoQueueIter *iter)
+{
+    PyObject *result;
+
+    result = cxoQueue_deqPayloadsHelper(iter->queue, iter->batchSize,
+            iter->withMsgId, 0);
+    if (result && PyList_GET_SIZE(result) == 0) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    return result;
+}
+
+
 //-----------------------------------------------------------------------------
 // declaration of methods
 //-----------------------------------------------------------------------------
 static PyMethodDef cxoMethods[] = {
+    { "deqIter", (PyCFunction) cxoQueue_deqIter,
+            METH_VARARGS | METH_KEYWORDS },
     { "deqMany", (PyCFunction) cxoQueue_deqMany, METH_VARARGS },
     { "deqOne", (PyCFunction) cxoQueue_deqOne, METH_NOARGS },
+    { "deqPayloads", (PyCFunction) cxoQueue_deqPayloads,
+            METH_VARARGS | METH_KEYWORDS },
     { "enqMany", (PyCFunction) cxoQueue_enqMany, METH_VARARGS },
     { "enqOne", (PyCFunction) cxoQueue_enqOne, METH_VARARGS },
     { NULL }
@@ -389,3 +776,13 @@ PyTypeObject cxoPyTypeQueue = {
     .tp_methods = cxoMethods,
     .tp_members = cxoMembers
 };
+
+PyTypeObject cxoPyTypeQueueIter = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.QueueIter",
+    .tp_basicsize = sizeof(cxoQueueIter),
+    .tp_dealloc = (destructor) cxoQueueIter_free,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_iter = PyObject_SelfIter,
+    .tp_iternext = (iternextfunc) cxoQueueIter_next
+};
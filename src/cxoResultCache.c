@@ -0,0 +1,576 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoResultCache.c
+//   Defines the routines for handling client side result caches. The rows
+// returned by queries are cached using the statement and its parameters as
+// the key. The first time a query is executed it is registered for query
+// change notification with a subscription owned by the cache; when a
+// notification is received stating that the results of the query have
+// changed, the rows cached for it are discarded and the query is executed
+// again the next time the rows are requested.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_new()
+//   Create a new result cache for the connection. A subscription for query
+// change notification is created which is used to register the queries
+// executed by the cache.
+//-----------------------------------------------------------------------------
+cxoResultCache *cxoResultCache_new(cxoConnection *connection,
+        uint32_t maxEntries, int clientInitiated)
+{
+    dpiSubscrCreateParams params;
+    cxoResultCache *cache;
+    cxoSubscr *subscr;
+    int status;
+
+    // create cache and the dictionaries used for managing the entries
+    cache = (cxoResultCache*)
+            cxoPyTypeResultCache.tp_alloc(&cxoPyTypeResultCache, 0);
+    if (!cache)
+        return NULL;
+    Py_INCREF(connection);
+    cache->connection = connection;
+    cache->maxEntries = maxEntries;
+    cache->entries = PyDict_New();
+    if (!cache->entries) {
+        Py_DECREF(cache);
+        return NULL;
+    }
+    cache->queryIds = PyDict_New();
+    if (!cache->queryIds) {
+        Py_DECREF(cache);
+        return NULL;
+    }
+    cache->queryKeys = PyDict_New();
+    if (!cache->queryKeys) {
+        Py_DECREF(cache);
+        return NULL;
+    }
+
+    // create Python subscription object
+    subscr = (cxoSubscr*) cxoPyTypeSubscr.tp_alloc(&cxoPyTypeSubscr, 0);
+    if (!subscr) {
+        Py_DECREF(cache);
+        return NULL;
+    }
+    cache->subscription = subscr;
+    Py_INCREF(connection);
+    subscr->connection = connection;
+
+    // create ODPI-C subscription; notifications are processed by the cache
+    if (dpiContext_initSubscrCreateParams(cxoDpiContext, &params) < 0) {
+        cxoError_raiseAndReturnNull();
+        Py_DECREF(cache);
+        return NULL;
+    }
+    params.qos = DPI_SUBSCR_QOS_QUERY;
+    params.clientInitiated = clientInitiated;
+    params.callback = (dpiSubscrCallback) cxoSubscr_callback;
+    params.callbackContext = subscr;
+    subscr->namespace = params.subscrNamespace;
+    subscr->protocol = params.protocol;
+    subscr->port = params.portNumber;
+    subscr->timeout = params.timeout;
+    subscr->operations = params.operations;
+    subscr->qos = params.qos;
+    subscr->groupingClass = params.groupingClass;
+    subscr->groupingValue = params.groupingValue;
+    subscr->groupingType = params.groupingType;
+    subscr->resultCache = cache;
+    Py_BEGIN_ALLOW_THREADS
+    status = dpiConn_subscribe(connection->handle, &params, &subscr->handle);
+    Py_END_ALLOW_THREADS
+    if (status < 0) {
+        cxoError_raiseAndReturnNull();
+        Py_DECREF(cache);
+        return NULL;
+    }
+    subscr->id = params.outRegId;
+
+    return cache;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_free()
+//   Free the memory associated with the result cache. The subscription may
+// still be referenced elsewhere so it is detached from the cache first.
+//-----------------------------------------------------------------------------
+static void cxoResultCache_free(cxoResultCache *cache)
+{
+    if (cache->subscription) {
+        cache->subscription->resultCache = NULL;
+        Py_CLEAR(cache->subscription);
+    }
+    Py_CLEAR(cache->connection);
+    Py_CLEAR(cache->entries);
+    Py_CLEAR(cache->queryIds);
+    Py_CLEAR(cache->queryKeys);
+    Py_TYPE(cache)->tp_free((PyObject*) cache);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_length()
+//   Return the number of queries for which rows are currently cached.
+//-----------------------------------------------------------------------------
+static Py_ssize_t cxoResultCache_length(cxoResultCache *cache)
+{
+    return PyDict_Size(cache->entries);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_clearAll()
+//   Discard all of the rows that are cached. If the registrations are also to
+// be discarded, queries will be registered again the next time they are
+// executed.
+//-----------------------------------------------------------------------------
+static void cxoResultCache_clearAll(cxoResultCache *cache,
+        int clearRegistrations)
+{
+    cache->invalidations += (uint64_t) PyDict_Size(cache->entries);
+    cache->generation++;
+    PyDict_Clear(cache->entries);
+    if (clearRegistrations) {
+        PyDict_Clear(cache->queryIds);
+        PyDict_Clear(cache->queryKeys);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_invalidateQuery()
+//   Discard the rows cached for the query with the given id, if any.
+//-----------------------------------------------------------------------------
+static int cxoResultCache_invalidateQuery(cxoResultCache *cache,
+        uint64_t queryId)
+{
+    PyObject *queryIdObj, *key;
+
+    queryIdObj = PyLong_FromUnsignedLongLong(queryId);
+    if (!queryIdObj)
+        return -1;
+    key = PyDict_GetItem(cache->queryKeys, queryIdObj);
+    Py_DECREF(queryIdObj);
+    if (!key)
+        return 0;
+    if (PyDict_GetItem(cache->entries, key)) {
+        if (PyDict_DelItem(cache->entries, key) < 0)
+            return -1;
+        cache->invalidations++;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_processMessage()
+//   Process a message received by the subscription owned by the cache. This
+// is called from the thread on which the notification is delivered with the
+// GIL held. Rows cached for queries that have changed are discarded; if the
+// message indicates that the registrations may no longer be valid, all of
+// the rows and registrations are discarded.
+//-----------------------------------------------------------------------------
+int cxoResultCache_processMessage(cxoResultCache *cache,
+        dpiSubscrMessage *message)
+{
+    uint32_t i;
+
+    if (message->errorInfo) {
+        cxoResultCache_clearAll(cache, 1);
+        return 0;
+    }
+    switch (message->eventType) {
+        case DPI_EVENT_QUERYCHANGE:
+            cache->generation++;
+            for (i = 0; i < message->numQueries; i++) {
+                if (cxoResultCache_invalidateQuery(cache,
+                        message->queries[i].id) < 0)
+                    return -1;
+            }
+            break;
+        case DPI_EVENT_DEREG:
+        case DPI_EVENT_STARTUP:
+        case DPI_EVENT_SHUTDOWN:
+        case DPI_EVENT_SHUTDOWN_ANY:
+            cxoResultCache_clearAll(cache, 1);
+            break;
+        default:
+            break;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_getKey()
+//   Return the key used for caching the rows of the query. This is a tuple
+// containing the statement and the parameters; parameters supplied as a
+// sequence are converted to a tuple and those supplied as a dictionary are
+// converted to a frozen set of (name, value) pairs.
+//-----------------------------------------------------------------------------
+static PyObject *cxoResultCache_getKey(PyObject *statement,
+        PyObject *parameters)
+{
+    PyObject *temp, *key;
+
+    if (!parameters) {
+        temp = Py_None;
+        Py_INCREF(temp);
+    } else if (PyDict_Check(parameters)) {
+        key = PyDict_Items(parameters);
+        if (!key)
+            return NULL;
+        temp = PyFrozenSet_New(key);
+        Py_DECREF(key);
+    } else {
+        temp = PySequence_Tuple(parameters);
+    }
+    if (!temp)
+        return NULL;
+    key = PyTuple_Pack(2, statement, temp);
+    Py_DECREF(temp);
+    if (!key)
+        return NULL;
+    if (PyObject_Hash(key) == -1) {
+        Py_DECREF(key);
+        return NULL;
+    }
+
+    return key;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_registerQuery()
+//   Execute the query using the subscription owned by the cache, which
+// registers it for query change notification. The id of the registered query
+// is returned along with the cursor which is ready for fetching.
+//-----------------------------------------------------------------------------
+static cxoCursor *cxoResultCache_registerQuery(cxoResultCache *cache,
+        PyObject *statement, PyObject *parameters, uint64_t *queryId)
+{
+    cxoBuffer statementBuffer;
+    uint32_t numQueryColumns;
+    cxoCursor *cursor;
+    int status;
+
+    // create cursor to perform query
+    cursor = (cxoCursor*) PyObject_CallMethod((PyObject*) cache->connection,
+            "cursor", NULL);
+    if (!cursor)
+        return NULL;
+
+    // prepare the statement for execution
+    if (cxoBuffer_fromObject(&statementBuffer, statement,
+            cache->connection->encodingInfo.encoding) < 0) {
+        Py_DECREF(cursor);
+        return NULL;
+    }
+    status = dpiSubscr_prepareStmt(cache->subscription->handle,
+            statementBuffer.ptr, statementBuffer.size, &cursor->handle);
+    cxoBuffer_clear(&statementBuffer);
+    if (status < 0) {
+        cxoError_raiseAndReturnNull();
+        Py_DECREF(cursor);
+        return NULL;
+    }
+
+    // perform binds
+    if (parameters && cxoCursor_setBindVariables(cursor, parameters, 1, 0,
+            0) < 0) {
+        Py_DECREF(cursor);
+        return NULL;
+    }
+    if (cxoCursor_performBind(cursor) < 0) {
+        Py_DECREF(cursor);
+        return NULL;
+    }
+
+    // perform the execute (which registers the query)
+    Py_BEGIN_ALLOW_THREADS
+    status = dpiStmt_execute(cursor->handle, DPI_MODE_EXEC_DEFAULT,
+            &numQueryColumns);
+    Py_END_ALLOW_THREADS
+    if (status < 0) {
+        cxoError_raiseAndReturnNull();
+        Py_DECREF(cursor);
+        return NULL;
+    }
+    if (numQueryColumns == 0) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "only queries can be cached");
+        Py_DECREF(cursor);
+        return NULL;
+    }
+    if (dpiStmt_getSubscrQueryId(cursor->handle, queryId) < 0) {
+        cxoError_raiseAndReturnNull();
+        Py_DECREF(cursor);
+        return NULL;
+    }
+
+    // define the fetch variables
+    if (cxoCursor_performDefine(cursor, numQueryColumns) < 0) {
+        Py_DECREF(cursor);
+        return NULL;
+    }
+
+    return cursor;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_executeQuery()
+//   Execute the query and return its rows as a tuple. If the query has not
+// been registered with the subscription owned by the cache it is registered
+// first.
+//-----------------------------------------------------------------------------
+static PyObject *cxoResultCache_executeQuery(cxoResultCache *cache,
+        PyObject *key, PyObject *statement, PyObject *parameters)
+{
+    PyObject *queryIdObj, *result, *rows;
+    cxoCursor *cursor;
+    uint64_t queryId;
+    int status;
+
+    // execute the query, registering it if needed
+    queryIdObj = PyDict_GetItem(cache->queryIds, key);
+    if (queryIdObj) {
+        cursor = (cxoCursor*) PyObject_CallMethod(
+                (PyObject*) cache->connection, "cursor", NULL);
+        if (!cursor)
+            return NULL;
+        result = PyObject_CallMethod((PyObject*) cursor, "execute", "OO",
+                statement, (parameters) ? parameters : Py_None);
+        if (!result) {
+            Py_DECREF(cursor);
+            return NULL;
+        }
+        Py_DECREF(result);
+    } else {
+        cursor = cxoResultCache_registerQuery(cache, statement, parameters,
+                &queryId);
+        if (!cursor)
+            return NULL;
+        queryIdObj = PyLong_FromUnsignedLongLong(queryId);
+        if (!queryIdObj) {
+            Py_DECREF(cursor);
+            return NULL;
+        }
+        status = PyDict_SetItem(cache->queryIds, key, queryIdObj);
+        if (status == 0)
+            status = PyDict_SetItem(cache->queryKeys, queryIdObj, key);
+        Py_DECREF(queryIdObj);
+        if (status < 0) {
+            Py_DECREF(cursor);
+            return NULL;
+        }
+    }
+
+    // fetch the rows and store them in a tuple
+    result = PyObject_CallMethod((PyObject*) cursor, "fetchall", NULL);
+    Py_DECREF(cursor);
+    if (!result)
+        return NULL;
+    rows = PyList_AsTuple(result);
+    Py_DECREF(result);
+    return rows;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_storeRows()
+//   Store the rows in the cache. If the cache is full, an arbitrary entry is
+// discarded first.
+//-----------------------------------------------------------------------------
+static int cxoResultCache_storeRows(cxoResultCache *cache, PyObject *key,
+        PyObject *rows)
+{
+    PyObject *evictKey, *value;
+    Py_ssize_t pos = 0;
+    int status;
+
+    if (cache->maxEntries == 0)
+        return 0;
+    if (PyDict_Size(cache->entries) >= (Py_ssize_t) cache->maxEntries &&
+            PyDict_Next(cache->entries, &pos, &evictKey, &value)) {
+        Py_INCREF(evictKey);
+        status = PyDict_DelItem(cache->entries, evictKey);
+        Py_DECREF(evictKey);
+        if (status < 0)
+            return -1;
+        cache->evictions++;
+    }
+    return PyDict_SetItem(cache->entries, key, rows);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_fetchAll()
+//   Return the rows of the query, either from the cache or by executing the
+// query. The rows are only stored in the cache if no notification was
+// received while the query was being executed; otherwise the rows may
+// already be stale.
+//-----------------------------------------------------------------------------
+static PyObject *cxoResultCache_fetchAll(cxoResultCache *cache,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "statement", "parameters", NULL };
+    PyObject *statement, *parameters, *key, *rows, *result;
+    uint64_t generation;
+
+    // parse arguments
+    parameters = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O!|O", keywordList,
+            &PyUnicode_Type, &statement, &parameters))
+        return NULL;
+    if (parameters == Py_None)
+        parameters = NULL;
+    if (parameters && !PyDict_Check(parameters) &&
+            !PySequence_Check(parameters)) {
+        PyErr_SetString(PyExc_TypeError,
+                "expecting a dictionary or sequence");
+        return NULL;
+    }
+    if (!cache->subscription->handle) {
+        cxoError_raiseFromString(cxoInterfaceErrorException,
+                "result cache is closed");
+        return NULL;
+    }
+    if (cxoConnection_isConnected(cache->connection) < 0)
+        return NULL;
+
+    // return the cached rows, if available
+    key = cxoResultCache_getKey(statement, parameters);
+    if (!key)
+        return NULL;
+    rows = PyDict_GetItem(cache->entries, key);
+    if (rows) {
+        cache->hits++;
+        Py_DECREF(key);
+        return PySequence_List(rows);
+    }
+
+    // otherwise, execute the query and cache the rows
+    cache->misses++;
+    generation = cache->generation;
+    rows = cxoResultCache_executeQuery(cache, key, statement, parameters);
+    if (!rows) {
+        Py_DECREF(key);
+        return NULL;
+    }
+    if (generation == cache->generation &&
+            cxoResultCache_storeRows(cache, key, rows) < 0) {
+        Py_DECREF(key);
+        Py_DECREF(rows);
+        return NULL;
+    }
+    Py_DECREF(key);
+    result = PySequence_List(rows);
+    Py_DECREF(rows);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_clear()
+//   Discard all of the rows that are cached.
+//-----------------------------------------------------------------------------
+static PyObject *cxoResultCache_clear(cxoResultCache *cache, PyObject *args)
+{
+    cxoResultCache_clearAll(cache, 0);
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoResultCache_close()
+//   Discard all of the rows that are cached and destroy the subscription
+// owned by the cache.
+//-----------------------------------------------------------------------------
+static PyObject *cxoResultCache_close(cxoResultCache *cache, PyObject *args)
+{
+    cxoSubscr *subscr = cache->subscription;
+    int status;
+
+    if (subscr->handle) {
+        if (cxoConnection_isConnected(cache->connection) < 0)
+            return NULL;
+        Py_BEGIN_ALLOW_THREADS
+        status = dpiConn_unsubscribe(cache->connection->handle,
+                subscr->handle);
+        Py_END_ALLOW_THREADS
+        if (status < 0)
+            return cxoError_raiseAndReturnNull();
+        subscr->handle = NULL;
+    }
+    cxoResultCache_clearAll(cache, 1);
+
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// declaration of methods
+//-----------------------------------------------------------------------------
+static PyMethodDef cxoMethods[] = {
+    { "fetchall", (PyCFunction) cxoResultCache_fetchAll,
+            METH_VARARGS | METH_KEYWORDS },
+    { "clear", (PyCFunction) cxoResultCache_clear, METH_NOARGS },
+    { "close", (PyCFunction) cxoResultCache_close, METH_NOARGS },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of members
+//-----------------------------------------------------------------------------
+static PyMemberDef cxoMembers[] = {
+    { "connection", T_OBJECT, offsetof(cxoResultCache, connection),
+            READONLY },
+    { "subscription", T_OBJECT, offsetof(cxoResultCache, subscription),
+            READONLY },
+    { "maxentries", T_UINT, offsetof(cxoResultCache, maxEntries), READONLY },
+    { "hits", T_ULONGLONG, offsetof(cxoResultCache, hits), READONLY },
+    { "misses", T_ULONGLONG, offsetof(cxoResultCache, misses), READONLY },
+    { "invalidations", T_ULONGLONG, offsetof(cxoResultCache, invalidations),
+            READONLY },
+    { "evictions", T_ULONGLONG, offsetof(cxoResultCache, evictions),
+            READONLY },
+    { NULL }
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of sequence methods
+//-----------------------------------------------------------------------------
+static PySequenceMethods cxoSequenceMethods = {
+    .sq_length = (lenfunc) cxoResultCache_length
+};
+
+
+//-----------------------------------------------------------------------------
+// Python type declaration
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypeResultCache = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "cx_Oracle.ResultCache",
+    .tp_basicsize = sizeof(cxoResultCache),
+    .tp_dealloc = (destructor) cxoResultCache_free,
+    .tp_as_sequence = &cxoSequenceMethods,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_methods = cxoMethods,
+    .tp_members = cxoMembers
+};
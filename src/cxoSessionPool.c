@@ -86,9 +86,9 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
                 "connectiontype must be a subclass of Connection");
         return -1;
     }
-    if (cxoUtils_getBooleanValue(threadedObj, 0, &temp) < 0)
+    if (cxoUtils_getBooleanValue(threadedObj, 0, &pool->threaded) < 0)
         return -1;
-    if (temp)
+    if (pool->threaded)
         dpiCommonParams.createMode |= DPI_MODE_CREATE_THREADED;
     if (cxoUtils_getBooleanValue(eventsObj, 0, &temp) < 0)
         return -1;
@@ -173,6 +173,18 @@ static int cxoSessionPool_init(cxoSessionPool *pool, PyObject *args,
     if (!pool->name)
         return -1;
 
+    // prepare the parameters used for acquiring connections without calling
+    // Connection.__init__(); external authentication is specified since no
+    // user name or password is given in that case
+    if (dpiContext_initCommonCreateParams(cxoDpiContext,
+            &pool->acquireCommonParams) < 0)
+        return cxoError_raiseAndReturnInt();
+    if (dpiContext_initConnCreateParams(cxoDpiContext,
+            &pool->acquireCreateParams) < 0)
+        return cxoError_raiseAndReturnInt();
+    pool->acquireCreateParams.pool = pool->handle;
+    pool->acquireCreateParams.externalAuth = 1;
+
     return 0;
 }
 
@@ -211,13 +223,22 @@ static PyObject *cxoSessionPool_acquire(cxoSessionPool *pool, PyObject *args,
     PyObject *matchAnyTagObj;
 
     // parse arguments
+    username = password = NULL;
+    cclassObj = purityObj = tagObj = matchAnyTagObj = NULL;
+    shardingKeyObj = superShardingKeyObj = NULL;
     if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|s#s#OOOOOO",
             keywordList, &username, &usernameLength, &password,
             &passwordLength, &cclassObj, &purityObj, &tagObj, &matchAnyTagObj,
             &shardingKeyObj, &superShardingKeyObj))
         return NULL;
 
-    // create arguments
+    // in the common case, acquire the connection directly
+    if (!username && !password && !shardingKeyObj && !superShardingKeyObj &&
+            pool->connectionType == &cxoPyTypeConnection)
+        return (PyObject*) cxoConnection_acquireFromPool(pool, cclassObj,
+                purityObj, tagObj, matchAnyTagObj);
+
+    // otherwise, create the connection by calling the connection type
     if (keywordArgs)
         createKeywordArgs = PyDict_Copy(keywordArgs);
     else createKeywordArgs = PyDict_New();
@@ -238,6 +259,76 @@ static PyObject *cxoSessionPool_acquire(cxoSessionPool *pool, PyObject *args,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSessionPool_acquireAsync()
+//   Acquire a connection from the session pool asynchronously and return an
+// asyncio future which completes with the connection. Only the parameters
+// that do not require calling the connection type are supported.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSessionPool_acquireAsync(cxoSessionPool *pool,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "cclass", "purity", "tag", "matchanytag",
+            NULL };
+    PyObject *cclassObj, *purityObj, *tagObj, *matchAnyTagObj;
+
+    // parse arguments
+    cclassObj = purityObj = tagObj = matchAnyTagObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|OOOO",
+            keywordList, &cclassObj, &purityObj, &tagObj, &matchAnyTagObj))
+        return NULL;
+    if (pool->connectionType != &cxoPyTypeConnection)
+        return cxoError_raiseFromString(cxoNotSupportedErrorException,
+                "asynchronous acquire is not supported with a custom "
+                "connection type");
+
+    return cxoConnection_acquireFromPoolAsync(pool, cclassObj, purityObj,
+            tagObj, matchAnyTagObj);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSessionPool_recordAcquire()
+//   Record the statistics for an attempt to acquire a connection from the
+// pool. This is called with the GIL held immediately after the attempt, which
+// serializes updates to the statistics. If the attempt failed, the error
+// information is examined to determine if the attempt timed out; if it is not
+// supplied by the caller, it is still available from ODPI-C.
+//-----------------------------------------------------------------------------
+void cxoSessionPool_recordAcquire(cxoSessionPool *pool, int status,
+        const dpiErrorInfo *errorInfo, double waitTime, int newSession)
+{
+    cxoSessionPoolStats *stats = &pool->stats;
+    dpiErrorInfo localErrorInfo;
+    double limit;
+    int i;
+
+    // record the wait time in the histogram
+    stats->numAcquires++;
+    stats->acquireTime += waitTime;
+    limit = 0.001;
+    for (i = 0; i < CXO_POOL_STATS_NUM_BUCKETS - 1; i++) {
+        if (waitTime < limit)
+            break;
+        limit *= 2;
+    }
+    stats->acquireWaits[i]++;
+
+    // record the outcome of the attempt
+    if (status < 0) {
+        stats->numAcquireErrors++;
+        if (!errorInfo) {
+            dpiContext_getError(cxoDpiContext, &localErrorInfo);
+            errorInfo = &localErrorInfo;
+        }
+        if (errorInfo->code == 24457 || errorInfo->code == 24418)
+            stats->numTimeouts++;
+    } else if (newSession) {
+        stats->numSessionsCreated++;
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSessionPool_close()
 //   Close the session pool and make it unusable.
@@ -297,10 +388,57 @@ static PyObject *cxoSessionPool_drop(cxoSessionPool *pool, PyObject *args)
     Py_CLEAR(connection->sessionPool);
     dpiConn_release(connection->handle);
     connection->handle = NULL;
+    Py_CLEAR(connection->objectTypes);
+    pool->stats.numSessionsDropped++;
     Py_RETURN_NONE;
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSessionPool_parallelFetch()
+//   Execute a query once for each of the partitions specified, using several
+// sessions from the pool concurrently, and return an iterator over the
+// batches of rows fetched.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSessionPool_parallelFetch(cxoSessionPool *pool,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "statement", "partitions", "sessions",
+            "batchsize", "columnar", NULL };
+    PyObject *statement, *partitions, *columnarObj;
+    uint32_t numSessions, batchSize;
+    int columnar;
+
+    // parse arguments
+    numSessions = 0;
+    batchSize = 1000;
+    columnarObj = NULL;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "OO|IIO",
+            keywordList, &statement, &partitions, &numSessions, &batchSize,
+            &columnarObj))
+        return NULL;
+    if (cxoUtils_getBooleanValue(columnarObj, 0, &columnar) < 0)
+        return NULL;
+
+    // validate arguments
+    if (!pool->threaded) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "parallel fetch requires a threaded session pool");
+        return NULL;
+    }
+    if (batchSize == 0) {
+        cxoError_raiseFromString(cxoProgrammingErrorException,
+                "batch size must be greater than zero");
+        return NULL;
+    }
+    if (numSessions == 0 || numSessions > pool->maxSessions)
+        numSessions = pool->maxSessions;
+
+    return (PyObject*) cxoParallelFetch_new(pool, statement, partitions,
+            numSessions, batchSize, columnar);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSessionPool_release()
 //   Release a connection back to the session pool.
@@ -340,10 +478,75 @@ static PyObject *cxoSessionPool_release(cxoSessionPool *pool, PyObject *args,
     Py_CLEAR(conn->sessionPool);
     dpiConn_release(conn->handle);
     conn->handle = NULL;
+    Py_CLEAR(conn->objectTypes);
     Py_RETURN_NONE;
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSessionPool_stats()
+//   Return a dictionary containing a snapshot of the statistics gathered for
+// the pool, along with the number of busy and open sessions.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSessionPool_stats(cxoSessionPool *pool, PyObject *args)
+{
+    cxoSessionPoolStats *stats = &pool->stats;
+    PyObject *result, *waits, *bounds;
+    uint32_t busyCount, openCount;
+    double limit;
+    int i;
+
+    // get the number of busy and open sessions
+    if (dpiPool_getBusyCount(pool->handle, &busyCount) < 0)
+        return cxoError_raiseAndReturnNull();
+    if (dpiPool_getOpenCount(pool->handle, &openCount) < 0)
+        return cxoError_raiseAndReturnNull();
+
+    // create the histogram of wait times and the upper bounds of its buckets
+    waits = PyTuple_New(CXO_POOL_STATS_NUM_BUCKETS);
+    if (!waits)
+        return NULL;
+    bounds = PyTuple_New(CXO_POOL_STATS_NUM_BUCKETS);
+    if (!bounds) {
+        Py_DECREF(waits);
+        return NULL;
+    }
+    limit = 0.001;
+    for (i = 0; i < CXO_POOL_STATS_NUM_BUCKETS; i++) {
+        PyTuple_SET_ITEM(waits, i,
+                PyLong_FromUnsignedLongLong(stats->acquireWaits[i]));
+        if (i == CXO_POOL_STATS_NUM_BUCKETS - 1)
+            PyTuple_SET_ITEM(bounds, i, PyFloat_FromDouble(Py_HUGE_VAL));
+        else PyTuple_SET_ITEM(bounds, i, PyFloat_FromDouble(limit));
+        limit *= 2;
+        if (!PyTuple_GET_ITEM(waits, i) || !PyTuple_GET_ITEM(bounds, i)) {
+            Py_DECREF(waits);
+            Py_DECREF(bounds);
+            return NULL;
+        }
+    }
+
+    // create the dictionary
+    result = Py_BuildValue("{sKsKsKsKsKsKsdsNsNsIsIsKsKsKsd}",
+            "acquires", stats->numAcquires,
+            "acquire_errors", stats->numAcquireErrors,
+            "timeouts", stats->numTimeouts,
+            "sessions_created", stats->numSessionsCreated,
+            "sessions_dropped", stats->numSessionsDropped,
+            "callbacks", stats->numCallbacks,
+            "acquire_time", stats->acquireTime,
+            "acquire_waits", waits,
+            "acquire_wait_bounds", bounds,
+            "busy", busyCount,
+            "opened", openCount,
+            "statement_prepares", stats->numStatementPrepares,
+            "statement_cache_hits", stats->numStatementCacheHits,
+            "statement_cache_misses", stats->numStatementCacheMisses,
+            "statement_prepare_time", stats->statementPrepareTime);
+    return result;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSessionPool_getAttribute()
 //   Return the value for the attribute.
@@ -532,11 +735,16 @@ static int cxoSessionPool_setWaitTimeout(cxoSessionPool *pool, PyObject *value,
 static PyMethodDef cxoMethods[] = {
     { "acquire", (PyCFunction) cxoSessionPool_acquire,
             METH_VARARGS | METH_KEYWORDS },
+    { "acquireasync", (PyCFunction) cxoSessionPool_acquireAsync,
+            METH_VARARGS | METH_KEYWORDS },
     { "close", (PyCFunction) cxoSessionPool_close,
             METH_VARARGS | METH_KEYWORDS },
     { "drop", (PyCFunction) cxoSessionPool_drop, METH_VARARGS },
+    { "parallelfetch", (PyCFunction) cxoSessionPool_parallelFetch,
+            METH_VARARGS | METH_KEYWORDS },
     { "release", (PyCFunction) cxoSessionPool_release,
             METH_VARARGS | METH_KEYWORDS },
+    { "stats", (PyCFunction) cxoSessionPool_stats, METH_NOARGS },
     { NULL }
 };
 
@@ -288,66 +288,150 @@ static PyObject *cxoSodaCollection_insertManyHelper(cxoSodaCollection *coll,
 
 
 //-----------------------------------------------------------------------------
-// cxoSodaCollection_insertMany()
-//   Inserts multilple document into the collection at one time.
+// cxoSodaCollection_insertManyFromList()
+//   Inserts the list of documents into the collection at one time and return
+// either None or, if requested, a list of documents containing all but the
+// content itself.
 //-----------------------------------------------------------------------------
-static PyObject *cxoSodaCollection_insertMany(cxoSodaCollection *coll,
-        PyObject *arg)
+static PyObject *cxoSodaCollection_insertManyFromList(cxoSodaCollection *coll,
+        PyObject *docs, int getDocs)
 {
-    dpiSodaDoc **handles;
+    dpiSodaDoc **handles, **returnHandles = NULL;
     Py_ssize_t numDocs;
     PyObject *result;
 
-    if (!PyList_Check(arg)) {
-        PyErr_SetString(PyExc_TypeError, "expecting list");
-        return NULL;
-    }
-    numDocs = PyList_GET_SIZE(arg);
+    numDocs = PyList_GET_SIZE(docs);
     handles = PyMem_Malloc(numDocs * sizeof(dpiSodaDoc*));
     if (!handles) {
         PyErr_NoMemory();
         return NULL;
     }
-    result = cxoSodaCollection_insertManyHelper(coll, arg, numDocs, handles,
-            NULL);
+    if (getDocs) {
+        returnHandles = PyMem_Malloc(numDocs * sizeof(dpiSodaDoc*));
+        if (!returnHandles) {
+            PyErr_NoMemory();
+            PyMem_Free(handles);
+            return NULL;
+        }
+    }
+    result = cxoSodaCollection_insertManyHelper(coll, docs, numDocs, handles,
+            returnHandles);
     PyMem_Free(handles);
+    if (returnHandles)
+        PyMem_Free(returnHandles);
     return result;
 }
 
 
 //-----------------------------------------------------------------------------
-// cxoSodaCollection_insertManyAndGet()
-//   Inserts multiple documents into the collection at one time and return a
-// list of documents containing all but the content itself.
+// cxoSodaCollection_insertManyFromIterable()
+//   Inserts the documents produced by an iterable into the collection. If a
+// batch size is specified, the documents are inserted in batches of that
+// size as they are produced; otherwise, all of them are inserted at one time.
 //-----------------------------------------------------------------------------
-static PyObject *cxoSodaCollection_insertManyAndGet(cxoSodaCollection *coll,
-        PyObject *arg)
+static PyObject *cxoSodaCollection_insertManyFromIterable(
+        cxoSodaCollection *coll, PyObject *args, PyObject *keywordArgs,
+        int getDocs)
 {
-    dpiSodaDoc **handles, **returnHandles;
-    Py_ssize_t numDocs;
-    PyObject *result;
+    static char *keywordList[] = { "docs", "batchSize", NULL };
+    PyObject *docs, *iterator, *batch, *item, *result, *returnDocs;
+    uint32_t batchSize;
+    Py_ssize_t size;
 
-    if (!PyList_Check(arg)) {
-        PyErr_SetString(PyExc_TypeError, "expecting list");
+    // parse arguments
+    batchSize = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "O|I", keywordList,
+            &docs, &batchSize))
         return NULL;
+
+    // lists that fit in a single batch are inserted directly
+    if (PyList_Check(docs) && (batchSize == 0 ||
+            PyList_GET_SIZE(docs) <= (Py_ssize_t) batchSize))
+        return cxoSodaCollection_insertManyFromList(coll, docs, getDocs);
+
+    // if no batch size was specified, all of the documents are inserted at
+    // one time
+    if (batchSize == 0) {
+        batch = PySequence_List(docs);
+        if (!batch)
+            return NULL;
+        result = cxoSodaCollection_insertManyFromList(coll, batch, getDocs);
+        Py_DECREF(batch);
+        return result;
     }
-    numDocs = PyList_GET_SIZE(arg);
-    handles = PyMem_Malloc(numDocs * sizeof(dpiSodaDoc*));
-    if (!handles) {
-        PyErr_NoMemory();
+
+    // otherwise, insert the documents in batches
+    iterator = PyObject_GetIter(docs);
+    if (!iterator)
+        return NULL;
+    batch = PyList_New(0);
+    returnDocs = (getDocs) ? PyList_New(0) : NULL;
+    if (!batch || (getDocs && !returnDocs)) {
+        Py_DECREF(iterator);
+        Py_XDECREF(batch);
+        Py_XDECREF(returnDocs);
         return NULL;
     }
-    returnHandles = PyMem_Malloc(numDocs * sizeof(dpiSodaDoc*));
-    if (!returnHandles) {
-        PyErr_NoMemory();
-        PyMem_Free(handles);
+    while (1) {
+        item = PyIter_Next(iterator);
+        if (item) {
+            if (PyList_Append(batch, item) < 0) {
+                Py_DECREF(item);
+                break;
+            }
+            Py_DECREF(item);
+            if (PyList_GET_SIZE(batch) < (Py_ssize_t) batchSize)
+                continue;
+        } else if (PyErr_Occurred() || PyList_GET_SIZE(batch) == 0)
+            break;
+        result = cxoSodaCollection_insertManyFromList(coll, batch, getDocs);
+        if (!result)
+            break;
+        size = PyList_GET_SIZE(batch);
+        if (getDocs && PyList_SetSlice(returnDocs,
+                PyList_GET_SIZE(returnDocs), PyList_GET_SIZE(returnDocs),
+                result) < 0) {
+            Py_DECREF(result);
+            break;
+        }
+        Py_DECREF(result);
+        if (PyList_SetSlice(batch, 0, size, NULL) < 0 || !item)
+            break;
+    }
+    Py_DECREF(iterator);
+    Py_DECREF(batch);
+    if (PyErr_Occurred()) {
+        Py_XDECREF(returnDocs);
         return NULL;
     }
-    result = cxoSodaCollection_insertManyHelper(coll, arg, numDocs, handles,
-            returnHandles);
-    PyMem_Free(handles);
-    PyMem_Free(returnHandles);
-    return result;
+    if (getDocs)
+        return returnDocs;
+    Py_RETURN_NONE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSodaCollection_insertMany()
+//   Inserts multilple document into the collection at one time.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSodaCollection_insertMany(cxoSodaCollection *coll,
+        PyObject *args, PyObject *keywordArgs)
+{
+    return cxoSodaCollection_insertManyFromIterable(coll, args, keywordArgs,
+            0);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSodaCollection_insertManyAndGet()
+//   Inserts multiple documents into the collection at one time and return a
+// list of documents containing all but the content itself.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSodaCollection_insertManyAndGet(cxoSodaCollection *coll,
+        PyObject *args, PyObject *keywordArgs)
+{
+    return cxoSodaCollection_insertManyFromIterable(coll, args, keywordArgs,
+            1);
 }
 
 
@@ -517,9 +601,10 @@ static PyMethodDef cxoMethods[] = {
     { "insertOne", (PyCFunction) cxoSodaCollection_insertOne, METH_O },
     { "insertOneAndGet", (PyCFunction) cxoSodaCollection_insertOneAndGet,
             METH_O },
-    { "insertMany", (PyCFunction) cxoSodaCollection_insertMany, METH_O },
+    { "insertMany", (PyCFunction) cxoSodaCollection_insertMany,
+            METH_VARARGS | METH_KEYWORDS },
     { "insertManyAndGet", (PyCFunction) cxoSodaCollection_insertManyAndGet,
-            METH_O },
+            METH_VARARGS | METH_KEYWORDS },
     { "save", (PyCFunction) cxoSodaCollection_save, METH_O },
     { "saveAndGet", (PyCFunction) cxoSodaCollection_saveAndGet, METH_O },
     { "truncate", (PyCFunction) cxoSodaCollection_truncate, METH_NOARGS },
@@ -33,6 +33,200 @@ cxoSodaDocCursor *cxoSodaDocCursor_new(cxoSodaDatabase *db,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSodaDocCursor_appendContentsHelper()
+//   Append the decoded contents of each of the documents to the list one at
+// a time. This is used when the contents of the documents cannot be decoded
+// together.
+//-----------------------------------------------------------------------------
+static int cxoSodaDocCursor_appendContentsHelper(dpiSodaDoc **handles,
+        uint32_t numDocs, PyObject *list)
+{
+    const char *content, *encoding;
+    PyObject *str, *value;
+    uint32_t i, length;
+
+    for (i = 0; i < numDocs; i++) {
+        if (dpiSodaDoc_getContent(handles[i], &content, &length,
+                &encoding) < 0)
+            return cxoError_raiseAndReturnInt();
+        if (length == 0) {
+            if (PyList_Append(list, Py_None) < 0)
+                return -1;
+            continue;
+        }
+        str = PyUnicode_Decode(content, length, encoding, NULL);
+        if (!str)
+            return -1;
+        value = PyObject_CallFunctionObjArgs(cxoJsonLoadFunction, str, NULL);
+        Py_DECREF(str);
+        if (!value)
+            return -1;
+        if (PyList_Append(list, value) < 0) {
+            Py_DECREF(value);
+            return -1;
+        }
+        Py_DECREF(value);
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSodaDocCursor_appendContents()
+//   Append the decoded contents of each of the documents to the list. If all
+// of the documents are JSON documents encoded in UTF-8, their contents are
+// joined into a single JSON array which is decoded at once; otherwise, the
+// contents of each document are decoded separately.
+//-----------------------------------------------------------------------------
+static int cxoSodaDocCursor_appendContents(dpiSodaDoc **handles,
+        uint32_t numDocs, PyObject *list)
+{
+    const char *content, *encoding, *mediaType;
+    uint32_t i, length, mediaTypeLength;
+    PyObject *str, *values;
+    size_t size, offset;
+    Py_ssize_t pos;
+    char *buffer;
+
+    // determine the size of the array, if possible
+    size = 2;
+    for (i = 0; i < numDocs; i++) {
+        if (dpiSodaDoc_getMediaType(handles[i], &mediaType,
+                &mediaTypeLength) < 0)
+            return cxoError_raiseAndReturnInt();
+        if (dpiSodaDoc_getContent(handles[i], &content, &length,
+                &encoding) < 0)
+            return cxoError_raiseAndReturnInt();
+        if (mediaTypeLength != 16 ||
+                strncmp(mediaType, "application/json", 16) != 0 ||
+                (encoding && strcmp(encoding, "UTF-8") != 0))
+            return cxoSodaDocCursor_appendContentsHelper(handles, numDocs,
+                    list);
+        size += ((length > 0) ? length : 4) + 1;
+    }
+
+    // join the contents of the documents into an array
+    buffer = PyMem_Malloc(size);
+    if (!buffer) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    buffer[0] = '[';
+    offset = 1;
+    for (i = 0; i < numDocs; i++) {
+        if (dpiSodaDoc_getContent(handles[i], &content, &length,
+                &encoding) < 0) {
+            PyMem_Free(buffer);
+            return cxoError_raiseAndReturnInt();
+        }
+        if (i > 0)
+            buffer[offset++] = ',';
+        if (length == 0) {
+            memcpy(buffer + offset, "null", 4);
+            offset += 4;
+        } else {
+            memcpy(buffer + offset, content, length);
+            offset += length;
+        }
+    }
+    buffer[offset++] = ']';
+
+    // decode the array and append its elements to the list
+    str = PyUnicode_DecodeUTF8(buffer, (Py_ssize_t) offset, NULL);
+    PyMem_Free(buffer);
+    if (!str)
+        return -1;
+    values = PyObject_CallFunctionObjArgs(cxoJsonLoadFunction, str, NULL);
+    Py_DECREF(str);
+    if (!values)
+        return -1;
+    if (!PyList_Check(values) ||
+            PyList_GET_SIZE(values) != (Py_ssize_t) numDocs) {
+        Py_DECREF(values);
+        return cxoSodaDocCursor_appendContentsHelper(handles, numDocs,
+                list);
+    }
+    pos = PyList_GET_SIZE(list);
+    if (PyList_SetSlice(list, pos, pos, values) < 0) {
+        Py_DECREF(values);
+        return -1;
+    }
+    Py_DECREF(values);
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSodaDocCursor_fetch()
+//   Fetch up to the specified number of documents from the cursor and append
+// them to the list, either as document objects or, if requested, as their
+// decoded contents. The documents are fetched without reacquiring the GIL
+// between them. The number of documents fetched is returned; if this is
+// less than the number requested, the cursor has been exhausted. On error,
+// -1 is returned.
+//-----------------------------------------------------------------------------
+int cxoSodaDocCursor_fetch(cxoSodaDatabase *db, dpiSodaDocCursor *handle,
+        uint32_t numDocs, int contents, PyObject *list)
+{
+    uint32_t flags, numFetched, i;
+    dpiSodaDoc **handles;
+    cxoSodaDoc *doc;
+    int status = 0;
+
+    // fetch the documents
+    if (cxoConnection_getSodaFlags(db->connection, &flags) < 0)
+        return -1;
+    handles = PyMem_Malloc(numDocs * sizeof(dpiSodaDoc*));
+    if (!handles) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    numFetched = 0;
+    Py_BEGIN_ALLOW_THREADS
+    while (numFetched < numDocs) {
+        status = dpiSodaDocCursor_getNext(handle, flags,
+                &handles[numFetched]);
+        if (status < 0 || !handles[numFetched])
+            break;
+        numFetched++;
+    }
+    Py_END_ALLOW_THREADS
+    if (status < 0)
+        cxoError_raiseAndReturnInt();
+
+    // append the contents of the documents, if requested
+    else if (contents) {
+        status = cxoSodaDocCursor_appendContents(handles, numFetched, list);
+
+    // otherwise, append the documents themselves; the documents take
+    // ownership of the handles
+    } else {
+        for (i = 0; i < numFetched; i++) {
+            doc = cxoSodaDoc_new(db, handles[i]);
+            handles[i] = NULL;
+            if (!doc || PyList_Append(list, (PyObject*) doc) < 0) {
+                Py_XDECREF(doc);
+                status = -1;
+                break;
+            }
+            Py_DECREF(doc);
+        }
+    }
+
+    // release any handles that remain
+    for (i = 0; i < numFetched; i++) {
+        if (handles[i])
+            dpiSodaDoc_release(handles[i]);
+    }
+    PyMem_Free(handles);
+
+    return (status < 0) ? -1 : (int) numFetched;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSodaDocCursor_free()
 //   Free the memory associated with a SODA document cursor.
@@ -78,6 +272,36 @@ static PyObject *cxoSodaDocCursor_close(cxoSodaDocCursor *cursor,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSodaDocCursor_fetchMany()
+//   Return a list of up to the specified number of documents from the
+// cursor, or their decoded contents if requested. An empty list is returned
+// once the cursor has been exhausted.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSodaDocCursor_fetchMany(cxoSodaDocCursor *cursor,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "numDocs", "contents", NULL };
+    uint32_t numDocs;
+    PyObject *list;
+    int contents;
+
+    contents = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "I|p", keywordList,
+            &numDocs, &contents))
+        return NULL;
+    list = PyList_New(0);
+    if (!list)
+        return NULL;
+    if (numDocs > 0 && cxoSodaDocCursor_fetch(cursor->db, cursor->handle,
+            numDocs, contents, list) < 0) {
+        Py_DECREF(list);
+        return NULL;
+    }
+    return list;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSodaDocCursor_getIter()
 //   Return a reference to the cursor which supports the iterator protocol.
@@ -121,6 +345,8 @@ static PyObject *cxoSodaDocCursor_getNext(cxoSodaDocCursor *cursor)
 //-----------------------------------------------------------------------------
 static PyMethodDef cxoMethods[] = {
     { "close", (PyCFunction) cxoSodaDocCursor_close, METH_NOARGS },
+    { "fetchMany", (PyCFunction) cxoSodaDocCursor_fetchMany,
+            METH_VARARGS | METH_KEYWORDS },
     { NULL }
 };
 
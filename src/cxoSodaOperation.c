@@ -304,19 +304,25 @@ static PyObject *cxoSodaOperation_getCursor(cxoSodaOperation *op,
 
 
 //-----------------------------------------------------------------------------
-// cxoSodaOperation_getDocuments()
-//   Returns a list of documents that match the criteria.
+// cxoSodaOperation_getDocumentsHelper()
+//   Returns a list of the documents that match the criteria, or their decoded
+// contents if requested. The documents are fetched in batches of the given
+// size, with the GIL released once for each batch.
 //-----------------------------------------------------------------------------
-static PyObject *cxoSodaOperation_getDocuments(cxoSodaOperation *op,
-        PyObject *args)
+static PyObject *cxoSodaOperation_getDocumentsHelper(cxoSodaOperation *op,
+        uint32_t batchSize, int contents)
 {
     dpiSodaDocCursor *cursor;
-    PyObject *docObj;
-    dpiSodaDoc *doc;
     PyObject *list;
     uint32_t flags;
     int status;
 
+    // determine the batch size to use
+    if (batchSize == 0)
+        batchSize = op->options.fetchArraySize;
+    if (batchSize == 0)
+        batchSize = CXO_SODA_DEFAULT_BATCH_SIZE;
+
     // acquire cursor
     if (cxoConnection_getSodaFlags(op->coll->db->connection, &flags) < 0)
         return NULL;
@@ -326,34 +332,22 @@ static PyObject *cxoSodaOperation_getDocuments(cxoSodaOperation *op,
     if (status < 0)
         return cxoError_raiseAndReturnNull();
 
-    // iterate cursor and create array of documents
+    // fetch batches of documents until the cursor is exhausted
     list = PyList_New(0);
     if (!list) {
         dpiSodaDocCursor_release(cursor);
         return NULL;
     }
     while (1) {
-        Py_BEGIN_ALLOW_THREADS
-        status = dpiSodaDocCursor_getNext(cursor, flags, &doc);
-        Py_END_ALLOW_THREADS
+        status = cxoSodaDocCursor_fetch(op->coll->db, cursor, batchSize,
+                contents, list);
         if (status < 0) {
-            cxoError_raiseAndReturnNull();
+            Py_DECREF(list);
             dpiSodaDocCursor_release(cursor);
             return NULL;
         }
-        if (!doc)
+        if ((uint32_t) status < batchSize)
             break;
-        docObj = (PyObject*) cxoSodaDoc_new(op->coll->db, doc);
-        if (!docObj) {
-            dpiSodaDocCursor_release(cursor);
-            return NULL;
-        }
-        if (PyList_Append(list, docObj) < 0) {
-            Py_DECREF(docObj);
-            dpiSodaDocCursor_release(cursor);
-            return NULL;
-        }
-        Py_DECREF(docObj);
     }
     dpiSodaDocCursor_release(cursor);
 
@@ -361,6 +355,36 @@ static PyObject *cxoSodaOperation_getDocuments(cxoSodaOperation *op,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSodaOperation_getContents()
+//   Returns a list of the decoded contents of the documents that match the
+// criteria.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSodaOperation_getContents(cxoSodaOperation *op,
+        PyObject *args, PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "batchSize", NULL };
+    uint32_t batchSize;
+
+    batchSize = 0;
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|I", keywordList,
+            &batchSize))
+        return NULL;
+    return cxoSodaOperation_getDocumentsHelper(op, batchSize, 1);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSodaOperation_getDocuments()
+//   Returns a list of documents that match the criteria.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSodaOperation_getDocuments(cxoSodaOperation *op,
+        PyObject *args)
+{
+    return cxoSodaOperation_getDocumentsHelper(op, 0, 0);
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSodaOperation_getOne()
 //   Returns a single document that matches the criteria or None if no
@@ -495,6 +519,8 @@ static PyMethodDef cxoMethods[] = {
     { "version", (PyCFunction) cxoSodaOperation_version, METH_O },
     { "count", (PyCFunction) cxoSodaOperation_count, METH_NOARGS },
     { "getCursor", (PyCFunction) cxoSodaOperation_getCursor, METH_NOARGS },
+    { "getContents", (PyCFunction) cxoSodaOperation_getContents,
+            METH_VARARGS | METH_KEYWORDS },
     { "getDocuments", (PyCFunction) cxoSodaOperation_getDocuments,
             METH_NOARGS },
     { "getOne", (PyCFunction) cxoSodaOperation_getOne, METH_NOARGS },
@@ -0,0 +1,160 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoStatementStats.c
+//   Defines the routines used for gathering timing statistics for the phases
+// of statement execution (prepare, bind, execute and fetch) on cursors and
+// connections. Statistics are only gathered for cursors that have requested
+// them and are exposed to Python as a struct sequence.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+//-----------------------------------------------------------------------------
+// names of the phases passed to the stats handler
+//-----------------------------------------------------------------------------
+static const char *cxoStatementPhaseNames[] = {
+    "prepare",
+    "bind",
+    "execute",
+    "fetch"
+};
+
+
+//-----------------------------------------------------------------------------
+// declaration of fields and description of the struct sequence
+//-----------------------------------------------------------------------------
+static PyStructSequence_Field cxoStatementStatsFields[] = {
+    { "prepares", "number of statements prepared" },
+    { "executes", "number of statements executed" },
+    { "fetch_calls", "number of calls made to fetch rows" },
+    { "rows_fetched", "number of rows fetched from the database" },
+    { "prepare_time", "seconds spent preparing statements" },
+    { "bind_time", "seconds spent converting and binding parameters" },
+    { "execute_time", "seconds spent executing statements" },
+    { "fetch_time", "seconds spent fetching rows from the database" },
+    { "row_time", "seconds spent creating rows from fetched data" },
+    { NULL }
+};
+
+static PyStructSequence_Desc cxoStatementStatsDesc = {
+    "cx_Oracle.StatementStats",
+    "Statistics gathered for the execution of statements.",
+    cxoStatementStatsFields,
+    9
+};
+
+
+//-----------------------------------------------------------------------------
+// Python type declaration
+//-----------------------------------------------------------------------------
+PyTypeObject cxoPyTypeStatementStats;
+
+
+//-----------------------------------------------------------------------------
+// cxoStatementStats_init()
+//   Initialize the struct sequence type used for returning statistics.
+//-----------------------------------------------------------------------------
+int cxoStatementStats_init(void)
+{
+    return PyStructSequence_InitType2(&cxoPyTypeStatementStats,
+            &cxoStatementStatsDesc);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStatementStats_add()
+//   Add the time spent in the given phase to the statistics.
+//-----------------------------------------------------------------------------
+static void cxoStatementStats_add(cxoStatementStats *stats,
+        cxoStatementPhase phase, double elapsed, uint32_t numRows)
+{
+    switch (phase) {
+        case CXO_STATEMENT_PHASE_PREPARE:
+            stats->numPrepares++;
+            stats->prepareTime += elapsed;
+            break;
+        case CXO_STATEMENT_PHASE_BIND:
+            stats->bindTime += elapsed;
+            break;
+        case CXO_STATEMENT_PHASE_EXECUTE:
+            stats->numExecutes++;
+            stats->executeTime += elapsed;
+            break;
+        case CXO_STATEMENT_PHASE_FETCH:
+            stats->numFetchCalls++;
+            stats->numRowsFetched += numRows;
+            stats->fetchTime += elapsed;
+            break;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStatementStats_record()
+//   Record the time spent in the given phase on the cursor and its connection
+// and call the stats handler, if one has been set on the cursor or the
+// connection. This must only be called with the GIL held.
+//-----------------------------------------------------------------------------
+int cxoStatementStats_record(cxoCursor *cursor, cxoStatementPhase phase,
+        double elapsed, uint32_t numRows)
+{
+    PyObject *handler, *result;
+
+    cxoStatementStats_add(&cursor->stats, phase, elapsed, numRows);
+    cxoStatementStats_add(&cursor->connection->stats, phase, elapsed,
+            numRows);
+    handler = cursor->statsHandler;
+    if (!handler || handler == Py_None)
+        handler = cursor->connection->statsHandler;
+    if (!handler || handler == Py_None)
+        return 0;
+    result = PyObject_CallFunction(handler, "Osd", cursor,
+            cxoStatementPhaseNames[phase], elapsed);
+    if (!result)
+        return -1;
+    Py_DECREF(result);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStatementStats_toPython()
+//   Return a struct sequence containing a snapshot of the statistics.
+//-----------------------------------------------------------------------------
+PyObject *cxoStatementStats_toPython(cxoStatementStats *stats)
+{
+    PyObject *result;
+
+    result = PyStructSequence_New(&cxoPyTypeStatementStats);
+    if (!result)
+        return NULL;
+    PyStructSequence_SET_ITEM(result, 0,
+            PyLong_FromUnsignedLongLong(stats->numPrepares));
+    PyStructSequence_SET_ITEM(result, 1,
+            PyLong_FromUnsignedLongLong(stats->numExecutes));
+    PyStructSequence_SET_ITEM(result, 2,
+            PyLong_FromUnsignedLongLong(stats->numFetchCalls));
+    PyStructSequence_SET_ITEM(result, 3,
+            PyLong_FromUnsignedLongLong(stats->numRowsFetched));
+    PyStructSequence_SET_ITEM(result, 4,
+            PyFloat_FromDouble(stats->prepareTime));
+    PyStructSequence_SET_ITEM(result, 5,
+            PyFloat_FromDouble(stats->bindTime));
+    PyStructSequence_SET_ITEM(result, 6,
+            PyFloat_FromDouble(stats->executeTime));
+    PyStructSequence_SET_ITEM(result, 7,
+            PyFloat_FromDouble(stats->fetchTime));
+    PyStructSequence_SET_ITEM(result, 8,
+            PyFloat_FromDouble(stats->rowTime));
+    if (PyErr_Occurred()) {
+        Py_DECREF(result);
+        return NULL;
+    }
+
+    return result;
+}
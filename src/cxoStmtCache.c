@@ -0,0 +1,318 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoStmtCache.c
+//   Defines the routines used for estimating the effectiveness of the
+// statement cache of a connection. ODPI-C does not expose whether a prepare
+// was satisfied from the cache so each connection keeps a model of its cache:
+// statements are identified by their tag (if one was supplied) or by a hash
+// of their SQL and the statement is considered to be found in the cache if
+// fewer than the configured number of statements have been prepared since it
+// was last used. A small number of entries beyond the size of the cache are
+// retained so that statements that are repeatedly evicted can be reported.
+// The statement cache belongs to the session, however, and sessions acquired
+// from a pool may already have statements cached when they are acquired; for
+// such connections, statements that have not been prepared since the
+// connection was acquired are counted as neither hits nor misses.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+// number of entries retained beyond the size of the statement cache
+#define CXO_STMT_CACHE_EXTRA_ENTRIES        64
+
+// number of entries allocated initially
+#define CXO_STMT_CACHE_INITIAL_ENTRIES      16
+
+// FNV-1a constants used for hashing tags and statements
+#define CXO_STMT_CACHE_FNV_OFFSET           14695981039346656037ULL
+#define CXO_STMT_CACHE_FNV_PRIME            1099511628211ULL
+
+
+//-----------------------------------------------------------------------------
+// cxoStmtCache_hash()
+//   Return the hash of the contents of the buffer. Tags and statements are
+// hashed from different starting points so that a tag that happens to match
+// the text of a statement is not confused with it.
+//-----------------------------------------------------------------------------
+static uint64_t cxoStmtCache_hash(cxoBuffer *buffer, int isTag)
+{
+    uint64_t hash = CXO_STMT_CACHE_FNV_OFFSET;
+    uint32_t i;
+
+    if (isTag)
+        hash = (hash ^ 0xff) * CXO_STMT_CACHE_FNV_PRIME;
+    for (i = 0; i < buffer->size; i++)
+        hash = (hash ^ (uint8_t) buffer->ptr[i]) * CXO_STMT_CACHE_FNV_PRIME;
+    return hash;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStmtCache_addEntry()
+//   Add an entry to the cache for a statement that is not already being
+// tracked. If the maximum number of entries is already being tracked, the
+// least recently used entry is replaced. Memory for the entries is only
+// allocated on a best effort basis and NULL is returned without raising an
+// exception if no entry is available.
+//-----------------------------------------------------------------------------
+static cxoStmtCacheEntry *cxoStmtCache_addEntry(cxoStmtCache *cache,
+        uint32_t cacheSize, cxoStmtCacheEntry *lru, uint64_t hash,
+        PyObject *statement, PyObject *tag)
+{
+    uint32_t maxEntries, allocatedEntries;
+    cxoStmtCacheEntry *entries, *entry;
+
+    // use a new entry if the maximum has not yet been reached
+    entry = NULL;
+    maxEntries = cacheSize + CXO_STMT_CACHE_EXTRA_ENTRIES;
+    if (cache->numEntries < maxEntries) {
+        if (cache->numEntries == cache->allocatedEntries) {
+            allocatedEntries = (cache->allocatedEntries == 0) ?
+                    CXO_STMT_CACHE_INITIAL_ENTRIES :
+                    cache->allocatedEntries * 2;
+            if (allocatedEntries > maxEntries)
+                allocatedEntries = maxEntries;
+            entries = PyMem_Realloc(cache->entries,
+                    allocatedEntries * sizeof(cxoStmtCacheEntry));
+            if (entries) {
+                cache->entries = entries;
+                cache->allocatedEntries = allocatedEntries;
+            }
+        }
+        if (cache->numEntries < cache->allocatedEntries) {
+            entry = &cache->entries[cache->numEntries++];
+            entry->statement = NULL;
+            entry->tag = NULL;
+        }
+    }
+
+    // otherwise, replace the least recently used entry
+    if (!entry) {
+        if (!lru)
+            return NULL;
+        entry = lru;
+        Py_CLEAR(entry->statement);
+        Py_CLEAR(entry->tag);
+    }
+
+    // populate the entry
+    Py_INCREF(statement);
+    entry->statement = statement;
+    if (tag && tag != Py_None) {
+        Py_INCREF(tag);
+        entry->tag = tag;
+    }
+    entry->hash = hash;
+    entry->lastUsed = 0;
+    entry->numPrepares = 0;
+    entry->numMisses = 0;
+    entry->prepareTime = 0;
+    return entry;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStmtCache_clear()
+//   Release the entries tracked by the cache.
+//-----------------------------------------------------------------------------
+void cxoStmtCache_clear(cxoStmtCache *cache)
+{
+    uint32_t i;
+
+    for (i = 0; i < cache->numEntries; i++) {
+        Py_CLEAR(cache->entries[i].statement);
+        Py_CLEAR(cache->entries[i].tag);
+    }
+    if (cache->entries) {
+        PyMem_Free(cache->entries);
+        cache->entries = NULL;
+    }
+    cache->numEntries = 0;
+    cache->allocatedEntries = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStmtCache_record()
+//   Record the prepare of a statement on the connection, along with the time
+// spent preparing it. The statistics are also added to those of the session
+// pool from which the connection was acquired, if applicable. Whether a
+// statement not yet known to the model of a pooled connection was found in
+// the cache cannot be estimated, so it is not counted as a hit or a miss.
+//-----------------------------------------------------------------------------
+void cxoStmtCache_record(cxoConnection *conn, cxoBuffer *statementBuffer,
+        cxoBuffer *tagBuffer, PyObject *statement, PyObject *tag,
+        double elapsed)
+{
+    cxoStmtCacheEntry *entry, *lru, *temp;
+    cxoStmtCache *cache = &conn->stmtCache;
+    uint32_t cacheSize, numNewer, i;
+    cxoSessionPoolStats *poolStats;
+    int hit, miss;
+    uint64_t hash;
+
+    // determine the size of the statement cache; no round trip is required
+    if (dpiConn_getStmtCacheSize(conn->handle, &cacheSize) < 0)
+        cacheSize = 0;
+
+    // search for the statement and the least recently used entry
+    if (tagBuffer->size > 0)
+        hash = cxoStmtCache_hash(tagBuffer, 1);
+    else hash = cxoStmtCache_hash(statementBuffer, 0);
+    entry = lru = NULL;
+    for (i = 0; i < cache->numEntries; i++) {
+        temp = &cache->entries[i];
+        if (temp->hash == hash)
+            entry = temp;
+        if (!lru || temp->lastUsed < lru->lastUsed)
+            lru = temp;
+    }
+
+    // the statement is in the cache if fewer statements than the size of the
+    // cache have been used since it was last used; a statement that is not
+    // known is not in the cache unless the session was acquired from a pool
+    if (entry) {
+        numNewer = 0;
+        for (i = 0; i < cache->numEntries; i++) {
+            if (cache->entries[i].lastUsed > entry->lastUsed)
+                numNewer++;
+        }
+        hit = (numNewer < cacheSize);
+        miss = !hit;
+    } else {
+        hit = 0;
+        miss = (conn->sessionPool == NULL);
+        entry = cxoStmtCache_addEntry(cache, cacheSize, lru, hash, statement,
+                tag);
+    }
+
+    // update statistics
+    cache->numPrepares++;
+    cache->prepareTime += elapsed;
+    if (hit)
+        cache->numHits++;
+    else if (miss)
+        cache->numMisses++;
+    if (entry) {
+        entry->lastUsed = ++cache->clock;
+        entry->numPrepares++;
+        entry->prepareTime += elapsed;
+        if (miss)
+            entry->numMisses++;
+    }
+    if (conn->sessionPool) {
+        poolStats = &conn->sessionPool->stats;
+        poolStats->numStatementPrepares++;
+        poolStats->statementPrepareTime += elapsed;
+        if (hit)
+            poolStats->numStatementCacheHits++;
+        else if (miss)
+            poolStats->numStatementCacheMisses++;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStmtCache_compareEntries()
+//   Compare two entries for sorting, placing the entries with the most misses
+// first and using the time spent preparing them to break ties.
+//-----------------------------------------------------------------------------
+static int cxoStmtCache_compareEntries(const void *value1, const void *value2)
+{
+    const cxoStmtCacheEntry *entry1 = *(const cxoStmtCacheEntry**) value1;
+    const cxoStmtCacheEntry *entry2 = *(const cxoStmtCacheEntry**) value2;
+
+    if (entry1->numMisses != entry2->numMisses)
+        return (entry1->numMisses > entry2->numMisses) ? -1 : 1;
+    if (entry1->prepareTime != entry2->prepareTime)
+        return (entry1->prepareTime > entry2->prepareTime) ? -1 : 1;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStmtCache_getStatements()
+//   Return a list of the statements that were most frequently not found in
+// the cache, limited to the number requested.
+//-----------------------------------------------------------------------------
+static PyObject *cxoStmtCache_getStatements(cxoStmtCache *cache, uint32_t top)
+{
+    cxoStmtCacheEntry **entries, *entry;
+    uint32_t numEntries, i;
+    PyObject *list, *item;
+
+    // collect the entries that have been missed and sort them
+    list = PyList_New(0);
+    if (!list || cache->numEntries == 0)
+        return list;
+    entries = PyMem_Malloc(cache->numEntries * sizeof(cxoStmtCacheEntry*));
+    if (!entries) {
+        Py_DECREF(list);
+        return PyErr_NoMemory();
+    }
+    numEntries = 0;
+    for (i = 0; i < cache->numEntries; i++) {
+        if (cache->entries[i].numMisses > 0)
+            entries[numEntries++] = &cache->entries[i];
+    }
+    qsort(entries, numEntries, sizeof(cxoStmtCacheEntry*),
+            cxoStmtCache_compareEntries);
+
+    // populate the list
+    if (numEntries > top)
+        numEntries = top;
+    for (i = 0; i < numEntries; i++) {
+        entry = entries[i];
+        item = Py_BuildValue("(OOKKd)", entry->statement,
+                (entry->tag) ? entry->tag : Py_None, entry->numPrepares,
+                entry->numMisses, entry->prepareTime);
+        if (!item || PyList_Append(list, item) < 0) {
+            Py_XDECREF(item);
+            Py_DECREF(list);
+            PyMem_Free(entries);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    PyMem_Free(entries);
+
+    return list;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoStmtCache_toPython()
+//   Return a dictionary containing a snapshot of the statistics gathered for
+// the statement cache. If a number of statements is requested, the statements
+// most frequently not found in the cache are included as well.
+//-----------------------------------------------------------------------------
+PyObject *cxoStmtCache_toPython(cxoStmtCache *cache, uint32_t top)
+{
+    PyObject *result, *statements;
+
+    result = Py_BuildValue("{sKsKsKsd}",
+            "prepares", cache->numPrepares,
+            "cache_hits", cache->numHits,
+            "cache_misses", cache->numMisses,
+            "prepare_time", cache->prepareTime);
+    if (!result || top == 0)
+        return result;
+    statements = cxoStmtCache_getStatements(cache, top);
+    if (!statements) {
+        Py_DECREF(result);
+        return NULL;
+    }
+    if (PyDict_SetItemString(result, "statements", statements) < 0) {
+        Py_DECREF(statements);
+        Py_DECREF(result);
+        return NULL;
+    }
+    Py_DECREF(statements);
+
+    return result;
+}
@@ -10,10 +10,31 @@
 //-----------------------------------------------------------------------------
 // cxoSubscr.c
 //   Defines the routines for handling Oracle subscription information.
+//
+// When a subscription is created with coalescing enabled, the notification
+// callback does not acquire the GIL. Instead, it copies the message into a
+// native queue protected by its own lock. The messages are removed from the
+// queue and coalesced either by a dedicated dispatcher thread which calls the
+// subscription callback or by calls to Subscription.getmessages() when no
+// callback is specified. As the dispatcher thread may outlive the
+// subscription, the queue is reference counted; the counts are only
+// manipulated with the GIL held.
 //-----------------------------------------------------------------------------
 
 #include "cxoModule.h"
 
+#ifndef PYTHREAD_INVALID_THREAD_ID
+#define PYTHREAD_INVALID_THREAD_ID      ((unsigned long) -1)
+#endif
+
+// alignment used for the structures copied into the block allocated for a
+// queued message
+#define CXO_SUBSCR_ALIGNMENT            8
+
+// number of microseconds to wait before checking for interrupts when waiting
+// for messages to be queued
+#define CXO_SUBSCR_WAIT_MICROSECONDS    100000
+
 //-----------------------------------------------------------------------------
 // cxoMessageRow_initialize()
 //   Initialize a new message row with the information from the descriptor.
@@ -44,6 +65,8 @@ static int cxoMessageTable_initialize(cxoMessageTable *tableObj,
     tableObj->operation = table->operation;
     tableObj->name = PyUnicode_Decode(table->name, table->nameLength, encoding,
             NULL);
+    if (!tableObj->name)
+        return -1;
     tableObj->rows = PyList_New(table->numRows);
     if (!tableObj->rows)
         return -1;
@@ -170,6 +193,656 @@ static int cxoMessage_initialize(cxoMessage *messageObj,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSubscr_alignSize()
+//   Return the size rounded up so that the structures copied into the block
+// allocated for a queued message are suitably aligned.
+//-----------------------------------------------------------------------------
+static size_t cxoSubscr_alignSize(size_t size)
+{
+    return (size + CXO_SUBSCR_ALIGNMENT - 1) &
+            ~((size_t) CXO_SUBSCR_ALIGNMENT - 1);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_sizeTables()
+//   Add the space required for copying the tables of a message to the sizes
+// of the structure and string areas.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_sizeTables(dpiSubscrMessageTable *tables,
+        uint32_t numTables, size_t *structSize, size_t *stringSize)
+{
+    uint32_t i, j;
+
+    *structSize += cxoSubscr_alignSize(numTables *
+            sizeof(dpiSubscrMessageTable));
+    for (i = 0; i < numTables; i++) {
+        *stringSize += tables[i].nameLength;
+        *structSize += cxoSubscr_alignSize(tables[i].numRows *
+                sizeof(dpiSubscrMessageRow));
+        for (j = 0; j < tables[i].numRows; j++)
+            *stringSize += tables[i].rows[j].rowidLength;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_copyStruct()
+//   Copy an array of structures into the structure area of the block
+// allocated for a queued message.
+//-----------------------------------------------------------------------------
+static void *cxoSubscr_copyStruct(char **structs, const void *value,
+        size_t size)
+{
+    void *ptr = *structs;
+
+    if (size > 0)
+        memcpy(ptr, value, size);
+    *structs += cxoSubscr_alignSize(size);
+    return ptr;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_copyString()
+//   Copy a string into the string area of the block allocated for a queued
+// message.
+//-----------------------------------------------------------------------------
+static const char *cxoSubscr_copyString(char **strings, const void *value,
+        size_t length)
+{
+    char *ptr = *strings;
+
+    if (!value)
+        return NULL;
+    memcpy(ptr, value, length);
+    *strings += length;
+    return ptr;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_copyTables()
+//   Copy the tables of a message (and the rows of those tables) into the block
+// allocated for a queued message.
+//-----------------------------------------------------------------------------
+static dpiSubscrMessageTable *cxoSubscr_copyTables(
+        dpiSubscrMessageTable *tables, uint32_t numTables, char **structs,
+        char **strings)
+{
+    dpiSubscrMessageTable *copy;
+    dpiSubscrMessageRow *rows;
+    uint32_t i, j;
+
+    copy = cxoSubscr_copyStruct(structs, tables,
+            numTables * sizeof(dpiSubscrMessageTable));
+    for (i = 0; i < numTables; i++) {
+        copy[i].name = cxoSubscr_copyString(strings, tables[i].name,
+                tables[i].nameLength);
+        rows = cxoSubscr_copyStruct(structs, tables[i].rows,
+                tables[i].numRows * sizeof(dpiSubscrMessageRow));
+        for (j = 0; j < tables[i].numRows; j++)
+            rows[j].rowid = cxoSubscr_copyString(strings,
+                    tables[i].rows[j].rowid, tables[i].rows[j].rowidLength);
+        copy[i].rows = rows;
+    }
+
+    return copy;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_copyMessage()
+//   Copy the message into a single block of memory so that it can be queued
+// after the notification callback returns. The structures are placed first
+// followed by the strings they reference. This is called without the GIL
+// held so only the raw memory allocator is used. NULL is returned if the
+// memory cannot be allocated.
+//-----------------------------------------------------------------------------
+static cxoSubscrEntry *cxoSubscr_copyMessage(dpiSubscrMessage *message)
+{
+    dpiErrorInfo *errorInfo = message->errorInfo;
+    size_t structSize, stringSize;
+    dpiSubscrMessageQuery *queries;
+    dpiSubscrMessage *copy;
+    cxoSubscrEntry *entry;
+    char *structs, *strings;
+    uint32_t i;
+
+    // determine the size of the block that is required
+    structSize = cxoSubscr_alignSize(sizeof(cxoSubscrEntry));
+    stringSize = message->dbNameLength + message->txIdLength +
+            message->queueNameLength + message->consumerNameLength +
+            message->aqMsgIdLength;
+    cxoSubscr_sizeTables(message->tables, message->numTables, &structSize,
+            &stringSize);
+    structSize += cxoSubscr_alignSize(message->numQueries *
+            sizeof(dpiSubscrMessageQuery));
+    for (i = 0; i < message->numQueries; i++)
+        cxoSubscr_sizeTables(message->queries[i].tables,
+                message->queries[i].numTables, &structSize, &stringSize);
+    if (errorInfo) {
+        structSize += cxoSubscr_alignSize(sizeof(dpiErrorInfo));
+        stringSize += errorInfo->messageLength;
+        if (errorInfo->encoding)
+            stringSize += strlen(errorInfo->encoding) + 1;
+        if (errorInfo->fnName)
+            stringSize += strlen(errorInfo->fnName) + 1;
+        if (errorInfo->action)
+            stringSize += strlen(errorInfo->action) + 1;
+        if (errorInfo->sqlState)
+            stringSize += strlen(errorInfo->sqlState) + 1;
+    }
+
+    // allocate the block and copy the message into it
+    entry = PyMem_RawMalloc(structSize + stringSize);
+    if (!entry)
+        return NULL;
+    entry->next = NULL;
+    copy = &entry->message;
+    *copy = *message;
+    structs = (char*) entry + cxoSubscr_alignSize(sizeof(cxoSubscrEntry));
+    strings = (char*) entry + structSize;
+    copy->dbName = cxoSubscr_copyString(&strings, message->dbName,
+            message->dbNameLength);
+    copy->txId = cxoSubscr_copyString(&strings, message->txId,
+            message->txIdLength);
+    copy->queueName = cxoSubscr_copyString(&strings, message->queueName,
+            message->queueNameLength);
+    copy->consumerName = cxoSubscr_copyString(&strings,
+            message->consumerName, message->consumerNameLength);
+    copy->aqMsgId = cxoSubscr_copyString(&strings, message->aqMsgId,
+            message->aqMsgIdLength);
+    copy->tables = cxoSubscr_copyTables(message->tables, message->numTables,
+            &structs, &strings);
+    queries = cxoSubscr_copyStruct(&structs, message->queries,
+            message->numQueries * sizeof(dpiSubscrMessageQuery));
+    for (i = 0; i < message->numQueries; i++)
+        queries[i].tables = cxoSubscr_copyTables(message->queries[i].tables,
+                message->queries[i].numTables, &structs, &strings);
+    copy->queries = queries;
+    if (errorInfo) {
+        copy->errorInfo = cxoSubscr_copyStruct(&structs, errorInfo,
+                sizeof(dpiErrorInfo));
+        copy->errorInfo->message = cxoSubscr_copyString(&strings,
+                errorInfo->message, errorInfo->messageLength);
+        if (errorInfo->encoding)
+            copy->errorInfo->encoding = cxoSubscr_copyString(&strings,
+                    errorInfo->encoding, strlen(errorInfo->encoding) + 1);
+        if (errorInfo->fnName)
+            copy->errorInfo->fnName = cxoSubscr_copyString(&strings,
+                    errorInfo->fnName, strlen(errorInfo->fnName) + 1);
+        if (errorInfo->action)
+            copy->errorInfo->action = cxoSubscr_copyString(&strings,
+                    errorInfo->action, strlen(errorInfo->action) + 1);
+        if (errorInfo->sqlState)
+            copy->errorInfo->sqlState = cxoSubscr_copyString(&strings,
+                    errorInfo->sqlState, strlen(errorInfo->sqlState) + 1);
+    }
+    return entry;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_signal()
+//   Signal that messages are available. The event is a lock which is released
+// when it is signalled and acquired by the consumer waiting for it; the flag
+// tracks the state of the lock and is only examined or changed with the mutex
+// held.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_signal(cxoSubscrQueue *queue)
+{
+    if (!queue->signalled) {
+        queue->signalled = 1;
+        PyThread_release_lock(queue->availableEvent);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_enqueue()
+//   Add a copy of the message to the end of the queue. This is called on the
+// notification thread without the GIL held. Returns -1 if the copy cannot be
+// allocated.
+//-----------------------------------------------------------------------------
+static int cxoSubscr_enqueue(cxoSubscrQueue *queue, dpiSubscrMessage *message)
+{
+    cxoSubscrEntry *entry;
+
+    entry = cxoSubscr_copyMessage(message);
+    if (!entry)
+        return -1;
+    PyThread_acquire_lock(queue->mutex, WAIT_LOCK);
+    if (queue->tail)
+        queue->tail->next = entry;
+    else queue->head = entry;
+    queue->tail = entry;
+    cxoSubscr_signal(queue);
+    PyThread_release_lock(queue->mutex);
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_requeue()
+//   Return entries that were dequeued but not processed to the front of the
+// queue.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_requeue(cxoSubscrQueue *queue, cxoSubscrEntry *entries)
+{
+    cxoSubscrEntry *last;
+
+    if (!entries)
+        return;
+    for (last = entries; last->next; last = last->next);
+    PyThread_acquire_lock(queue->mutex, WAIT_LOCK);
+    last->next = queue->head;
+    if (!queue->head)
+        queue->tail = last;
+    queue->head = entries;
+    cxoSubscr_signal(queue);
+    PyThread_release_lock(queue->mutex);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_dequeue()
+//   Remove all of the entries from the queue and return them. This is called
+// by the consumer after it has acquired the event. The closed flag is
+// returned as well, if requested.
+//-----------------------------------------------------------------------------
+static cxoSubscrEntry *cxoSubscr_dequeue(cxoSubscrQueue *queue, int *closed)
+{
+    cxoSubscrEntry *entries;
+
+    PyThread_acquire_lock(queue->mutex, WAIT_LOCK);
+    entries = queue->head;
+    queue->head = queue->tail = NULL;
+    queue->signalled = 0;
+    if (closed)
+        *closed = queue->closed;
+    PyThread_release_lock(queue->mutex);
+
+    return entries;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_freeEntries()
+//   Free the entries up to (but not including) the specified entry.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_freeEntries(cxoSubscrEntry *entry,
+        cxoSubscrEntry *stop)
+{
+    cxoSubscrEntry *next;
+
+    while (entry != stop) {
+        next = entry->next;
+        PyMem_RawFree(entry);
+        entry = next;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_releaseQueue()
+//   Release a reference to the queue and free it once the last reference has
+// been released. This is called with the GIL held.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_releaseQueue(cxoSubscrQueue *queue)
+{
+    if (--queue->refCount > 0)
+        return;
+    cxoSubscr_freeEntries(queue->head, NULL);
+    if (queue->mutex)
+        PyThread_free_lock(queue->mutex);
+    if (queue->availableEvent)
+        PyThread_free_lock(queue->availableEvent);
+    if (queue->closedEvent)
+        PyThread_free_lock(queue->closedEvent);
+    if (queue->consumerLock)
+        PyThread_free_lock(queue->consumerLock);
+    PyMem_Free(queue);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_closeQueue()
+//   Close the queue when the subscription is freed. The dispatcher thread, if
+// one is running, is woken up so that it can terminate. This is called with
+// the GIL held after the ODPI-C subscription has been released so no further
+// messages are queued.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_closeQueue(cxoSubscrQueue *queue)
+{
+    PyThread_acquire_lock(queue->mutex, WAIT_LOCK);
+    queue->closed = 1;
+    queue->subscr = NULL;
+    cxoSubscr_signal(queue);
+    PyThread_release_lock(queue->mutex);
+    PyThread_release_lock(queue->closedEvent);
+    cxoSubscr_releaseQueue(queue);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_mergeTables()
+//   Merge the tables of a message into the tables of the message with which
+// it is being coalesced. The operations of tables with the same name are
+// combined and the rows are appended to the existing table.
+//-----------------------------------------------------------------------------
+static int cxoSubscr_mergeTables(PyObject *tables, PyObject *newTables)
+{
+    cxoMessageTable *table, *newTable;
+    Py_ssize_t i, j;
+    int status;
+
+    for (i = 0; i < PyList_GET_SIZE(newTables); i++) {
+        newTable = (cxoMessageTable*) PyList_GET_ITEM(newTables, i);
+        table = NULL;
+        for (j = 0; j < PyList_GET_SIZE(tables); j++) {
+            table = (cxoMessageTable*) PyList_GET_ITEM(tables, j);
+            status = PyObject_RichCompareBool(table->name, newTable->name,
+                    Py_EQ);
+            if (status < 0)
+                return -1;
+            if (status)
+                break;
+            table = NULL;
+        }
+        if (!table) {
+            if (PyList_Append(tables, (PyObject*) newTable) < 0)
+                return -1;
+            continue;
+        }
+        table->operation |= newTable->operation;
+        if (PyList_SetSlice(table->rows, PY_SSIZE_T_MAX, PY_SSIZE_T_MAX,
+                newTable->rows) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_mergeQueries()
+//   Merge the queries of a message into the queries of the message with which
+// it is being coalesced. The operations of queries with the same id are
+// combined and their tables are merged.
+//-----------------------------------------------------------------------------
+static int cxoSubscr_mergeQueries(PyObject *queries, PyObject *newQueries)
+{
+    cxoMessageQuery *query, *newQuery;
+    Py_ssize_t i, j;
+
+    for (i = 0; i < PyList_GET_SIZE(newQueries); i++) {
+        newQuery = (cxoMessageQuery*) PyList_GET_ITEM(newQueries, i);
+        query = NULL;
+        for (j = 0; j < PyList_GET_SIZE(queries); j++) {
+            query = (cxoMessageQuery*) PyList_GET_ITEM(queries, j);
+            if (query->id == newQuery->id)
+                break;
+            query = NULL;
+        }
+        if (!query) {
+            if (PyList_Append(queries, (PyObject*) newQuery) < 0)
+                return -1;
+            continue;
+        }
+        query->operation |= newQuery->operation;
+        if (cxoSubscr_mergeTables(query->tables, newQuery->tables) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_mergeMessage()
+//   Add the message to the list of coalesced messages. Object and query
+// change messages are merged into the last message in the list if it is of
+// the same type so that the order of the events is retained; all other
+// messages are appended to the list. The transaction id is only retained if
+// all of the merged messages share it.
+//-----------------------------------------------------------------------------
+static int cxoSubscr_mergeMessage(PyObject *messages, cxoMessage *message)
+{
+    Py_ssize_t numMessages;
+    cxoMessage *last;
+    int status;
+
+    numMessages = PyList_GET_SIZE(messages);
+    if (numMessages == 0)
+        return PyList_Append(messages, (PyObject*) message);
+    last = (cxoMessage*) PyList_GET_ITEM(messages, numMessages - 1);
+    if (last->type != message->type ||
+            (message->type != DPI_EVENT_OBJCHANGE &&
+             message->type != DPI_EVENT_QUERYCHANGE))
+        return PyList_Append(messages, (PyObject*) message);
+    if (last->txId) {
+        status = 0;
+        if (message->txId) {
+            status = PyObject_RichCompareBool(last->txId, message->txId,
+                    Py_EQ);
+            if (status < 0)
+                return -1;
+        }
+        if (!status)
+            Py_CLEAR(last->txId);
+    }
+    if (message->type == DPI_EVENT_OBJCHANGE)
+        return cxoSubscr_mergeTables(last->tables, message->tables);
+    return cxoSubscr_mergeQueries(last->queries, message->queries);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_coalesce()
+//   Create messages for the queued entries up to (but not including) the
+// first entry that reports an error and coalesce them. The entry at which
+// processing stopped is returned in the next parameter.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSubscr_coalesce(cxoSubscr *subscr,
+        cxoSubscrEntry *entries, cxoSubscrEntry **next)
+{
+    cxoSubscrEntry *entry;
+    cxoMessage *message;
+    PyObject *messages;
+
+    for (entry = entries; entry && !entry->message.errorInfo;
+            entry = entry->next);
+    *next = entry;
+    messages = PyList_New(0);
+    if (!messages)
+        return NULL;
+    for (entry = entries; entry != *next; entry = entry->next) {
+        message = (cxoMessage*)
+                cxoPyTypeMessage.tp_alloc(&cxoPyTypeMessage, 0);
+        if (!message) {
+            Py_DECREF(messages);
+            return NULL;
+        }
+        if (cxoMessage_initialize(message, subscr, &entry->message) < 0 ||
+                cxoSubscr_mergeMessage(messages, message) < 0) {
+            Py_DECREF(message);
+            Py_DECREF(messages);
+            return NULL;
+        }
+        Py_DECREF(message);
+    }
+
+    return messages;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_dispatch()
+//   Deliver the queued entries to the callback, one call for each coalesced
+// message. Errors are reported in the same way as for messages that are
+// delivered directly on the notification thread.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_dispatch(cxoSubscr *subscr, cxoSubscrEntry *entries)
+{
+    PyObject *messages, *result;
+    cxoSubscrEntry *next;
+    Py_ssize_t i;
+
+    while (entries) {
+        if (entries->message.errorInfo) {
+            cxoError_raiseFromInfo(entries->message.errorInfo);
+            PyErr_Print();
+            entries = entries->next;
+            continue;
+        }
+        messages = cxoSubscr_coalesce(subscr, entries, &next);
+        if (!messages) {
+            PyErr_Print();
+        } else {
+            for (i = 0; i < PyList_GET_SIZE(messages); i++) {
+                result = PyObject_CallFunctionObjArgs(subscr->callback,
+                        PyList_GET_ITEM(messages, i), NULL);
+                if (!result)
+                    PyErr_Print();
+                Py_XDECREF(result);
+            }
+            Py_DECREF(messages);
+        }
+        entries = next;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_dispatcherMain()
+//   Main routine for the dispatcher thread. Once messages are queued, the
+// thread waits for the coalescing window to elapse and then delivers all of
+// the messages queued in the meantime. The thread terminates when the
+// subscription is freed.
+//-----------------------------------------------------------------------------
+static void cxoSubscr_dispatcherMain(void *arg)
+{
+    cxoSubscrQueue *queue = (cxoSubscrQueue*) arg;
+    PyGILState_STATE gstate;
+    cxoSubscrEntry *entries;
+    cxoSubscr *subscr;
+    int closed = 0;
+
+    while (!closed) {
+        // wait for messages to be queued and then for the window to elapse;
+        // the closed event ends the wait early when the subscription is freed
+        PyThread_acquire_lock(queue->availableEvent, WAIT_LOCK);
+        if (queue->window > 0)
+            PyThread_acquire_lock_timed(queue->closedEvent,
+                    (PY_TIMEOUT_T) queue->window * 1000, 0);
+        entries = cxoSubscr_dequeue(queue, &closed);
+
+        // deliver the messages to the callback
+        gstate = PyGILState_Ensure();
+        if (entries && !queue->closed) {
+            subscr = queue->subscr;
+            Py_INCREF(subscr);
+            cxoSubscr_dispatch(subscr, entries);
+            Py_DECREF(subscr);
+        }
+        cxoSubscr_freeEntries(entries, NULL);
+        if (closed)
+            cxoSubscr_releaseQueue(queue);
+        PyGILState_Release(gstate);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_initQueue()
+//   Create the queue used for coalesced delivery of the messages for the
+// subscription. If a callback was specified, the dispatcher thread which
+// delivers the messages to it is also started.
+//-----------------------------------------------------------------------------
+int cxoSubscr_initQueue(cxoSubscr *subscr, uint32_t window)
+{
+    cxoSubscrQueue *queue;
+
+    // create the queue
+    queue = PyMem_Malloc(sizeof(cxoSubscrQueue));
+    if (!queue) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    memset(queue, 0, sizeof(cxoSubscrQueue));
+    queue->refCount = 1;
+    queue->subscr = subscr;
+    queue->window = window;
+
+    // create the locks; the events start out not signalled (acquired)
+    queue->mutex = PyThread_allocate_lock();
+    queue->availableEvent = PyThread_allocate_lock();
+    queue->closedEvent = PyThread_allocate_lock();
+    queue->consumerLock = PyThread_allocate_lock();
+    if (!queue->mutex || !queue->availableEvent || !queue->closedEvent ||
+            !queue->consumerLock) {
+        cxoSubscr_releaseQueue(queue);
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyThread_acquire_lock(queue->availableEvent, WAIT_LOCK);
+    PyThread_acquire_lock(queue->closedEvent, WAIT_LOCK);
+    subscr->queue = queue;
+
+    // start the dispatcher thread, if applicable
+    if (!subscr->callback)
+        return 0;
+#if PY_VERSION_HEX < 0x03070000
+    PyEval_InitThreads();
+#endif
+    queue->refCount++;
+    if (PyThread_start_new_thread(cxoSubscr_dispatcherMain, queue) ==
+            PYTHREAD_INVALID_THREAD_ID) {
+        queue->refCount--;
+        cxoError_raiseFromString(cxoInterfaceErrorException,
+                "unable to start dispatcher thread");
+        return -1;
+    }
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoSubscr_wait()
+//   Wait up to the specified number of seconds for messages to be queued.
+// The GIL is released while waiting and the wait is performed in slices so
+// that interrupts are processed. Returns 1 if messages are available, 0 if
+// the timeout expired and -1 if an exception was raised.
+//-----------------------------------------------------------------------------
+static int cxoSubscr_wait(cxoSubscrQueue *queue, double timeout)
+{
+    PY_TIMEOUT_T remaining, wait;
+    PyLockStatus status;
+
+    if (timeout * 1000000 > (double) PY_TIMEOUT_MAX)
+        remaining = PY_TIMEOUT_MAX;
+    else remaining = (PY_TIMEOUT_T) (timeout * 1000000);
+    while (1) {
+        wait = (remaining < CXO_SUBSCR_WAIT_MICROSECONDS) ? remaining :
+                CXO_SUBSCR_WAIT_MICROSECONDS;
+        Py_BEGIN_ALLOW_THREADS
+        status = PyThread_acquire_lock_timed(queue->availableEvent, wait, 0);
+        Py_END_ALLOW_THREADS
+        if (status == PY_LOCK_ACQUIRED)
+            return 1;
+        remaining -= wait;
+        if (remaining <= 0)
+            return 0;
+        if (PyErr_CheckSignals() < 0)
+            return -1;
+    }
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSubscr_callbackHandler()
 //   Routine that performs the actual call.
@@ -213,10 +886,25 @@ static int cxoSubscr_callbackHandler(cxoSubscr *subscr,
 void cxoSubscr_callback(cxoSubscr *subscr, dpiSubscrMessage *message)
 {
 #ifdef WITH_THREAD
-    PyGILState_STATE gstate = PyGILState_Ensure();
+    PyGILState_STATE gstate;
 #endif
 
-    if (message->errorInfo) {
+    // queue the message for coalesced delivery, if applicable; the GIL is
+    // only acquired if the message cannot be queued
+    if (subscr->queue && cxoSubscr_enqueue(subscr->queue, message) == 0)
+        return;
+
+#ifdef WITH_THREAD
+    gstate = PyGILState_Ensure();
+#endif
+
+    if (subscr->resultCache) {
+        if (cxoResultCache_processMessage(subscr->resultCache, message) < 0)
+            PyErr_Print();
+    } else if (subscr->queue) {
+        PyErr_NoMemory();
+        PyErr_Print();
+    } else if (message->errorInfo) {
         cxoError_raiseFromInfo(message->errorInfo);
         PyErr_Print();
     } else if (cxoSubscr_callbackHandler(subscr, message) < 0)
@@ -238,6 +926,10 @@ static void cxoSubscr_free(cxoSubscr *subscr)
         dpiSubscr_release(subscr->handle);
         subscr->handle = NULL;
     }
+    if (subscr->queue) {
+        cxoSubscr_closeQueue(subscr->queue);
+        subscr->queue = NULL;
+    }
     Py_CLEAR(subscr->connection);
     Py_CLEAR(subscr->callback);
     Py_CLEAR(subscr->name);
@@ -270,6 +962,62 @@ static PyObject *cxoSubscr_repr(cxoSubscr *subscription)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoSubscr_getMessages()
+//   Return the messages queued for a subscription created with coalescing
+// enabled and no callback. The messages are coalesced before they are
+// returned. If no messages are queued, wait up to the specified number of
+// seconds for messages to arrive. Only one thread waits at a time.
+//-----------------------------------------------------------------------------
+static PyObject *cxoSubscr_getMessages(cxoSubscr *subscr, PyObject *args,
+        PyObject *keywordArgs)
+{
+    static char *keywordList[] = { "timeout", NULL };
+    cxoSubscrQueue *queue = subscr->queue;
+    cxoSubscrEntry *entries, *next;
+    PyObject *messages;
+    double timeout = 0;
+    int status;
+
+    // parse arguments
+    if (!PyArg_ParseTupleAndKeywords(args, keywordArgs, "|d", keywordList,
+            &timeout))
+        return NULL;
+    if (!queue || subscr->callback)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "subscription was not created with coalesce enabled and "
+                "no callback");
+    if (timeout < 0)
+        return cxoError_raiseFromString(cxoProgrammingErrorException,
+                "timeout must not be negative");
+
+    // wait for messages to be queued and remove them from the queue
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(queue->consumerLock, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
+    status = cxoSubscr_wait(queue, timeout);
+    entries = (status > 0) ? cxoSubscr_dequeue(queue, NULL) : NULL;
+    PyThread_release_lock(queue->consumerLock);
+    if (status < 0)
+        return NULL;
+    if (!entries)
+        return PyList_New(0);
+
+    // an error is raised if the first entry reports one; otherwise, the
+    // messages up to the first error are coalesced and returned and the
+    // remaining entries are returned to the queue
+    if (entries->message.errorInfo) {
+        next = entries->next;
+        cxoError_raiseFromInfo(entries->message.errorInfo);
+        messages = NULL;
+    } else messages = cxoSubscr_coalesce(subscr, entries, &next);
+    cxoSubscr_freeEntries(entries, next);
+    cxoSubscr_requeue(queue, next);
+
+    return messages;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoSubscr_registerQuery()
 //   Register a query for database change notification.
@@ -464,6 +1212,8 @@ static PyMemberDef cxoMessageQueryTypeMembers[] = {
 // declaration of methods for Python types
 //-----------------------------------------------------------------------------
 static PyMethodDef cxoSubscrTypeMethods[] = {
+    { "getmessages", (PyCFunction) cxoSubscr_getMessages,
+            METH_VARARGS | METH_KEYWORDS },
     { "registerquery", (PyCFunction) cxoSubscr_registerQuery,
             METH_VARARGS },
     { NULL, NULL }
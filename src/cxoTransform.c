@@ -24,6 +24,10 @@
 #define PyDateTime_DELTA_GET_MICROSECONDS(x) ((x)->microseconds)
 #endif
 
+// maximum time zone offset (in minutes) for which time zone objects are
+// cached; Oracle supports offsets from -12:00 to +14:00
+#define CXO_TRANSFORM_MAX_TZ_OFFSET     (15 * 60)
+
 // forward declarations
 static Py_ssize_t cxoTransform_calculateSize(PyObject *value,
         cxoTransformNum transformNum);
@@ -46,6 +50,10 @@ typedef struct {
 PyTypeObject *cxoPyTypeDate;
 PyTypeObject *cxoPyTypeDateTime;
 static PyTypeObject *cxoPyTypeDecimal;
+#if PY_VERSION_HEX < 0x03070000
+static PyObject *cxoPyTypeTimeZone;
+#endif
+static PyObject *cxoTimeZones[2 * CXO_TRANSFORM_MAX_TZ_OFFSET + 1];
 static const cxoTransform cxoAllTransforms[] = {
     {
         CXO_TRANSFORM_NONE,
@@ -203,6 +211,10 @@ static Py_ssize_t cxoTransform_calculateSize(PyObject *value,
         case CXO_TRANSFORM_NONE:
             return 1;
         case CXO_TRANSFORM_BINARY:
+            if (PyByteArray_Check(value))
+                return PyByteArray_GET_SIZE(value);
+            if (PyMemoryView_Check(value))
+                return PyMemoryView_GET_BUFFER(value)->len;
             return PyBytes_GET_SIZE(value);
         case CXO_TRANSFORM_NSTRING:
         case CXO_TRANSFORM_STRING:
@@ -248,8 +260,13 @@ int cxoTransform_fromPython(cxoTransformNum transformNum,
                 return -1;
             return 0;
         case CXO_TRANSFORM_BINARY:
-        case CXO_TRANSFORM_FIXED_CHAR:
         case CXO_TRANSFORM_LONG_BINARY:
+            if (cxoBuffer_fromBinaryObject(buffer, pyValue) < 0)
+                return -1;
+            dbValue->asBytes.ptr = (char*) buffer->ptr;
+            dbValue->asBytes.length = buffer->size;
+            return 0;
+        case CXO_TRANSFORM_FIXED_CHAR:
         case CXO_TRANSFORM_LONG_STRING:
         case CXO_TRANSFORM_STRING:
             if (cxoBuffer_fromObject(buffer, pyValue, encoding) < 0)
@@ -548,7 +565,8 @@ cxoTransformNum cxoTransform_getNumFromPythonValue(PyObject *value, int plsql)
     }
     if (PyUnicode_Check(value))
         return CXO_TRANSFORM_STRING;
-    if (PyBytes_Check(value))
+    if (PyBytes_Check(value) || PyByteArray_Check(value) ||
+            PyMemoryView_Check(value))
         return CXO_TRANSFORM_BINARY;
     if (PyLong_Check(value))
         return CXO_TRANSFORM_INT;
@@ -736,6 +754,15 @@ int cxoTransform_init(void)
         return -1;
     cxoPyTypeDate = PyDateTimeAPI->DateType;
     cxoPyTypeDateTime = PyDateTimeAPI->DateTimeType;
+#if PY_VERSION_HEX < 0x03070000
+    module = PyImport_ImportModule("datetime");
+    if (!module)
+        return -1;
+    cxoPyTypeTimeZone = PyObject_GetAttrString(module, "timezone");
+    Py_DECREF(module);
+    if (!cxoPyTypeTimeZone)
+        return -1;
+#endif
 
     // import the decimal module for decimal support
     module = PyImport_ImportModule("decimal");
@@ -762,111 +789,561 @@ PyObject *cxoTransform_timestampFromTicks(PyObject *args)
 
 
 //-----------------------------------------------------------------------------
-// cxoTransform_toPython()
-//   Transforms a database value into its corresponding Python object.
+// cxoTransform_numberToDouble()
+//   Parse the text representation of a number generated by ODPI-C into a
+// double. This produces the same (correctly rounded) value as creating a
+// Python float from the equivalent string, but without creating the string.
 //-----------------------------------------------------------------------------
-PyObject *cxoTransform_toPython(cxoTransformNum transformNum,
-        cxoConnection *connection, cxoObjectType *objType,
-        dpiDataBuffer *dbValue, const char *encodingErrors)
+int cxoTransform_numberToDouble(const char *ptr, uint32_t length,
+        double *value)
+{
+    char buffer[CXO_MAX_NUMBER_CHARS + 1];
+
+    if (length > CXO_MAX_NUMBER_CHARS) {
+        cxoError_raiseFromString(cxoDataErrorException,
+                "number value is too long to convert");
+        return -1;
+    }
+    memcpy(buffer, ptr, length);
+    buffer[length] = '\0';
+    *value = PyOS_string_to_double(buffer, NULL, NULL);
+    if (*value == -1.0 && PyErr_Occurred())
+        return -1;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_numberToInt64()
+//   Parse the text representation of a number generated by ODPI-C into a
+// 64-bit integer. If the text contains anything other than an optional sign
+// and digits or the value does not fit in a 64-bit integer, -1 is returned
+// but no exception is raised; the caller is expected to use another method of
+// conversion in that case.
+//-----------------------------------------------------------------------------
+int cxoTransform_numberToInt64(const char *ptr, uint32_t length,
+        int64_t *value)
+{
+    uint64_t result = 0, limit, digit;
+    int isNegative = 0;
+    uint32_t i = 0;
+
+    if (length > 0 && ptr[0] == '-') {
+        isNegative = 1;
+        i = 1;
+    }
+    if (i == length)
+        return -1;
+    limit = (isNegative) ? (uint64_t) INT64_MAX + 1 : (uint64_t) INT64_MAX;
+    for (; i < length; i++) {
+        if (ptr[i] < '0' || ptr[i] > '9')
+            return -1;
+        digit = (uint64_t) (ptr[i] - '0');
+        if (result > (limit - digit) / 10)
+            return -1;
+        result = result * 10 + digit;
+    }
+    *value = (isNegative) ? (int64_t) (0 - result) : (int64_t) result;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_isNumberTextAscii()
+//   Return a boolean indicating if the text representation of numbers is
+// ASCII, which is true of every encoding supported except UTF-16. Only in that
+// case can the text be parsed directly.
+//-----------------------------------------------------------------------------
+static int cxoTransform_isNumberTextAscii(dpiBytes *bytes)
+{
+    return (!bytes->encoding || strncmp(bytes->encoding, "UTF-16", 6) != 0);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_numberTextToPython()
+//   Transforms the text representation of a number into a Python object by
+// creating a string and calling the given type (or function) with it. This is
+// only used for values that cannot be parsed directly.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_numberTextToPython(dpiBytes *bytes,
+        const char *encodingErrors, PyObject *(*func)(PyObject*))
 {
     PyObject *stringObj, *result;
-    dpiIntervalDS *intervalDS;
-    dpiTimestamp *timestamp;
+
+    stringObj = PyUnicode_Decode(bytes->ptr, bytes->length, bytes->encoding,
+            encodingErrors);
+    if (!stringObj)
+        return NULL;
+    result = (*func)(stringObj);
+    Py_DECREF(stringObj);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonBinary()
+//   Transforms a database raw value into a Python bytes object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonBinary(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    dpiBytes *bytes = &dbValue->asBytes;
+
+    return PyBytes_FromStringAndSize(bytes->ptr, bytes->length);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonBfile()
+//   Transforms a database BFILE value into a Python LOB object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonBfile(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return cxoLob_new(connection, cxoDbTypeBfile, dbValue->asLOB);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonBlob()
+//   Transforms a database BLOB value into a Python LOB object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonBlob(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return cxoLob_new(connection, cxoDbTypeBlob, dbValue->asLOB);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonBoolean()
+//   Transforms a database boolean value into a Python boolean.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonBoolean(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    if (dbValue->asBoolean)
+        Py_RETURN_TRUE;
+    Py_RETURN_FALSE;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonClob()
+//   Transforms a database CLOB value into a Python LOB object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonClob(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return cxoLob_new(connection, cxoDbTypeClob, dbValue->asLOB);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonCursor()
+//   Transforms a database REF cursor value into a Python cursor object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonCursor(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    cxoCursor *cursor;
+
+    cursor = (cxoCursor*) PyObject_CallMethod((PyObject*) connection,
+            "cursor", NULL);
+    if (!cursor)
+        return NULL;
+    cursor->handle = dbValue->asStmt;
+    dpiStmt_addRef(cursor->handle);
+    cursor->fixupRefCursor = 1;
+    return (PyObject*) cursor;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonDate()
+//   Transforms a database date value into a Python date.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonDate(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    dpiTimestamp *timestamp = &dbValue->asTimestamp;
+
+    return PyDate_FromDate(timestamp->year, timestamp->month, timestamp->day);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonDateTime()
+//   Transforms a database date or timestamp value into a Python datetime.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonDateTime(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    dpiTimestamp *timestamp = &dbValue->asTimestamp;
+
+    return PyDateTime_FromDateAndTime(timestamp->year, timestamp->month,
+            timestamp->day, timestamp->hour, timestamp->minute,
+            timestamp->second, timestamp->fsecond / 1000);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_getTimeZone()
+//   Return a time zone object for the given offset in minutes. The objects
+// are cached so that they are only created the first time an offset is
+// encountered.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_getTimeZone(int offset)
+{
+    PyObject *delta, *timeZone;
+    int index;
+
+    index = offset + CXO_TRANSFORM_MAX_TZ_OFFSET;
+    if (index >= 0 && index <= 2 * CXO_TRANSFORM_MAX_TZ_OFFSET &&
+            cxoTimeZones[index]) {
+        Py_INCREF(cxoTimeZones[index]);
+        return cxoTimeZones[index];
+    }
+    delta = PyDelta_FromDSU(0, offset * 60, 0);
+    if (!delta)
+        return NULL;
+#if PY_VERSION_HEX < 0x03070000
+    timeZone = PyObject_CallFunctionObjArgs(cxoPyTypeTimeZone, delta, NULL);
+#else
+    timeZone = PyTimeZone_FromOffset(delta);
+#endif
+    Py_DECREF(delta);
+    if (timeZone && index >= 0 && index <= 2 * CXO_TRANSFORM_MAX_TZ_OFFSET) {
+        Py_INCREF(timeZone);
+        cxoTimeZones[index] = timeZone;
+    }
+    return timeZone;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonDateTimeWithTimeZone()
+//   Transforms a database timestamp with time zone value into a Python
+// datetime with the time zone offset of the value as its tzinfo.
+//-----------------------------------------------------------------------------
+PyObject *cxoTransform_toPythonDateTimeWithTimeZone(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    dpiTimestamp *timestamp = &dbValue->asTimestamp;
+    PyObject *timeZone, *result;
+
+    timeZone = cxoTransform_getTimeZone(timestamp->tzHourOffset * 60 +
+            timestamp->tzMinuteOffset);
+    if (!timeZone)
+        return NULL;
+    result = PyDateTimeAPI->DateTime_FromDateAndTime(timestamp->year,
+            timestamp->month, timestamp->day, timestamp->hour,
+            timestamp->minute, timestamp->second, timestamp->fsecond / 1000,
+            timeZone, PyDateTimeAPI->DateTimeType);
+    Py_DECREF(timeZone);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonDecimal()
+//   Transforms a database number value into a Python decimal.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonDecimal(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    dpiBytes *bytes = &dbValue->asBytes;
+    PyObject *stringObj, *result;
+
+    if (cxoTransform_isNumberTextAscii(bytes))
+        stringObj = PyUnicode_DecodeASCII(bytes->ptr, bytes->length, NULL);
+    else stringObj = PyUnicode_Decode(bytes->ptr, bytes->length,
+            bytes->encoding, encodingErrors);
+    if (!stringObj)
+        return NULL;
+#if PY_VERSION_HEX >= 0x03090000
+    result = PyObject_CallOneArg((PyObject*) cxoPyTypeDecimal, stringObj);
+#else
+    result = PyObject_CallFunctionObjArgs((PyObject*) cxoPyTypeDecimal,
+            stringObj, NULL);
+#endif
+    Py_DECREF(stringObj);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonFloat()
+//   Transforms a database number value into a Python float. The text of the
+// number is parsed directly into a double.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonFloat(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    dpiBytes *bytes = &dbValue->asBytes;
+    double value;
+
+    if (!cxoTransform_isNumberTextAscii(bytes))
+        return cxoTransform_numberTextToPython(bytes, encodingErrors,
+                PyNumber_Float);
+    if (cxoTransform_numberToDouble(bytes->ptr, bytes->length, &value) < 0)
+        return NULL;
+    return PyFloat_FromDouble(value);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonInt()
+//   Transforms a database number value into a Python integer, or a Python
+// float if the value has a fractional part. Values that fit in a 64-bit
+// integer are parsed directly; larger values are parsed by Python from a
+// temporary null terminated copy of the text.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonInt(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    char buffer[CXO_MAX_NUMBER_CHARS + 1];
+    dpiBytes *bytes = &dbValue->asBytes;
+    int64_t intValue;
+    double value;
+
+    if (!cxoTransform_isNumberTextAscii(bytes)) {
+        if (memchr(bytes->ptr, '.', bytes->length) == NULL)
+            return cxoTransform_numberTextToPython(bytes, encodingErrors,
+                    PyNumber_Long);
+        return cxoTransform_numberTextToPython(bytes, encodingErrors,
+                PyNumber_Float);
+    }
+    if (cxoTransform_numberToInt64(bytes->ptr, bytes->length,
+            &intValue) == 0)
+        return PyLong_FromLongLong(intValue);
+    if (memchr(bytes->ptr, '.', bytes->length) != NULL) {
+        if (cxoTransform_numberToDouble(bytes->ptr, bytes->length,
+                &value) < 0)
+            return NULL;
+        return PyFloat_FromDouble(value);
+    }
+    if (bytes->length > CXO_MAX_NUMBER_CHARS)
+        return cxoError_raiseFromString(cxoDataErrorException,
+                "number value is too long to convert");
+    memcpy(buffer, bytes->ptr, bytes->length);
+    buffer[bytes->length] = '\0';
+    return PyLong_FromString(buffer, NULL, 10);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonNativeDouble()
+//   Transforms a database binary double value into a Python float.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonNativeDouble(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return PyFloat_FromDouble(dbValue->asDouble);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonNativeFloat()
+//   Transforms a database binary float value into a Python float.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonNativeFloat(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return PyFloat_FromDouble(dbValue->asFloat);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonNativeInt()
+//   Transforms a database binary integer value into a Python integer.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonNativeInt(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return PyLong_FromLongLong(dbValue->asInt64);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonNclob()
+//   Transforms a database NCLOB value into a Python LOB object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonNclob(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return cxoLob_new(connection, cxoDbTypeNclob, dbValue->asLOB);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonObject()
+//   Transforms a database object value into a Python object.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonObject(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return cxoObject_new(objType, dbValue->asObject);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonRowid()
+//   Transforms a database rowid value into a Python string.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonRowid(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
     uint32_t rowidLength;
-    cxoDbType *dbType;
     const char *rowid;
-    cxoCursor *cursor;
-    dpiBytes *bytes;
+
+    if (dpiRowid_getStringValue(dbValue->asRowid, &rowid, &rowidLength) < 0)
+        return cxoError_raiseAndReturnNull();
+    return PyUnicode_Decode(rowid, rowidLength,
+            connection->encodingInfo.encoding, NULL);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonString()
+//   Transforms a database string value into a Python string.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonString(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    dpiBytes *bytes = &dbValue->asBytes;
+
+    return PyUnicode_Decode(bytes->ptr, bytes->length, bytes->encoding,
+            encodingErrors);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonTimedelta()
+//   Transforms a database interval day to second value into a Python
+// timedelta.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonTimedelta(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    dpiIntervalDS *intervalDS = &dbValue->asIntervalDS;
     int32_t seconds;
 
+    seconds = intervalDS->hours * 60 * 60 + intervalDS->minutes * 60 +
+            intervalDS->seconds;
+    return PyDelta_FromDSU(intervalDS->days, seconds,
+            intervalDS->fseconds / 1000);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPythonUnsupported()
+//   Raises an exception for database values that cannot be transformed.
+//-----------------------------------------------------------------------------
+static PyObject *cxoTransform_toPythonUnsupported(cxoConnection *connection,
+        cxoObjectType *objType, dpiDataBuffer *dbValue,
+        const char *encodingErrors)
+{
+    return cxoError_raiseFromString(cxoNotSupportedErrorException,
+            "Database value cannot be converted to a Python value");
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_getToPythonFunc()
+//   Returns the function used to transform a database value into its
+// corresponding Python object. Variables resolve this function once when they
+// are created so that no dispatch on the transform is required for each value.
+//-----------------------------------------------------------------------------
+cxoTransformToPythonFunc cxoTransform_getToPythonFunc(
+        cxoTransformNum transformNum)
+{
     switch (transformNum) {
         case CXO_TRANSFORM_BINARY:
         case CXO_TRANSFORM_LONG_BINARY:
-            bytes = &dbValue->asBytes;
-            return PyBytes_FromStringAndSize(bytes->ptr, bytes->length);
+            return cxoTransform_toPythonBinary;
         case CXO_TRANSFORM_BFILE:
+            return cxoTransform_toPythonBfile;
         case CXO_TRANSFORM_BLOB:
-        case CXO_TRANSFORM_CLOB:
-        case CXO_TRANSFORM_NCLOB:
-            dbType = cxoDbType_fromTransformNum(transformNum);
-            return cxoLob_new(connection, dbType, dbValue->asLOB);
+            return cxoTransform_toPythonBlob;
         case CXO_TRANSFORM_BOOLEAN:
-            if (dbValue->asBoolean)
-                Py_RETURN_TRUE;
-            Py_RETURN_FALSE;
+            return cxoTransform_toPythonBoolean;
+        case CXO_TRANSFORM_CLOB:
+            return cxoTransform_toPythonClob;
         case CXO_TRANSFORM_CURSOR:
-            cursor = (cxoCursor*) PyObject_CallMethod((PyObject*) connection,
-                    "cursor", NULL);
-            if (!cursor)
-                return NULL;
-            cursor->handle = dbValue->asStmt;
-            dpiStmt_addRef(cursor->handle);
-            cursor->fixupRefCursor = 1;
-            return (PyObject*) cursor;
+            return cxoTransform_toPythonCursor;
         case CXO_TRANSFORM_DATE:
-            timestamp = &dbValue->asTimestamp;
-            return PyDate_FromDate(timestamp->year, timestamp->month,
-                    timestamp->day);
+            return cxoTransform_toPythonDate;
         case CXO_TRANSFORM_DATETIME:
         case CXO_TRANSFORM_TIMESTAMP:
         case CXO_TRANSFORM_TIMESTAMP_LTZ:
         case CXO_TRANSFORM_TIMESTAMP_TZ:
-            timestamp = &dbValue->asTimestamp;
-            return PyDateTime_FromDateAndTime(timestamp->year,
-                    timestamp->month, timestamp->day, timestamp->hour,
-                    timestamp->minute, timestamp->second,
-                    timestamp->fsecond / 1000);
+            return cxoTransform_toPythonDateTime;
+        case CXO_TRANSFORM_DECIMAL:
+            return cxoTransform_toPythonDecimal;
         case CXO_TRANSFORM_FIXED_CHAR:
         case CXO_TRANSFORM_FIXED_NCHAR:
         case CXO_TRANSFORM_LONG_STRING:
         case CXO_TRANSFORM_NSTRING:
         case CXO_TRANSFORM_STRING:
-            bytes = &dbValue->asBytes;
-            return PyUnicode_Decode(bytes->ptr, bytes->length, bytes->encoding,
-                    encodingErrors);
+            return cxoTransform_toPythonString;
+        case CXO_TRANSFORM_FLOAT:
+            return cxoTransform_toPythonFloat;
+        case CXO_TRANSFORM_INT:
+            return cxoTransform_toPythonInt;
         case CXO_TRANSFORM_NATIVE_DOUBLE:
-            return PyFloat_FromDouble(dbValue->asDouble);
+            return cxoTransform_toPythonNativeDouble;
         case CXO_TRANSFORM_NATIVE_FLOAT:
-            return PyFloat_FromDouble(dbValue->asFloat);
+            return cxoTransform_toPythonNativeFloat;
         case CXO_TRANSFORM_NATIVE_INT:
-            return PyLong_FromLongLong(dbValue->asInt64);
-        case CXO_TRANSFORM_DECIMAL:
-        case CXO_TRANSFORM_INT:
-        case CXO_TRANSFORM_FLOAT:
-            bytes = &dbValue->asBytes;
-            stringObj = PyUnicode_Decode(bytes->ptr, bytes->length,
-                    bytes->encoding, encodingErrors);
-            if (!stringObj)
-                return NULL;
-            if (transformNum == CXO_TRANSFORM_INT &&
-                    memchr(bytes->ptr, '.', bytes->length) == NULL) {
-                result = PyNumber_Long(stringObj);
-            } else if (transformNum == CXO_TRANSFORM_DECIMAL) {
-                result = PyObject_CallFunctionObjArgs(
-                        (PyObject*) cxoPyTypeDecimal, stringObj, NULL);
-            } else {
-                result = PyNumber_Float(stringObj);
-            }
-            Py_DECREF(stringObj);
-            return result;
+            return cxoTransform_toPythonNativeInt;
+        case CXO_TRANSFORM_NCLOB:
+            return cxoTransform_toPythonNclob;
         case CXO_TRANSFORM_OBJECT:
-            return cxoObject_new(objType, dbValue->asObject);
+            return cxoTransform_toPythonObject;
         case CXO_TRANSFORM_ROWID:
-            if (dpiRowid_getStringValue(dbValue->asRowid, &rowid,
-                    &rowidLength) < 0)
-                return cxoError_raiseAndReturnNull();
-            return PyUnicode_Decode(rowid, rowidLength,
-                    connection->encodingInfo.encoding, NULL);
+            return cxoTransform_toPythonRowid;
         case CXO_TRANSFORM_TIMEDELTA:
-            intervalDS = &dbValue->asIntervalDS; 
-            seconds = intervalDS->hours * 60 * 60 + intervalDS->minutes * 60 +
-                    intervalDS->seconds;
-            return PyDelta_FromDSU(intervalDS->days, seconds,
-                    intervalDS->fseconds / 1000);
+            return cxoTransform_toPythonTimedelta;
         default:
             break;
     }
 
-    return cxoError_raiseFromString(cxoNotSupportedErrorException,
-            "Database value cannot be converted to a Python value");
+    return cxoTransform_toPythonUnsupported;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoTransform_toPython()
+//   Transforms a database value into its corresponding Python object.
+//-----------------------------------------------------------------------------
+PyObject *cxoTransform_toPython(cxoTransformNum transformNum,
+        cxoConnection *connection, cxoObjectType *objType,
+        dpiDataBuffer *dbValue, const char *encodingErrors)
+{
+    cxoTransformToPythonFunc func;
+
+    func = cxoTransform_getToPythonFunc(transformNum);
+    return (*func)(connection, objType, dbValue, encodingErrors);
 }
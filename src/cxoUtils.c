@@ -9,6 +9,10 @@
 
 #include "cxoModule.h"
 
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
 //-----------------------------------------------------------------------------
 // cxoUtils_convertOciAttrToPythonValue()
 //   Convert the OCI attribute value to an equivalent Python value using the
@@ -214,6 +218,28 @@ int cxoUtils_getModuleAndName(PyTypeObject *type, PyObject **module,
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoUtils_getMonotonicTime()
+//   Return the value of a monotonic clock, in seconds. This is only useful
+// for measuring elapsed time and may be called without the GIL held.
+//-----------------------------------------------------------------------------
+double cxoUtils_getMonotonicTime(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec / 1e9;
+#endif
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoUtils_initializeDPI()
 //   Initialize the ODPI-C library. This is done when the first standalone
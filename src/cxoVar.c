@@ -14,6 +14,346 @@
 
 #include "cxoModule.h"
 
+//-----------------------------------------------------------------------------
+// cxoVar_getValueDefault()
+//   Return the value at the given location in the variable. This is used for
+// all transforms which do not require holding an additional reference to the
+// underlying value and when no output converter has been specified.
+//-----------------------------------------------------------------------------
+static PyObject *cxoVar_getValueDefault(cxoVar *var, dpiData *data)
+{
+    if (data->isNull)
+        Py_RETURN_NONE;
+    return (*var->toPythonFunc)(var->connection, var->objectType,
+            &data->value, var->encodingErrors);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_getValueLob()
+//   Return the LOB value at the given location in the variable. An additional
+// reference to the LOB is held by the Python object that is created.
+//-----------------------------------------------------------------------------
+static PyObject *cxoVar_getValueLob(cxoVar *var, dpiData *data)
+{
+    PyObject *value;
+
+    if (data->isNull)
+        Py_RETURN_NONE;
+    value = (*var->toPythonFunc)(var->connection, var->objectType,
+            &data->value, var->encodingErrors);
+    if (value)
+        dpiLob_addRef(data->value.asLOB);
+    return value;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_getValueObject()
+//   Return the object value at the given location in the variable. An
+// additional reference to the object is held by the Python object that is
+// created.
+//-----------------------------------------------------------------------------
+static PyObject *cxoVar_getValueObject(cxoVar *var, dpiData *data)
+{
+    PyObject *value;
+
+    if (data->isNull)
+        Py_RETURN_NONE;
+    value = (*var->toPythonFunc)(var->connection, var->objectType,
+            &data->value, var->encodingErrors);
+    if (value)
+        dpiObject_addRef(data->value.asObject);
+    return value;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_getValueFromStringCache()
+//   Return the string value at the given location in the variable, using the
+// string cache to avoid decoding values that have been decoded recently. The
+// cache is direct mapped: the hash of the bytes determines the only entry in
+// which the value may be found and a decoded value replaces whatever value was
+// previously stored in that entry.
+//-----------------------------------------------------------------------------
+static PyObject *cxoVar_getValueFromStringCache(cxoVar *var, dpiData *data)
+{
+    dpiBytes *bytes = &data->value.asBytes;
+    cxoStringCacheEntry *entry;
+    PyObject *key, *value;
+    uint32_t hash, i;
+
+    if (data->isNull)
+        Py_RETURN_NONE;
+
+    // calculate the hash of the bytes (FNV-1a) and look for the value
+    hash = 2166136261u;
+    for (i = 0; i < bytes->length; i++) {
+        hash ^= (unsigned char) bytes->ptr[i];
+        hash *= 16777619u;
+    }
+    entry = &var->stringCache[hash & (var->stringCacheSize - 1)];
+    if (entry->key && PyBytes_GET_SIZE(entry->key) == bytes->length &&
+            memcmp(PyBytes_AS_STRING(entry->key), bytes->ptr,
+                    bytes->length) == 0) {
+        Py_INCREF(entry->value);
+        return entry->value;
+    }
+
+    // not found, decode the value and replace the entry
+    value = (*var->toPythonFunc)(var->connection, var->objectType,
+            &data->value, var->encodingErrors);
+    if (!value)
+        return NULL;
+    key = PyBytes_FromStringAndSize(bytes->ptr, bytes->length);
+    if (!key) {
+        Py_DECREF(value);
+        return NULL;
+    }
+    Py_XDECREF(entry->key);
+    Py_XDECREF(entry->value);
+    entry->key = key;
+    Py_INCREF(value);
+    entry->value = value;
+    return value;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_getValueFromDateCache()
+//   Return the date value at the given location in the variable, using the
+// date cache to avoid creating objects for values that have been fetched
+// recently. The cache is direct mapped in the same way as the string cache;
+// the key packs all of the components of the value into a single integer.
+// Values with fractional seconds are not cached.
+//-----------------------------------------------------------------------------
+static PyObject *cxoVar_getValueFromDateCache(cxoVar *var, dpiData *data)
+{
+    dpiTimestamp *timestamp = &data->value.asTimestamp;
+    cxoDateCacheEntry *entry;
+    PyObject *value;
+    uint64_t key;
+
+    if (data->isNull)
+        Py_RETURN_NONE;
+    if (timestamp->fsecond != 0)
+        return (*var->toPythonFunc)(var->connection, var->objectType,
+                &data->value, var->encodingErrors);
+
+    // pack the value into the key and look for the value
+    key = ((uint64_t) (uint16_t) timestamp->year << 40) |
+            ((uint64_t) timestamp->month << 32) |
+            ((uint64_t) timestamp->day << 24) |
+            ((uint64_t) timestamp->hour << 16) |
+            ((uint64_t) timestamp->minute << 8) | timestamp->second;
+    entry = &var->dateCache[(uint32_t) ((key * UINT64_C(0x9E3779B97F4A7C15))
+            >> 32) & (var->dateCacheSize - 1)];
+    if (entry->value && entry->key == key) {
+        Py_INCREF(entry->value);
+        return entry->value;
+    }
+
+    // not found, create the value and replace the entry
+    value = (*var->toPythonFunc)(var->connection, var->objectType,
+            &data->value, var->encodingErrors);
+    if (!value)
+        return NULL;
+    Py_XDECREF(entry->value);
+    entry->key = key;
+    Py_INCREF(value);
+    entry->value = value;
+    return value;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_getUnconvertedValueFunc()
+//   Return the function used to get the value from the variable before any
+// output converter is applied.
+//-----------------------------------------------------------------------------
+static cxoVarGetValueFunc cxoVar_getUnconvertedValueFunc(cxoVar *var)
+{
+    switch (var->transformNum) {
+        case CXO_TRANSFORM_BFILE:
+        case CXO_TRANSFORM_BLOB:
+        case CXO_TRANSFORM_CLOB:
+        case CXO_TRANSFORM_NCLOB:
+            return cxoVar_getValueLob;
+        case CXO_TRANSFORM_OBJECT:
+            return cxoVar_getValueObject;
+        default:
+            break;
+    }
+    if (var->stringCache)
+        return cxoVar_getValueFromStringCache;
+    if (var->dateCache)
+        return cxoVar_getValueFromDateCache;
+    return cxoVar_getValueDefault;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_getValueConverted()
+//   Return the value at the given location in the variable after calling the
+// output converter.
+//-----------------------------------------------------------------------------
+static PyObject *cxoVar_getValueConverted(cxoVar *var, dpiData *data)
+{
+    PyObject *value, *result;
+
+    if (data->isNull)
+        Py_RETURN_NONE;
+    value = (*cxoVar_getUnconvertedValueFunc(var))(var, data);
+    if (!value)
+        return NULL;
+    result = PyObject_CallFunctionObjArgs(var->outConverter, value, NULL);
+    Py_DECREF(value);
+    return result;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_resolveGetValueFunc()
+//   Resolve the function used to get values from the variable. This is done
+// when the variable is created and whenever the output converter is changed
+// so that no decisions need to be made for each value that is fetched.
+//-----------------------------------------------------------------------------
+void cxoVar_resolveGetValueFunc(cxoVar *var)
+{
+    if (var->tzAware && (var->transformNum == CXO_TRANSFORM_TIMESTAMP_TZ ||
+            var->transformNum == CXO_TRANSFORM_TIMESTAMP_LTZ))
+        var->toPythonFunc = cxoTransform_toPythonDateTimeWithTimeZone;
+    else var->toPythonFunc = cxoTransform_getToPythonFunc(var->transformNum);
+    if (var->outConverter && var->outConverter != Py_None)
+        var->getValueFunc = cxoVar_getValueConverted;
+    else var->getValueFunc = cxoVar_getUnconvertedValueFunc(var);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_clearStringCache()
+//   Clear the string cache, if one is in use.
+//-----------------------------------------------------------------------------
+static void cxoVar_clearStringCache(cxoVar *var)
+{
+    uint32_t i;
+
+    if (var->stringCache) {
+        for (i = 0; i < var->stringCacheSize; i++) {
+            Py_XDECREF(var->stringCache[i].key);
+            Py_XDECREF(var->stringCache[i].value);
+        }
+        PyMem_Free(var->stringCache);
+        var->stringCache = NULL;
+    }
+    var->stringCacheSize = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_clearDateCache()
+//   Clear the date cache, if one is in use.
+//-----------------------------------------------------------------------------
+static void cxoVar_clearDateCache(cxoVar *var)
+{
+    uint32_t i;
+
+    if (var->dateCache) {
+        for (i = 0; i < var->dateCacheSize; i++)
+            Py_XDECREF(var->dateCache[i].value);
+        PyMem_Free(var->dateCache);
+        var->dateCache = NULL;
+    }
+    var->dateCacheSize = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_setDateCacheSize()
+//   Set the number of entries in the cache of date values used when fetching
+// values from the variable. The size is rounded up to the next power of two;
+// zero disables the cache. Only date and timestamp variables without time
+// zones may use the cache.
+//-----------------------------------------------------------------------------
+int cxoVar_setDateCacheSize(cxoVar *var, uint32_t size)
+{
+    uint32_t actualSize;
+
+    // discard any existing cache
+    cxoVar_clearDateCache(var);
+
+    // create the new cache, if applicable
+    if (size > 0) {
+        switch (var->transformNum) {
+            case CXO_TRANSFORM_DATE:
+            case CXO_TRANSFORM_DATETIME:
+            case CXO_TRANSFORM_TIMESTAMP:
+                break;
+            default:
+                cxoError_raiseFromString(cxoProgrammingErrorException,
+                        "date cache can only be used with date variables");
+                return -1;
+        }
+        if (size > 0x80000000u)
+            size = 0x80000000u;
+        for (actualSize = 1; actualSize < size; actualSize *= 2);
+        var->dateCache = PyMem_Calloc(actualSize, sizeof(cxoDateCacheEntry));
+        if (!var->dateCache) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        var->dateCacheSize = actualSize;
+    }
+
+    cxoVar_resolveGetValueFunc(var);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_setStringCacheSize()
+//   Set the number of entries in the cache of decoded string values used when
+// fetching values from the variable. The size is rounded up to the next power
+// of two; zero disables the cache. Only string variables may use the cache.
+//-----------------------------------------------------------------------------
+int cxoVar_setStringCacheSize(cxoVar *var, uint32_t size)
+{
+    uint32_t actualSize;
+
+    // discard any existing cache
+    cxoVar_clearStringCache(var);
+
+    // create the new cache, if applicable
+    if (size > 0) {
+        switch (var->transformNum) {
+            case CXO_TRANSFORM_FIXED_CHAR:
+            case CXO_TRANSFORM_FIXED_NCHAR:
+            case CXO_TRANSFORM_LONG_STRING:
+            case CXO_TRANSFORM_NSTRING:
+            case CXO_TRANSFORM_STRING:
+                break;
+            default:
+                cxoError_raiseFromString(cxoProgrammingErrorException,
+                        "string cache can only be used with string variables");
+                return -1;
+        }
+        if (size > 0x80000000u)
+            size = 0x80000000u;
+        for (actualSize = 1; actualSize < size; actualSize *= 2);
+        var->stringCache = PyMem_Calloc(actualSize,
+                sizeof(cxoStringCacheEntry));
+        if (!var->stringCache) {
+            PyErr_NoMemory();
+            return -1;
+        }
+        var->stringCacheSize = actualSize;
+    }
+
+    cxoVar_resolveGetValueFunc(var);
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoVar_new()
 //   Allocate a new variable.
@@ -47,6 +387,7 @@ cxoVar *cxoVar_new(cxoCursor *cursor, Py_ssize_t numElements,
     if (var->size == 0)
         var->size = cxoTransform_getDefaultSize(transformNum);
     var->isArray = isArray;
+    cxoVar_resolveGetValueFunc(var);
 
     // determine database type
     var->dbType = cxoDbType_fromTransformNum(var->transformNum);
@@ -92,6 +433,8 @@ static void cxoVar_free(cxoVar *var)
     }
     if (var->encodingErrors)
         PyMem_Free((void*) var->encodingErrors);
+    cxoVar_clearStringCache(var);
+    cxoVar_clearDateCache(var);
     Py_CLEAR(var->connection);
     Py_CLEAR(var->inConverter);
     Py_CLEAR(var->outConverter);
@@ -123,6 +466,7 @@ cxoVar *cxoVar_newByValue(cxoCursor *cursor, PyObject *value,
     cxoTransformNum transformNum;
     Py_ssize_t size;
     cxoObject *obj;
+    cxoVar *var;
     int isArray;
 
     // determine if an input type handler should be used; an input type handler
@@ -160,12 +504,60 @@ cxoVar *cxoVar_newByValue(cxoCursor *cursor, PyObject *value,
     if (transformNum == CXO_TRANSFORM_OBJECT) {
         obj = (cxoObject*) value;
         objType = obj->objectType;
+    } else if (!isArray) {
+        var = cxoCursor_getPooledVar(cursor, (uint32_t) numElements,
+                transformNum, (uint32_t) size);
+        if (var)
+            return var;
     }
     return cxoVar_new(cursor, numElements, transformNum, size, isArray,
             objType);
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoVar_newByVar()
+//   Allocate a new variable with the same characteristics (type, size, number
+// of elements, converters, encoding errors and string cache size) as an
+// existing variable. The values of the existing variable are not copied.
+//-----------------------------------------------------------------------------
+cxoVar *cxoVar_newByVar(cxoCursor *cursor, cxoVar *var)
+{
+    cxoVar *newVar;
+
+    newVar = cxoVar_new(cursor, var->allocatedElements, var->transformNum,
+            var->size, var->isArray, var->objectType);
+    if (!newVar)
+        return NULL;
+    Py_XINCREF(var->inConverter);
+    newVar->inConverter = var->inConverter;
+    Py_XINCREF(var->outConverter);
+    newVar->outConverter = var->outConverter;
+    newVar->tzAware = var->tzAware;
+    cxoVar_resolveGetValueFunc(newVar);
+    if (var->encodingErrors) {
+        newVar->encodingErrors = PyMem_Malloc(strlen(var->encodingErrors) + 1);
+        if (!newVar->encodingErrors) {
+            Py_DECREF(newVar);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        strcpy((char*) newVar->encodingErrors, var->encodingErrors);
+    }
+    if (var->stringCacheSize > 0 &&
+            cxoVar_setStringCacheSize(newVar, var->stringCacheSize) < 0) {
+        Py_DECREF(newVar);
+        return NULL;
+    }
+    if (var->dateCacheSize > 0 &&
+            cxoVar_setDateCacheSize(newVar, var->dateCacheSize) < 0) {
+        Py_DECREF(newVar);
+        return NULL;
+    }
+    return newVar;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoVar_newArrayByType()
 //   Allocate a new PL/SQL array by looking at the Python data type.
@@ -304,7 +696,6 @@ static PyObject *cxoVar_getArrayValue(cxoVar *var, uint32_t numElements,
 //-----------------------------------------------------------------------------
 PyObject *cxoVar_getSingleValue(cxoVar *var, dpiData *data, uint32_t arrayPos)
 {
-    PyObject *value, *result;
     uint32_t numReturnedRows;
     dpiData *returnedData;
 
@@ -320,33 +711,7 @@ PyObject *cxoVar_getSingleValue(cxoVar *var, dpiData *data, uint32_t arrayPos)
     if (data)
         data = &data[arrayPos];
     else data = &var->data[arrayPos];
-    if (data->isNull)
-        Py_RETURN_NONE;
-    value = cxoTransform_toPython(var->transformNum, var->connection,
-            var->objectType, &data->value, var->encodingErrors);
-    if (value) {
-        switch (var->transformNum) {
-            case CXO_TRANSFORM_BFILE:
-            case CXO_TRANSFORM_BLOB:
-            case CXO_TRANSFORM_CLOB:
-            case CXO_TRANSFORM_NCLOB:
-                dpiLob_addRef(data->value.asLOB);
-                break;
-            case CXO_TRANSFORM_OBJECT:
-                dpiObject_addRef(data->value.asObject);
-                break;
-            default:
-                break;
-        }
-        if (var->outConverter && var->outConverter != Py_None) {
-            result = PyObject_CallFunctionObjArgs(var->outConverter, value,
-                    NULL);
-            Py_DECREF(value);
-            return result;
-        }
-    }
-
-    return value;
+    return (*var->getValueFunc)(var, data);
 }
 
 
@@ -373,57 +738,75 @@ PyObject *cxoVar_getValue(cxoVar *var, uint32_t arrayPos)
 
 
 //-----------------------------------------------------------------------------
-// cxoVar_setValueBytes()
-//   Set a value in the variable from a byte string of some sort.
+// cxoVar_resize()
+//   Replace the variable with one that is large enough to hold values of the
+// given size. The existing values are copied to the new variable, except the
+// one at the given position (which is about to be replaced).
 //-----------------------------------------------------------------------------
-static int cxoVar_setValueBytes(cxoVar *var, uint32_t pos, dpiData *data,
-        cxoBuffer *buffer)
+static int cxoVar_resize(cxoVar *var, uint32_t size, uint32_t skipPos)
 {
     dpiData *tempVarData, *sourceData;
     dpiOracleTypeNum oracleTypeNum;
     dpiNativeTypeNum nativeTypeNum;
     uint32_t i, numElements;
     dpiVar *tempVarHandle;
-    int status;
 
-    if (buffer->size > var->bufferSize) {
-        cxoTransform_getTypeInfo(var->transformNum, &oracleTypeNum,
-                &nativeTypeNum);
-        if (dpiConn_newVar(var->connection->handle, oracleTypeNum,
-                nativeTypeNum, var->allocatedElements, buffer->size, 0,
-                var->isArray, NULL, &tempVarHandle, &tempVarData) < 0)
-            return cxoError_raiseAndReturnInt();
-        if (var->isArray) {
-            if (dpiVar_getNumElementsInArray(var->handle, &numElements) < 0) {
-                cxoError_raiseAndReturnInt();
-                dpiVar_release(tempVarHandle);
-                return -1;
-            }
-            if (dpiVar_setNumElementsInArray(tempVarHandle, numElements) < 0) {
-                cxoError_raiseAndReturnInt();
-                dpiVar_release(tempVarHandle);
-                return -1;
-            }
+    cxoTransform_getTypeInfo(var->transformNum, &oracleTypeNum,
+            &nativeTypeNum);
+    if (dpiConn_newVar(var->connection->handle, oracleTypeNum,
+            nativeTypeNum, var->allocatedElements, size, 0,
+            var->isArray, NULL, &tempVarHandle, &tempVarData) < 0)
+        return cxoError_raiseAndReturnInt();
+    if (var->isArray) {
+        if (dpiVar_getNumElementsInArray(var->handle, &numElements) < 0) {
+            cxoError_raiseAndReturnInt();
+            dpiVar_release(tempVarHandle);
+            return -1;
         }
-        for (i = 0; i < var->allocatedElements; i++) {
-            sourceData = &var->data[i];
-            if (i == pos || sourceData->isNull)
-                continue;
-            if (dpiVar_setFromBytes(tempVarHandle, i,
-                    sourceData->value.asBytes.ptr,
-                    sourceData->value.asBytes.length) < 0) {
-                cxoError_raiseAndReturnInt();
-                dpiVar_release(tempVarHandle);
-                return -1;
-            }
+        if (dpiVar_setNumElementsInArray(tempVarHandle, numElements) < 0) {
+            cxoError_raiseAndReturnInt();
+            dpiVar_release(tempVarHandle);
+            return -1;
         }
-        dpiVar_release(var->handle);
-        var->handle = tempVarHandle;
-        var->data = tempVarData;
-        var->size = buffer->numCharacters;
-        var->bufferSize = buffer->size;
     }
-    status = dpiVar_setFromBytes(var->handle, pos, buffer->ptr, buffer->size);
+    for (i = 0; i < var->allocatedElements; i++) {
+        sourceData = &var->data[i];
+        if (i == skipPos || sourceData->isNull)
+            continue;
+        if (dpiVar_setFromBytes(tempVarHandle, i,
+                sourceData->value.asBytes.ptr,
+                sourceData->value.asBytes.length) < 0) {
+            cxoError_raiseAndReturnInt();
+            dpiVar_release(tempVarHandle);
+            return -1;
+        }
+    }
+    dpiVar_release(var->handle);
+    var->handle = tempVarHandle;
+    var->data = tempVarData;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_setFromBytes()
+//   Set the value of the variable at the given position from bytes that are
+// already in the form expected by the variable, resizing the variable first
+// if the value does not fit. The size of the variable is the number of
+// characters in the value for strings and the number of bytes otherwise.
+//-----------------------------------------------------------------------------
+int cxoVar_setFromBytes(cxoVar *var, uint32_t pos, const char *value,
+        uint32_t length, uint32_t numCharacters)
+{
+    int status;
+
+    if (length > var->bufferSize) {
+        if (cxoVar_resize(var, length, pos) < 0)
+            return -1;
+        var->size = numCharacters;
+        var->bufferSize = length;
+    }
+    status = dpiVar_setFromBytes(var->handle, pos, value, length);
     if (status < 0)
         return cxoError_raiseAndReturnInt();
     return 0;
@@ -513,7 +896,8 @@ static int cxoVar_setSingleValue(cxoVar *var, uint32_t arrayPos,
                     var->connection->encodingInfo.encoding,
                     var->connection->encodingInfo.nencoding, var, arrayPos);
             if (result == 0 && var->nativeTypeNum == DPI_NATIVE_TYPE_BYTES)
-                result = cxoVar_setValueBytes(var, arrayPos, data, &buffer);
+                result = cxoVar_setFromBytes(var, arrayPos, buffer.ptr,
+                        buffer.size, buffer.numCharacters);
             cxoBuffer_clear(&buffer);
         }
     }
@@ -570,6 +954,66 @@ int cxoVar_setValue(cxoVar *var, uint32_t arrayPos, PyObject *value)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoVar_setColumnValues()
+//   Set the values of the variable from a column of values (a list or tuple as
+// returned by PySequence_Fast()). The size of the largest string or bytes
+// value in the column is passed in by the caller so that the variable can be
+// resized once, instead of each time a larger value is encountered.
+//-----------------------------------------------------------------------------
+int cxoVar_setColumnValues(cxoVar *var, PyObject *values, uint32_t numValues,
+        uint32_t maxSize)
+{
+    uint32_t i;
+
+    // arrays can only be set one at a time (and only one can be set)
+    if (var->isArray) {
+        for (i = 0; i < numValues; i++) {
+            if (cxoVar_setValue(var, i,
+                    PySequence_Fast_GET_ITEM(values, i)) < 0)
+                return -1;
+        }
+        return 0;
+    }
+
+    // ensure we do not exceed the number of allocated elements
+    if (numValues > var->allocatedElements) {
+        PyErr_SetString(PyExc_IndexError,
+                "cxoVar_setColumnValues: array size exceeded");
+        return -1;
+    }
+
+    // resize the variable once, if needed, to hold the largest value
+    if (maxSize > var->size && var->nativeTypeNum == DPI_NATIVE_TYPE_BYTES) {
+        switch (var->transformNum) {
+            case CXO_TRANSFORM_BINARY:
+            case CXO_TRANSFORM_FIXED_CHAR:
+            case CXO_TRANSFORM_FIXED_NCHAR:
+            case CXO_TRANSFORM_NSTRING:
+            case CXO_TRANSFORM_STRING:
+                if (cxoVar_resize(var, maxSize, UINT32_MAX) < 0)
+                    return -1;
+                var->size = maxSize;
+                if (dpiVar_getSizeInBytes(var->handle, &var->bufferSize) < 0)
+                    return cxoError_raiseAndReturnInt();
+                break;
+            default:
+                break;
+        }
+    }
+
+    // set all of the values
+    var->isValueSet = 1;
+    for (i = 0; i < numValues; i++) {
+        if (cxoVar_setSingleValue(var, i,
+                PySequence_Fast_GET_ITEM(values, i)) < 0)
+            return -1;
+    }
+
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoVar_externalCopy()
 //   Copy the contents of the source variable to the destination variable.
@@ -675,6 +1119,34 @@ static PyObject *cxoVar_getType(cxoVar *var, void *unused)
 }
 
 
+//-----------------------------------------------------------------------------
+// cxoVar_getOutConverter()
+//   Return the output converter associated with the variable.
+//-----------------------------------------------------------------------------
+static PyObject *cxoVar_getOutConverter(cxoVar *var, void *unused)
+{
+    if (!var->outConverter)
+        Py_RETURN_NONE;
+    Py_INCREF(var->outConverter);
+    return var->outConverter;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoVar_setOutConverter()
+//   Set the output converter associated with the variable and resolve the
+// function used to get values from the variable again.
+//-----------------------------------------------------------------------------
+static int cxoVar_setOutConverter(cxoVar *var, PyObject *value, void *unused)
+{
+    Py_XINCREF(value);
+    Py_XDECREF(var->outConverter);
+    var->outConverter = value;
+    cxoVar_resolveGetValueFunc(var);
+    return 0;
+}
+
+
 //-----------------------------------------------------------------------------
 // cxoVar_repr()
 //   Return a string representation of the variable.
@@ -719,11 +1191,13 @@ static PyObject *cxoVar_repr(cxoVar *var)
 //-----------------------------------------------------------------------------
 static PyMemberDef cxoMembers[] = {
     { "bufferSize", T_INT, offsetof(cxoVar, bufferSize), READONLY },
+    { "datecachesize", T_UINT, offsetof(cxoVar, dateCacheSize), READONLY },
     { "inconverter", T_OBJECT, offsetof(cxoVar, inConverter), 0 },
     { "numElements", T_INT, offsetof(cxoVar, allocatedElements),
             READONLY },
-    { "outconverter", T_OBJECT, offsetof(cxoVar, outConverter), 0 },
     { "size", T_INT, offsetof(cxoVar, size), READONLY },
+    { "stringcachesize", T_UINT, offsetof(cxoVar, stringCacheSize),
+            READONLY },
     { NULL }
 };
 
@@ -733,6 +1207,8 @@ static PyMemberDef cxoMembers[] = {
 //-----------------------------------------------------------------------------
 static PyGetSetDef cxoCalcMembers[] = {
     { "actualElements", (getter) cxoVar_externalGetActualElements, 0, 0, 0 },
+    { "outconverter", (getter) cxoVar_getOutConverter,
+            (setter) cxoVar_setOutConverter, 0, 0 },
     { "type", (getter) cxoVar_getType, 0, 0, 0 },
     { "values", (getter) cxoVar_externalGetValues, 0, 0, 0 },
     { NULL }
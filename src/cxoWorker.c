@@ -0,0 +1,454 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2020, Oracle and/or its affiliates. All rights reserved.
+//
+// Licensed under BSD license (see LICENSE.txt).
+//-----------------------------------------------------------------------------
+
+//-----------------------------------------------------------------------------
+// cxoWorker.c
+//   Defines the routines used for performing work (such as a round-trip to
+// the database) on a native thread while the calling thread continues to
+// execute Python code. The work is performed without holding the GIL and may
+// not make use of any Python objects. Since ODPI-C retains error information
+// separately for each thread, the error information is copied by the worker
+// thread so that it can be raised by the calling thread. Work that is started
+// in the background is performed by a native thread dedicated to the worker,
+// which is started the first time it is needed and is reused for all of the
+// work started by the worker until the worker is freed. Work that is queued
+// is performed by a small pool of native threads that are shared by the whole
+// process and remain available once started. Work that may block for an
+// unbounded time (such as waiting for a session to be released back to a
+// session pool) is given a thread of its own in addition to the maximum so
+// that it cannot prevent other work from being performed.
+//-----------------------------------------------------------------------------
+
+#include "cxoModule.h"
+
+#ifndef PYTHREAD_INVALID_THREAD_ID
+#define PYTHREAD_INVALID_THREAD_ID      ((unsigned long) -1)
+#endif
+
+//-----------------------------------------------------------------------------
+// structure used to track the threads in the pool; each thread waits on its
+// own lock while it is idle so that exactly one thread is woken for each piece
+// of work that is queued
+//-----------------------------------------------------------------------------
+typedef struct cxoWorkerThread {
+    PyThread_type_lock wakeLock;
+    struct cxoWorkerThread *nextIdle;
+} cxoWorkerThread;
+
+// the pool of threads and the queue of work waiting to be performed; the
+// mutex protects the queue, the list of idle threads and the counts, which are
+// accessed by the threads in the pool without the GIL held; the number of
+// threads is permitted to exceed the maximum by the number of pieces of work
+// that may block which are queued or in progress
+static PyThread_type_lock cxoWorkerPoolMutex = NULL;
+static cxoWorker *cxoWorkerPoolHead = NULL;
+static cxoWorker *cxoWorkerPoolTail = NULL;
+static cxoWorkerThread *cxoWorkerPoolIdle = NULL;
+static uint32_t cxoWorkerPoolNumThreads = 0;
+static uint32_t cxoWorkerPoolNumBlocking = 0;
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_run()
+//   Run the function and retain the error information if it fails. This is
+// called without the GIL held.
+//-----------------------------------------------------------------------------
+static void cxoWorker_run(cxoWorker *worker)
+{
+    uint32_t length;
+
+    worker->status = (*worker->func)(worker->arg);
+    if (worker->status < 0) {
+        dpiContext_getError(cxoDpiContext, &worker->errorInfo);
+        length = worker->errorInfo.messageLength;
+        if (length > CXO_WORKER_MAX_ERROR_MESSAGE)
+            length = CXO_WORKER_MAX_ERROR_MESSAGE;
+        memcpy(worker->errorMessage, worker->errorInfo.message, length);
+        worker->errorInfo.message = worker->errorMessage;
+        worker->errorInfo.messageLength = length;
+        strncpy(worker->errorEncoding, worker->errorInfo.encoding,
+                CXO_WORKER_MAX_ERROR_ENCODING - 1);
+        worker->errorEncoding[CXO_WORKER_MAX_ERROR_ENCODING - 1] = '\0';
+        worker->errorInfo.encoding = worker->errorEncoding;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_complete()
+//   Run the function on a native thread. The lock is released once the work is
+// complete in order to notify the thread waiting for it. The worker structure
+// may not be referenced after that, so the notification function (if one was
+// set) is retained beforehand; it is called after the lock has been released
+// and is responsible for keeping its argument alive until then.
+//-----------------------------------------------------------------------------
+static void cxoWorker_complete(cxoWorker *worker)
+{
+    cxoWorkerNotifyFunc notifyFunc;
+    void *notifyArg;
+
+    cxoWorker_run(worker);
+    notifyFunc = worker->notifyFunc;
+    notifyArg = worker->arg;
+    PyThread_release_lock(worker->completedLock);
+    if (notifyFunc)
+        (*notifyFunc)(notifyArg);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_threadMain()
+//   Main routine for the native thread dedicated to a worker. The thread waits
+// for work to be started and performs it until it is asked to stop; the
+// completed lock is released one final time in order to notify the thread
+// waiting for it to stop, after which the worker may not be referenced.
+//-----------------------------------------------------------------------------
+static void cxoWorker_threadMain(void *arg)
+{
+    cxoWorker *worker = (cxoWorker*) arg;
+
+    while (1) {
+        PyThread_acquire_lock(worker->startLock, WAIT_LOCK);
+        if (worker->stopRequested)
+            break;
+        cxoWorker_complete(worker);
+    }
+    PyThread_release_lock(worker->completedLock);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_poolThreadMain()
+//   Main routine for the threads in the pool. Work is taken from the queue
+// until it is empty; the thread then adds itself to the list of idle threads
+// and waits to be woken when more work is queued. Instead of becoming idle, a
+// thread exits if the number of threads exceeds the number permitted, which
+// happens once work that may block has completed.
+//-----------------------------------------------------------------------------
+static void cxoWorker_poolThreadMain(void *arg)
+{
+    cxoWorkerThread *thread = (cxoWorkerThread*) arg;
+    cxoWorker *worker;
+    int mayBlock;
+
+    PyThread_acquire_lock(cxoWorkerPoolMutex, WAIT_LOCK);
+    while (1) {
+        worker = cxoWorkerPoolHead;
+        if (!worker) {
+            if (cxoWorkerPoolNumThreads >
+                    CXO_WORKER_POOL_MAX_THREADS + cxoWorkerPoolNumBlocking)
+                break;
+            thread->nextIdle = cxoWorkerPoolIdle;
+            cxoWorkerPoolIdle = thread;
+            PyThread_release_lock(cxoWorkerPoolMutex);
+            PyThread_acquire_lock(thread->wakeLock, WAIT_LOCK);
+            PyThread_acquire_lock(cxoWorkerPoolMutex, WAIT_LOCK);
+            continue;
+        }
+        cxoWorkerPoolHead = worker->next;
+        if (!cxoWorkerPoolHead)
+            cxoWorkerPoolTail = NULL;
+        PyThread_release_lock(cxoWorkerPoolMutex);
+        mayBlock = worker->mayBlock;
+        cxoWorker_complete(worker);
+        PyThread_acquire_lock(cxoWorkerPoolMutex, WAIT_LOCK);
+        if (mayBlock)
+            cxoWorkerPoolNumBlocking--;
+    }
+    cxoWorkerPoolNumThreads--;
+    PyThread_release_lock(cxoWorkerPoolMutex);
+    PyThread_free_lock(thread->wakeLock);
+    PyMem_RawFree(thread);
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_startPoolThread()
+//   Start another thread in the pool. The lock used to wake the thread is held
+// until work is available for it. The thread has already been counted by the
+// caller.
+//-----------------------------------------------------------------------------
+static int cxoWorker_startPoolThread(void)
+{
+    cxoWorkerThread *thread;
+
+    thread = PyMem_RawMalloc(sizeof(cxoWorkerThread));
+    if (!thread) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    thread->nextIdle = NULL;
+    thread->wakeLock = PyThread_allocate_lock();
+    if (!thread->wakeLock) {
+        PyMem_RawFree(thread);
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyThread_acquire_lock(thread->wakeLock, NOWAIT_LOCK);
+#if PY_VERSION_HEX < 0x03070000
+    PyEval_InitThreads();
+#endif
+    if (PyThread_start_new_thread(cxoWorker_poolThreadMain, thread) ==
+            PYTHREAD_INVALID_THREAD_ID) {
+        PyThread_free_lock(thread->wakeLock);
+        PyMem_RawFree(thread);
+        PyErr_SetString(PyExc_RuntimeError, "unable to start worker thread");
+        return -1;
+    }
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_discard()
+//   Wait for any work in progress to complete and discard its result, along
+// with any error that took place.
+//-----------------------------------------------------------------------------
+void cxoWorker_discard(cxoWorker *worker)
+{
+    cxoWorker_sync(worker);
+    worker->isStarted = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_free()
+//   Free the resources used by the worker. If work is still in progress, wait
+// for it to complete first, discarding any error that took place. The thread
+// dedicated to the worker, if one was started, is then asked to stop and the
+// worker waits for it to do so.
+//-----------------------------------------------------------------------------
+void cxoWorker_free(cxoWorker *worker)
+{
+    cxoWorker_discard(worker);
+    if (worker->hasThread) {
+        Py_BEGIN_ALLOW_THREADS
+        PyThread_acquire_lock(worker->completedLock, WAIT_LOCK);
+        worker->stopRequested = 1;
+        PyThread_release_lock(worker->startLock);
+        PyThread_acquire_lock(worker->completedLock, WAIT_LOCK);
+        Py_END_ALLOW_THREADS
+        PyThread_release_lock(worker->completedLock);
+        PyThread_free_lock(worker->startLock);
+        worker->startLock = NULL;
+        worker->hasThread = 0;
+        worker->stopRequested = 0;
+    }
+    if (worker->completedLock) {
+        PyThread_free_lock(worker->completedLock);
+        worker->completedLock = NULL;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_init()
+//   Initialize the worker.
+//-----------------------------------------------------------------------------
+void cxoWorker_init(cxoWorker *worker)
+{
+    worker->completedLock = NULL;
+    worker->startLock = NULL;
+    worker->func = NULL;
+    worker->notifyFunc = NULL;
+    worker->arg = NULL;
+    worker->next = NULL;
+    worker->inBackground = 0;
+    worker->mayBlock = 0;
+    worker->isStarted = 0;
+    worker->hasThread = 0;
+    worker->stopRequested = 0;
+    worker->status = 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_queue()
+//   Queue the work to be performed in the background by one of the threads in
+// the pool and return immediately. An idle thread is woken to perform the
+// work; if no thread is idle, another thread is started unless the maximum
+// number of threads has been reached, in which case the work is performed by
+// the first thread that becomes available. Work that may block always permits
+// another thread to be started, so that blocked work never occupies the
+// threads needed by other work. As with cxoWorker_start(), cxoWorker_wait()
+// must be called to determine if the work was successful.
+//-----------------------------------------------------------------------------
+int cxoWorker_queue(cxoWorker *worker, cxoWorkerFunc func, void *arg,
+        int mayBlock)
+{
+    cxoWorkerThread *thread;
+    int startThread;
+
+    // the pool mutex is created the first time work is queued
+    if (!cxoWorkerPoolMutex) {
+        cxoWorkerPoolMutex = PyThread_allocate_lock();
+        if (!cxoWorkerPoolMutex) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+
+    // the lock is held while the work is in progress
+    if (!worker->completedLock) {
+        worker->completedLock = PyThread_allocate_lock();
+        if (!worker->completedLock) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+
+    // start another thread if no thread is idle and the maximum has not been
+    // reached; if a thread cannot be started, the existing threads are used
+    // unless the work may block
+    PyThread_acquire_lock(cxoWorkerPoolMutex, WAIT_LOCK);
+    if (mayBlock)
+        cxoWorkerPoolNumBlocking++;
+    startThread = (!cxoWorkerPoolIdle && cxoWorkerPoolNumThreads <
+            CXO_WORKER_POOL_MAX_THREADS + cxoWorkerPoolNumBlocking);
+    if (startThread)
+        cxoWorkerPoolNumThreads++;
+    PyThread_release_lock(cxoWorkerPoolMutex);
+    if (startThread && cxoWorker_startPoolThread() < 0) {
+        PyThread_acquire_lock(cxoWorkerPoolMutex, WAIT_LOCK);
+        cxoWorkerPoolNumThreads--;
+        if (mayBlock || cxoWorkerPoolNumThreads == 0) {
+            if (mayBlock)
+                cxoWorkerPoolNumBlocking--;
+            PyThread_release_lock(cxoWorkerPoolMutex);
+            return -1;
+        }
+        PyThread_release_lock(cxoWorkerPoolMutex);
+        PyErr_Clear();
+    }
+
+    // add the work to the queue and wake an idle thread, if there is one
+    worker->func = func;
+    worker->arg = arg;
+    worker->next = NULL;
+    worker->inBackground = 1;
+    worker->mayBlock = mayBlock;
+    worker->status = 0;
+    PyThread_acquire_lock(worker->completedLock, NOWAIT_LOCK);
+    worker->isStarted = 1;
+    PyThread_acquire_lock(cxoWorkerPoolMutex, WAIT_LOCK);
+    if (cxoWorkerPoolTail)
+        cxoWorkerPoolTail->next = worker;
+    else cxoWorkerPoolHead = worker;
+    cxoWorkerPoolTail = worker;
+    thread = cxoWorkerPoolIdle;
+    if (thread)
+        cxoWorkerPoolIdle = thread->nextIdle;
+    PyThread_release_lock(cxoWorkerPoolMutex);
+    if (thread)
+        PyThread_release_lock(thread->wakeLock);
+
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_startThread()
+//   Start the native thread dedicated to the worker. The start lock is held
+// whenever no work is waiting to be performed by the thread.
+//-----------------------------------------------------------------------------
+static int cxoWorker_startThread(cxoWorker *worker)
+{
+    worker->startLock = PyThread_allocate_lock();
+    if (!worker->startLock) {
+        PyErr_NoMemory();
+        return -1;
+    }
+    PyThread_acquire_lock(worker->startLock, NOWAIT_LOCK);
+#if PY_VERSION_HEX < 0x03070000
+    PyEval_InitThreads();
+#endif
+    if (PyThread_start_new_thread(cxoWorker_threadMain, worker) ==
+            PYTHREAD_INVALID_THREAD_ID) {
+        PyThread_free_lock(worker->startLock);
+        worker->startLock = NULL;
+        PyErr_SetString(PyExc_RuntimeError, "unable to start worker thread");
+        return -1;
+    }
+    worker->hasThread = 1;
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_start()
+//   Start performing the work. If the work is to be performed in the
+// background, the thread dedicated to the worker (started the first time it
+// is needed) is signalled and this function returns immediately; otherwise,
+// the work is performed before this function returns (but still without
+// holding the GIL). In both cases, cxoWorker_wait() must be called to
+// determine if the work was successful before more work is started.
+//-----------------------------------------------------------------------------
+int cxoWorker_start(cxoWorker *worker, cxoWorkerFunc func, void *arg,
+        int inBackground)
+{
+    worker->func = func;
+    worker->arg = arg;
+    worker->inBackground = inBackground;
+    worker->status = 0;
+
+    // perform the work immediately, if applicable
+    if (!inBackground) {
+        worker->isStarted = 1;
+        Py_BEGIN_ALLOW_THREADS
+        cxoWorker_run(worker);
+        Py_END_ALLOW_THREADS
+        return 0;
+    }
+
+    // the lock is held while the work is in progress
+    if (!worker->completedLock) {
+        worker->completedLock = PyThread_allocate_lock();
+        if (!worker->completedLock) {
+            PyErr_NoMemory();
+            return -1;
+        }
+    }
+    if (!worker->hasThread && cxoWorker_startThread(worker) < 0)
+        return -1;
+    PyThread_acquire_lock(worker->completedLock, NOWAIT_LOCK);
+    worker->isStarted = 1;
+    PyThread_release_lock(worker->startLock);
+    return 0;
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_sync()
+//   Wait for any work in progress to complete without consuming its result;
+// cxoWorker_wait() must still be called to determine if the work was
+// successful.
+//-----------------------------------------------------------------------------
+void cxoWorker_sync(cxoWorker *worker)
+{
+    if (worker->isStarted && worker->inBackground) {
+        Py_BEGIN_ALLOW_THREADS
+        PyThread_acquire_lock(worker->completedLock, WAIT_LOCK);
+        Py_END_ALLOW_THREADS
+        PyThread_release_lock(worker->completedLock);
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+// cxoWorker_wait()
+//   Wait for the work to complete, if any was started, and raise an exception
+// if it failed.
+//-----------------------------------------------------------------------------
+int cxoWorker_wait(cxoWorker *worker)
+{
+    if (!worker->isStarted)
+        return 0;
+    cxoWorker_sync(worker);
+    worker->isStarted = 0;
+    if (worker->status < 0)
+        return cxoError_raiseFromInfo(&worker->errorInfo);
+    return 0;
+}
@@ -129,5 +129,41 @@ class TestCase(TestEnv.BaseTestCase):
         messages = otherQueue.deqMany(5)
         self.assertEqual(len(messages), 0)
 
+    def testDeqPayloads(self):
+        "test bulk dequeue of payloads only"
+        queue = self.__getAndClearRawQueue()
+        encoding = self.connection.encoding
+        messages = [self.connection.msgproperties(payload=d) \
+                for d in RAW_PAYLOAD_DATA]
+        queue.enqMany(messages)
+        payloads = queue.deqPayloads(5)
+        self.assertEqual([p.decode(encoding) for p in payloads],
+                RAW_PAYLOAD_DATA[:5])
+        results = queue.deqPayloads(3, withMsgId=True)
+        self.assertEqual([p.decode(encoding) for p, m in results],
+                RAW_PAYLOAD_DATA[5:8])
+        self.assertTrue(all(isinstance(m, bytes) for p, m in results))
+        buffer, offsets = queue.deqPayloads(10, asBuffer=True)
+        payloads = [buffer[offsets[i]:offsets[i + 1]].decode(encoding) \
+                for i in range(len(offsets) - 1)]
+        self.assertEqual(payloads, RAW_PAYLOAD_DATA[8:])
+        self.assertEqual(offsets[-1], len(buffer))
+        self.assertEqual(queue.deqPayloads(5), [])
+        self.connection.commit()
+        self.assertRaises(cx_Oracle.ProgrammingError, queue.deqPayloads, 0)
+
+    def testDeqIter(self):
+        "test iterating over batches of dequeued payloads"
+        queue = self.__getAndClearRawQueue()
+        messages = [self.connection.msgproperties(payload=d) \
+                for d in RAW_PAYLOAD_DATA]
+        queue.enqMany(messages)
+        batches = list(queue.deqIter(5))
+        self.connection.commit()
+        self.assertEqual([len(b) for b in batches], [5, 5, 2])
+        payloads = [p.decode(self.connection.encoding) \
+                for b in batches for p in b]
+        self.assertEqual(payloads, RAW_PAYLOAD_DATA)
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
@@ -368,6 +368,84 @@ class TestCase(TestEnv.BaseTestCase):
         count, = cursor.fetchone()
         self.assertEqual(count, 0)
 
+    def testPipeline(self):
+        "test running operations in a pipeline"
+        connection = TestEnv.GetConnection()
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestTempTable")
+        pipeline = connection.pipeline()
+        self.assertEqual(pipeline.connection, connection)
+        sql = "insert into TestTempTable (IntCol, StringCol) values (:1, :2)"
+        pipeline.execute(sql, (1, "First"))
+        pipeline.execute(sql, [2, None])
+        pipeline.execute("""
+                update TestTempTable set
+                    StringCol = :value
+                where IntCol <= :maxIntCol""",
+                dict(value="Updated", maxIntCol=1))
+        pipeline.commit()
+        pipeline.fetchone("select count(*) from TestTempTable")
+        pipeline.fetchmany("""
+                select IntCol, StringCol
+                from TestTempTable
+                order by IntCol""", numRows=1)
+        pipeline.fetchall("select IntCol from TestTempTable where IntCol > :1",
+                [5])
+        pipeline.execute("begin null; end;")
+        self.assertEqual(len(pipeline), 8)
+        results = pipeline.run()
+        self.assertEqual(results,
+                [1, 1, 1, None, (2,), [(1, "Updated")], [], None])
+        otherConnection = TestEnv.GetConnection()
+        otherCursor = otherConnection.cursor()
+        otherCursor.execute("select count(*) from TestTempTable")
+        count, = otherCursor.fetchone()
+        self.assertEqual(count, 2)
+        pipeline.clear()
+        self.assertEqual(len(pipeline), 0)
+        self.assertEqual(pipeline.run(), [])
+
+    def testPipelineError(self):
+        "test an error raised while running a bundle of statements"
+        connection = TestEnv.GetConnection()
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestTempTable")
+        pipeline = connection.pipeline()
+        sql = "insert into TestTempTable (IntCol, StringCol) values (:1, :2)"
+        pipeline.execute(sql, (1, "First"))
+        pipeline.execute(sql, (1, "Duplicate"))
+        self.assertRaises(cx_Oracle.IntegrityError, pipeline.run)
+        cursor.execute("select count(*) from TestTempTable")
+        count, = cursor.fetchone()
+        self.assertEqual(count, 0)
+        self.assertRaises(TypeError, pipeline.execute, 5)
+
+    def testStmtCacheStats(self):
+        "test the statistics gathered for the statement cache"
+        connection = TestEnv.GetConnection()
+        connection.stmtcachesize = 2
+        initialStats = connection.stmtcachestats()
+        self.assertEqual(sorted(initialStats),
+                ["cache_hits", "cache_misses", "prepare_time", "prepares"])
+        statements = ["select 1 from dual", "select 2 from dual",
+                "select 1 from dual", "select 3 from dual",
+                "select 2 from dual"]
+        for sql in statements:
+            cursor = connection.cursor()
+            cursor.execute(sql)
+        stats = connection.stmtcachestats(top=1)
+        self.assertEqual(stats["prepares"] - initialStats["prepares"], 5)
+        self.assertEqual(stats["cache_hits"] - initialStats["cache_hits"], 1)
+        self.assertEqual(stats["cache_misses"] - initialStats["cache_misses"],
+                4)
+        self.assertTrue(stats["prepare_time"] >= 0)
+        self.assertEqual(len(stats["statements"]), 1)
+        statement, tag, prepares, misses, prepareTime = stats["statements"][0]
+        self.assertEqual(statement, "select 2 from dual")
+        self.assertEqual(tag, None)
+        self.assertEqual((prepares, misses), (2, 2))
+        self.assertRaises(TypeError, connection.stmtcachestats, "1")
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
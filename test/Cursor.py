@@ -11,9 +11,13 @@
 
 import TestEnv
 
+import asyncio
 import cx_Oracle
 import decimal
+import io
+import json
 import sys
+import tempfile
 
 class TestCase(TestEnv.BaseTestCase):
 
@@ -295,6 +299,89 @@ class TestCase(TestEnv.BaseTestCase):
         expectedData = [1, 3, 6, 10, 15, 21, 28, 36, 45]
         self.assertEqual(var.values, expectedData)
 
+    def testExecuteManyColumnarByPosition(self):
+        "test executing a statement multiple times (columnar positional)"
+        self.cursor.execute("truncate table TestTempTable")
+        intValues = list(range(1, 251))
+        stringValues = [None if n % 10 == 0 else "S%d" % n + "X" * (n % 7)
+                for n in intValues]
+        sql = "insert into TestTempTable (IntCol, StringCol) values (:1, :2)"
+        self.cursor.executemany(sql, [intValues, tuple(stringValues)],
+                columnar=True)
+        self.assertEqual(self.cursor.rowcount, len(intValues))
+        self.cursor.execute("""
+                select IntCol, StringCol
+                from TestTempTable
+                order by IntCol""")
+        self.assertEqual(self.cursor.fetchall(),
+                list(zip(intValues, stringValues)))
+
+    def testExecuteManyColumnarByName(self):
+        "test executing a statement multiple times (columnar named)"
+        self.cursor.execute("truncate table TestTempTable")
+        data = dict(intVal=[1, 2, 3], numVal=[None, 2.5, 3])
+        sql = "insert into TestTempTable (IntCol, NumberCol) " \
+                "values (:intVal, :numVal)"
+        self.cursor.executemany(sql, data, columnar=True)
+        self.cursor.executemany(sql, dict(intVal=[4, 5], numVal=[4.5, None]),
+                columnar=True)
+        self.cursor.execute("""
+                select IntCol, NumberCol
+                from TestTempTable
+                order by IntCol""")
+        self.assertEqual(self.cursor.fetchall(),
+                [(1, None), (2, 2.5), (3, 3), (4, 4.5), (5, None)])
+
+    def testExecuteManyColumnarInvalid(self):
+        "test executemany() with invalid columnar parameters"
+        sql = "insert into TestTempTable (IntCol, StringCol) values (:1, :2)"
+        self.assertRaises(cx_Oracle.ProgrammingError, self.cursor.executemany,
+                sql, [[1, 2, 3], ["One", "Two"]], columnar=True)
+        self.assertRaises(TypeError, self.cursor.executemany, sql,
+                "These are not valid parameters", columnar=True)
+        self.assertRaises(TypeError, self.cursor.executemany, sql,
+                [[1, 2], 5], columnar=True)
+
+    def testExecuteManyInBatches(self):
+        "test executing a statement multiple times (from an iterator)"
+        self.cursor.execute("truncate table TestTempTable")
+        numRows = 1234
+        rows = ((n, "String %d" % n if n % 3 else None)
+                for n in range(numRows))
+        sql = "insert into TestTempTable (IntCol, StringCol) values (:1, :2)"
+        self.cursor.executemany(sql, rows, batchsize=100)
+        self.assertEqual(self.cursor.rowcount, numRows)
+        self.cursor.execute("""
+                select count(*), count(StringCol), max(StringCol)
+                from TestTempTable""")
+        self.assertEqual(self.cursor.fetchone(),
+                (numRows, 822, "String 998"))
+
+    def testExecuteManyInBatchesThreaded(self):
+        "test executing a statement in batches on a threaded connection"
+        connection = TestEnv.GetConnection(threaded=True)
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestTempTable")
+        rows = iter([{"value": n} for n in range(1, 26)])
+        sql = "insert into TestTempTable (IntCol) values (:value)"
+        cursor.executemany(sql, rows, batchsize=7)
+        self.assertEqual(cursor.rowcount, 25)
+        cursor.execute("select sum(IntCol) from TestTempTable")
+        self.assertEqual(cursor.fetchone(), (325,))
+
+    def testExecuteManyInBatchesWithException(self):
+        "test executing a statement in batches (with exception)"
+        self.cursor.execute("truncate table TestTempTable")
+        rows = ([n] for n in (1, 2, 3, 4, 5, 6, 7, 5, 9, 10))
+        sql = "insert into TestTempTable (IntCol) values (:1)"
+        self.assertRaises(cx_Oracle.DatabaseError, self.cursor.executemany,
+                sql, rows, batchsize=3)
+        self.assertEqual(self.cursor.rowcount, 7)
+        self.assertRaises(cx_Oracle.ProgrammingError, self.cursor.executemany,
+                sql, [[1]], batchsize=3, batcherrors=True)
+        self.assertRaises(TypeError, self.cursor.executemany, sql, 5,
+                batchsize=3)
+
     def testPrepare(self):
         """test preparing a statement and executing it multiple times"""
         self.assertEqual(self.cursor.statement, None)
@@ -750,5 +837,366 @@ class TestCase(TestEnv.BaseTestCase):
                 where rowid = :1""", [rowid])
         self.assertEqual("Row %s" % rows[-3], self.cursor.fetchone()[0])
 
+    def testFetchColumns(self):
+        """test fetching rows as columns"""
+        self.cursor.execute("truncate table TestTempTable")
+        rows = [(1, "First", 1.25), (2, None, None), (3, "Third", 7)]
+        self.cursor.executemany("""
+                insert into TestTempTable (IntCol, StringCol, NumberCol)
+                values (:1, :2, :3)""", rows)
+        self.connection.commit()
+        self.cursor.execute("""
+                select IntCol, StringCol, NumberCol
+                from TestTempTable
+                order by IntCol""")
+        intCol, stringCol, numberCol = self.cursor.fetchcolumns()
+        self.assertEqual(intCol.name, "INTCOL")
+        self.assertEqual(intCol.format, "q")
+        self.assertEqual(intCol.data.tolist(), [1, 2, 3])
+        self.assertEqual(intCol.validity, None)
+        self.assertEqual(stringCol.length, 3)
+        self.assertEqual(stringCol.nullcount, 1)
+        self.assertEqual(stringCol.offsets.tolist(), [0, 5, 5, 10])
+        self.assertEqual(bytes(stringCol.data), b"FirstThird")
+        self.assertEqual(stringCol.validity.tolist(), [5])
+        self.assertEqual(numberCol.format, "d")
+        self.assertEqual(numberCol.data.tolist(), [1.25, 0.0, 7.0])
+        self.assertEqual(self.cursor.rowcount, 3)
+        self.assertEqual(self.cursor.fetchall(), [])
+
+    def testFetchColumnsWithLimit(self):
+        """test fetching rows as columns with a row limit"""
+        self.cursor.arraysize = 4
+        self.cursor.execute("""
+                select IntCol
+                from TestNumbers
+                order by IntCol""")
+        column, = self.cursor.fetchcolumns(6)
+        self.assertEqual(column.data.tolist(), [1, 2, 3, 4, 5, 6])
+        self.assertEqual(self.cursor.fetchone(), (7,))
+        column, = self.cursor.fetchcolumns()
+        self.assertEqual(column.data.tolist(), [8, 9, 10])
+
+    def testExport(self):
+        """test exporting rows to a file in CSV and JSON lines format"""
+        self.cursor.execute("truncate table TestTempTable")
+        rows = [(1, 'Comma, "quoted"', 1.25), (2, None, None), (3, "Third", 7)]
+        self.cursor.executemany("""
+                insert into TestTempTable (IntCol, StringCol, NumberCol)
+                values (:1, :2, :3)""", rows)
+        self.connection.commit()
+        sql = """
+                select IntCol, StringCol, NumberCol
+                from TestTempTable
+                order by IntCol"""
+        self.cursor.execute(sql)
+        output = io.BytesIO()
+        self.assertEqual(self.cursor.export(output), 3)
+        self.assertEqual(output.getvalue(),
+                b'INTCOL,STRINGCOL,NUMBERCOL\n'
+                b'1,"Comma, ""quoted""",1.25\n'
+                b'2,,\n'
+                b'3,Third,7\n')
+        self.assertEqual(self.cursor.rowcount, 3)
+        self.cursor.execute(sql)
+        output = io.BytesIO()
+        self.assertEqual(self.cursor.export(output, format="jsonl",
+                numRows=2), 2)
+        lines = output.getvalue().decode().splitlines()
+        self.assertEqual([json.loads(l) for l in lines],
+                [dict(INTCOL=1, STRINGCOL='Comma, "quoted"', NUMBERCOL=1.25),
+                 dict(INTCOL=2, STRINGCOL=None, NUMBERCOL=None)])
+        with tempfile.TemporaryFile() as f:
+            self.assertEqual(self.cursor.export(f.fileno(), header=False,
+                    delimiter="|"), 1)
+            f.seek(0)
+            self.assertEqual(f.read(), b"3|Third|7\n")
+        sql = """
+                select
+                    cast(1.5 as binary_double) DoubleCol,
+                    binary_double_nan NanCol,
+                    binary_double_infinity InfCol,
+                    -binary_double_infinity NegInfCol
+                from dual"""
+        self.cursor.execute(sql)
+        output = io.BytesIO()
+        self.assertEqual(self.cursor.export(output, header=False), 1)
+        self.assertEqual(output.getvalue(), b"1.5,nan,inf,-inf\n")
+        self.cursor.execute(sql)
+        output = io.BytesIO()
+        self.assertEqual(self.cursor.export(output, format="jsonl"), 1)
+        self.assertEqual(output.getvalue(),
+                b'{"DOUBLECOL":1.5,"NANCOL":null,"INFCOL":null,'
+                b'"NEGINFCOL":null}\n')
+        self.cursor.execute(sql)
+        self.assertRaises(cx_Oracle.ProgrammingError, self.cursor.export,
+                output, format="xml")
+        self.assertRaises(TypeError, self.cursor.export, None)
+
+    def testLoad(self):
+        """test loading rows from delimited text"""
+        self.cursor.execute("truncate table TestTempTable")
+        sql = """
+                insert into TestTempTable (IntCol, StringCol, NumberCol)
+                values (:1, :2, :3)"""
+        data = b'INTCOL,STRINGCOL,NUMBERCOL\n' \
+               b'1,"Comma, ""quoted""",1.25\r\n' \
+               b'2,,\n' \
+               b'\n' \
+               b'3,"Multi\nline",7'
+        self.assertEqual(self.cursor.load(sql, data, [int, str, float],
+                batchsize=2, header=True), 3)
+        self.assertEqual(self.cursor.rowcount, 3)
+        self.cursor.execute("""
+                select IntCol, StringCol, NumberCol
+                from TestTempTable
+                order by IntCol""")
+        self.assertEqual(self.cursor.fetchall(),
+                [(1, 'Comma, "quoted"', 1.25), (2, None, None),
+                 (3, "Multi\nline", 7)])
+        self.assertEqual(self.cursor.load(sql, io.BytesIO(b"4|Four|\n"),
+                delimiter="|"), 1)
+        self.cursor.execute("truncate table TestTempTable")
+        data = "5,Five,\n5,Duplicate,\n6,Six,\n6,Duplicate,\n"
+        self.assertEqual(self.cursor.load(sql, data, batchsize=3,
+                batcherrors=True, arraydmlrowcounts=True), 4)
+        self.assertEqual([e.offset for e in self.cursor.getbatcherrors()],
+                [1, 3])
+        self.assertEqual(self.cursor.getarraydmlrowcounts(), [1, 0, 1, 0])
+        self.cursor.load("""
+                update TestTempTable set
+                    StringCol = :1
+                where IntCol = 0""", 'A\n\n""\r\n\r\nB',
+                arraydmlrowcounts=True)
+        self.assertEqual(self.cursor.getarraydmlrowcounts(), [0, 0, 0])
+        self.assertRaises(cx_Oracle.DataError, self.cursor.load, sql,
+                "7,Seven\n", [int, str, int])
+        self.assertRaises(cx_Oracle.DataError, self.cursor.load, sql,
+                '8,"Unterminated,\n', [int, str, int])
+        self.assertRaises(cx_Oracle.NotSupportedError, self.cursor.load,
+                sql, "1,2,3\n", [int, cx_Oracle.DB_TYPE_CLOB, int])
+
+    def testVarPool(self):
+        """test variables are used again by different statements"""
+        self.assertEqual(self.cursor.varpoolsize, 0)
+        self.cursor.varpoolsize = 4
+        self.cursor.execute("select IntCol from TestNumbers order by IntCol")
+        self.assertEqual(self.cursor.fetchone(), (1,))
+        varId = id(self.cursor.fetchvars[0])
+        self.cursor.execute("""
+                select IntCol
+                from TestNumbers
+                where IntCol > 5
+                order by IntCol""")
+        self.assertEqual(id(self.cursor.fetchvars[0]), varId)
+        self.assertEqual([n for n, in self.cursor], list(range(6, 11)))
+        var = self.cursor.fetchvars[0]
+        self.cursor.execute("select IntCol from TestNumbers order by IntCol")
+        self.assertIsNot(self.cursor.fetchvars[0], var)
+        self.assertEqual(var.getvalue(0), 6)
+        self.cursor.execute("""
+                select IntCol
+                from TestNumbers
+                where IntCol = :value""", value=3)
+        self.assertEqual(self.cursor.fetchall(), [(3,)])
+        self.cursor.execute("select :1 * 2 from dual", [5])
+        self.assertEqual(self.cursor.fetchall(), [(10,)])
+        self.cursor.tzaware = True
+        self.cursor.execute("""
+                select IntCol, systimestamp
+                from TestNumbers
+                order by IntCol""")
+        self.assertIsNotNone(self.cursor.fetchone()[1].tzinfo)
+        varId = id(self.cursor.fetchvars[0])
+        self.cursor.tzaware = False
+        self.cursor.execute("""
+                select IntCol, systimestamp
+                from TestNumbers
+                where IntCol > 5
+                order by IntCol""")
+        self.assertEqual(id(self.cursor.fetchvars[0]), varId)
+        self.assertIsNone(self.cursor.fetchone()[1].tzinfo)
+
+    def testChangeOutConverterAfterDefine(self):
+        """test changing the output converter of a fetch variable"""
+        self.cursor.arraysize = 2
+        self.cursor.execute("""
+                select IntCol
+                from TestNumbers
+                order by IntCol""")
+        self.assertEqual(self.cursor.fetchone(), (1,))
+        var, = self.cursor.fetchvars
+        self.assertEqual(var.outconverter, None)
+        var.outconverter = lambda value: value * 10
+        self.assertEqual(self.cursor.fetchone(), (20,))
+        var.outconverter = None
+        self.assertEqual(self.cursor.fetchone(), (3,))
+
+    def testBackgroundFetch(self):
+        """test fetching rows in the background"""
+        connection = TestEnv.GetConnection(threaded=True)
+        cursor = connection.cursor()
+        self.assertEqual(cursor.backgroundfetch, False)
+        cursor.backgroundfetch = True
+        cursor.arraysize = 3
+        sql = "select IntCol, StringCol from TestStrings order by IntCol"
+        cursor.execute(sql)
+        self.assertEqual(cursor.fetchone(), (1, "String 1"))
+        self.assertEqual(cursor.fetchmany(4),
+                [(i, "String %d" % i) for i in range(2, 6)])
+        self.assertEqual(cursor.fetchall(),
+                [(i, "String %d" % i) for i in range(6, 11)])
+        cursor.execute(sql)
+        self.assertEqual(cursor.fetchone(), (1, "String 1"))
+        cursor.execute(sql)
+        self.assertEqual([r for r, s in cursor], list(range(1, 11)))
+        cursor.execute(sql)
+        column, strings = cursor.fetchcolumns()
+        self.assertEqual(column.data.tolist(), list(range(1, 11)))
+
+    def testBackgroundFetchVariables(self):
+        """test fetch variables do not change during background fetching"""
+        connection = TestEnv.GetConnection(threaded=True)
+        cursor = connection.cursor()
+        cursor.backgroundfetch = True
+        cursor.arraysize = 2
+        cursor.execute("select IntCol from TestNumbers order by IntCol")
+        intVar, = cursor.fetchvars
+        intVar.outconverter = lambda v: v * 10
+        self.assertEqual(cursor.fetchone(), (10,))
+        self.assertEqual(cursor.fetchmany(3), [(20,), (30,), (40,)])
+        self.assertIs(cursor.fetchvars[0], intVar)
+        self.assertEqual(cursor.description[0][0], "INTCOL")
+        self.assertEqual(cursor.fetchall(),
+                [(i * 10,) for i in range(5, 11)])
+        self.assertIs(cursor.fetchvars[0], intVar)
+        self.assertRaises(cx_Oracle.InterfaceError, cursor.fetchraw)
+
+    def testBackgroundFetchNotThreaded(self):
+        """test background fetching requires a threaded connection"""
+        self.assertRaises(cx_Oracle.ProgrammingError, setattr, self.cursor,
+                "backgroundfetch", True)
+        self.cursor.backgroundfetch = False
+        self.assertEqual(self.cursor.backgroundfetch, False)
+
+    def testAutoArraySize(self):
+        """test determining the array size automatically"""
+        self.cursor.arraysize = "auto"
+        self.cursor.fetchbytes = 4096
+        self.cursor.execute("""
+                select level, rpad('X', 50, 'X')
+                from dual
+                connect by level <= 5000""")
+        self.assertTrue(0 < self.cursor.arraysize < 100)
+        rows = self.cursor.fetchall()
+        self.assertEqual([r[0] for r in rows], list(range(1, 5001)))
+        self.assertEqual(self.cursor.rowcount, 5000)
+        self.cursor.arraysize = 25
+        self.assertEqual(self.cursor.arraysize, 25)
+        self.assertRaises(ValueError, setattr, self.cursor, "arraysize",
+                "automatic")
+
+    def testStatementStats(self):
+        """test gathering statement statistics"""
+        self.assertEqual(self.connection.collectstats, False)
+        cursor = self.connection.cursor()
+        self.assertEqual(cursor.collectstats, False)
+        cursor.execute("select 1 from dual")
+        cursor.fetchall()
+        self.assertEqual(cursor.stats(), (0, 0, 0, 0, 0, 0, 0, 0, 0))
+        phases = []
+        cursor.collectstats = True
+        cursor.statshandler = lambda c, phase, elapsed: phases.append(phase)
+        cursor.arraysize = 4
+        cursor.execute("select level from dual connect by level <= :n", n=10)
+        self.assertEqual(len(cursor.fetchall()), 10)
+        stats = cursor.stats()
+        self.assertIsInstance(stats, cx_Oracle.StatementStats)
+        self.assertEqual(stats.prepares, 1)
+        self.assertEqual(stats.executes, 1)
+        self.assertEqual(stats.rows_fetched, 10)
+        self.assertTrue(stats.fetch_calls >= 3)
+        self.assertTrue(stats.fetch_time > 0)
+        self.assertEqual(phases[:3], ["prepare", "bind", "execute"])
+        self.assertEqual(phases[3:], ["fetch"] * stats.fetch_calls)
+        connStats = self.connection.stats()
+        self.assertTrue(connStats.executes >= stats.executes)
+        self.assertTrue(connStats.rows_fetched >= stats.rows_fetched)
+
+    def testAsyncExecuteAndFetch(self):
+        """test executing, fetching and committing asynchronously"""
+        connection = TestEnv.GetConnection(threaded=True)
+        cursor = connection.cursor()
+        cursor.execute("truncate table TestTempTable")
+        cursor.arraysize = 7
+        async def Run():
+            result = await cursor.executeasync("""
+                    insert into TestTempTable (IntCol, StringCol)
+                    values (:1, :2)""", (1, "Async"))
+            self.assertEqual(result, None)
+            self.assertEqual(cursor.rowcount, 1)
+            await connection.commitasync()
+            future = cursor.executeasync("""
+                    select level from dual connect by level <= :n""", n=20)
+            self.assertRaisesRegex(cx_Oracle.InterfaceError, "^connection is",
+                    cursor.fetchmanyasync)
+            self.assertIs(await future, cursor)
+            rows = await cursor.fetchmanyasync(15)
+            self.assertEqual([r for r, in rows], list(range(1, 16)))
+            rows = await cursor.fetchmanyasync(0)
+            self.assertEqual([r for r, in rows], list(range(16, 21)))
+            rows = await cursor.fetchmanyasync()
+            self.assertEqual(rows, [])
+            with self.assertRaises(cx_Oracle.DatabaseError):
+                await cursor.executeasync("select 1 / 0 from dual")
+        asyncio.get_event_loop().run_until_complete(Run())
+        otherConnection = TestEnv.GetConnection()
+        otherCursor = otherConnection.cursor()
+        otherCursor.execute("select IntCol, StringCol from TestTempTable")
+        self.assertEqual(otherCursor.fetchall(), [(1, "Async")])
+
+    def testAsyncRequiresThreaded(self):
+        """test asynchronous operations require threaded mode"""
+        self.assertRaisesRegex(cx_Oracle.ProgrammingError, "threaded mode",
+                self.cursor.executeasync, "select 1 from dual")
+        self.assertRaisesRegex(cx_Oracle.ProgrammingError, "threaded mode",
+                self.connection.commitasync)
+
+    def testAsyncRequiresRunningLoop(self):
+        """test asynchronous operations require a running event loop"""
+        connection = TestEnv.GetConnection(threaded=True)
+        cursor = connection.cursor()
+        self.assertRaises(RuntimeError, cursor.executeasync,
+                "select 1 from dual")
+        self.assertRaises(RuntimeError, connection.commitasync)
+        cursor.execute("select 1 from dual")
+        self.assertEqual(cursor.fetchall(), [(1,)])
+
+    def testRowMode(self):
+        """test fetching rows as dictionaries and named tuples"""
+        cursor = self.connection.cursor()
+        self.assertEqual(cursor.rowmode, "tuple")
+        sql = "select IntCol, StringCol, 5 from TestStrings where IntCol <= 2"
+        cursor.rowmode = "dict"
+        cursor.execute(sql + " order by IntCol")
+        self.assertEqual(cursor.fetchall(),
+                [{"INTCOL": 1, "STRINGCOL": "String 1", "5": 5},
+                 {"INTCOL": 2, "STRINGCOL": "String 2", "5": 5}])
+        cursor.rowmode = "namedtuple"
+        cursor.execute(sql + " order by IntCol")
+        row = cursor.fetchone()
+        self.assertEqual(row, (1, "String 1", 5))
+        self.assertEqual((row.INTCOL, row.STRINGCOL, row._2),
+                (1, "String 1", 5))
+        cursor.execute("select IntCol from TestStrings where IntCol = 3")
+        self.assertEqual(cursor.fetchone().INTCOL, 3)
+        cursor.execute(sql + " order by IntCol")
+        cursor.rowmode = "dict"
+        self.assertEqual(cursor.fetchone()["INTCOL"], 1)
+        cursor.rowmode = None
+        self.assertEqual(cursor.fetchone(), (2, "String 2", 5))
+        self.assertRaises(cx_Oracle.ProgrammingError, setattr, cursor,
+                "rowmode", "structseq")
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
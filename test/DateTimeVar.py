@@ -246,6 +246,48 @@ class TestCase(TestEnv.BaseTestCase):
         self.assertEqual(self.cursor.fetchone(), self.dataByKey[4])
         self.assertEqual(self.cursor.fetchone(), None)
 
+    def testDateCache(self):
+        "test fetching dates using a date cache"
+        self.cursor.datecachesize = 3
+        self.cursor.execute("""
+                select trunc(DateCol, 'MM')
+                from TestDates
+                order by IntCol""")
+        self.assertEqual(self.cursor.fetchvars[0].datecachesize, 4)
+        values = [v for v, in self.cursor]
+        self.assertEqual(values, [datetime.datetime(d.year, d.month, 1) \
+                for i, d, n in self.rawData])
+        self.assertTrue(values[0] is values[1])
+        self.cursor.datecachesize = 0
+        self.cursor.execute("select IntCol from TestDates")
+        self.assertEqual(self.cursor.fetchvars[0].datecachesize, 0)
+
+    def testTimestampTZAware(self):
+        "test fetching timestamps with time zones as aware datetimes"
+        sql = """
+                select
+                    to_timestamp_tz('2020-03-01 10:30:00 -05:30',
+                            'YYYY-MM-DD HH24:MI:SS TZH:TZM'),
+                    to_timestamp_tz('2020-03-01 10:30:00 +02:00',
+                            'YYYY-MM-DD HH24:MI:SS TZH:TZM')
+                from dual"""
+        self.cursor.execute(sql)
+        self.assertEqual(self.cursor.fetchone()[0].tzinfo, None)
+        self.cursor.tzaware = True
+        self.cursor.execute(sql)
+        value1, value2 = self.cursor.fetchone()
+        offset = datetime.timedelta(hours=-5, minutes=-30)
+        self.assertEqual(value1, datetime.datetime(2020, 3, 1, 10, 30,
+                tzinfo=datetime.timezone(offset)))
+        self.assertEqual(value2.utcoffset(), datetime.timedelta(hours=2))
+        self.cursor.execute(sql)
+        column1, column2 = self.cursor.fetchcolumns()
+        epoch = datetime.datetime(1970, 1, 1, tzinfo=datetime.timezone.utc)
+        self.assertEqual(column1.data[0],
+                (value1 - epoch) // datetime.timedelta(microseconds=1))
+        self.assertEqual(column2.data[0],
+                (value2 - epoch) // datetime.timedelta(microseconds=1))
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
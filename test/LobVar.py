@@ -98,6 +98,47 @@ class TestCase(TestEnv.BaseTestCase):
         lob.trim()
         self.assertEqual(lob.size(), 0)
 
+    def __TestLobStream(self, lobType):
+        self.cursor.execute("truncate table Test%ss" % lobType)
+        longString = "".join(chr(ord("A") + i % 26) * 1000 for i in range(75))
+        if lobType == "BLOB":
+            longString = longString.encode("ascii")
+        self.cursor.setinputsizes(longString = getattr(cx_Oracle, lobType))
+        self.cursor.execute("""
+                insert into Test%ss (IntCol, %sCol)
+                values (1, :longString)""" % (lobType, lobType),
+                longString = longString)
+        self.cursor.execute("select %sCol from Test%ss" % (lobType, lobType))
+        lob, = self.cursor.fetchone()
+        chunkSize = lob.getchunksize()
+        with lob.openstream() as stream:
+            self.assertEqual(stream.chunksize % chunkSize, 0)
+            chunks = list(stream)
+            self.assertEqual(stream.tell(), len(longString))
+        self.assertEqual(stream.closed, True)
+        self.assertTrue(all(len(c) <= stream.chunksize for c in chunks))
+        self.assertEqual(chunks[0][:0].join(chunks), longString)
+        stream = lob.openstream(chunksize = 1)
+        self.assertEqual(stream.chunksize, chunkSize)
+        self.assertEqual(stream.read(10), longString[:10])
+        self.assertEqual(stream.read(), longString[10:])
+        self.assertEqual(stream.read(), longString[:0])
+        stream = lob.openstream()
+        buffer = bytearray(10000)
+        data = bytearray()
+        while True:
+            numBytes = stream.readinto(buffer)
+            if numBytes == 0:
+                break
+            data.extend(buffer[:numBytes])
+        if lobType == "BLOB":
+            self.assertEqual(bytes(data), longString)
+        else:
+            self.assertEqual(data.decode(self.connection.encoding),
+                    longString)
+        stream.close()
+        self.assertRaises(ValueError, stream.read)
+
     def __TestTemporaryLOB(self, lobType):
         self.cursor.execute("truncate table Test%ss" % lobType)
         value = "A test string value"
@@ -164,6 +205,10 @@ class TestCase(TestEnv.BaseTestCase):
                   ('BLOBCOL', cx_Oracle.DB_TYPE_BLOB, None, None, None, None,
                         0) ])
 
+    def testBLOBStream(self):
+        "test streaming BLOBs"
+        self.__TestLobStream("BLOB")
+
     def testBLOBsDirect(self):
         "test binding and fetching BLOB data (directly)"
         self.__PerformTest("BLOB", cx_Oracle.DB_TYPE_BLOB)
@@ -184,6 +229,10 @@ class TestCase(TestEnv.BaseTestCase):
                   ('CLOBCOL', cx_Oracle.DB_TYPE_CLOB, None, None, None, None,
                         0) ])
 
+    def testCLOBStream(self):
+        "test streaming CLOBs"
+        self.__TestLobStream("CLOB")
+
     def testCLOBsDirect(self):
         "test binding and fetching CLOB data (directly)"
         self.__PerformTest("CLOB", cx_Oracle.DB_TYPE_CLOB)
@@ -279,6 +328,39 @@ class TestCase(TestEnv.BaseTestCase):
         nclobVar = self.cursor.var(cx_Oracle.DB_TYPE_NCLOB)
         self.assertRaises(IndexError, nclobVar.setvalue, 1, "test char")
 
+    def testFetchLobsAsValues(self):
+        "test fetching LOB columns directly as strings and bytes"
+        self.assertEqual(self.connection.fetchlobs, True)
+        self.assertEqual(self.cursor.fetchlobs, True)
+        self.cursor.execute("truncate table TestCLOBs")
+        self.cursor.execute("truncate table TestBLOBs")
+        longString = "X" * 50000
+        self.cursor.setinputsizes(None, cx_Oracle.DB_TYPE_CLOB)
+        self.cursor.executemany("insert into TestCLOBs values (:1, :2)",
+                [(1, "Small"), (2, longString), (3, None)])
+        self.cursor.setinputsizes(None, cx_Oracle.DB_TYPE_BLOB)
+        self.cursor.execute("insert into TestBLOBs values (:1, :2)",
+                (1, b"Bytes"))
+        self.connection.commit()
+        self.cursor.fetchlobs = False
+        self.cursor.execute("select * from TestCLOBs order by IntCol")
+        self.assertEqual(self.cursor.fetchall(),
+                [(1, "Small"), (2, longString), (3, None)])
+        self.assertEqual(self.cursor.description[1][1],
+                cx_Oracle.DB_TYPE_CLOB)
+        self.cursor.execute("select * from TestBLOBs")
+        self.assertEqual(self.cursor.fetchall(), [(1, b"Bytes")])
+        self.connection.fetchlobs = False
+        cursor = self.connection.cursor()
+        self.connection.fetchlobs = True
+        self.assertEqual(cursor.fetchlobs, False)
+        cursor.execute("select ClobCol from TestCLOBs where IntCol = 1")
+        self.assertEqual(cursor.fetchone(), ("Small",))
+        self.cursor.fetchlobs = True
+        self.cursor.execute("select ClobCol from TestCLOBs where IntCol = 1")
+        lob, = self.cursor.fetchone()
+        self.assertEqual(lob.read(), "Small")
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
@@ -406,5 +406,25 @@ class TestCase(TestEnv.BaseTestCase):
             fetchedValue, = self.cursor.fetchone()
             self.assertEqual(value, fetchedValue)
 
+    def testFetchIntegerBoundaries(self):
+        "test fetching integers at and beyond the range of 64-bit integers"
+        for value in (0, -1, 2 ** 63 - 1, 2 ** 63, -2 ** 63, -2 ** 63 - 1,
+                10 ** 38 - 1, -10 ** 38 + 1):
+            self.cursor.execute("select to_number(:1) from dual",
+                    [str(value)])
+            fetchedValue, = self.cursor.fetchone()
+            self.assertTrue(isinstance(fetchedValue, int),
+                    "integer not returned")
+            self.assertEqual(fetchedValue, value)
+
+    def testFetchFloatMatchesString(self):
+        "test fetching floats gives the same value as parsing the string"
+        for value in ("0.1", "-1.25", "123456789.123456789", "1e-130",
+                "9.99999999999999999999999999999999999999e125"):
+            self.cursor.execute("select to_number(:1), to_char(to_number(:1)) "
+                    "from dual", [value])
+            fetchedValue, stringValue = self.cursor.fetchone()
+            self.assertEqual(fetchedValue, float(stringValue))
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
@@ -14,6 +14,7 @@ import TestEnv
 import cx_Oracle
 import datetime
 import decimal
+import weakref
 
 class TestCase(TestEnv.BaseTestCase):
 
@@ -369,6 +370,77 @@ class TestCase(TestEnv.BaseTestCase):
         arrayObj.trim(1)
         self.assertEqual(self.__GetObjectAsTuple(arrayObj), [])
 
+    def testObjectTypeCache(self):
+        "test object types are cached by the connection"
+        typeObj = self.connection.gettype("UDT_OBJECT")
+        self.assertIs(self.connection.gettype("UDT_OBJECT"), typeObj)
+        subObjectArrayType = self.connection.gettype("UDT_OBJECTARRAY")
+        self.assertIs(subObjectArrayType.element_type,
+                self.connection.gettype("UDT_SUBOBJECT"))
+        sql = """
+                select ObjectCol
+                from TestObjects
+                where ObjectCol is not null
+                  and rownum <= 1"""
+        for i in range(2):
+            self.cursor.execute(sql)
+            objValue, = self.cursor.fetchone()
+            self.assertIs(objValue.type, typeObj)
+        self.assertIs(typeObj.attributes[-1].type, subObjectArrayType)
+
+    def testObjectTypeCacheAcrossStatements(self):
+        "test object types are not built again by a different statement"
+        self.cursor.execute("""
+                select ObjectCol
+                from TestObjects
+                where ObjectCol is not null
+                order by IntCol""")
+        objValue, = self.cursor.fetchone()
+        typeRef = weakref.ref(objValue.type)
+        del objValue
+        self.cursor.execute("""
+                select ObjectCol
+                from TestObjects
+                where ObjectCol is not null
+                order by IntCol desc""")
+        objValue, = self.cursor.fetchone()
+        self.assertIsNotNone(typeRef())
+        self.assertIs(objValue.type, typeRef())
+        del objValue
+        self.assertIs(self.connection.gettype("UDT_OBJECT"), typeRef())
+
+    def testDeepConversion(self):
+        "test converting nested objects to lists and dictionaries"
+        subObjType = self.connection.gettype("UDT_SUBOBJECT")
+        arrayType = self.connection.gettype("UDT_OBJECTARRAY")
+        data = [(1, "AB"), (2, "CDE"), (3, None)]
+        arrayObj = arrayType()
+        for numVal, strVal in data:
+            subObj = subObjType()
+            subObj.SUBNUMBERVALUE = numVal
+            subObj.SUBSTRINGVALUE = strVal
+            arrayObj.append(subObj)
+        expectedValue = [dict(SUBNUMBERVALUE=n, SUBSTRINGVALUE=s)
+                for n, s in data]
+        self.assertEqual(arrayObj.aslist(deep=True), expectedValue)
+        self.assertEqual(arrayObj.asdict(deep=True),
+                dict(enumerate(expectedValue)))
+        self.assertTrue(all(isinstance(v, cx_Oracle.Object)
+                for v in arrayObj.aslist()))
+        self.assertEqual(subObj.asdict(),
+                dict(SUBNUMBERVALUE=3, SUBSTRINGVALUE=None))
+        objType = self.connection.gettype("UDT_OBJECT")
+        obj = objType()
+        obj.NUMBERVALUE = 5
+        obj.SUBOBJECTVALUE = subObj
+        obj.SUBOBJECTARRAY = arrayObj
+        result = obj.asdict(deep=True)
+        self.assertEqual(result["NUMBERVALUE"], 5)
+        self.assertEqual(result["SUBOBJECTVALUE"], expectedValue[-1])
+        self.assertEqual(result["SUBOBJECTARRAY"], expectedValue)
+        self.assertIsInstance(obj.asdict()["SUBOBJECTVALUE"],
+                cx_Oracle.Object)
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
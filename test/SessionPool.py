@@ -11,6 +11,7 @@
 
 import TestEnv
 
+import asyncio
 import cx_Oracle
 import threading
 
@@ -306,6 +307,145 @@ class TestCase(TestEnv.BaseTestCase):
             self.assertRaises(cx_Oracle.DatabaseError, pool.release, conn,
                     tag="INVALID_TAG")
 
+    def testAcquireConnectionType(self):
+        "test acquiring connections with and without a connection type"
+        callbackArgs = []
+        def SessionCallback(conn, requestedTag):
+            callbackArgs.append((type(conn), requestedTag))
+        class MyConnection(cx_Oracle.Connection):
+            def __init__(self, *args, **kwargs):
+                self.initialized = True
+                super(MyConnection, self).__init__(*args, **kwargs)
+        pool = TestEnv.GetPool(min=1, max=2, increment=1,
+                getmode=cx_Oracle.SPOOL_ATTRVAL_NOWAIT,
+                sessionCallback=SessionCallback)
+        conn = pool.acquire(cclass="TEST_CCLASS", tag="TIME_ZONE=UTC")
+        self.assertEqual(type(conn), cx_Oracle.Connection)
+        self.assertEqual(conn.encoding, pool.encoding)
+        self.__VerifyConnection(conn, TestEnv.GetMainUser())
+        self.assertEqual(callbackArgs,
+                [(cx_Oracle.Connection, "TIME_ZONE=UTC")])
+        conn.close()
+        pool = TestEnv.GetPool(min=1, max=2, increment=1,
+                connectiontype=MyConnection)
+        conn = pool.acquire()
+        self.assertEqual(type(conn), MyConnection)
+        self.assertEqual(conn.initialized, True)
+        self.__VerifyConnection(conn, TestEnv.GetMainUser())
+
+    def testStats(self):
+        "test the statistics gathered for the pool"
+        pool = TestEnv.GetPool(min=1, max=2, increment=1,
+                getmode=cx_Oracle.SPOOL_ATTRVAL_NOWAIT,
+                sessionCallback=lambda conn, tag: None)
+        stats = pool.stats()
+        self.assertEqual(stats["acquires"], 0)
+        self.assertEqual(sum(stats["acquire_waits"]), 0)
+        self.assertEqual(len(stats["acquire_waits"]),
+                len(stats["acquire_wait_bounds"]))
+        conn1 = pool.acquire()
+        conn2 = pool.acquire()
+        self.assertRaises(cx_Oracle.DatabaseError, pool.acquire)
+        stats = pool.stats()
+        self.assertEqual(stats["acquires"], 3)
+        self.assertEqual(stats["acquire_errors"], 1)
+        self.assertEqual(stats["timeouts"], 1)
+        self.assertEqual(stats["sessions_created"], 2)
+        self.assertEqual(stats["callbacks"], 2)
+        self.assertEqual(stats["busy"], 2)
+        self.assertEqual(sum(stats["acquire_waits"]), 3)
+        self.assertTrue(stats["acquire_time"] >= 0)
+        pool.drop(conn1)
+        pool.release(conn2)
+        conn = pool.acquire()
+        stats = pool.stats()
+        self.assertEqual(stats["acquires"], 4)
+        self.assertEqual(stats["sessions_created"], 2)
+        self.assertEqual(stats["sessions_dropped"], 1)
+        cursor = conn.cursor()
+        cursor.execute("select user from dual")
+        stats = pool.stats()
+        self.assertEqual(stats["statement_prepares"], 1)
+        self.assertEqual(stats["statement_cache_hits"], 0)
+        self.assertEqual(stats["statement_cache_misses"], 0)
+        self.assertTrue(stats["statement_prepare_time"] >= 0)
+        cursor = conn.cursor()
+        cursor.execute("select user from dual")
+        stats = pool.stats()
+        self.assertEqual(stats["statement_prepares"], 2)
+        self.assertEqual(stats["statement_cache_hits"], 1)
+        self.assertEqual(stats["statement_cache_misses"], 0)
+
+    def testAcquireAsync(self):
+        """test acquiring connections asynchronously"""
+        pool = TestEnv.GetPool(min=0, max=4, increment=1, threaded=True,
+                getmode=cx_Oracle.SPOOL_ATTRVAL_WAIT)
+        async def Run():
+            connections = await asyncio.gather(*[pool.acquireasync() \
+                    for i in range(4)])
+            self.assertEqual(pool.busy, 4)
+            for connection in connections:
+                self.assertIsInstance(connection, cx_Oracle.Connection)
+                cursor = connection.cursor()
+                await cursor.executeasync("select user from dual")
+                user, = await cursor.fetchmanyasync(1)
+                self.assertEqual(user, (TestEnv.GetMainUser().upper(),))
+            return connections
+        connections = asyncio.get_event_loop().run_until_complete(Run())
+        for connection in connections:
+            pool.release(connection)
+        self.assertEqual(pool.busy, 0)
+        self.assertEqual(pool.stats()["acquires"], 4)
+
+    def testAcquireAsyncWaitingForSessions(self):
+        """test waiting acquires do not block operations on other sessions"""
+        pool = TestEnv.GetPool(min=0, max=2, increment=1, threaded=True,
+                getmode=cx_Oracle.SPOOL_ATTRVAL_WAIT)
+        async def Work():
+            connection = await pool.acquireasync()
+            cursor = connection.cursor()
+            await cursor.executeasync("select user from dual")
+            user, = await cursor.fetchmanyasync(1)
+            await connection.commitasync()
+            pool.release(connection)
+            return user
+        async def Run():
+            return await asyncio.wait_for(asyncio.gather(*[Work() \
+                    for i in range(12)]), 60)
+        users = asyncio.get_event_loop().run_until_complete(Run())
+        self.assertEqual(users, [(TestEnv.GetMainUser().upper(),)] * 12)
+        self.assertEqual(pool.busy, 0)
+
+    def testParallelFetch(self):
+        """test fetching partitions of a query in parallel"""
+        pool = TestEnv.GetPool(min=0, max=4, increment=1, threaded=True,
+                getmode=cx_Oracle.SPOOL_ATTRVAL_WAIT)
+        sql = """
+                select IntCol
+                from TestNumbers
+                where IntCol between :1 and :2
+                order by IntCol"""
+        partitions = [(1, 3), (4, 6), (7, 9), (10, 12), (13, 15)]
+        results = {}
+        for partitionNum, batch in pool.parallelfetch(sql, partitions,
+                sessions=3, batchsize=2):
+            self.assertLessEqual(len(batch), 2)
+            results.setdefault(partitionNum, []).extend(v for v, in batch)
+        self.assertEqual(results, {0: [1, 2, 3], 1: [4, 5, 6], 2: [7, 8, 9],
+                3: [10]})
+        self.assertEqual(pool.busy, 0)
+        values = []
+        for partitionNum, columns in pool.parallelfetch(sql, [(1, 10)],
+                columnar=True):
+            column, = columns
+            values.extend(column.data.tolist())
+        self.assertEqual(values, list(range(1, 11)))
+        fetch = pool.parallelfetch("select 1 / 0 from dual", [None])
+        self.assertRaises(cx_Oracle.DatabaseError, list, fetch)
+        nonThreadedPool = TestEnv.GetPool(min=0, max=1, increment=1)
+        self.assertRaises(cx_Oracle.ProgrammingError,
+                nonThreadedPool.parallelfetch, sql, partitions)
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
@@ -294,6 +294,50 @@ class TestCase(TestEnv.BaseTestCase):
         self.assertEqual(coll.find().count(), 0)
         coll.drop()
 
+    def testFetchManyDocuments(self):
+        "test fetching documents and their contents in batches"
+        sodaDatabase = self.getSodaDatabase()
+        coll = sodaDatabase.createCollection("cxoFetchManyDocs")
+        coll.find().remove()
+        valuesToInsert = [{"name": "Name %d" % i, "num": i} for i in range(7)]
+        for value in valuesToInsert:
+            coll.insertOne(value)
+        self.connection.commit()
+        filterSpec = {'$orderby': [{'path': 'num', 'order': 'asc'}]}
+        cursor = coll.find().filter(filterSpec).getCursor()
+        docs = cursor.fetchMany(3)
+        self.assertEqual([d.getContent() for d in docs], valuesToInsert[:3])
+        self.assertEqual(cursor.fetchMany(3, contents=True),
+                valuesToInsert[3:6])
+        self.assertEqual(cursor.fetchMany(3, contents=True),
+                valuesToInsert[6:])
+        self.assertEqual(cursor.fetchMany(3), [])
+        self.assertEqual(coll.find().filter(filterSpec).getContents(),
+                valuesToInsert)
+        self.assertEqual(coll.find().filter(filterSpec).getContents(
+                batchSize=2), valuesToInsert)
+        docs = coll.find().filter(filterSpec).getDocuments()
+        self.assertEqual([d.getContent() for d in docs], valuesToInsert)
+        coll.drop()
+
+    def testInsertManyInBatches(self):
+        "test inserting documents from an iterable in batches"
+        sodaDatabase = self.getSodaDatabase(minclient=(18, 5))
+        coll = sodaDatabase.createCollection("cxoInsertManyBatches")
+        coll.find().remove()
+        coll.insertMany(({"num": i} for i in range(5)), batchSize=2)
+        self.assertEqual(coll.find().count(), 5)
+        docs = coll.insertManyAndGet(({"num": i} for i in range(5, 8)),
+                batchSize=2)
+        self.assertEqual(len(docs), 3)
+        self.assertEqual(coll.find().key(docs[2].key).getOne().getContent(),
+                {"num": 7})
+        coll.insertMany(iter([{"num": 8}, {"num": 9}]))
+        contents = coll.find().getContents()
+        self.assertEqual(sorted(c["num"] for c in contents), list(range(10)))
+        self.connection.commit()
+        coll.drop()
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
@@ -162,6 +162,19 @@ class TestCase(TestEnv.BaseTestCase):
                 value = "Raw 4".encode("ascii"))
         self.assertEqual(self.cursor.fetchall(), [self.dataByKey[4]])
 
+    def testBindRawFromBuffers(self):
+        "test binding in a raw from bytearray and memoryview objects"
+        for value in (bytearray(b"Raw 4"), memoryview(b"Raw 4"),
+                memoryview(b"...Raw 4...")[3:-3]):
+            self.cursor.execute("""
+                    select * from TestStrings
+                    where RawCol = :value""",
+                    value = value)
+            self.assertEqual(self.cursor.fetchall(), [self.dataByKey[4]])
+        self.assertRaises(TypeError, self.cursor.execute,
+                "select * from TestStrings where RawCol = :value",
+                value = memoryview(b"Raw 4 Raw 5")[::2])
+
     def testBindAndFetchRowid(self):
         "test binding (and fetching) a rowid"
         self.cursor.execute("""
@@ -432,6 +445,41 @@ class TestCase(TestEnv.BaseTestCase):
         actualValue, = self.cursor.fetchone()
         self.assertEqual(actualValue.strip(), xmlString)
 
+    def testStringCache(self):
+        "test fetching repeated strings with a string cache"
+        self.cursor.stringcachesize = 5
+        self.cursor.execute("""
+                select mod(level, 3), 'Value ' || mod(level, 3), level
+                from dual
+                connect by level <= 300""")
+        self.assertEqual(self.cursor.fetchvars[1].stringcachesize, 8)
+        self.assertEqual(self.cursor.fetchvars[0].stringcachesize, 0)
+        rows = self.cursor.fetchall()
+        self.assertEqual([r[1] for r in rows],
+                ["Value %d" % (n % 3) for n in range(1, 301)])
+        self.assertTrue(rows[0][1] is rows[3][1])
+        self.assertTrue(rows[1][1] is rows[298][1])
+
+    def testStringCacheFromOutputTypeHandler(self):
+        "test fetching strings with a string cache from a type handler"
+        def outputTypeHandler(cursor, name, defaultType, size, precision,
+                scale):
+            if defaultType == cx_Oracle.DB_TYPE_VARCHAR:
+                return cursor.var(str, size, arraysize=cursor.arraysize,
+                        stringcachesize=16)
+        self.cursor.outputtypehandler = outputTypeHandler
+        self.cursor.execute("""
+                select 'Same', StringCol, NullableCol
+                from TestStrings
+                order by IntCol""")
+        self.assertEqual(self.cursor.fetchvars[0].stringcachesize, 16)
+        rows = self.cursor.fetchall()
+        self.assertEqual([r[1:] for r in rows],
+                [(r[1], r[4]) for r in self.rawData])
+        self.assertTrue(rows[0][0] is rows[-1][0])
+        self.assertRaises(cx_Oracle.ProgrammingError, self.cursor.var, int,
+                stringcachesize=16)
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 
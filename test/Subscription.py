@@ -8,6 +8,7 @@ import TestEnv
 
 import cx_Oracle
 import threading
+import time
 
 class SubscriptionData(object):
 
@@ -109,6 +110,74 @@ class TestCase(TestEnv.BaseTestCase):
                 (TestEnv.GetMainUser(), TestEnv.GetConnectString())
         self.assertEqual(str(sub), expectedValue)
 
+    def testCoalescedMessages(self):
+        "test coalesced delivery of messages using getmessages()"
+        if self.isOnOracleCloud():
+            self.skipTest("Oracle Cloud does not support subscriptions " \
+                    "currently")
+        self.cursor.execute("truncate table TestTempTable")
+        connection = TestEnv.GetConnection(threaded=True, events=True)
+        sub = connection.subscribe(timeout=10, coalesce=True,
+                qos=cx_Oracle.SUBSCR_QOS_ROWIDS)
+        self.assertRaises(cx_Oracle.ProgrammingError, sub.getmessages, -1)
+        sub.registerquery("select * from TestTempTable")
+        self.assertEqual(sub.getmessages(), [])
+        connection.autocommit = True
+        cursor = connection.cursor()
+        for i in range(3):
+            cursor.execute("""
+                    insert into TestTempTable (IntCol, StringCol)
+                    values (:1, 'test')""", [i + 1])
+        rowids = []
+        for i in range(100):
+            for message in sub.getmessages(0.1):
+                if message.type == cx_Oracle.EVENT_OBJCHANGE:
+                    table, = message.tables
+                    self.assertEqual(table.operation, cx_Oracle.OPCODE_INSERT)
+                    rowids.extend(r.rowid for r in table.rows)
+            if len(rowids) == 3:
+                break
+        cursor.execute("select rowid from TestTempTable order by IntCol")
+        self.assertEqual(sorted(rowids), sorted(r for r, in cursor))
+        callbackSub = connection.subscribe(callback=lambda m: None,
+                coalesce=True, coalesceWindow=10)
+        self.assertRaises(cx_Oracle.ProgrammingError,
+                callbackSub.getmessages)
+
+    def testResultCache(self):
+        "test result cache invalidated by query change notification"
+        if self.isOnOracleCloud():
+            self.skipTest("Oracle Cloud does not support subscriptions " \
+                    "currently")
+        self.cursor.execute("truncate table TestTempTable")
+        self.cursor.execute("""
+                insert into TestTempTable (IntCol, StringCol)
+                values (1, 'test')""")
+        self.connection.commit()
+        connection = TestEnv.GetConnection(threaded=True, events=True)
+        cache = connection.resultcache(maxentries=10)
+        sql = "select IntCol, StringCol from TestTempTable where IntCol >= :1"
+        self.assertEqual(cache.fetchall(sql, [1]), [(1, "test")])
+        self.assertEqual(cache.fetchall(sql, [1]), [(1, "test")])
+        self.assertEqual(cache.fetchall(sql, [2]), [])
+        self.assertEqual((cache.hits, cache.misses), (1, 2))
+        self.assertEqual(len(cache), 2)
+        self.cursor.execute("""
+                insert into TestTempTable (IntCol, StringCol)
+                values (2, 'test2')""")
+        self.connection.commit()
+        for i in range(100):
+            if cache.invalidations == 2:
+                break
+            time.sleep(0.1)
+        self.assertEqual(cache.fetchall(sql, [2]), [(2, "test2")])
+        self.assertEqual(cache.fetchall(sql, [1]), [(1, "test"), (2, "test2")])
+        self.assertEqual(cache.invalidations, 2)
+        cache.clear()
+        self.assertEqual(len(cache), 0)
+        cache.close()
+        self.assertRaises(cx_Oracle.InterfaceError, cache.fetchall, sql, [1])
+
 if __name__ == "__main__":
     TestEnv.RunTestCases()
 